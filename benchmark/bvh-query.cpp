@@ -0,0 +1,84 @@
+#include <iostream>
+#include <random>
+#include <vector>
+#include <chrono>
+#include "../common/bounding-volume-hierarchy.hpp"
+#include "../common/composite-shape.hpp"
+#include "../common/circle.hpp"
+#include "../common/rectangle.hpp"
+
+using namespace klimchuk;
+
+int main(int argc, char* argv[])
+{
+  size_t numberOfGroups = (argc > 1) ? std::stoul(argv[1]) : 1000;
+  size_t sizeOfGroup = (argc > 2) ? std::stoul(argv[2]) : 1000;
+  std::mt19937 generator(1);
+  std::uniform_real_distribution<double> position(-10000.0, 10000.0);
+  std::uniform_real_distribution<double> size(0.5, 5.0);
+
+  typedef std::chrono::steady_clock clock;
+  clock::time_point start = clock::now();
+  CompositeShape scene(std::make_shared<Circle>(0.0, 0.0, 1.0));
+  for (size_t i = 0; i < numberOfGroups; ++i)
+  {
+    std::shared_ptr<CompositeShape> group = std::make_shared<CompositeShape>(
+      std::make_shared<Rectangle>(size(generator), size(generator), position(generator), position(generator)));
+    for (size_t j = 1; j < sizeOfGroup; ++j)
+    {
+      group->add(std::make_shared<Circle>(position(generator), position(generator), size(generator)));
+    }
+    scene.add(group);
+  }
+  std::chrono::duration<double> sceneTime = clock::now() - start;
+
+  start = clock::now();
+  BoundingVolumeHierarchy hierarchy(scene);
+  std::chrono::duration<double> buildTime = clock::now() - start;
+
+  const size_t numberOfQueries = 10000;
+  std::vector<point_t> points(numberOfQueries);
+  for (point_t& point : points)
+  {
+    point = { position(generator), position(generator) };
+  }
+
+  size_t numberOfHits = 0;
+  start = clock::now();
+  for (const point_t& point : points)
+  {
+    numberOfHits += hierarchy.queryOverlap({ 20.0, 20.0, point }).size();
+  }
+  std::chrono::duration<double> overlapTime = clock::now() - start;
+
+  start = clock::now();
+  for (const point_t& point : points)
+  {
+    numberOfHits += hierarchy.queryPoint(point).size();
+  }
+  std::chrono::duration<double> pointTime = clock::now() - start;
+
+  start = clock::now();
+  for (size_t i = 0; i < numberOfQueries / 10; ++i)
+  {
+    numberOfHits += hierarchy.queryRay(points[i], { 1.0, 0.3 }).size();
+  }
+  std::chrono::duration<double> rayTime = clock::now() - start;
+
+  start = clock::now();
+  for (size_t i = 0; i < 10; ++i)
+  {
+    scene[i]->move(5.0, 5.0);
+    hierarchy.refit(scene[i]);
+  }
+  std::chrono::duration<double> refitTime = clock::now() - start;
+
+  std::cout << "Leaves: " << hierarchy.getSize() << ", nodes: " << hierarchy.getNumberOfNodes()
+      << ", depth: " << hierarchy.getDepth() << ", hits: " << numberOfHits << '\n'
+      << "scene: " << sceneTime.count() << " s, build: " << buildTime.count() << " s\n"
+      << "overlap query: " << overlapTime.count() * 1e6 / numberOfQueries << " us\n"
+      << "point query:   " << pointTime.count() * 1e6 / numberOfQueries << " us\n"
+      << "ray query:     " << rayTime.count() * 1e6 / (numberOfQueries / 10) << " us\n"
+      << "group refit:   " << refitTime.count() * 1e6 / 10 << " us\n";
+  return 0;
+}
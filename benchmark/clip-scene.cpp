@@ -0,0 +1,62 @@
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <string>
+#include <thread>
+#include "../common/clipper.hpp"
+#include "../common/circle.hpp"
+#include "../common/rectangle.hpp"
+#include "../common/triangle.hpp"
+#include "../common/polygon.hpp"
+
+using namespace klimchuk;
+
+int main(int argc, char* argv[])
+{
+  size_t numberOfShapes = (argc > 1) ? std::stoul(argv[1]) : 1000000;
+  size_t numberOfThreads = (argc > 2) ? std::stoul(argv[2]) : std::thread::hardware_concurrency();
+  std::mt19937 generator(1);
+  std::uniform_real_distribution<double> position(-1000.0, 1000.0);
+  std::uniform_real_distribution<double> size(0.5, 4.0);
+  std::uniform_real_distribution<double> angle(0.0, 90.0);
+  CompositeShape scene(std::make_shared<Circle>(0.0, 0.0, 100.0));
+  for (size_t i = 1; i < numberOfShapes; ++i)
+  {
+    const double x = position(generator);
+    const double y = position(generator);
+    if (i % 3 == 0)
+    {
+      scene.add(std::make_shared<Circle>(x, y, size(generator) / 2));
+    }
+    else if (i % 3 == 1)
+    {
+      scene.add(std::make_shared<Rectangle>(size(generator), size(generator), x, y));
+      scene[i]->rotate(angle(generator));
+    }
+    else
+    {
+      scene.add(std::make_shared<Triangle>(point_t{ x, y }, point_t{ x + size(generator), y },
+        point_t{ x, y + size(generator) }));
+    }
+  }
+
+  typedef std::chrono::steady_clock clock;
+  Clipper viewport(rectangle_t{ 1000.0, 1000.0, { 0.0, 0.0 } });
+  Clipper region(std::make_shared<Polygon>(std::initializer_list<point_t>{ { -800.0, -800.0 }, { 800.0, -800.0 },
+    { 0.0, 0.0 }, { 800.0, 800.0 }, { -800.0, 800.0 } }));
+  viewport.clip(scene, numberOfThreads);
+  region.clip(scene, numberOfThreads);
+  clock::time_point start = clock::now();
+  viewport.clip(scene, numberOfThreads);
+  std::chrono::duration<double> viewportTime = clock::now() - start;
+  start = clock::now();
+  region.clip(scene, numberOfThreads);
+  std::chrono::duration<double> regionTime = clock::now() - start;
+
+  std::cout << "Shapes: " << numberOfShapes << ", threads: " << numberOfThreads << '\n'
+      << "viewport: " << viewportTime.count() << " s, " << viewport.getSize() << " fragments, "
+      << viewport.getNumberOfVertices() << " vertices\n"
+      << "concave region (" << region.getNumberOfPieces() << " pieces): " << regionTime.count() << " s, "
+      << region.getSize() << " fragments, " << region.getNumberOfVertices() << " vertices\n";
+  return 0;
+}
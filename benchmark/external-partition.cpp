@@ -0,0 +1,44 @@
+#include <iostream>
+#include <fstream>
+#include <random>
+#include <chrono>
+#include <string>
+#include <cstdio>
+#include <cmath>
+#include "../common/external-partition.hpp"
+
+using namespace klimchuk;
+
+int main(int argc, char* argv[])
+{
+  size_t numberOfShapes = (argc > 1) ? std::stoul(argv[1]) : 2000000;
+  size_t sizeOfMemory = ((argc > 2) ? std::stoul(argv[2]) : 16) << 20;
+  const std::string pathOfFrames = (argc > 3) ? argv[3] : "/tmp/klimchuk-frames.bin";
+  const std::string pathOfLayers = pathOfFrames + ".layers";
+  {
+    std::mt19937 generator(1);
+    const double extent = std::sqrt(static_cast<double>(numberOfShapes)) * 10.0;
+    std::uniform_real_distribution<double> position(-extent, extent);
+    std::uniform_real_distribution<double> size(1.0, 20.0);
+    std::ofstream stream(pathOfFrames, std::ios::binary);
+    for (size_t i = 0; i < numberOfShapes; ++i)
+    {
+      const rectangle_t frame{ size(generator), size(generator), { position(generator), position(generator) } };
+      stream.write(reinterpret_cast<const char*>(&frame), sizeof(frame));
+    }
+  }
+  for (Matrix::Mode mode : { Matrix::Mode::FIRST_FIT, Matrix::Mode::MINIMUM_LAYERS })
+  {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    const external_statistics_t statistics = partitionExternally(pathOfFrames, pathOfLayers, sizeOfMemory, mode);
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << ((mode == Matrix::Mode::FIRST_FIT) ? "FIRST_FIT" : "MINIMUM_LAYERS") << ": "
+        << statistics.numberOfShapes << " shapes, " << statistics.numberOfLayers << " layers in " << seconds
+        << " s (" << statistics.numberOfShapes * sizeof(rectangle_t) / seconds / (1 << 20) << " MiB/s), "
+        << statistics.numberOfRuns << " runs, " << statistics.numberOfMergePasses << " merge passes, front "
+        << statistics.maxSizeOfFront << " entries, memory limit " << (sizeOfMemory >> 20) << " MiB\n";
+  }
+  std::remove(pathOfFrames.c_str());
+  std::remove(pathOfLayers.c_str());
+  return 0;
+}
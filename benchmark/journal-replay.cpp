@@ -0,0 +1,159 @@
+#include <iostream>
+#include <fstream>
+#include <random>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdio>
+#include "../common/journal.hpp"
+#include "../common/circle.hpp"
+#include "../common/rectangle.hpp"
+#include "../common/polygon.hpp"
+#include "../common/composite-shape.hpp"
+#include "../common/matrix.hpp"
+
+using namespace klimchuk;
+
+namespace
+{
+  const char* NAMES[] = { "circle", "rectangle", "triangle", "polygon", "composite-shape", "matrix", "forget",
+    "move-to", "move-by", "scale", "rotate", "add", "remove", "matrix-add", "matrix-remove", "matrix-update" };
+
+  struct statistics_t
+  {
+    size_t count;
+    size_t failures;
+    double total;
+    double maximum;
+  };
+
+  struct sample_t
+  {
+    double seconds;
+    size_t record;
+    Journal::Operation operation;
+  };
+
+  void recordWorkload(const std::string& path, size_t numberOfShapes)
+  {
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<double> position(-1000.0, 1000.0);
+    std::uniform_real_distribution<double> size(0.5, 4.0);
+    std::uniform_real_distribution<double> step(-5.0, 5.0);
+    std::vector<Shape::ShapePtr> shapes;
+    Matrix matrix(Matrix::Mode::FIRST_FIT, Matrix::Filter::ORIENTED_FRAME);
+    std::ofstream stream(path, std::ios::binary);
+    Journal journal(stream);
+    for (size_t i = 0; i < numberOfShapes; ++i)
+    {
+      const double x = position(generator);
+      const double y = position(generator);
+      if (i % 3 == 0)
+      {
+        shapes.push_back(std::make_shared<Circle>(x, y, size(generator)));
+      }
+      else if (i % 3 == 1)
+      {
+        shapes.push_back(std::make_shared<Rectangle>(size(generator), size(generator), x, y));
+      }
+      else
+      {
+        shapes.push_back(std::make_shared<Polygon>(std::initializer_list<point_t>{ { x, y }, { x + 2, y },
+          { x + 2, y + 2 }, { x + 1, y + 1 }, { x, y + 2 } }));
+      }
+      matrix.add(shapes.back());
+    }
+    CompositeShape compositeShape(shapes.front());
+    for (size_t i = 1; i < shapes.size(); i += 10)
+    {
+      compositeShape.add(shapes[i]);
+    }
+    std::uniform_int_distribution<size_t> index(0, numberOfShapes - 1);
+    for (size_t i = 0; i < numberOfShapes; ++i)
+    {
+      const Shape::ShapePtr& shape = shapes[index(generator)];
+      shape->move(step(generator), step(generator));
+      shape->rotate(step(generator));
+      matrix.update(shape);
+    }
+    compositeShape.rotate(15.0);
+    compositeShape.scale(1.5);
+    for (size_t i = 0; i < numberOfShapes / 10; ++i)
+    {
+      matrix.remove(shapes[i]);
+    }
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  std::string path = (argc > 1) ? argv[1] : "";
+  const size_t numberOfSlowest = (argc > 2) ? std::stoul(argv[2]) : 10;
+  const bool isGenerated = path.empty();
+  if (isGenerated)
+  {
+    path = "/tmp/journal-replay.bin";
+    recordWorkload(path, 5000);
+  }
+
+  std::ifstream stream(path, std::ios::binary);
+  if (!stream)
+  {
+    std::cerr << "Can't open " << path << '\n';
+    return 1;
+  }
+  JournalPlayer player(stream);
+  std::vector<statistics_t> statistics(sizeof(NAMES) / sizeof(NAMES[0]), statistics_t{ 0, 0, 0.0, 0.0 });
+  std::vector<sample_t> samples;
+  typedef std::chrono::steady_clock clock;
+  double total = 0.0;
+  while (player.read())
+  {
+    const clock::time_point start = clock::now();
+    bool isFailed = false;
+    try
+    {
+      player.execute();
+    }
+    catch (const std::logic_error&)
+    {
+      isFailed = true;
+    }
+    const double seconds = std::chrono::duration<double>(clock::now() - start).count();
+    statistics_t& entry = statistics[static_cast<size_t>(player.getOperation())];
+    ++entry.count;
+    entry.failures += isFailed ? 1 : 0;
+    entry.total += seconds;
+    entry.maximum = std::max(entry.maximum, seconds);
+    samples.push_back({ seconds, player.getNumberOfRecords() - 1, player.getOperation() });
+    total += seconds;
+  }
+  if (isGenerated)
+  {
+    std::remove(path.c_str());
+  }
+
+  std::cout << "Records: " << player.getNumberOfRecords() << ", replay: " << total << " s\n";
+  for (size_t i = 0; i < statistics.size(); ++i)
+  {
+    if (statistics[i].count == 0)
+    {
+      continue;
+    }
+    std::cout << NAMES[i] << ": " << statistics[i].count << " calls, " << statistics[i].total * 1e3 << " ms, mean "
+        << statistics[i].total / statistics[i].count * 1e6 << " us, max " << statistics[i].maximum * 1e6 << " us"
+        << ((statistics[i].failures == 0) ? "" : ", failed " + std::to_string(statistics[i].failures)) << '\n';
+  }
+  const size_t numberOfShown = std::min(numberOfSlowest, samples.size());
+  std::partial_sort(samples.begin(), samples.begin() + numberOfShown, samples.end(),
+    [](const sample_t& lhs, const sample_t& rhs) { return lhs.seconds > rhs.seconds; });
+  std::cout << "Slowest records:\n";
+  for (size_t i = 0; i < numberOfShown; ++i)
+  {
+    std::cout << "  #" << samples[i].record << ' ' << NAMES[static_cast<size_t>(samples[i].operation)] << ' '
+        << samples[i].seconds * 1e6 << " us\n";
+  }
+  return 0;
+}
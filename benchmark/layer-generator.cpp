@@ -0,0 +1,85 @@
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "../common/layer-generator.hpp"
+#include "../common/partition.hpp"
+#include "../common/circle.hpp"
+#include "../common/rectangle.hpp"
+
+using namespace klimchuk;
+
+namespace
+{
+  typedef std::chrono::steady_clock clock;
+
+  CompositeShape makeScatter(size_t numberOfShapes, double extent, double maxSize)
+  {
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<double> position(-extent, extent);
+    std::uniform_real_distribution<double> size(maxSize / 10, maxSize);
+    CompositeShape scene(std::make_shared<Circle>(0.0, 0.0, maxSize / 2));
+    for (size_t i = 1; i < numberOfShapes; ++i)
+    {
+      if (i % 3 == 0)
+      {
+        scene.add(std::make_shared<Circle>(position(generator), position(generator), size(generator) / 2));
+      }
+      else
+      {
+        scene.add(std::make_shared<Rectangle>(size(generator), size(generator), position(generator), position(generator)));
+      }
+    }
+    return scene;
+  }
+
+  double getMilliseconds(const clock::time_point& start)
+  {
+    return std::chrono::duration<double, std::milli>(clock::now() - start).count();
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  size_t numberOfShapes = (argc > 1) ? std::stoul(argv[1]) : 50000;
+  double extent = (argc > 2) ? std::stod(argv[2]) : 2000.0;
+  double budget = (argc > 3) ? std::stod(argv[3]) : 4.0;
+  CompositeShape scene = makeScatter(numberOfShapes, extent, 40.0);
+
+  clock::time_point start = clock::now();
+  Matrix matrix = partition(scene, Matrix::Mode::MINIMUM_LAYERS);
+  std::cout << "partition: " << matrix.getNumberOFLayers() << " layers in " << getMilliseconds(start) << " ms\n";
+
+  start = clock::now();
+  LayerGenerator generator(scene);
+  std::vector<Shape::ShapePtr> layer;
+  generator.next(layer);
+  const double firstLayer = getMilliseconds(start);
+  size_t sizeOfFirstLayer = layer.size();
+  while (generator.next(layer))
+  {}
+  std::cout << "generator: layer 0 (" << sizeOfFirstLayer << " shapes) after " << firstLayer << " ms, "
+      << generator.getNumberOfLayers() << " layers in " << getMilliseconds(start) << " ms\n";
+
+  LayerGenerator framed(scene);
+  const std::chrono::duration<double, std::milli> frameBudget(budget);
+  size_t numberOfFrames = 0;
+  size_t framesToFirstLayer = 0;
+  double longestFrame = 0.0;
+  LayerGenerator::Status status = LayerGenerator::Status::SUSPENDED;
+  while (status != LayerGenerator::Status::FINISHED)
+  {
+    const clock::time_point frame = clock::now();
+    status = framed.resume(layer, std::chrono::duration_cast<clock::duration>(frameBudget));
+    longestFrame = std::max(longestFrame, getMilliseconds(frame));
+    ++numberOfFrames;
+    if ((status == LayerGenerator::Status::LAYER) && (framed.getNumberOfLayers() == 1))
+    {
+      framesToFirstLayer = numberOfFrames;
+    }
+  }
+  std::cout << "frame loop (" << budget << " ms budget): layer 0 in frame " << framesToFirstLayer << ", "
+      << numberOfFrames << " frames, longest step " << longestFrame << " ms\n";
+  return 0;
+}
@@ -0,0 +1,76 @@
+#include <iostream>
+#include <random>
+#include <vector>
+#include <chrono>
+#include "../common/matrix.hpp"
+#include "../common/rectangle.hpp"
+#include "../common/circle.hpp"
+
+using namespace klimchuk;
+
+int main(int argc, char* argv[])
+{
+  size_t numberOfShapes = (argc > 1) ? std::stoul(argv[1]) : 2000;
+  size_t numberOfSteps = (argc > 2) ? std::stoul(argv[2]) : 200;
+  std::mt19937 generator(1);
+  std::uniform_real_distribution<double> position(-1000.0, 1000.0);
+  std::uniform_real_distribution<double> size(1.0, 30.0);
+  std::uniform_real_distribution<double> motion(-1.0, 1.0);
+
+  std::vector<Shape::ShapePtr> shapes;
+  for (size_t i = 0; i < numberOfShapes; ++i)
+  {
+    if (i % 2 == 0)
+    {
+      shapes.push_back(std::make_shared<Rectangle>(size(generator), size(generator), position(generator), position(generator)));
+    }
+    else
+    {
+      shapes.push_back(std::make_shared<Circle>(position(generator), position(generator), size(generator) / 2));
+    }
+  }
+
+  Matrix matrix;
+  for (const Shape::ShapePtr& shape : shapes)
+  {
+    matrix.add(shape);
+  }
+
+  std::vector<size_t> movedShapes(numberOfSteps);
+  for (size_t i = 0; i < numberOfSteps; ++i)
+  {
+    movedShapes[i] = generator() % numberOfShapes;
+  }
+
+  typedef std::chrono::steady_clock clock;
+  std::chrono::duration<double> incrementalTime{ 0 };
+  std::chrono::duration<double> rebuildTime{ 0 };
+  for (size_t i = 0; i < numberOfSteps; ++i)
+  {
+    const Shape::ShapePtr& shape = shapes[movedShapes[i]];
+    shape->move(motion(generator), motion(generator));
+
+    clock::time_point start = clock::now();
+    matrix.update(shape);
+    incrementalTime += clock::now() - start;
+
+    start = clock::now();
+    Matrix rebuilt;
+    for (const Shape::ShapePtr& element : shapes)
+    {
+      rebuilt.add(element);
+    }
+    rebuildTime += clock::now() - start;
+
+    if (rebuilt.getNumberOFLayers() != matrix.getNumberOFLayers())
+    {
+      std::cerr << "Incremental matrix differs from the full rebuild.\n";
+      return 1;
+    }
+  }
+
+  std::cout << "Shapes: " << numberOfShapes << ", moves: " << numberOfSteps << '\n'
+      << "update():     " << (incrementalTime.count() * 1e6 / numberOfSteps) << " us per move\n"
+      << "full rebuild: " << (rebuildTime.count() * 1e6 / numberOfSteps) << " us per move\n";
+  return 0;
+}
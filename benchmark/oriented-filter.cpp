@@ -0,0 +1,67 @@
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <string>
+#include "../common/partition.hpp"
+#include "../common/rectangle.hpp"
+#include "../common/triangle.hpp"
+
+using namespace klimchuk;
+
+int main(int argc, char* argv[])
+{
+  size_t numberOfShapes = (argc > 1) ? std::stoul(argv[1]) : 20000;
+  std::mt19937 generator(1);
+  std::uniform_real_distribution<double> position(-500.0, 500.0);
+  std::uniform_real_distribution<double> length(2.0, 20.0);
+  std::uniform_real_distribution<double> angle(0.0, 180.0);
+  CompositeShape scene(std::make_shared<Rectangle>(10.0, 1.0, 0.0, 0.0));
+  for (size_t i = 1; i < numberOfShapes; ++i)
+  {
+    double x = position(generator);
+    double y = position(generator);
+    if (i % 4 == 0)
+    {
+      scene.add(std::make_shared<Triangle>(point_t{ x, y }, point_t{ x + length(generator), y },
+        point_t{ x, y + 1.0 }));
+    }
+    else
+    {
+      scene.add(std::make_shared<Rectangle>(length(generator), 1.0, x, y));
+    }
+    scene[i]->rotate(angle(generator));
+  }
+
+  typedef std::chrono::steady_clock clock;
+  for (Matrix::Mode mode : { Matrix::Mode::FIRST_FIT, Matrix::Mode::MINIMUM_LAYERS })
+  {
+    for (Matrix::Filter filter : { Matrix::Filter::FRAME, Matrix::Filter::ORIENTED_FRAME })
+    {
+      clock::time_point start = clock::now();
+      Matrix matrix = partition(scene, mode, filter);
+      std::chrono::duration<double> time = clock::now() - start;
+      std::cout << ((mode == Matrix::Mode::FIRST_FIT) ? "first fit" : "minimum layers")
+          << ((filter == Matrix::Filter::FRAME) ? ", frames:          " : ", oriented frames: ")
+          << matrix.getNumberOFLayers() << " layers, " << time.count() * 1e3 << " ms\n";
+    }
+  }
+
+  std::vector<rectangle_t> frames;
+  std::vector<oriented_rectangle_t> orientedFrames;
+  for (size_t i = 0; i < scene.getSize(); ++i)
+  {
+    frames.push_back(scene[i]->getFrameRect());
+    orientedFrames.push_back(scene[i]->getOrientedFrameRect());
+  }
+  std::vector<intersection_t> intersections = findIntersections(frames.data(), frames.size());
+  size_t numberOfOriented = 0;
+  clock::time_point start = clock::now();
+  for (const intersection_t& intersection : intersections)
+  {
+    numberOfOriented += areShapesIntersect(orientedFrames[intersection.first], orientedFrames[intersection.second]);
+  }
+  std::chrono::duration<double> time = clock::now() - start;
+  std::cout << "overlapping frames: " << intersections.size() << ", overlapping oriented frames: " << numberOfOriented
+      << ", " << time.count() * 1e9 / intersections.size() << " ns per test\n";
+  return 0;
+}
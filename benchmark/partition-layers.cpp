@@ -0,0 +1,96 @@
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "../common/partition.hpp"
+#include "../common/circle.hpp"
+#include "../common/rectangle.hpp"
+
+using namespace klimchuk;
+
+namespace
+{
+  CompositeShape makeScatter(size_t numberOfShapes, double extent, double maxSize)
+  {
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<double> position(-extent, extent);
+    std::uniform_real_distribution<double> size(maxSize / 10, maxSize);
+    CompositeShape scene(std::make_shared<Circle>(0.0, 0.0, maxSize / 2));
+    for (size_t i = 1; i < numberOfShapes; ++i)
+    {
+      if (i % 3 == 0)
+      {
+        scene.add(std::make_shared<Circle>(position(generator), position(generator), size(generator) / 2));
+      }
+      else
+      {
+        scene.add(std::make_shared<Rectangle>(size(generator), size(generator), position(generator), position(generator)));
+      }
+    }
+    return scene;
+  }
+
+  CompositeShape makeTiles(size_t side)
+  {
+    CompositeShape scene(std::make_shared<Rectangle>(1.2, 1.2, 0.0, 0.0));
+    for (size_t i = 1; i < side * side; ++i)
+    {
+      scene.add(std::make_shared<Rectangle>(1.2, 1.2, static_cast<double>(i % side), static_cast<double>(i / side)));
+    }
+    return scene;
+  }
+
+  size_t countViolations(CompositeShape& scene, Matrix& matrix)
+  {
+    std::unordered_map<const Shape*, size_t> layers;
+    for (size_t i = 0; i < matrix.getNumberOFLayers(); ++i)
+    {
+      for (size_t j = 0; j < matrix.getSizeOfLayer(i); ++j)
+      {
+        layers[matrix[i][j].get()] = i;
+      }
+    }
+    std::vector<rectangle_t> frames;
+    for (size_t i = 0; i < scene.getSize(); ++i)
+    {
+      frames.push_back(scene[i]->getFrameRect());
+    }
+    size_t violations = 0;
+    for (const intersection_t& intersection : findIntersections(frames.data(), frames.size()))
+    {
+      if (layers[scene[intersection.first].get()] >= layers[scene[intersection.second].get()])
+      {
+        ++violations;
+      }
+    }
+    return violations;
+  }
+
+  void report(const std::string& name, CompositeShape& scene)
+  {
+    typedef std::chrono::steady_clock clock;
+    clock::time_point start = clock::now();
+    Matrix firstFit = partition(scene, Matrix::Mode::FIRST_FIT);
+    std::chrono::duration<double> firstFitTime = clock::now() - start;
+    start = clock::now();
+    Matrix minimum = partition(scene, Matrix::Mode::MINIMUM_LAYERS);
+    std::chrono::duration<double> minimumTime = clock::now() - start;
+    std::cout << name << " (" << scene.getSize() << " shapes): FIRST_FIT " << firstFit.getNumberOFLayers()
+        << " layers, " << countViolations(scene, firstFit) << " misordered overlaps, " << firstFitTime.count() * 1e3
+        << " ms; MINIMUM_LAYERS " << minimum.getNumberOFLayers() << " layers, " << countViolations(scene, minimum)
+        << " misordered overlaps, " << minimumTime.count() * 1e3 << " ms\n";
+  }
+}
+
+int main()
+{
+  CompositeShape sparse = makeScatter(5000, 1000.0, 40.0);
+  CompositeShape dense = makeScatter(5000, 200.0, 40.0);
+  CompositeShape tiles = makeTiles(70);
+  report("sparse scatter", sparse);
+  report("dense scatter", dense);
+  report("overlapping tiles", tiles);
+  return 0;
+}
@@ -0,0 +1,65 @@
+#include <iostream>
+#include <sstream>
+#include <random>
+#include <string>
+#include <thread>
+#include "../common/pipeline.hpp"
+
+using namespace klimchuk;
+
+namespace
+{
+  void printStatistics(const char* name, const pipeline_statistics_t& statistics)
+  {
+    std::cout << name << ": " << statistics.total << " s (" << statistics.numberOfShapes / statistics.total
+        << " shapes/s), parse " << statistics.parsing << " s, transform " << statistics.transforming
+        << " s, partition " << statistics.partitioning << " s\n";
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  size_t numberOfShapes = (argc > 1) ? std::stoul(argv[1]) : 20000;
+  size_t capacityOfQueues = (argc > 2) ? std::stoul(argv[2]) : 1024;
+  std::mt19937 generator(1);
+  std::uniform_real_distribution<double> position(-20000.0, 20000.0);
+  std::uniform_real_distribution<double> size(0.5, 4.0);
+  std::uniform_real_distribution<double> angle(0.0, 90.0);
+  std::ostringstream text;
+  for (size_t i = 0; i < numberOfShapes; ++i)
+  {
+    const double x = position(generator);
+    const double y = position(generator);
+    if (i % 3 == 0)
+    {
+      text << "circle " << x << ' ' << y << ' ' << size(generator) << '\n';
+    }
+    else if (i % 3 == 1)
+    {
+      text << "rectangle " << size(generator) << ' ' << size(generator) << ' ' << x << ' ' << y << ' '
+          << angle(generator) << '\n';
+    }
+    else
+    {
+      text << "polygon " << x << ' ' << y << ' ' << x + 2 << ' ' << y << ' ' << x + 2 << ' ' << y + 2 << ' '
+          << x + 1 << ' ' << y + 1 << ' ' << x << ' ' << y + 2 << '\n';
+    }
+  }
+  const std::string scene = text.str();
+  const Transform transform = [](const Shape::ShapePtr& shape)
+  {
+    shape->rotate(10.0);
+    shape->scale(0.5);
+    shape->move(1.0, 2.0);
+  };
+
+  std::istringstream first(scene);
+  Matrix pipelined;
+  printStatistics("pipelined", runPipeline(first, transform, pipelined, capacityOfQueues));
+  std::istringstream second(scene);
+  Matrix sequential;
+  printStatistics("sequential", runSequentially(second, transform, sequential));
+  std::cout << "Hardware threads: " << std::thread::hardware_concurrency() << ", layers: "
+      << pipelined.getNumberOFLayers() << " / " << sequential.getNumberOFLayers() << '\n';
+  return 0;
+}
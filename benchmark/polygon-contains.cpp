@@ -0,0 +1,56 @@
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cmath>
+#include "../common/polygon.hpp"
+
+using namespace klimchuk;
+
+int main(int argc, char* argv[])
+{
+  size_t numberOfVertices = (argc > 1) ? std::stoul(argv[1]) : 100000;
+  size_t numberOfQueries = (argc > 2) ? std::stoul(argv[2]) : 1000000;
+  std::mt19937 generator(1);
+  std::uniform_real_distribution<double> radius(50.0, 100.0);
+  std::vector<point_t> ring(numberOfVertices);
+  for (size_t i = 0; i < numberOfVertices; ++i)
+  {
+    const double angle = 2 * M_PI * i / numberOfVertices;
+    const double length = radius(generator);
+    ring[i] = { length * std::cos(angle), length * std::sin(angle) };
+  }
+  std::uniform_real_distribution<double> position(-100.0, 100.0);
+  std::vector<point_t> queries(numberOfQueries);
+  for (point_t& query : queries)
+  {
+    query = { position(generator), position(generator) };
+  }
+
+  typedef std::chrono::steady_clock clock;
+  Polygon polygon(ring.data(), ring.size());
+  clock::time_point start = clock::now();
+  const size_t numberOfTriangles = polygon.getTriangulation().size() / 3;
+  std::chrono::duration<double> triangulationTime = clock::now() - start;
+  start = clock::now();
+  polygon.contains(point_t{ 0.0, 0.0 });
+  std::chrono::duration<double> slabsTime = clock::now() - start;
+  start = clock::now();
+  size_t numberOfInside = 0;
+  for (const point_t& query : queries)
+  {
+    numberOfInside += polygon.contains(query) ? 1 : 0;
+  }
+  std::chrono::duration<double> singleTime = clock::now() - start;
+  start = clock::now();
+  const std::vector<bool> results = polygon.contains(queries.data(), queries.size());
+  std::chrono::duration<double> batchTime = clock::now() - start;
+
+  std::cout << "Vertices: " << numberOfVertices << ", queries: " << numberOfQueries << '\n'
+      << "triangulation: " << triangulationTime.count() << " s, " << numberOfTriangles << " triangles\n"
+      << "slabs: " << slabsTime.count() << " s\n"
+      << "single queries: " << singleTime.count() << " s, " << numberOfInside << " inside\n"
+      << "batch query: " << batchTime.count() << " s, " << results.size() << " results\n";
+  return 0;
+}
@@ -0,0 +1,64 @@
+#include <iostream>
+#include <fstream>
+#include <random>
+#include <chrono>
+#include <string>
+#include <thread>
+#include "../common/raster.hpp"
+#include "../common/partition.hpp"
+#include "../common/circle.hpp"
+#include "../common/rectangle.hpp"
+#include "../common/triangle.hpp"
+
+using namespace klimchuk;
+
+int main(int argc, char* argv[])
+{
+  size_t numberOfShapes = (argc > 1) ? std::stoul(argv[1]) : 1000000;
+  size_t numberOfThreads = (argc > 2) ? std::stoul(argv[2]) : std::thread::hardware_concurrency();
+  std::mt19937 generator(1);
+  std::uniform_real_distribution<double> position(-1000.0, 1000.0);
+  std::uniform_real_distribution<double> size(0.5, 4.0);
+  std::uniform_real_distribution<double> angle(0.0, 90.0);
+  CompositeShape scene(std::make_shared<Circle>(0.0, 0.0, 100.0));
+  for (size_t i = 1; i < numberOfShapes; ++i)
+  {
+    const double x = position(generator);
+    const double y = position(generator) * 9 / 16;
+    if (i % 3 == 0)
+    {
+      scene.add(std::make_shared<Circle>(x, y, size(generator) / 2));
+    }
+    else if (i % 3 == 1)
+    {
+      scene.add(std::make_shared<Rectangle>(size(generator), size(generator), x, y));
+      scene[i]->rotate(angle(generator));
+    }
+    else
+    {
+      scene.add(std::make_shared<Triangle>(point_t{ x, y }, point_t{ x + size(generator), y },
+        point_t{ x, y + size(generator) }));
+    }
+  }
+  Matrix matrix = partition(scene, Matrix::Mode::MINIMUM_LAYERS);
+
+  typedef std::chrono::steady_clock clock;
+  Raster raster(3840, 2160, { 2000.0, 1125.0, { 0.0, 0.0 } });
+  clock::time_point start = clock::now();
+  raster.render(scene, Raster::Mode::COVERAGE, numberOfThreads);
+  std::chrono::duration<double> coverageTime = clock::now() - start;
+  raster.clear();
+  start = clock::now();
+  raster.render(matrix, Raster::Mode::LAYER_INDEX, numberOfThreads);
+  std::chrono::duration<double> layerTime = clock::now() - start;
+
+  std::cout << "Shapes: " << numberOfShapes << ", layers: " << matrix.getNumberOFLayers() << ", threads: "
+      << numberOfThreads << '\n' << "coverage image:    " << coverageTime.count() << " s\n"
+      << "layer index image: " << layerTime.count() << " s\n";
+  if (argc > 3)
+  {
+    std::ofstream file(argv[3], std::ios::binary);
+    raster.writePpm(file);
+  }
+  return 0;
+}
@@ -0,0 +1,106 @@
+#include <iostream>
+#include <random>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include "../common/scene-diff.hpp"
+#include "../common/rectangle.hpp"
+#include "../common/circle.hpp"
+
+using namespace klimchuk;
+
+namespace
+{
+  std::shared_ptr<CompositeShape> makeScene(size_t numberOfGroups, size_t sizeOfGroup)
+  {
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<double> position(-1000.0, 1000.0);
+    std::uniform_real_distribution<double> size(1.0, 30.0);
+    std::shared_ptr<CompositeShape> scene;
+    for (size_t i = 0; i < numberOfGroups; ++i)
+    {
+      std::shared_ptr<CompositeShape> group;
+      for (size_t j = 0; j < sizeOfGroup; ++j)
+      {
+        Shape::ShapePtr shape;
+        if (j % 2 == 0)
+        {
+          shape = std::make_shared<Rectangle>(size(generator), size(generator), position(generator), position(generator));
+        }
+        else
+        {
+          shape = std::make_shared<Circle>(position(generator), position(generator), size(generator) / 2);
+        }
+        group ? group->add(shape) : void(group = std::make_shared<CompositeShape>(shape));
+      }
+      scene ? scene->add(group) : void(scene = std::make_shared<CompositeShape>(group));
+    }
+    return scene;
+  }
+
+  size_t compareFully(const CompositeShape& oldScene, const CompositeShape& newScene)
+  {
+    size_t numberOfDifferences = 0;
+    for (size_t i = 0; i < oldScene.getSize(); ++i)
+    {
+      const CompositeShape& oldGroup = dynamic_cast<const CompositeShape&>(*oldScene[i]);
+      const CompositeShape& newGroup = dynamic_cast<const CompositeShape&>(*newScene[i]);
+      for (size_t j = 0; j < oldGroup.getSize(); ++j)
+      {
+        const rectangle_t oldFrame = oldGroup[j]->getFrameRect();
+        const rectangle_t newFrame = newGroup[j]->getFrameRect();
+        numberOfDifferences += (oldFrame.pos.x != newFrame.pos.x) || (oldFrame.pos.y != newFrame.pos.y)
+          || (oldFrame.width != newFrame.width) || (oldFrame.height != newFrame.height)
+          || (oldGroup[j]->getArea() != newGroup[j]->getArea());
+      }
+    }
+    return numberOfDifferences;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  size_t numberOfGroups = (argc > 1) ? std::stoul(argv[1]) : 100;
+  size_t sizeOfGroup = (argc > 2) ? std::stoul(argv[2]) : 1000;
+  size_t numberOfSteps = (argc > 3) ? std::stoul(argv[3]) : 100;
+  std::shared_ptr<CompositeShape> oldScene = makeScene(numberOfGroups, sizeOfGroup);
+  std::shared_ptr<CompositeShape> newScene = makeScene(numberOfGroups, sizeOfGroup);
+  std::mt19937 generator(2);
+
+  typedef std::chrono::steady_clock clock;
+  clock::time_point start = clock::now();
+  oldScene->getHash();
+  newScene->getHash();
+  const std::chrono::duration<double> hashTime = clock::now() - start;
+
+  std::chrono::duration<double> diffTime{ 0 };
+  std::chrono::duration<double> fullTime{ 0 };
+  for (size_t i = 0; i < numberOfSteps; ++i)
+  {
+    const size_t groupIndex = generator() % numberOfGroups;
+    const size_t shapeIndex = generator() % sizeOfGroup;
+    dynamic_cast<CompositeShape&>(*(*newScene)[groupIndex])[shapeIndex]->move(1.0, 0.0);
+
+    start = clock::now();
+    const std::vector<scene_change_t> changes = diffScenes(*oldScene, *newScene);
+    diffTime += clock::now() - start;
+
+    start = clock::now();
+    const size_t numberOfDifferences = compareFully(*oldScene, *newScene);
+    fullTime += clock::now() - start;
+
+    if ((numberOfDifferences != 1) || (changes.size() != 2))
+    {
+      std::cerr << "Scene diff differs from the full comparison.\n";
+      return 1;
+    }
+    dynamic_cast<CompositeShape&>(*(*oldScene)[groupIndex])[shapeIndex]->move(1.0, 0.0);
+  }
+
+  std::cout << "Shapes: " << numberOfGroups * sizeOfGroup << " in " << numberOfGroups << " groups, edits: "
+      << numberOfSteps << '\n'
+      << "first hashing:   " << (hashTime.count() * 1e3) << " ms\n"
+      << "diffScenes():    " << (diffTime.count() * 1e6 / numberOfSteps) << " us per edit\n"
+      << "full comparison: " << (fullTime.count() * 1e6 / numberOfSteps) << " us per edit\n";
+  return 0;
+}
@@ -0,0 +1,69 @@
+#include <iostream>
+#include <fstream>
+#include <random>
+#include <chrono>
+#include <string>
+#include <cstdio>
+#include "../common/scene-reader.hpp"
+
+using namespace klimchuk;
+
+int main(int argc, char* argv[])
+{
+  size_t numberOfShapes = (argc > 1) ? std::stoul(argv[1]) : 1000000;
+  const std::string path = (argc > 2) ? argv[2] : "/tmp/scene-reader.txt";
+  std::mt19937 generator(1);
+  std::uniform_real_distribution<double> position(-1000.0, 1000.0);
+  std::uniform_real_distribution<double> size(0.5, 4.0);
+  std::uniform_real_distribution<double> angle(0.0, 90.0);
+  {
+    std::ofstream stream(path);
+    for (size_t i = 0; i < numberOfShapes; ++i)
+    {
+      const double x = position(generator);
+      const double y = position(generator);
+      if (i % 4 == 0)
+      {
+        stream << "circle " << x << ' ' << y << ' ' << size(generator) << '\n';
+      }
+      else if (i % 4 == 1)
+      {
+        stream << "rectangle " << size(generator) << ' ' << size(generator) << ' ' << x << ' ' << y << ' '
+            << angle(generator) << '\n';
+      }
+      else if (i % 4 == 2)
+      {
+        stream << "triangle " << x << ' ' << y << ' ' << x + size(generator) << ' ' << y << ' ' << x << ' '
+            << y + size(generator) << '\n';
+      }
+      else
+      {
+        stream << "polygon " << x << ' ' << y << ' ' << x + 2 << ' ' << y << ' ' << x + 2 << ' ' << y + 2 << ' '
+            << x + 1 << ' ' << y + 1 << ' ' << x << ' ' << y + 2 << '\n';
+      }
+    }
+  }
+  std::ifstream probe(path, std::ios::binary | std::ios::ate);
+  const double megabytes = static_cast<double>(probe.tellg()) / (1 << 20);
+
+  typedef std::chrono::steady_clock clock;
+  clock::time_point start = clock::now();
+  std::ifstream stream(path, std::ios::binary);
+  SceneReader reader(stream);
+  size_t numberOfRead = 0;
+  while (reader.next())
+  {
+    ++numberOfRead;
+  }
+  std::chrono::duration<double> parseTime = clock::now() - start;
+  start = clock::now();
+  std::ifstream sceneStream(path, std::ios::binary);
+  CompositeShape scene = readScene(sceneStream);
+  std::chrono::duration<double> loadTime = clock::now() - start;
+  std::remove(path.c_str());
+
+  std::cout << "Shapes: " << numberOfRead << ", file: " << megabytes << " MiB\n"
+      << "parse and construct: " << parseTime.count() << " s, " << megabytes / parseTime.count() << " MiB/s\n"
+      << "load CompositeShape: " << loadTime.count() << " s, " << scene.getSize() << " shapes\n";
+  return 0;
+}
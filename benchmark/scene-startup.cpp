@@ -0,0 +1,83 @@
+#include <iostream>
+#include <fstream>
+#include <random>
+#include <chrono>
+#include <string>
+#include "../common/mapped-scene.hpp"
+#include "../common/partition.hpp"
+#include "../common/circle.hpp"
+#include "../common/rectangle.hpp"
+#include "../common/triangle.hpp"
+
+using namespace klimchuk;
+
+int main(int argc, char* argv[])
+{
+  size_t numberOfShapes = (argc > 1) ? std::stoul(argv[1]) : 1000000;
+  const std::string path = (argc > 2) ? argv[2] : "/tmp/scene-startup.bin";
+  typedef std::chrono::steady_clock clock;
+  clock::time_point start = clock::now();
+  std::mt19937 generator(1);
+  std::uniform_real_distribution<double> position(-1000.0, 1000.0);
+  std::uniform_real_distribution<double> size(0.5, 4.0);
+  std::uniform_real_distribution<double> angle(0.0, 90.0);
+  CompositeShape scene(std::make_shared<Circle>(0.0, 0.0, 1.0));
+  for (size_t i = 1; i < numberOfShapes; ++i)
+  {
+    const double x = position(generator);
+    const double y = position(generator);
+    if (i % 3 == 0)
+    {
+      scene.add(std::make_shared<Circle>(x, y, size(generator) / 2));
+    }
+    else if (i % 3 == 1)
+    {
+      scene.add(std::make_shared<Rectangle>(size(generator), size(generator), x, y));
+      scene[i]->rotate(angle(generator));
+    }
+    else
+    {
+      scene.add(std::make_shared<Triangle>(point_t{ x, y }, point_t{ x + size(generator), y },
+        point_t{ x, y + size(generator) }));
+    }
+  }
+  Matrix matrix = partition(scene, Matrix::Mode::MINIMUM_LAYERS);
+  std::chrono::duration<double> buildTime = clock::now() - start;
+  start = clock::now();
+  {
+    std::ofstream stream(path, std::ios::binary);
+    writeScene(stream, scene, &matrix);
+  }
+  std::chrono::duration<double> writeTime = clock::now() - start;
+
+  start = clock::now();
+  MappedScene mapped(path);
+  std::chrono::duration<double> mapTime = clock::now() - start;
+  start = clock::now();
+  double sumOfRadiuses = 0.0;
+  for (size_t i = 0; i < mapped.getSize(); ++i)
+  {
+    if (mapped[i].type == MappedScene::Type::CIRCLE)
+    {
+      sumOfRadiuses += mapped.getCircle(i).radius;
+    }
+  }
+  size_t numberOfLayered = 0;
+  for (size_t i = 0; i < mapped.getNumberOfLayers(); ++i)
+  {
+    numberOfLayered += mapped.getSizeOfLayer(i);
+  }
+  std::chrono::duration<double> touchTime = clock::now() - start;
+  start = clock::now();
+  CompositeShape loaded = mapped.getCompositeShape();
+  std::chrono::duration<double> materializeTime = clock::now() - start;
+
+  std::cout << "Shapes: " << numberOfShapes << ", layers: " << mapped.getNumberOfLayers() << '\n'
+      << "build and partition: " << buildTime.count() << " s\n"
+      << "write: " << writeTime.count() << " s\n"
+      << "map: " << mapTime.count() * 1e3 << " ms\n"
+      << "first pass over records and layers: " << touchTime.count() * 1e3 << " ms (" << sumOfRadiuses << ", "
+      << numberOfLayered << ")\n"
+      << "materialize CompositeShape: " << materializeTime.count() << " s, " << loaded.getSize() << " shapes\n";
+  return 0;
+}
@@ -0,0 +1,54 @@
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <cmath>
+#include "../common/sharded-partition.hpp"
+#include "../common/partition.hpp"
+#include "../common/circle.hpp"
+#include "../common/rectangle.hpp"
+
+using namespace klimchuk;
+
+namespace
+{
+  typedef std::chrono::steady_clock clock;
+
+  double getMilliseconds(const clock::time_point& start)
+  {
+    return std::chrono::duration<double, std::milli>(clock::now() - start).count();
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  size_t numberOfShapes = (argc > 1) ? std::stoul(argv[1]) : 200000;
+  size_t maxNumberOfProcesses = (argc > 2) ? std::stoul(argv[2]) : 8;
+  std::mt19937 generator(1);
+  const double extent = std::sqrt(static_cast<double>(numberOfShapes)) * 8.0;
+  std::uniform_real_distribution<double> position(-extent, extent);
+  std::uniform_real_distribution<double> size(1.0, 20.0);
+  CompositeShape scene(std::make_shared<Circle>(0.0, 0.0, 5.0));
+  for (size_t i = 1; i < numberOfShapes; ++i)
+  {
+    scene.add(std::make_shared<Rectangle>(size(generator), size(generator), position(generator), position(generator)));
+  }
+
+  clock::time_point start = clock::now();
+  Matrix expected = partition(scene, Matrix::Mode::MINIMUM_LAYERS);
+  std::cout << "partition: " << expected.getNumberOFLayers() << " layers in " << getMilliseconds(start) << " ms\n";
+  for (size_t numberOfProcesses = 1; numberOfProcesses <= maxNumberOfProcesses; numberOfProcesses *= 2)
+  {
+    start = clock::now();
+    Matrix matrix = partitionInProcesses(scene, numberOfProcesses, Matrix::Mode::MINIMUM_LAYERS);
+    const double minimumLayers = getMilliseconds(start);
+    start = clock::now();
+    Matrix firstFit = partitionInProcesses(scene, numberOfProcesses, Matrix::Mode::FIRST_FIT);
+    std::cout << numberOfProcesses << " processes: MINIMUM_LAYERS " << matrix.getNumberOFLayers() << " layers in "
+        << minimumLayers << " ms, FIRST_FIT " << firstFit.getNumberOFLayers() << " layers in "
+        << getMilliseconds(start) << " ms\n";
+  }
+  std::cout << "Hardware threads: " << std::thread::hardware_concurrency() << '\n';
+  return 0;
+}
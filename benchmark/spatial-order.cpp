@@ -0,0 +1,63 @@
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "../common/partition.hpp"
+#include "../common/circle.hpp"
+#include "../common/rectangle.hpp"
+
+using namespace klimchuk;
+
+int main(int argc, char* argv[])
+{
+  size_t numberOfShapes = (argc > 1) ? std::stoul(argv[1]) : 1000000;
+  std::mt19937 generator(1);
+  std::uniform_real_distribution<double> position(-1000.0, 1000.0);
+  std::uniform_real_distribution<double> size(0.5, 4.0);
+  CompositeShape scene(std::make_shared<Circle>(0.0, 0.0, 1.0));
+  for (size_t i = 1; i < numberOfShapes; ++i)
+  {
+    if (i % 2 == 0)
+    {
+      scene.add(std::make_shared<Circle>(position(generator), position(generator), size(generator) / 2));
+    }
+    else
+    {
+      scene.add(std::make_shared<Rectangle>(size(generator), size(generator), position(generator), position(generator)));
+    }
+  }
+  std::vector<rectangle_t> frames(numberOfShapes);
+  for (size_t i = 0; i < numberOfShapes; ++i)
+  {
+    frames[i] = scene[i]->getFrameRect();
+  }
+
+  typedef std::chrono::steady_clock clock;
+  clock::time_point start = clock::now();
+  const size_t numberOfIntersections = findIntersections(frames.data(), frames.size()).size();
+  std::chrono::duration<double> sweepTime = clock::now() - start;
+  std::cout << "Shapes: " << numberOfShapes << ", intersections: " << numberOfIntersections << '\n'
+      << "insertion order: sweep " << sweepTime.count() << " s\n";
+  for (CompositeShape::Curve curve : { CompositeShape::Curve::MORTON, CompositeShape::Curve::HILBERT })
+  {
+    start = clock::now();
+    const std::vector<size_t> order = scene.getSpatialOrder(curve);
+    std::chrono::duration<double> orderTime = clock::now() - start;
+    std::vector<rectangle_t> orderedFrames(numberOfShapes);
+    for (size_t i = 0; i < numberOfShapes; ++i)
+    {
+      orderedFrames[i] = frames[order[i]];
+    }
+    start = clock::now();
+    findIntersections(orderedFrames.data(), orderedFrames.size());
+    sweepTime = clock::now() - start;
+    std::cout << ((curve == CompositeShape::Curve::MORTON) ? "morton" : "hilbert") << " order: ordering "
+        << orderTime.count() << " s, sweep " << sweepTime.count() << " s\n";
+  }
+  start = clock::now();
+  Matrix matrix = partition(scene, Matrix::Mode::MINIMUM_LAYERS);
+  std::chrono::duration<double> partitionTime = clock::now() - start;
+  std::cout << "partition: " << partitionTime.count() << " s, " << matrix.getNumberOFLayers() << " layers\n";
+  return 0;
+}
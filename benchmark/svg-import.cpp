@@ -0,0 +1,72 @@
+#include <iostream>
+#include <fstream>
+#include <random>
+#include <chrono>
+#include <string>
+#include <cstdio>
+#include "../common/svg.hpp"
+
+using namespace klimchuk;
+
+int main(int argc, char* argv[])
+{
+  size_t numberOfShapes = (argc > 1) ? std::stoul(argv[1]) : 1000000;
+  const std::string path = (argc > 2) ? argv[2] : "/tmp/svg-import.svg";
+  std::mt19937 generator(1);
+  std::uniform_real_distribution<double> position(-1000.0, 1000.0);
+  std::uniform_real_distribution<double> size(0.5, 4.0);
+  std::uniform_real_distribution<double> angle(0.0, 90.0);
+  {
+    std::ofstream stream(path);
+    stream << "<?xml version=\"1.0\"?>\n<svg xmlns=\"http://www.w3.org/2000/svg\">\n";
+    for (size_t i = 0; i < numberOfShapes; ++i)
+    {
+      const double x = position(generator);
+      const double y = position(generator);
+      if (i % 1000 == 0)
+      {
+        stream << ((i == 0) ? "" : "</g>\n") << "<g transform=\"translate(" << x << ' ' << y << ") rotate("
+            << angle(generator) << ")\">\n";
+      }
+      if (i % 4 == 0)
+      {
+        stream << "  <circle cx=\"" << x << "\" cy=\"" << y << "\" r=\"" << size(generator) << "\"/>\n";
+      }
+      else if (i % 4 == 1)
+      {
+        stream << "  <rect x=\"" << x << "\" y=\"" << y << "\" width=\"" << size(generator) << "\" height=\""
+            << size(generator) << "\" transform=\"rotate(" << angle(generator) << ")\"/>\n";
+      }
+      else if (i % 4 == 2)
+      {
+        stream << "  <polygon points=\"" << x << ',' << y << ' ' << x + size(generator) << ',' << y << ' ' << x << ','
+            << y + size(generator) << "\"/>\n";
+      }
+      else
+      {
+        stream << "  <path d=\"M" << x << ' ' << y << " h2 v2 l-1 -1 l-1 1 z\"/>\n";
+      }
+    }
+    stream << ((numberOfShapes == 0) ? "" : "</g>\n") << "</svg>\n";
+  }
+  std::ifstream probe(path, std::ios::binary | std::ios::ate);
+  const double megabytes = static_cast<double>(probe.tellg()) / (1 << 20);
+
+  typedef std::chrono::steady_clock clock;
+  clock::time_point start = clock::now();
+  std::ifstream stream(path, std::ios::binary);
+  CompositeShape scene = readSvg(stream);
+  std::chrono::duration<double> readTime = clock::now() - start;
+  start = clock::now();
+  {
+    std::ofstream output(path, std::ios::binary);
+    writeSvg(output, scene);
+  }
+  std::chrono::duration<double> writeTime = clock::now() - start;
+  std::remove(path.c_str());
+
+  std::cout << "Shapes: " << numberOfShapes << ", groups: " << scene.getSize() << ", file: " << megabytes << " MiB\n"
+      << "import: " << readTime.count() << " s, " << megabytes / readTime.count() << " MiB/s\n"
+      << "export: " << writeTime.count() << " s\n";
+  return 0;
+}
@@ -0,0 +1,52 @@
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <string>
+#include <thread>
+#include "../common/composite-shape.hpp"
+#include "../common/circle.hpp"
+#include "../common/rectangle.hpp"
+#include "../common/triangle.hpp"
+
+using namespace klimchuk;
+
+int main(int argc, char* argv[])
+{
+  size_t numberOfShapes = (argc > 1) ? std::stoul(argv[1]) : 1000000;
+  std::mt19937 generator(1);
+  const double extent = std::sqrt(static_cast<double>(numberOfShapes)) * 2.0;
+  std::uniform_real_distribution<double> position(-extent, extent);
+  std::uniform_real_distribution<double> size(0.5, 3.0);
+  std::uniform_real_distribution<double> angle(0.0, 90.0);
+  CompositeShape scene(std::make_shared<Circle>(0.0, 0.0, 1.0));
+  for (size_t i = 1; i < numberOfShapes; ++i)
+  {
+    const double x = position(generator);
+    const double y = position(generator);
+    if (i % 3 == 0)
+    {
+      scene.add(std::make_shared<Circle>(x, y, size(generator) / 2));
+    }
+    else if (i % 3 == 1)
+    {
+      scene.add(std::make_shared<Rectangle>(size(generator), size(generator), x, y));
+      scene[i]->rotate(angle(generator));
+    }
+    else
+    {
+      scene.add(std::make_shared<Triangle>(point_t{ x, y }, point_t{ x + size(generator), y },
+        point_t{ x, y + size(generator) }));
+    }
+  }
+
+  typedef std::chrono::steady_clock clock;
+  std::cout << "Shapes: " << numberOfShapes << ", sum of areas: " << scene.getArea() << '\n';
+  for (size_t numberOfThreads : { static_cast<size_t>(1), static_cast<size_t>(std::thread::hardware_concurrency()) })
+  {
+    clock::time_point start = clock::now();
+    double area = scene.getUnionArea(numberOfThreads);
+    std::chrono::duration<double> time = clock::now() - start;
+    std::cout << "threads: " << numberOfThreads << ", union area: " << area << ", " << time.count() << " s\n";
+  }
+  return 0;
+}
@@ -0,0 +1,93 @@
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include "../common/vertex-encoding.hpp"
+#include "../common/polygon.hpp"
+
+using namespace klimchuk;
+
+namespace
+{
+  std::vector<char> readFile(const std::string& path)
+  {
+    std::ifstream stream(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  size_t numberOfPolygons = (argc > 1) ? std::stoul(argv[1]) : 100000;
+  size_t numberOfVertices = (argc > 2) ? std::stoul(argv[2]) : 64;
+  const double quantum = (argc > 3) ? std::stod(argv[3]) : 0.001;
+  const std::string rawPath = "/tmp/vertex-encoding.raw";
+  const std::string encodedPath = "/tmp/vertex-encoding.bin";
+  std::mt19937 generator(1);
+  std::uniform_real_distribution<double> position(-10000.0, 10000.0);
+  std::uniform_real_distribution<double> noise(0.9, 1.1);
+  {
+    std::ofstream raw(rawPath, std::ios::binary);
+    std::ofstream encoded(encodedPath, std::ios::binary);
+    std::vector<point_t> points(numberOfVertices);
+    for (size_t i = 0; i < numberOfPolygons; ++i)
+    {
+      const point_t centre{ position(generator), position(generator) };
+      for (size_t j = 0; j < numberOfVertices; ++j)
+      {
+        const double angle = 2 * M_PI * j / numberOfVertices;
+        const double radius = 5.0 * noise(generator);
+        points[j] = { std::round((centre.x + radius * std::cos(angle)) / quantum) * quantum,
+          std::round((centre.y + radius * std::sin(angle)) / quantum) * quantum };
+      }
+      const uint64_t size = numberOfVertices;
+      raw.write(reinterpret_cast<const char*>(&size), sizeof(size));
+      raw.write(reinterpret_cast<const char*>(points.data()), points.size() * sizeof(point_t));
+      const std::vector<uint8_t> data = encodeVertices(points.data(), points.size(), quantum);
+      encoded.write(reinterpret_cast<const char*>(data.data()), data.size());
+    }
+  }
+
+  typedef std::chrono::steady_clock clock;
+  clock::time_point start = clock::now();
+  const std::vector<char> raw = readFile(rawPath);
+  double area = 0.0;
+  for (size_t offset = 0; offset < raw.size();)
+  {
+    uint64_t size = 0;
+    std::memcpy(&size, raw.data() + offset, sizeof(size));
+    offset += sizeof(size);
+    Polygon polygon(reinterpret_cast<const point_t*>(raw.data() + offset), size);
+    offset += size * sizeof(point_t);
+    area += polygon.getArea();
+  }
+  std::chrono::duration<double> rawTime = clock::now() - start;
+
+  start = clock::now();
+  const std::vector<char> file = readFile(encodedPath);
+  const uint8_t* encoded = reinterpret_cast<const uint8_t*>(file.data());
+  double encodedArea = 0.0;
+  for (size_t offset = 0; offset < file.size();)
+  {
+    const size_t size = getSizeOfEncodedVertices(encoded + offset, file.size() - offset);
+    Polygon polygon(encoded + offset, size);
+    offset += size;
+    encodedArea += polygon.getArea();
+  }
+  std::chrono::duration<double> encodedTime = clock::now() - start;
+  std::remove(rawPath.c_str());
+  std::remove(encodedPath.c_str());
+
+  std::cout << "Polygons: " << numberOfPolygons << " x " << numberOfVertices << " vertices, quantum " << quantum << '\n'
+      << "raw: " << raw.size() << " bytes, load " << rawTime.count() << " s\n"
+      << "encoded: " << file.size() << " bytes (" << static_cast<double>(raw.size()) / file.size() << "x), load "
+      << encodedTime.count() << " s\n"
+      << "area difference: " << std::abs(area - encodedArea) << '\n';
+  return 0;
+}
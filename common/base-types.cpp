@@ -1,8 +1,251 @@
 #include "base-types.hpp"
+#include <stdexcept>
+#include <algorithm>
+#include <vector>
 #include <cmath>
+#include <random>
+#include <cstring>
+#include "predicates.hpp"
+
+namespace
+{
+  bool isInsideCircle(const klimchuk::circle_t& circle, const klimchuk::point_t& point)
+  {
+    return std::hypot(point.x - circle.pos.x, point.y - circle.pos.y) <= circle.radius * (1.0 + 1e-12);
+  }
+
+  klimchuk::circle_t getCircle(const klimchuk::point_t& a, const klimchuk::point_t& b)
+  {
+    return klimchuk::circle_t{ { (a.x + b.x) / 2, (a.y + b.y) / 2 }, std::hypot(b.x - a.x, b.y - a.y) / 2 };
+  }
+
+  klimchuk::circle_t getCircle(const klimchuk::point_t& a, const klimchuk::point_t& b, const klimchuk::point_t& c)
+  {
+    const klimchuk::point_t ab{ b.x - a.x, b.y - a.y };
+    const klimchuk::point_t ac{ c.x - a.x, c.y - a.y };
+    const double denominator = 2 * ((ab.x * ac.y) - (ab.y * ac.x));
+    if (denominator == 0.0)
+    {
+      klimchuk::circle_t circle = getCircle(a, b);
+      for (const klimchuk::circle_t& candidate : { getCircle(a, c), getCircle(b, c) })
+      {
+        circle = (candidate.radius > circle.radius) ? candidate : circle;
+      }
+      return circle;
+    }
+    const double lengthAB = (ab.x * ab.x) + (ab.y * ab.y);
+    const double lengthAC = (ac.x * ac.x) + (ac.y * ac.y);
+    const klimchuk::point_t offset{ ((ac.y * lengthAB) - (ab.y * lengthAC)) / denominator,
+      ((ab.x * lengthAC) - (ac.x * lengthAB)) / denominator };
+    return klimchuk::circle_t{ { a.x + offset.x, a.y + offset.y }, std::hypot(offset.x, offset.y) };
+  }
+
+}
 
 bool klimchuk::areShapesIntersect(const rectangle_t& rectangle1, const rectangle_t& rectangle2)
 {
-  return (abs(rectangle1.pos.x - rectangle2.pos.x) <= ((rectangle1.width / 2) + (rectangle2.width / 2))
-    && (abs(rectangle1.pos.y - rectangle2.pos.y) <= ((rectangle1.height / 2) + (rectangle2.height / 2))));
+  return (std::abs(rectangle1.pos.x - rectangle2.pos.x) <= ((rectangle1.width / 2) + (rectangle2.width / 2))
+    && (std::abs(rectangle1.pos.y - rectangle2.pos.y) <= ((rectangle1.height / 2) + (rectangle2.height / 2))));
+}
+
+bool klimchuk::areShapesIntersect(const oriented_rectangle_t& rectangle1, const oriented_rectangle_t& rectangle2)
+{
+  const point_t distance{ rectangle2.pos.x - rectangle1.pos.x, rectangle2.pos.y - rectangle1.pos.y };
+  const double cosinus = std::abs((rectangle1.axis.x * rectangle2.axis.x) + (rectangle1.axis.y * rectangle2.axis.y));
+  const double sinus = std::abs((rectangle1.axis.x * rectangle2.axis.y) - (rectangle1.axis.y * rectangle2.axis.x));
+  const double distances[4] = {
+    (distance.x * rectangle1.axis.x) + (distance.y * rectangle1.axis.y),
+    (distance.y * rectangle1.axis.x) - (distance.x * rectangle1.axis.y),
+    (distance.x * rectangle2.axis.x) + (distance.y * rectangle2.axis.y),
+    (distance.y * rectangle2.axis.x) - (distance.x * rectangle2.axis.y) };
+  const double radiuses[4] = {
+    (rectangle1.width / 2) + (((rectangle2.width * cosinus) + (rectangle2.height * sinus)) / 2),
+    (rectangle1.height / 2) + (((rectangle2.width * sinus) + (rectangle2.height * cosinus)) / 2),
+    (rectangle2.width / 2) + (((rectangle1.width * cosinus) + (rectangle1.height * sinus)) / 2),
+    (rectangle2.height / 2) + (((rectangle1.width * sinus) + (rectangle1.height * cosinus)) / 2) };
+  for (size_t i = 0; i < 4; ++i)
+  {
+    if (std::abs(distances[i]) > radiuses[i])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+klimchuk::rectangle_t klimchuk::getFrameRect(const oriented_rectangle_t& rectangle)
+{
+  const double cosinus = std::abs(rectangle.axis.x);
+  const double sinus = std::abs(rectangle.axis.y);
+  return rectangle_t{ (rectangle.width * cosinus) + (rectangle.height * sinus),
+    (rectangle.width * sinus) + (rectangle.height * cosinus), rectangle.pos };
+}
+
+void klimchuk::getCorners(const oriented_rectangle_t& rectangle, point_t* corners)
+{
+  if (!corners)
+  {
+    throw std::invalid_argument("getCorners: Array of corners is empty.");
+  }
+  const point_t width{ rectangle.axis.x * rectangle.width / 2, rectangle.axis.y * rectangle.width / 2 };
+  const point_t height{ -rectangle.axis.y * rectangle.height / 2, rectangle.axis.x * rectangle.height / 2 };
+  corners[0] = { rectangle.pos.x + width.x + height.x, rectangle.pos.y + width.y + height.y };
+  corners[1] = { rectangle.pos.x - width.x + height.x, rectangle.pos.y - width.y + height.y };
+  corners[2] = { rectangle.pos.x - width.x - height.x, rectangle.pos.y - width.y - height.y };
+  corners[3] = { rectangle.pos.x + width.x - height.x, rectangle.pos.y + width.y - height.y };
+}
+
+klimchuk::oriented_rectangle_t klimchuk::getMinimumAreaRect(const point_t* points, size_t numberOfPoints)
+{
+  if (!points || (numberOfPoints == 0))
+  {
+    throw std::invalid_argument("getMinimumAreaRect: Array of points is empty.");
+  }
+  std::vector<point_t> hull = getConvexHull(points, numberOfPoints);
+  oriented_rectangle_t best{ 0.0, 0.0, hull[0], { 1.0, 0.0 } };
+  double bestArea = -1.0;
+  const size_t size = hull.size();
+  size_t right = 1 % size;
+  size_t top = right;
+  size_t left = right;
+  for (size_t i = 0; (i < size) && (size > 1); ++i)
+  {
+    const point_t& begin = hull[i];
+    const point_t& end = hull[(i + 1) % size];
+    const double length = std::hypot(end.x - begin.x, end.y - begin.y);
+    if (length == 0.0)
+    {
+      continue;
+    }
+    const point_t axis{ (end.x - begin.x) / length, (end.y - begin.y) / length };
+    auto getU = [&hull, &begin, &axis](size_t index)
+    {
+      return ((hull[index].x - begin.x) * axis.x) + ((hull[index].y - begin.y) * axis.y);
+    };
+    auto getV = [&hull, &begin, &axis](size_t index)
+    {
+      return ((hull[index].y - begin.y) * axis.x) - ((hull[index].x - begin.x) * axis.y);
+    };
+    for (size_t step = 0; (step < size) && (getU((right + 1) % size) > getU(right)); ++step)
+    {
+      right = (right + 1) % size;
+    }
+    top = (i == 0) ? right : top;
+    for (size_t step = 0; (step < size) && (getV((top + 1) % size) > getV(top)); ++step)
+    {
+      top = (top + 1) % size;
+    }
+    left = (i == 0) ? top : left;
+    for (size_t step = 0; (step < size) && (getU((left + 1) % size) < getU(left)); ++step)
+    {
+      left = (left + 1) % size;
+    }
+    const double minU = std::min(0.0, getU(left));
+    const double maxU = std::max(0.0, getU(right));
+    const double minV = 0.0;
+    const double maxV = std::max(0.0, getV(top));
+    const double area = (maxU - minU) * (maxV - minV);
+    if ((bestArea < 0.0) || (area < bestArea))
+    {
+      const double middleU = (minU + maxU) / 2;
+      const double middleV = (minV + maxV) / 2;
+      bestArea = area;
+      best = oriented_rectangle_t{ maxU - minU, maxV - minV,
+        { begin.x + (middleU * axis.x) - (middleV * axis.y), begin.y + (middleU * axis.y) + (middleV * axis.x) }, axis };
+    }
+  }
+  return best;
+}
+
+std::vector<klimchuk::point_t> klimchuk::getConvexHull(const point_t* points, size_t numberOfPoints)
+{
+  if (!points || (numberOfPoints == 0))
+  {
+    throw std::invalid_argument("getConvexHull: Array of points is empty.");
+  }
+  std::vector<point_t> sortedPoints(points, points + numberOfPoints);
+  std::sort(sortedPoints.begin(), sortedPoints.end(), [](const point_t& lhs, const point_t& rhs)
+  {
+    return (lhs.x < rhs.x) || ((lhs.x == rhs.x) && (lhs.y < rhs.y));
+  });
+  if (sortedPoints.size() < 3)
+  {
+    return sortedPoints;
+  }
+  std::vector<point_t> hull(2 * sortedPoints.size());
+  size_t size = 0;
+  for (size_t i = 0; i < sortedPoints.size(); ++i)
+  {
+    while ((size >= 2) && (getOrientation(hull[size - 2], hull[size - 1], sortedPoints[i]) <= 0.0))
+    {
+      --size;
+    }
+    hull[size++] = sortedPoints[i];
+  }
+  for (size_t i = sortedPoints.size() - 1, lower = size + 1; i > 0; --i)
+  {
+    while ((size >= lower) && (getOrientation(hull[size - 2], hull[size - 1], sortedPoints[i - 1]) <= 0.0))
+    {
+      --size;
+    }
+    hull[size++] = sortedPoints[i - 1];
+  }
+  hull.resize(size - 1);
+  return hull;
+}
+
+klimchuk::circle_t klimchuk::getEnclosingCircle(const point_t* points, size_t numberOfPoints)
+{
+  if (!points || (numberOfPoints == 0))
+  {
+    throw std::invalid_argument("getEnclosingCircle: Array of points is empty.");
+  }
+  std::vector<point_t> shuffledPoints(points, points + numberOfPoints);
+  std::shuffle(shuffledPoints.begin(), shuffledPoints.end(), std::mt19937(numberOfPoints));
+  circle_t circle{ shuffledPoints[0], 0.0 };
+  for (size_t i = 1; i < numberOfPoints; ++i)
+  {
+    if (isInsideCircle(circle, shuffledPoints[i]))
+    {
+      continue;
+    }
+    circle = circle_t{ shuffledPoints[i], 0.0 };
+    for (size_t j = 0; j < i; ++j)
+    {
+      if (isInsideCircle(circle, shuffledPoints[j]))
+      {
+        continue;
+      }
+      circle = getCircle(shuffledPoints[i], shuffledPoints[j]);
+      for (size_t k = 0; k < j; ++k)
+      {
+        if (!isInsideCircle(circle, shuffledPoints[k]))
+        {
+          circle = getCircle(shuffledPoints[i], shuffledPoints[j], shuffledPoints[k]);
+        }
+      }
+    }
+  }
+  return circle;
+}
+
+uint64_t klimchuk::hashCombine(uint64_t hash, uint64_t value)
+{
+  hash ^= value * 0x9E3779B97F4A7C15ull;
+  hash ^= hash >> 32;
+  hash *= 0xD6E8FEB86659FD93ull;
+  return hash ^ (hash >> 32);
+}
+
+uint64_t klimchuk::hashCombine(uint64_t hash, double value)
+{
+  uint64_t bits = 0;
+  value = (value == 0.0) ? 0.0 : value;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return hashCombine(hash, bits);
+}
+
+uint64_t klimchuk::hashCombine(uint64_t hash, const point_t& point)
+{
+  return hashCombine(hashCombine(hash, point.x), point.y);
 }
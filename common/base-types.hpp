@@ -1,6 +1,10 @@
 #ifndef KLIMCHUK_BASE_TYPES
 #define KLIMCHUK_BASE_TYPES
 
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
 namespace klimchuk
 {
 
@@ -17,6 +21,29 @@ namespace klimchuk
     point_t pos;
   };
 
+  struct oriented_rectangle_t
+  {
+    double width;
+    double height;
+    point_t pos;
+    point_t axis;
+  };
+
+  struct circle_t
+  {
+    point_t pos;
+    double radius;
+  };
+
   bool areShapesIntersect(const rectangle_t& rectangle1, const rectangle_t& rectangle2);
+  bool areShapesIntersect(const oriented_rectangle_t& rectangle1, const oriented_rectangle_t& rectangle2);
+  rectangle_t getFrameRect(const oriented_rectangle_t& rectangle);
+  void getCorners(const oriented_rectangle_t& rectangle, point_t* corners);
+  oriented_rectangle_t getMinimumAreaRect(const point_t* points, size_t numberOfPoints);
+  std::vector<point_t> getConvexHull(const point_t* points, size_t numberOfPoints);
+  circle_t getEnclosingCircle(const point_t* points, size_t numberOfPoints);
+  uint64_t hashCombine(uint64_t hash, uint64_t value);
+  uint64_t hashCombine(uint64_t hash, double value);
+  uint64_t hashCombine(uint64_t hash, const point_t& point);
 }
 #endif
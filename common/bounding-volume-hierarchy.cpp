@@ -0,0 +1,459 @@
+#include "bounding-volume-hierarchy.hpp"
+#include <stdexcept>
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace
+{
+  const size_t NO_PARENT = static_cast<size_t>(-1);
+  const size_t MAX_CHILDREN = 4;
+  const size_t NUMBER_OF_BINS = 16;
+  const double MAX_OVERLAP_OF_GROUPS = 2.0;
+}
+
+klimchuk::BoundingVolumeHierarchy::BoundingVolumeHierarchy(CompositeShape& compositeShape, bool isRebalanced):
+  isRebalanced_{ isRebalanced },
+  numberOfLeaves_{ 0 },
+  nodes_{ node_t{ NO_PARENT, 0, 0, nullptr } },
+  bounds_{ bounds_t{ 0.0, 0.0, 0.0, 0.0 } }
+{
+  build(0, compositeShape);
+  owners_.clear();
+  owners_.shrink_to_fit();
+  refit();
+}
+
+void klimchuk::BoundingVolumeHierarchy::refit()
+{
+  for (size_t i = nodes_.size(); i > 0; --i)
+  {
+    refitNode(i - 1);
+  }
+}
+
+void klimchuk::BoundingVolumeHierarchy::refit(const Shape::ShapePtr& shape)
+{
+  if (!shape)
+  {
+    throw std::invalid_argument("BoundingVolumeHierarchy: Parametr is not shape.");
+  }
+  std::pair<std::unordered_multimap<const Shape*, size_t>::const_iterator,
+    std::unordered_multimap<const Shape*, size_t>::const_iterator> range = indexes_.equal_range(shape.get());
+  if (range.first == range.second)
+  {
+    throw std::invalid_argument("BoundingVolumeHierarchy: Shape is not in hierarchy.");
+  }
+  std::vector<size_t> subtree;
+  for (; range.first != range.second; ++range.first)
+  {
+    subtree.clear();
+    subtree.push_back(range.first->second);
+    for (size_t i = 0; i < subtree.size(); ++i)
+    {
+      const node_t& node = nodes_[subtree[i]];
+      for (size_t j = 0; j < node.numberOfChildren; ++j)
+      {
+        subtree.push_back(node.firstChild + j);
+      }
+    }
+    for (size_t i = subtree.size(); i > 0; --i)
+    {
+      refitNode(subtree[i - 1]);
+    }
+    for (size_t parent = nodes_[range.first->second].parent; parent != NO_PARENT; parent = nodes_[parent].parent)
+    {
+      bounds_t oldBounds = bounds_[parent];
+      refitNode(parent);
+      const bounds_t& newBounds = bounds_[parent];
+      if ((oldBounds.minX == newBounds.minX) && (oldBounds.minY == newBounds.minY)
+        && (oldBounds.maxX == newBounds.maxX) && (oldBounds.maxY == newBounds.maxY))
+      {
+        break;
+      }
+    }
+  }
+}
+
+std::vector<klimchuk::Shape::ShapePtr> klimchuk::BoundingVolumeHierarchy::queryOverlap(const rectangle_t& area) const
+{
+  const bounds_t query{ area.pos.x - (area.width / 2), area.pos.y - (area.height / 2),
+    area.pos.x + (area.width / 2), area.pos.y + (area.height / 2) };
+  return this->query([&query](const bounds_t& bounds)
+  {
+    return (bounds.minX <= query.maxX) && (query.minX <= bounds.maxX)
+      && (bounds.minY <= query.maxY) && (query.minY <= bounds.maxY);
+  });
+}
+
+std::vector<klimchuk::Shape::ShapePtr> klimchuk::BoundingVolumeHierarchy::queryOrientedOverlap(
+  const oriented_rectangle_t& area) const
+{
+  std::vector<Shape::ShapePtr> shapes = queryOverlap(klimchuk::getFrameRect(area));
+  shapes.erase(std::remove_if(shapes.begin(), shapes.end(), [&area](const Shape::ShapePtr& shape)
+  {
+    return !areShapesIntersect(shape->getOrientedFrameRect(), area);
+  }), shapes.end());
+  return shapes;
+}
+
+std::vector<klimchuk::Shape::ShapePtr> klimchuk::BoundingVolumeHierarchy::queryPoint(const point_t& point) const
+{
+  return query([&point](const bounds_t& bounds)
+  {
+    return (bounds.minX <= point.x) && (point.x <= bounds.maxX) && (bounds.minY <= point.y) && (point.y <= bounds.maxY);
+  });
+}
+
+std::vector<klimchuk::Shape::ShapePtr> klimchuk::BoundingVolumeHierarchy::queryRay(const point_t& origin,
+  const point_t& direction) const
+{
+  if ((direction.x == 0.0) && (direction.y == 0.0))
+  {
+    throw std::invalid_argument("BoundingVolumeHierarchy: Direction of ray can't be zero.");
+  }
+  const double inverseX = 1.0 / direction.x;
+  const double inverseY = 1.0 / direction.y;
+  auto getEntry = [&origin, &direction, inverseX, inverseY](const bounds_t& bounds)
+  {
+    double entry = 0.0;
+    double exit = std::numeric_limits<double>::infinity();
+    const double origins[2] = { origin.x, origin.y };
+    const double directions[2] = { direction.x, direction.y };
+    const double inverses[2] = { inverseX, inverseY };
+    const double mins[2] = { bounds.minX, bounds.minY };
+    const double maxs[2] = { bounds.maxX, bounds.maxY };
+    for (size_t axis = 0; axis < 2; ++axis)
+    {
+      if (directions[axis] == 0.0)
+      {
+        if ((origins[axis] < mins[axis]) || (origins[axis] > maxs[axis]))
+        {
+          return std::numeric_limits<double>::infinity();
+        }
+        continue;
+      }
+      double near = (mins[axis] - origins[axis]) * inverses[axis];
+      double far = (maxs[axis] - origins[axis]) * inverses[axis];
+      if (near > far)
+      {
+        std::swap(near, far);
+      }
+      entry = std::max(entry, near);
+      exit = std::min(exit, far);
+    }
+    return (entry <= exit) ? entry : std::numeric_limits<double>::infinity();
+  };
+  std::vector<std::pair<double, Shape::ShapePtr>> hits;
+  std::vector<size_t> stack{ 0 };
+  while (!stack.empty())
+  {
+    size_t index = stack.back();
+    stack.pop_back();
+    double entry = getEntry(bounds_[index]);
+    if (entry == std::numeric_limits<double>::infinity())
+    {
+      continue;
+    }
+    const node_t& node = nodes_[index];
+    if (node.numberOfChildren == 0)
+    {
+      hits.emplace_back(entry, node.shape);
+    }
+    for (size_t i = 0; i < node.numberOfChildren; ++i)
+    {
+      stack.push_back(node.firstChild + i);
+    }
+  }
+  std::stable_sort(hits.begin(), hits.end(),
+    [](const std::pair<double, Shape::ShapePtr>& lhs, const std::pair<double, Shape::ShapePtr>& rhs)
+  {
+    return lhs.first < rhs.first;
+  });
+  std::vector<Shape::ShapePtr> shapes;
+  shapes.reserve(hits.size());
+  for (const std::pair<double, Shape::ShapePtr>& hit : hits)
+  {
+    shapes.push_back(hit.second);
+  }
+  return shapes;
+}
+
+klimchuk::rectangle_t klimchuk::BoundingVolumeHierarchy::getFrameRect() const
+{
+  const bounds_t& bounds = bounds_[0];
+  return rectangle_t{ bounds.maxX - bounds.minX, bounds.maxY - bounds.minY,
+    { (bounds.minX + bounds.maxX) / 2, (bounds.minY + bounds.maxY) / 2 } };
+}
+
+size_t klimchuk::BoundingVolumeHierarchy::getSize() const
+{
+  return numberOfLeaves_;
+}
+
+size_t klimchuk::BoundingVolumeHierarchy::getNumberOfNodes() const
+{
+  return nodes_.size();
+}
+
+size_t klimchuk::BoundingVolumeHierarchy::getDepth() const
+{
+  std::vector<size_t> depths(nodes_.size(), 1);
+  size_t depth = 1;
+  for (size_t i = 1; i < nodes_.size(); ++i)
+  {
+    depths[i] = depths[nodes_[i].parent] + 1;
+    depth = std::max(depth, depths[i]);
+  }
+  return depth;
+}
+
+void klimchuk::BoundingVolumeHierarchy::build(size_t indexOfNode, CompositeShape& compositeShape)
+{
+  auto makeItem = [](const Shape::ShapePtr& shape, size_t owner)
+  {
+    rectangle_t frame = shape->getFrameRect();
+    return item_t{ shape, bounds_t{ frame.pos.x - (frame.width / 2), frame.pos.y - (frame.height / 2),
+      frame.pos.x + (frame.width / 2), frame.pos.y + (frame.height / 2) }, owner };
+  };
+  std::vector<item_t> items;
+  items.reserve(compositeShape.getSize());
+  for (size_t i = 0; i < compositeShape.getSize(); ++i)
+  {
+    items.push_back(makeItem(compositeShape[i], NO_PARENT));
+  }
+  while (isRebalanced_)
+  {
+    bounds_t total = items[0].bounds;
+    double areaOfGroups = 0.0;
+    for (const item_t& item : items)
+    {
+      total.minX = std::min(total.minX, item.bounds.minX);
+      total.minY = std::min(total.minY, item.bounds.minY);
+      total.maxX = std::max(total.maxX, item.bounds.maxX);
+      total.maxY = std::max(total.maxY, item.bounds.maxY);
+      if (dynamic_cast<CompositeShape*>(item.shape.get()))
+      {
+        areaOfGroups += (item.bounds.maxX - item.bounds.minX) * (item.bounds.maxY - item.bounds.minY);
+      }
+    }
+    if (areaOfGroups <= MAX_OVERLAP_OF_GROUPS * (total.maxX - total.minX) * (total.maxY - total.minY))
+    {
+      break;
+    }
+    std::vector<item_t> dissolved;
+    dissolved.reserve(items.size());
+    for (const item_t& item : items)
+    {
+      CompositeShape* group = dynamic_cast<CompositeShape*>(item.shape.get());
+      if (!group)
+      {
+        dissolved.push_back(item);
+        continue;
+      }
+      owners_.push_back(owner_t{ group, item.owner });
+      for (size_t i = 0; i < group->getSize(); ++i)
+      {
+        dissolved.push_back(makeItem((*group)[i], owners_.size() - 1));
+      }
+    }
+    items.swap(dissolved);
+  }
+  if (isRebalanced_)
+  {
+    split(indexOfNode, items.data(), items.size());
+  }
+  else
+  {
+    attach(indexOfNode, items.data(), items.size());
+  }
+}
+
+void klimchuk::BoundingVolumeHierarchy::split(size_t indexOfNode, item_t* items, size_t numberOfItems)
+{
+  if (numberOfItems <= MAX_CHILDREN)
+  {
+    attach(indexOfNode, items, numberOfItems);
+    return;
+  }
+  double minCentre[2] = { std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity() };
+  double maxCentre[2] = { -std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity() };
+  for (size_t i = 0; i < numberOfItems; ++i)
+  {
+    const double centre[2] = { items[i].bounds.minX + items[i].bounds.maxX, items[i].bounds.minY + items[i].bounds.maxY };
+    for (size_t axis = 0; axis < 2; ++axis)
+    {
+      minCentre[axis] = std::min(minCentre[axis], centre[axis]);
+      maxCentre[axis] = std::max(maxCentre[axis], centre[axis]);
+    }
+  }
+  const size_t axis = ((maxCentre[0] - minCentre[0]) >= (maxCentre[1] - minCentre[1])) ? 0 : 1;
+  const double extent = maxCentre[axis] - minCentre[axis];
+  auto getBin = [&minCentre, axis, extent](const item_t& item)
+  {
+    const double centre = (axis == 0) ? (item.bounds.minX + item.bounds.maxX) : (item.bounds.minY + item.bounds.maxY);
+    size_t bin = static_cast<size_t>(NUMBER_OF_BINS * (centre - minCentre[axis]) / extent);
+    return std::min(bin, NUMBER_OF_BINS - 1);
+  };
+  auto unite = [](bounds_t& lhs, const bounds_t& rhs)
+  {
+    lhs.minX = std::min(lhs.minX, rhs.minX);
+    lhs.minY = std::min(lhs.minY, rhs.minY);
+    lhs.maxX = std::max(lhs.maxX, rhs.maxX);
+    lhs.maxY = std::max(lhs.maxY, rhs.maxY);
+  };
+  auto getHalfPerimeter = [](const bounds_t& bounds)
+  {
+    return (bounds.maxX - bounds.minX) + (bounds.maxY - bounds.minY);
+  };
+
+  size_t middle = numberOfItems / 2;
+  bool isBinned = false;
+  if (extent > 0.0)
+  {
+    const bounds_t empty{ std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(),
+      -std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity() };
+    size_t counts[NUMBER_OF_BINS] = {};
+    bounds_t bins[NUMBER_OF_BINS];
+    std::fill(bins, bins + NUMBER_OF_BINS, empty);
+    for (size_t i = 0; i < numberOfItems; ++i)
+    {
+      size_t bin = getBin(items[i]);
+      ++counts[bin];
+      unite(bins[bin], items[i].bounds);
+    }
+    double rightCosts[NUMBER_OF_BINS] = {};
+    bounds_t right = empty;
+    size_t rightCount = 0;
+    for (size_t i = NUMBER_OF_BINS - 1; i > 0; --i)
+    {
+      unite(right, bins[i]);
+      rightCount += counts[i];
+      rightCosts[i] = (rightCount == 0) ? 0.0 : (getHalfPerimeter(right) * rightCount);
+    }
+    bounds_t left = empty;
+    size_t leftCount = 0;
+    double bestCost = std::numeric_limits<double>::infinity();
+    size_t bestBin = 0;
+    for (size_t i = 1; i < NUMBER_OF_BINS; ++i)
+    {
+      unite(left, bins[i - 1]);
+      leftCount += counts[i - 1];
+      if ((leftCount == 0) || (leftCount == numberOfItems))
+      {
+        continue;
+      }
+      double cost = (getHalfPerimeter(left) * leftCount) + rightCosts[i];
+      if (cost < bestCost)
+      {
+        bestCost = cost;
+        bestBin = i;
+      }
+    }
+    if (bestBin != 0)
+    {
+      middle = std::partition(items, items + numberOfItems, [&getBin, bestBin](const item_t& item)
+      {
+        return getBin(item) < bestBin;
+      }) - items;
+      isBinned = true;
+    }
+  }
+  if (!isBinned)
+  {
+    std::nth_element(items, items + middle, items + numberOfItems, [axis](const item_t& lhs, const item_t& rhs)
+    {
+      return (axis == 0) ? (lhs.bounds.minX + lhs.bounds.maxX < rhs.bounds.minX + rhs.bounds.maxX)
+        : (lhs.bounds.minY + lhs.bounds.maxY < rhs.bounds.minY + rhs.bounds.maxY);
+    });
+  }
+
+  const size_t firstChild = nodes_.size();
+  nodes_.push_back(node_t{ indexOfNode, 0, 0, nullptr });
+  nodes_.push_back(node_t{ indexOfNode, 0, 0, nullptr });
+  bounds_.resize(nodes_.size());
+  nodes_[indexOfNode].firstChild = firstChild;
+  nodes_[indexOfNode].numberOfChildren = 2;
+  split(firstChild, items, middle);
+  split(firstChild + 1, items + middle, numberOfItems - middle);
+}
+
+void klimchuk::BoundingVolumeHierarchy::attach(size_t indexOfNode, item_t* items, size_t numberOfItems)
+{
+  const size_t firstChild = nodes_.size();
+  nodes_.resize(firstChild + numberOfItems);
+  bounds_.resize(nodes_.size());
+  nodes_[indexOfNode].firstChild = firstChild;
+  nodes_[indexOfNode].numberOfChildren = numberOfItems;
+  for (size_t i = 0; i < numberOfItems; ++i)
+  {
+    nodes_[firstChild + i] = node_t{ indexOfNode, 0, 0, items[i].shape };
+    indexes_.emplace(items[i].shape.get(), firstChild + i);
+    for (size_t owner = items[i].owner; owner != NO_PARENT; owner = owners_[owner].parent)
+    {
+      indexes_.emplace(owners_[owner].shape, firstChild + i);
+    }
+  }
+  for (size_t i = 0; i < numberOfItems; ++i)
+  {
+    CompositeShape* compositeShape = dynamic_cast<CompositeShape*>(items[i].shape.get());
+    if (compositeShape)
+    {
+      build(firstChild + i, *compositeShape);
+    }
+    else
+    {
+      ++numberOfLeaves_;
+    }
+  }
+}
+
+void klimchuk::BoundingVolumeHierarchy::refitNode(size_t indexOfNode)
+{
+  const node_t& node = nodes_[indexOfNode];
+  bounds_t& bounds = bounds_[indexOfNode];
+  if (node.numberOfChildren == 0)
+  {
+    rectangle_t frame = node.shape->getFrameRect();
+    bounds = bounds_t{ frame.pos.x - (frame.width / 2), frame.pos.y - (frame.height / 2),
+      frame.pos.x + (frame.width / 2), frame.pos.y + (frame.height / 2) };
+    return;
+  }
+  bounds = bounds_[node.firstChild];
+  for (size_t i = 1; i < node.numberOfChildren; ++i)
+  {
+    const bounds_t& child = bounds_[node.firstChild + i];
+    bounds.minX = std::min(bounds.minX, child.minX);
+    bounds.minY = std::min(bounds.minY, child.minY);
+    bounds.maxX = std::max(bounds.maxX, child.maxX);
+    bounds.maxY = std::max(bounds.maxY, child.maxY);
+  }
+}
+
+template < typename Predicate >
+std::vector<klimchuk::Shape::ShapePtr> klimchuk::BoundingVolumeHierarchy::query(Predicate isAccepted) const
+{
+  std::vector<Shape::ShapePtr> shapes;
+  std::vector<size_t> stack;
+  stack.reserve(64);
+  stack.push_back(0);
+  while (!stack.empty())
+  {
+    size_t index = stack.back();
+    stack.pop_back();
+    if (!isAccepted(bounds_[index]))
+    {
+      continue;
+    }
+    const node_t& node = nodes_[index];
+    if (node.numberOfChildren == 0)
+    {
+      shapes.push_back(node.shape);
+    }
+    for (size_t i = 0; i < node.numberOfChildren; ++i)
+    {
+      stack.push_back(node.firstChild + i);
+    }
+  }
+  return shapes;
+}
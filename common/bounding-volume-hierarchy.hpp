@@ -0,0 +1,74 @@
+#ifndef KLIMCHUK_BOUNDING_VOLUME_HIERARCHY
+#define KLIMCHUK_BOUNDING_VOLUME_HIERARCHY
+
+#include <vector>
+#include <unordered_map>
+#include "shape.hpp"
+#include "composite-shape.hpp"
+
+namespace klimchuk
+{
+  class BoundingVolumeHierarchy
+  {
+  public:
+    BoundingVolumeHierarchy(CompositeShape& compositeShape, bool isRebalanced = true);
+
+    void refit();
+    void refit(const Shape::ShapePtr& shape);
+
+    std::vector<Shape::ShapePtr> queryOverlap(const rectangle_t& area) const;
+    std::vector<Shape::ShapePtr> queryOrientedOverlap(const oriented_rectangle_t& area) const;
+    std::vector<Shape::ShapePtr> queryPoint(const point_t& point) const;
+    std::vector<Shape::ShapePtr> queryRay(const point_t& origin, const point_t& direction) const;
+
+    rectangle_t getFrameRect() const;
+    size_t getSize() const;
+    size_t getNumberOfNodes() const;
+    size_t getDepth() const;
+  private:
+    struct bounds_t
+    {
+      double minX;
+      double minY;
+      double maxX;
+      double maxY;
+    };
+
+    struct node_t
+    {
+      size_t parent;
+      size_t firstChild;
+      size_t numberOfChildren;
+      Shape::ShapePtr shape;
+    };
+
+    struct item_t
+    {
+      Shape::ShapePtr shape;
+      bounds_t bounds;
+      size_t owner;
+    };
+
+    struct owner_t
+    {
+      const Shape* shape;
+      size_t parent;
+    };
+
+    bool isRebalanced_;
+    size_t numberOfLeaves_;
+    std::vector<node_t> nodes_;
+    std::vector<bounds_t> bounds_;
+    std::unordered_multimap<const Shape*, size_t> indexes_;
+    std::vector<owner_t> owners_;
+
+    void build(size_t indexOfNode, CompositeShape& compositeShape);
+    void split(size_t indexOfNode, item_t* items, size_t numberOfItems);
+    void attach(size_t indexOfNode, item_t* items, size_t numberOfItems);
+    void refitNode(size_t indexOfNode);
+    template < typename Predicate >
+    std::vector<Shape::ShapePtr> query(Predicate isAccepted) const;
+  };
+}
+
+#endif
@@ -1,6 +1,30 @@
 #include "circle.hpp"
 #include <cmath>
 #include <stdexcept>
+#include <array>
+#include <algorithm>
+#include <mutex>
+
+namespace
+{
+  const uint64_t HASH_SEED = 1;
+  const size_t MIN_NUMBER_OF_SEGMENTS = 8;
+  const size_t NUMBER_OF_LEVELS = 14;
+
+  std::array<double, NUMBER_OF_LEVELS> getSagittas()
+  {
+    std::array<double, NUMBER_OF_LEVELS> sagittas;
+    for (size_t i = 0; i < NUMBER_OF_LEVELS; ++i)
+    {
+      sagittas[i] = 1.0 - std::cos(M_PI / (MIN_NUMBER_OF_SEGMENTS << i));
+    }
+    return sagittas;
+  }
+
+  const std::array<double, NUMBER_OF_LEVELS> SAGITTAS = getSagittas();
+  std::once_flag unitCircleFlags[NUMBER_OF_LEVELS];
+  std::vector<klimchuk::point_t> unitCircles[NUMBER_OF_LEVELS];
+}
 
 klimchuk::Circle::Circle(double posX, double posY, double radius):
   radius_{ radius },
@@ -22,15 +46,24 @@ klimchuk::rectangle_t klimchuk::Circle::getFrameRect() const
   return rectangle_t{ 2 * radius_, 2 * radius_, centre_ };
 }
 
+klimchuk::oriented_rectangle_t klimchuk::Circle::getOrientedFrameRect() const
+{
+  return oriented_rectangle_t{ 2 * radius_, 2 * radius_, centre_, { 1.0, 0.0 } };
+}
+
 void klimchuk::Circle::move(const point_t& point)
 {
+  const Journal::Scope scope(Journal::Operation::MOVE_TO, *this, point.x, point.y);
   centre_ = point;
+  invalidateOwners();
 }
 
 void klimchuk::Circle::move(double moveAbscissa, double moveOrdinate)
 {
+  const Journal::Scope scope(Journal::Operation::MOVE_BY, *this, moveAbscissa, moveOrdinate);
   centre_.x += moveAbscissa;
   centre_.y += moveOrdinate;
+  invalidateOwners();
 }
 
 klimchuk::point_t klimchuk::Circle::getCentre() const
@@ -40,11 +73,13 @@ klimchuk::point_t klimchuk::Circle::getCentre() const
 
 void klimchuk::Circle::scale(double coefficient)
 {
+  const Journal::Scope scope(Journal::Operation::SCALE, *this, coefficient);
   if (coefficient <= 0)
   {
     throw std::invalid_argument("Circle: Coefficient must be more than a zero.");
   }
   radius_ *= coefficient;
+  invalidateOwners();
 }
 
 double klimchuk::Circle::getRadius() const
@@ -52,5 +87,68 @@ double klimchuk::Circle::getRadius() const
   return radius_;
 }
 
-void klimchuk::Circle::rotate(double)
-{}
+void klimchuk::Circle::rotate(double angle)
+{
+  const Journal::Scope scope(Journal::Operation::ROTATE, *this, angle);
+}
+
+uint64_t klimchuk::Circle::getHash() const
+{
+  return hashCombine(hashCombine(HASH_SEED, centre_), radius_);
+}
+
+std::vector<klimchuk::point_t> klimchuk::Circle::tessellate(double tolerance) const
+{
+  std::vector<point_t> points;
+  tessellate(points, centre_, radius_, getNumberOfSegments(radius_, tolerance));
+  return points;
+}
+
+size_t klimchuk::Circle::getNumberOfSegments(double radius, double tolerance)
+{
+  if ((radius <= 0.0) || (tolerance <= 0.0))
+  {
+    throw std::invalid_argument("Circle: Radius and tolerance must be more than a zero.");
+  }
+  const std::array<double, NUMBER_OF_LEVELS>::const_iterator sagitta = std::partition_point(SAGITTAS.begin(),
+      SAGITTAS.end() - 1, [radius, tolerance](double sagitta)
+  {
+    return radius * sagitta > tolerance;
+  });
+  return MIN_NUMBER_OF_SEGMENTS << (sagitta - SAGITTAS.begin());
+}
+
+const klimchuk::point_t* klimchuk::Circle::getUnitCircle(size_t numberOfSegments)
+{
+  size_t level = 0;
+  while ((level < NUMBER_OF_LEVELS - 1) && ((MIN_NUMBER_OF_SEGMENTS << level) < numberOfSegments))
+  {
+    ++level;
+  }
+  if ((MIN_NUMBER_OF_SEGMENTS << level) != numberOfSegments)
+  {
+    throw std::invalid_argument("Circle: Number of segments must be a power of two from 8 to 65536.");
+  }
+  std::call_once(unitCircleFlags[level], [numberOfSegments, level]()
+  {
+    std::vector<point_t>& points = unitCircles[level];
+    points.resize(numberOfSegments);
+    for (size_t i = 0; i < numberOfSegments; ++i)
+    {
+      const double angle = 2 * M_PI * i / numberOfSegments;
+      points[i] = { std::cos(angle), std::sin(angle) };
+    }
+  });
+  return unitCircles[level].data();
+}
+
+void klimchuk::Circle::tessellate(std::vector<point_t>& points, const point_t& centre, double radius,
+    size_t numberOfSegments)
+{
+  const point_t* unitCircle = getUnitCircle(numberOfSegments);
+  points.reserve(points.size() + numberOfSegments);
+  for (size_t i = 0; i < numberOfSegments; ++i)
+  {
+    points.push_back({ centre.x + (radius * unitCircle[i].x), centre.y + (radius * unitCircle[i].y) });
+  }
+}
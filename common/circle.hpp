@@ -1,5 +1,6 @@
 #ifndef KLIMCHUK_CIRCLE
 #define KLIMCHUK_CIRCLE
+#include <vector>
 #include "shape.hpp"
 
 namespace klimchuk
@@ -10,12 +11,18 @@ namespace klimchuk
     Circle(double posX, double posY, double radius);
     double getArea() const override;
     rectangle_t getFrameRect() const override;
+    oriented_rectangle_t getOrientedFrameRect() const override;
     void move(const point_t& point) override;
     void move(double moveAbscissa, double moveOrdinate) override;
     point_t getCentre() const override;
     void scale(double coefficient) override;
     double getRadius() const;
     void rotate(double) override;
+    uint64_t getHash() const override;
+    std::vector<point_t> tessellate(double tolerance) const;
+    static size_t getNumberOfSegments(double radius, double tolerance);
+    static const point_t* getUnitCircle(size_t numberOfSegments);
+    static void tessellate(std::vector<point_t>& points, const point_t& centre, double radius, size_t numberOfSegments);
   private:
     double radius_;
     point_t centre_;
@@ -0,0 +1,316 @@
+#include "clipper.hpp"
+#include <stdexcept>
+#include <algorithm>
+#include <thread>
+#include <cmath>
+#include "circle.hpp"
+#include "polygon.hpp"
+#include "predicates.hpp"
+
+namespace
+{
+  double getDoubleArea(const klimchuk::point_t* points, size_t numberOfPoints)
+  {
+    double area = 0.0;
+    for (size_t i = 0; i < numberOfPoints; ++i)
+    {
+      const klimchuk::point_t& next = points[(i + 1 == numberOfPoints) ? 0 : (i + 1)];
+      area += (points[i].x * next.y) - (points[i].y * next.x);
+    }
+    return area;
+  }
+}
+
+klimchuk::Clipper::Clipper(const rectangle_t& viewport, double tolerance):
+  tolerance_{ tolerance },
+  pieces_{ 0 }
+{
+  if ((viewport.width <= 0.0) || (viewport.height <= 0.0))
+  {
+    throw std::invalid_argument("Clipper: Viewport must have positive size.");
+  }
+  if (!(tolerance > 0.0))
+  {
+    throw std::invalid_argument("Clipper: Tolerance must be more than a zero.");
+  }
+  const double left = viewport.pos.x - (viewport.width / 2);
+  const double right = viewport.pos.x + (viewport.width / 2);
+  const double bottom = viewport.pos.y - (viewport.height / 2);
+  const double top = viewport.pos.y + (viewport.height / 2);
+  const point_t corners[] = { { left, bottom }, { right, bottom }, { right, top }, { left, top } };
+  addPiece(corners, 4);
+}
+
+klimchuk::Clipper::Clipper(const Shape::ConstShapePtr& region, double tolerance):
+  tolerance_{ tolerance },
+  pieces_{ 0 }
+{
+  if (!region)
+  {
+    throw std::invalid_argument("Clipper: Parametr is not shape.");
+  }
+  if (!(tolerance > 0.0))
+  {
+    throw std::invalid_argument("Clipper: Tolerance must be more than a zero.");
+  }
+  if (dynamic_cast<const CompositeShape*>(region.get()))
+  {
+    throw std::invalid_argument("Clipper: Unsupported type of region.");
+  }
+  outlines_t outlines;
+  addOutlines(outlines, region);
+  if (outlines.outlines.empty())
+  {
+    throw std::invalid_argument("Clipper: Area of region should be more than zero.");
+  }
+  const outline_t& outline = outlines.outlines.front();
+  std::vector<point_t> points;
+  if (outline.radius > 0.0)
+  {
+    Circle::tessellate(points, outline.centre, outline.radius,
+      Circle::getNumberOfSegments(outline.radius, tolerance_));
+  }
+  else
+  {
+    points.assign(outlines.vertices.begin() + outline.begin, outlines.vertices.begin() + outline.end);
+    points.erase(std::unique(points.begin(), points.end(), [](const point_t& lhs, const point_t& rhs)
+    {
+      return (lhs.x == rhs.x) && (lhs.y == rhs.y);
+    }), points.end());
+    if ((points.size() > 1) && (points.front().x == points.back().x) && (points.front().y == points.back().y))
+    {
+      points.pop_back();
+    }
+  }
+
+  bool isConvex = true;
+  for (size_t i = 0; isConvex && (i < points.size()); ++i)
+  {
+    isConvex = getOrientation(points[i], points[(i + 1) % points.size()], points[(i + 2) % points.size()]) >= 0.0;
+  }
+  if (isConvex)
+  {
+    addPiece(points.data(), points.size());
+    return;
+  }
+
+  const Polygon& polygon = dynamic_cast<const Polygon&>(*region);
+  const std::vector<size_t> triangles = polygon.getTriangulation();
+  for (size_t i = 0; i < triangles.size(); i += 3)
+  {
+    const point_t triangle[] = { polygon[triangles[i]], polygon[triangles[i + 1]], polygon[triangles[i + 2]] };
+    if (getDoubleArea(triangle, 3) > 0.0)
+    {
+      addPiece(triangle, 3);
+    }
+  }
+}
+
+void klimchuk::Clipper::clip(const CompositeShape& compositeShape, size_t numberOfThreads)
+{
+  if (numberOfThreads == 0)
+  {
+    throw std::invalid_argument("Clipper: Number of threads must be more than zero.");
+  }
+  outlines_t outlines;
+  for (size_t i = 0; i < compositeShape.getSize(); ++i)
+  {
+    addOutlines(outlines, compositeShape[i]);
+  }
+  const size_t numberOfOutlines = outlines.outlines.size();
+  numberOfThreads = std::max<size_t>(1, std::min(numberOfThreads, numberOfOutlines));
+  if (buffers_.size() < numberOfThreads)
+  {
+    buffers_.resize(numberOfThreads);
+  }
+  auto clipRange = [this, &outlines, numberOfOutlines, numberOfThreads](size_t indexOfThread)
+  {
+    buffer_t& buffer = buffers_[indexOfThread];
+    buffer.vertices.clear();
+    buffer.fragments.clear();
+    const size_t last = numberOfOutlines * (indexOfThread + 1) / numberOfThreads;
+    for (size_t i = numberOfOutlines * indexOfThread / numberOfThreads; i < last; ++i)
+    {
+      clipOutline(buffer, outlines, i);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < numberOfThreads; ++i)
+  {
+    threads.emplace_back(clipRange, i);
+  }
+  clipRange(0);
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  size_t numberOfVertices = 0;
+  size_t numberOfFragments = 0;
+  for (size_t i = 0; i < numberOfThreads; ++i)
+  {
+    numberOfVertices += buffers_[i].vertices.size();
+    numberOfFragments += buffers_[i].fragments.size();
+  }
+  vertices_.clear();
+  fragments_.clear();
+  vertices_.reserve(numberOfVertices);
+  fragments_.reserve(numberOfFragments);
+  for (size_t i = 0; i < numberOfThreads; ++i)
+  {
+    const size_t offset = vertices_.size();
+    vertices_.insert(vertices_.end(), buffers_[i].vertices.begin(), buffers_[i].vertices.end());
+    for (const fragment_t& fragment : buffers_[i].fragments)
+    {
+      fragments_.push_back({ fragment.begin + offset, fragment.end + offset, fragment.source });
+    }
+  }
+}
+
+const klimchuk::Clipper::fragment_t& klimchuk::Clipper::operator[](size_t index) const
+{
+  if (index >= fragments_.size())
+  {
+    throw std::out_of_range("Clipper: Invalid index to access.");
+  }
+  return fragments_[index];
+}
+
+size_t klimchuk::Clipper::getSize() const
+{
+  return fragments_.size();
+}
+
+const klimchuk::point_t* klimchuk::Clipper::getVertices() const
+{
+  return vertices_.data();
+}
+
+size_t klimchuk::Clipper::getNumberOfVertices() const
+{
+  return vertices_.size();
+}
+
+size_t klimchuk::Clipper::getNumberOfPieces() const
+{
+  return pieces_.size() - 1;
+}
+
+bool klimchuk::Clipper::isConvex() const
+{
+  return getNumberOfPieces() == 1;
+}
+
+double klimchuk::Clipper::getArea() const
+{
+  double area = 0.0;
+  for (const fragment_t& fragment : fragments_)
+  {
+    area += getDoubleArea(&vertices_[fragment.begin], fragment.end - fragment.begin);
+  }
+  return area / 2;
+}
+
+void klimchuk::Clipper::addPiece(const point_t* points, size_t numberOfPoints)
+{
+  double minX = points[0].x;
+  double maxX = points[0].x;
+  double minY = points[0].y;
+  double maxY = points[0].y;
+  for (size_t i = 0; i < numberOfPoints; ++i)
+  {
+    minX = std::min(minX, points[i].x);
+    maxX = std::max(maxX, points[i].x);
+    minY = std::min(minY, points[i].y);
+    maxY = std::max(maxY, points[i].y);
+  }
+  pieceVertices_.insert(pieceVertices_.end(), points, points + numberOfPoints);
+  pieces_.push_back(pieceVertices_.size());
+  frames_.push_back({ maxX - minX, maxY - minY, { (minX + maxX) / 2, (minY + maxY) / 2 } });
+}
+
+void klimchuk::Clipper::clipOutline(buffer_t& buffer, const outlines_t& outlines, size_t index) const
+{
+  const outline_t& outline = outlines.outlines[index];
+  const rectangle_t& frame = outlines.frames[index];
+  size_t firstPiece = 0;
+  while ((firstPiece + 1 < pieces_.size()) && !areShapesIntersect(frame, frames_[firstPiece]))
+  {
+    ++firstPiece;
+  }
+  if (firstPiece + 1 == pieces_.size())
+  {
+    return;
+  }
+  buffer.subject.clear();
+  if (outline.radius > 0.0)
+  {
+    Circle::tessellate(buffer.subject, outline.centre, outline.radius,
+      Circle::getNumberOfSegments(outline.radius, tolerance_));
+  }
+  else
+  {
+    buffer.subject.assign(outlines.vertices.begin() + outline.begin, outlines.vertices.begin() + outline.end);
+  }
+  const point_t corners[] = { { frame.pos.x - (frame.width / 2), frame.pos.y - (frame.height / 2) },
+    { frame.pos.x + (frame.width / 2), frame.pos.y - (frame.height / 2) },
+    { frame.pos.x + (frame.width / 2), frame.pos.y + (frame.height / 2) },
+    { frame.pos.x - (frame.width / 2), frame.pos.y + (frame.height / 2) } };
+
+  for (size_t piece = firstPiece; piece + 1 < pieces_.size(); ++piece)
+  {
+    if (!areShapesIntersect(frame, frames_[piece]))
+    {
+      continue;
+    }
+    const point_t* edges = &pieceVertices_[pieces_[piece]];
+    const size_t numberOfEdges = pieces_[piece + 1] - pieces_[piece];
+    bool isInside = true;
+    for (size_t i = 0; isInside && (i < numberOfEdges); ++i)
+    {
+      const point_t& begin = edges[i];
+      const point_t& end = edges[(i + 1 == numberOfEdges) ? 0 : (i + 1)];
+      for (const point_t& corner : corners)
+      {
+        isInside = isInside && (getOrientation(begin, end, corner) >= 0.0);
+      }
+    }
+    const std::vector<point_t>* result = &buffer.subject;
+    if (!isInside)
+    {
+      buffer.current = buffer.subject;
+      for (size_t i = 0; (i < numberOfEdges) && !buffer.current.empty(); ++i)
+      {
+        const point_t& begin = edges[i];
+        const point_t& end = edges[(i + 1 == numberOfEdges) ? 0 : (i + 1)];
+        buffer.next.clear();
+        point_t previous = buffer.current.back();
+        double previousSide = getOrientation(begin, end, previous);
+        for (const point_t& point : buffer.current)
+        {
+          const double side = getOrientation(begin, end, point);
+          if ((side >= 0.0) != (previousSide >= 0.0))
+          {
+            const double ratio = previousSide / (previousSide - side);
+            buffer.next.push_back({ previous.x + (ratio * (point.x - previous.x)),
+              previous.y + (ratio * (point.y - previous.y)) });
+          }
+          if (side >= 0.0)
+          {
+            buffer.next.push_back(point);
+          }
+          previous = point;
+          previousSide = side;
+        }
+        buffer.current.swap(buffer.next);
+      }
+      result = &buffer.current;
+    }
+    if ((result->size() < 3) || !(getDoubleArea(result->data(), result->size()) > 0.0))
+    {
+      continue;
+    }
+    buffer.fragments.push_back({ buffer.vertices.size(), buffer.vertices.size() + result->size(), index });
+    buffer.vertices.insert(buffer.vertices.end(), result->begin(), result->end());
+  }
+}
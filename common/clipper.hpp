@@ -0,0 +1,58 @@
+#ifndef KLIMCHUK_CLIPPER
+#define KLIMCHUK_CLIPPER
+
+#include <vector>
+#include "shape.hpp"
+#include "composite-shape.hpp"
+#include "outline.hpp"
+
+namespace klimchuk
+{
+  class Clipper
+  {
+  public:
+    struct fragment_t
+    {
+      size_t begin;
+      size_t end;
+      size_t source;
+    };
+
+    static constexpr double DEFAULT_TOLERANCE = 0.001;
+
+    explicit Clipper(const rectangle_t& viewport, double tolerance = DEFAULT_TOLERANCE);
+    explicit Clipper(const Shape::ConstShapePtr& region, double tolerance = DEFAULT_TOLERANCE);
+
+    void clip(const CompositeShape& compositeShape, size_t numberOfThreads = 1);
+
+    const fragment_t& operator[](size_t index) const;
+    size_t getSize() const;
+    const point_t* getVertices() const;
+    size_t getNumberOfVertices() const;
+    size_t getNumberOfPieces() const;
+    bool isConvex() const;
+    double getArea() const;
+  private:
+    struct buffer_t
+    {
+      std::vector<point_t> vertices;
+      std::vector<fragment_t> fragments;
+      std::vector<point_t> subject;
+      std::vector<point_t> current;
+      std::vector<point_t> next;
+    };
+
+    double tolerance_;
+    std::vector<point_t> pieceVertices_;
+    std::vector<size_t> pieces_;
+    std::vector<rectangle_t> frames_;
+    std::vector<point_t> vertices_;
+    std::vector<fragment_t> fragments_;
+    std::vector<buffer_t> buffers_;
+
+    void addPiece(const point_t* points, size_t numberOfPoints);
+    void clipOutline(buffer_t& buffer, const outlines_t& outlines, size_t index) const;
+  };
+}
+
+#endif
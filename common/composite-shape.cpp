@@ -3,44 +3,154 @@
 #include <stdexcept>
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include "shape.hpp"
+#include "union-area.hpp"
+#include "circle.hpp"
+#include "triangle.hpp"
+#include "polygon.hpp"
+
+namespace
+{
+  const uint64_t HASH_SEED = 5;
+  const size_t NUMBER_OF_SIDES_OF_CIRCLE = 16;
+  const unsigned int BITS_PER_AXIS = 16;
+  const unsigned int BITS_PER_DIGIT = 8;
+  // A shape held by one composite stores that owner; a shape shared by several stores their list tagged by this bit.
+  const uintptr_t SHARED_OWNERS = 1;
+
+  typedef std::vector<klimchuk::CompositeShape*> owners_t;
+
+  owners_t* getSharedOwners(uintptr_t owners)
+  {
+    return reinterpret_cast<owners_t*>(owners & ~SHARED_OWNERS);
+  }
+
+  uint32_t getMortonCode(uint32_t x, uint32_t y)
+  {
+    auto spread = [](uint32_t value)
+    {
+      value = (value | (value << 8)) & 0x00FF00FFu;
+      value = (value | (value << 4)) & 0x0F0F0F0Fu;
+      value = (value | (value << 2)) & 0x33333333u;
+      return (value | (value << 1)) & 0x55555555u;
+    };
+    return spread(x) | (spread(y) << 1);
+  }
+
+  uint32_t getHilbertCode(uint32_t x, uint32_t y)
+  {
+    uint32_t code = 0;
+    for (uint32_t side = 1u << (BITS_PER_AXIS - 1); side > 0; side /= 2)
+    {
+      const uint32_t quadrantX = ((x & side) != 0) ? 1 : 0;
+      const uint32_t quadrantY = ((y & side) != 0) ? 1 : 0;
+      code += side * side * ((3 * quadrantX) ^ quadrantY);
+      if (quadrantY == 0)
+      {
+        if (quadrantX == 1)
+        {
+          x = side - 1 - (x & (side - 1));
+          y = side - 1 - (y & (side - 1));
+        }
+        std::swap(x, y);
+      }
+    }
+    return code;
+  }
+}
 
 klimchuk::CompositeShape::CompositeShape(const Shape::ShapePtr& shape) :
   size_{ 1 },
-  arrayOfShapes_{ std::make_unique<ShapePtr[]>(size_) }
+  capacity_{ 1 },
+  arrayOfShapes_{ std::make_unique<ShapePtr[]>(capacity_) },
+  isHullCached_{ false },
+  hull_(),
+  enclosingCircle_{ { 0.0, 0.0 }, 0.0 },
+  isHashCached_{ false },
+  hash_{ 0 }
 {
   if (!shape)
   {
     throw std::invalid_argument("CompositeShape: Parametr is not shape.");
   }
+  addOwner(*shape);
   arrayOfShapes_[0] = shape;
 }
 
+klimchuk::CompositeShape::CompositeShape() :
+  size_{ 0 },
+  capacity_{ 0 },
+  arrayOfShapes_(),
+  isHullCached_{ false },
+  hull_(),
+  enclosingCircle_{ { 0.0, 0.0 }, 0.0 },
+  isHashCached_{ false },
+  hash_{ 0 }
+{}
+
 klimchuk::CompositeShape::CompositeShape(const CompositeShape& rhs) :
-  size_{ rhs.size_ },
-  arrayOfShapes_{ std::make_unique<Shape::ShapePtr[]>(size_) }
+  Shape(rhs),
+  size_{ 0 },
+  capacity_{ rhs.size_ },
+  arrayOfShapes_{ std::make_unique<Shape::ShapePtr[]>(capacity_) },
+  isHullCached_{ rhs.isHullCached_ },
+  hull_(rhs.hull_),
+  enclosingCircle_{ rhs.enclosingCircle_ },
+  isHashCached_{ rhs.isHashCached_ },
+  hash_{ rhs.hash_ }
 {
-  for (size_t i = 0; i < size_; ++i)
+  try
+  {
+    for (; size_ < rhs.size_; ++size_)
+    {
+      addOwner(*rhs.arrayOfShapes_[size_]);
+      arrayOfShapes_[size_] = rhs.arrayOfShapes_[size_];
+    }
+  }
+  catch (...)
   {
-    arrayOfShapes_[i] = rhs.arrayOfShapes_[i];
+    while (size_ > 0)
+    {
+      removeOwner(*arrayOfShapes_[--size_]);
+    }
+    throw;
   }
 }
 
 klimchuk::CompositeShape::CompositeShape(CompositeShape&& rhs) noexcept :
+  Shape(rhs),
   size_{ rhs.size_ },
-  arrayOfShapes_{ std::move(rhs.arrayOfShapes_) }
-{}
+  capacity_{ rhs.capacity_ },
+  arrayOfShapes_{ std::move(rhs.arrayOfShapes_) },
+  isHullCached_{ rhs.isHullCached_ },
+  hull_(std::move(rhs.hull_)),
+  enclosingCircle_{ rhs.enclosingCircle_ },
+  isHashCached_{ rhs.isHashCached_ },
+  hash_{ rhs.hash_ }
+{
+  rhs.size_ = 0;
+  rhs.capacity_ = 0;
+  for (size_t i = 0; i < size_; ++i)
+  {
+    replaceOwner(*arrayOfShapes_[i], &rhs);
+  }
+  Journal::forget(&rhs);
+}
+
+klimchuk::CompositeShape::~CompositeShape()
+{
+  for (size_t i = 0; i < size_; ++i)
+  {
+    removeOwner(*arrayOfShapes_[i]);
+  }
+}
 
 klimchuk::CompositeShape& klimchuk::CompositeShape::operator=(const CompositeShape& rhs)
 {
   if (this != &rhs)
   {
-    arrayOfShapes_ = std::make_unique<Shape::ShapePtr[]>(rhs.size_);
-    size_ = rhs.size_;
-    for (size_t i = 0; i < size_; ++i)
-    {
-      arrayOfShapes_[i] = rhs.arrayOfShapes_[i];
-    }
+    *this = CompositeShape(rhs);
   }
   return *this;
 }
@@ -49,8 +159,26 @@ klimchuk::CompositeShape& klimchuk::CompositeShape::operator=(CompositeShape&& r
 {
   if (this != &rhs)
   {
+    Shape::operator=(rhs);
+    Journal::forget(&rhs);
+    for (size_t i = 0; i < size_; ++i)
+    {
+      removeOwner(*arrayOfShapes_[i]);
+    }
     size_ = rhs.size_;
+    capacity_ = rhs.capacity_;
     arrayOfShapes_ = std::move(rhs.arrayOfShapes_);
+    rhs.size_ = 0;
+    rhs.capacity_ = 0;
+    for (size_t i = 0; i < size_; ++i)
+    {
+      replaceOwner(*arrayOfShapes_[i], &rhs);
+    }
+    isHullCached_ = rhs.isHullCached_;
+    hull_ = std::move(rhs.hull_);
+    enclosingCircle_ = rhs.enclosingCircle_;
+    isHashCached_ = rhs.isHashCached_;
+    hash_ = rhs.hash_;
   }
   return *this;
 }
@@ -83,6 +211,7 @@ klimchuk::Shape::ConstShapePtr klimchuk::CompositeShape::operator[](size_t index
 
 void klimchuk::CompositeShape::add(const Shape::ShapePtr& shape)
 {
+  const Journal::Scope scope(Journal::Operation::ADD, *this, shape);
   if (!arrayOfShapes_)
   {
     throw std::domain_error("CompositeShape: Array of shapes is empty.");
@@ -91,18 +220,25 @@ void klimchuk::CompositeShape::add(const Shape::ShapePtr& shape)
   {
     throw std::invalid_argument("CompositeShape: Parametr is not shape.");
   }
-  std::unique_ptr<Shape::ShapePtr[]> tempArray = std::make_unique<Shape::ShapePtr[]>(size_ + 1);
-  for (size_t i = 0; i < size_; ++i)
+  if (size_ == capacity_)
   {
-    tempArray[i] = arrayOfShapes_[i];
+    capacity_ *= 2;
+    std::unique_ptr<Shape::ShapePtr[]> tempArray = std::make_unique<Shape::ShapePtr[]>(capacity_);
+    for (size_t i = 0; i < size_; ++i)
+    {
+      tempArray[i] = std::move(arrayOfShapes_[i]);
+    }
+    arrayOfShapes_.swap(tempArray);
   }
-  tempArray[size_] = shape;
+  addOwner(*shape);
+  arrayOfShapes_[size_] = shape;
   ++size_;
-  arrayOfShapes_.swap(tempArray);
+  invalidateCaches();
 }
 
 void klimchuk::CompositeShape::remove(size_t index)
 {
+  const Journal::Scope scope(Journal::Operation::REMOVE, *this, index);
   if (!arrayOfShapes_)
   {
     throw std::domain_error("CompositeShape: Array of shapes is empty.");
@@ -115,17 +251,14 @@ void klimchuk::CompositeShape::remove(size_t index)
   {
     throw std::length_error("You can not delete last figure in CompositeShape.");
   }
-  std::unique_ptr<Shape::ShapePtr[]> tempArray = std::make_unique<Shape::ShapePtr[]>(size_ - 1);
-  for (size_t i = 0; i < index; ++i)
-  {
-    tempArray[i] = arrayOfShapes_[i];
-  }
+  removeOwner(*arrayOfShapes_[index]);
   for (size_t i = index; i < size_ - 1; ++i)
   {
-    tempArray[i] = arrayOfShapes_[i + 1];
+    arrayOfShapes_[i] = std::move(arrayOfShapes_[i + 1]);
   }
   size_--;
-  arrayOfShapes_.swap(tempArray);
+  arrayOfShapes_[size_].reset();
+  invalidateCaches();
 }
 
 size_t klimchuk::CompositeShape::getSize() const
@@ -137,6 +270,61 @@ size_t klimchuk::CompositeShape::getSize() const
   return size_;
 }
 
+std::vector<size_t> klimchuk::CompositeShape::getSpatialOrder(Curve curve) const
+{
+  if (!arrayOfShapes_)
+  {
+    throw std::domain_error("CompositeShape: Array of shapes is empty.");
+  }
+  std::vector<point_t> centres(size_);
+  point_t minimum = arrayOfShapes_[0]->getFrameRect().pos;
+  point_t maximum = minimum;
+  for (size_t i = 0; i < size_; ++i)
+  {
+    centres[i] = arrayOfShapes_[i]->getFrameRect().pos;
+    minimum = { std::min(minimum.x, centres[i].x), std::min(minimum.y, centres[i].y) };
+    maximum = { std::max(maximum.x, centres[i].x), std::max(maximum.y, centres[i].y) };
+  }
+  const double maxCell = static_cast<double>((1u << BITS_PER_AXIS) - 1);
+  auto quantize = [maxCell](double value, double minValue, double maxValue)
+  {
+    return (maxValue > minValue) ? static_cast<uint32_t>((value - minValue) / (maxValue - minValue) * maxCell) : 0u;
+  };
+  std::vector<uint32_t> codes(size_);
+  for (size_t i = 0; i < size_; ++i)
+  {
+    const uint32_t x = quantize(centres[i].x, minimum.x, maximum.x);
+    const uint32_t y = quantize(centres[i].y, minimum.y, maximum.y);
+    codes[i] = (curve == Curve::MORTON) ? getMortonCode(x, y) : getHilbertCode(x, y);
+  }
+
+  std::vector<size_t> order(size_);
+  std::vector<size_t> sorted(size_);
+  for (size_t i = 0; i < size_; ++i)
+  {
+    order[i] = i;
+  }
+  const size_t numberOfBuckets = 1u << BITS_PER_DIGIT;
+  for (unsigned int shift = 0; shift < 2 * BITS_PER_AXIS; shift += BITS_PER_DIGIT)
+  {
+    std::vector<size_t> beginnings(numberOfBuckets + 1, 0);
+    for (size_t i = 0; i < size_; ++i)
+    {
+      ++beginnings[((codes[i] >> shift) & (numberOfBuckets - 1)) + 1];
+    }
+    for (size_t i = 0; i < numberOfBuckets; ++i)
+    {
+      beginnings[i + 1] += beginnings[i];
+    }
+    for (size_t index : order)
+    {
+      sorted[beginnings[(codes[index] >> shift) & (numberOfBuckets - 1)]++] = index;
+    }
+    order.swap(sorted);
+  }
+  return order;
+}
+
 double klimchuk::CompositeShape::getArea() const
 {
   if (!arrayOfShapes_)
@@ -151,6 +339,15 @@ double klimchuk::CompositeShape::getArea() const
   return sumOfAreas;
 }
 
+double klimchuk::CompositeShape::getUnionArea(size_t numberOfThreads) const
+{
+  if (!arrayOfShapes_)
+  {
+    throw std::domain_error("CompositeShape: Array of shapes is empty.");
+  }
+  return klimchuk::getUnionArea(arrayOfShapes_.get(), size_, numberOfThreads);
+}
+
 klimchuk::rectangle_t klimchuk::CompositeShape::getFrameRect() const
 {
   if (!arrayOfShapes_)
@@ -174,6 +371,61 @@ klimchuk::rectangle_t klimchuk::CompositeShape::getFrameRect() const
     {(leftLine + ((rightLine - leftLine) / 2)), (bottomLine + ((topLine - bottomLine) / 2))} };
 }
 
+klimchuk::oriented_rectangle_t klimchuk::CompositeShape::getOrientedFrameRect() const
+{
+  if (!arrayOfShapes_)
+  {
+    throw std::domain_error("CompositeShape: Array of shapes is empty.");
+  }
+  std::unique_ptr<point_t[]> corners = std::make_unique<point_t[]>(4 * size_);
+  for (size_t i = 0; i < size_; ++i)
+  {
+    getCorners(arrayOfShapes_[i]->getOrientedFrameRect(), &corners[4 * i]);
+  }
+  return getMinimumAreaRect(corners.get(), 4 * size_);
+}
+
+std::vector<klimchuk::point_t> klimchuk::CompositeShape::getConvexHull() const
+{
+  if (!arrayOfShapes_)
+  {
+    throw std::domain_error("CompositeShape: Array of shapes is empty.");
+  }
+  cacheHull();
+  return hull_;
+}
+
+klimchuk::circle_t klimchuk::CompositeShape::getEnclosingCircle() const
+{
+  if (!arrayOfShapes_)
+  {
+    throw std::domain_error("CompositeShape: Array of shapes is empty.");
+  }
+  cacheHull();
+  return enclosingCircle_;
+}
+
+klimchuk::rectangle_t klimchuk::CompositeShape::getHullFrameRect() const
+{
+  if (!arrayOfShapes_)
+  {
+    throw std::domain_error("CompositeShape: Array of shapes is empty.");
+  }
+  cacheHull();
+  double minX = hull_[0].x;
+  double maxX = hull_[0].x;
+  double minY = hull_[0].y;
+  double maxY = hull_[0].y;
+  for (const point_t& point : hull_)
+  {
+    minX = std::min(minX, point.x);
+    maxX = std::max(maxX, point.x);
+    minY = std::min(minY, point.y);
+    maxY = std::max(maxY, point.y);
+  }
+  return rectangle_t{ maxX - minX, maxY - minY, { (minX + maxX) / 2, (minY + maxY) / 2 } };
+}
+
 klimchuk::point_t klimchuk::CompositeShape::getCentre() const
 {
   if (!arrayOfShapes_)
@@ -185,18 +437,26 @@ klimchuk::point_t klimchuk::CompositeShape::getCentre() const
 
 void klimchuk::CompositeShape::move(double moveAbscissa, double moveOrdinate)
 {
+  const Journal::Scope scope(Journal::Operation::MOVE_BY, *this, moveAbscissa, moveOrdinate);
   if (!arrayOfShapes_)
   {
     throw std::domain_error("CompositeShape: Array of shapes is empty.");
   }
+  const bool isHullCached = isHullCached_;
   for (size_t i = 0; i < size_; ++i)
   {
     arrayOfShapes_[i]->move(moveAbscissa, moveOrdinate);
   }
+  invalidateCaches();
+  if (isHullCached)
+  {
+    transformHull({ 0.0, 0.0 }, { moveAbscissa, moveOrdinate }, 1.0, 1.0, 0.0);
+  }
 }
 
 void klimchuk::CompositeShape::move(const point_t& point)
 {
+  const Journal::Scope scope(Journal::Operation::MOVE_TO, *this, point.x, point.y);
   if (!arrayOfShapes_)
   {
     throw std::domain_error("CompositeShape: Array of shapes is empty.");
@@ -207,6 +467,7 @@ void klimchuk::CompositeShape::move(const point_t& point)
 
 void klimchuk::CompositeShape::scale(double coefficient)
 {
+  const Journal::Scope scope(Journal::Operation::SCALE, *this, coefficient);
   if (!arrayOfShapes_)
   {
     throw std::domain_error("CompositeShape: Array of shapes is empty.");
@@ -216,6 +477,7 @@ void klimchuk::CompositeShape::scale(double coefficient)
     throw std::invalid_argument("CompositeShape: Coefficient must be more than a zero.");
   }
   point_t centreOfComposite = getCentre();
+  const bool isHullCached = isHullCached_;
   for (size_t i = 0; i < size_; ++i)
   {
     point_t centreOfShape = arrayOfShapes_[i]->getCentre();
@@ -223,13 +485,20 @@ void klimchuk::CompositeShape::scale(double coefficient)
       (centreOfComposite.y + (coefficient * (centreOfShape.y - centreOfComposite.y))) });
     arrayOfShapes_[i]->scale(coefficient);
   }
+  invalidateCaches();
+  if (isHullCached)
+  {
+    transformHull(centreOfComposite, centreOfComposite, coefficient, 1.0, 0.0);
+  }
 }
 
 void klimchuk::CompositeShape::rotate(double angle)
 {
+  const Journal::Scope scope(Journal::Operation::ROTATE, *this, angle);
   double cosinusOfAngle = cos(angle * M_PI / 180);
   double sinusOfAngle = sin(angle * M_PI / 180);
   point_t centreOFCompositeShape = getCentre();
+  const bool isHullCached = isHullCached_;
   for (size_t i = 0; i < size_; ++i)
   {
     point_t centreOfShape = arrayOfShapes_[i]->getCentre();
@@ -240,4 +509,162 @@ void klimchuk::CompositeShape::rotate(double angle)
     arrayOfShapes_[i]->move({ newCentreAbscissa, newCentreOrdinate });
     arrayOfShapes_[i]->rotate(angle);
   }
+  invalidateCaches();
+  if (isHullCached)
+  {
+    transformHull(centreOFCompositeShape, centreOFCompositeShape, 1.0, cosinusOfAngle, sinusOfAngle);
+  }
+}
+
+uint64_t klimchuk::CompositeShape::getHash() const
+{
+  if (!arrayOfShapes_)
+  {
+    throw std::domain_error("CompositeShape: Array of shapes is empty.");
+  }
+  if (!isHashCached_)
+  {
+    uint64_t hash = hashCombine(HASH_SEED, static_cast<uint64_t>(size_));
+    for (size_t i = 0; i < size_; ++i)
+    {
+      hash = hashCombine(hash, arrayOfShapes_[i]->getHash());
+    }
+    hash_ = hash;
+    isHashCached_ = true;
+  }
+  return hash_;
+}
+
+void klimchuk::Shape::invalidateOwners()
+{
+  if ((owners_ & SHARED_OWNERS) == 0)
+  {
+    if (owners_ != 0)
+    {
+      reinterpret_cast<CompositeShape*>(owners_)->invalidateCaches();
+    }
+    return;
+  }
+  for (CompositeShape* owner : *getSharedOwners(owners_))
+  {
+    owner->invalidateCaches();
+  }
+}
+
+void klimchuk::CompositeShape::addOwner(Shape& shape)
+{
+  if (shape.owners_ == 0)
+  {
+    shape.owners_ = reinterpret_cast<uintptr_t>(this);
+  }
+  else if ((shape.owners_ & SHARED_OWNERS) == 0)
+  {
+    owners_t* owners = new owners_t{ reinterpret_cast<CompositeShape*>(shape.owners_), this };
+    shape.owners_ = reinterpret_cast<uintptr_t>(owners) | SHARED_OWNERS;
+  }
+  else
+  {
+    getSharedOwners(shape.owners_)->push_back(this);
+  }
+}
+
+void klimchuk::CompositeShape::removeOwner(Shape& shape)
+{
+  if ((shape.owners_ & SHARED_OWNERS) == 0)
+  {
+    shape.owners_ = 0;
+    return;
+  }
+  owners_t* owners = getSharedOwners(shape.owners_);
+  owners->erase(std::find(owners->begin(), owners->end(), this));
+  if (owners->size() == 1)
+  {
+    shape.owners_ = reinterpret_cast<uintptr_t>(owners->front());
+    delete owners;
+  }
+}
+
+void klimchuk::CompositeShape::replaceOwner(Shape& shape, const CompositeShape* previousOwner)
+{
+  if ((shape.owners_ & SHARED_OWNERS) == 0)
+  {
+    shape.owners_ = reinterpret_cast<uintptr_t>(this);
+    return;
+  }
+  owners_t* owners = getSharedOwners(shape.owners_);
+  *std::find(owners->begin(), owners->end(), previousOwner) = this;
+}
+
+void klimchuk::CompositeShape::invalidateCaches()
+{
+  if (isHullCached_ || isHashCached_)
+  {
+    isHullCached_ = false;
+    isHashCached_ = false;
+    invalidateOwners();
+  }
+}
+
+void klimchuk::CompositeShape::cacheHull() const
+{
+  if (isHullCached_)
+  {
+    return;
+  }
+  std::vector<point_t> points;
+  for (size_t i = 0; i < size_; ++i)
+  {
+    const Shape* shape = arrayOfShapes_[i].get();
+    if (const CompositeShape* compositeShape = dynamic_cast<const CompositeShape*>(shape))
+    {
+      compositeShape->cacheHull();
+      points.insert(points.end(), compositeShape->hull_.begin(), compositeShape->hull_.end());
+    }
+    else if (const Circle* circle = dynamic_cast<const Circle*>(shape))
+    {
+      const point_t centre = circle->getCentre();
+      const double radius = circle->getRadius() / std::cos(M_PI / NUMBER_OF_SIDES_OF_CIRCLE);
+      const point_t* unitCircle = Circle::getUnitCircle(2 * NUMBER_OF_SIDES_OF_CIRCLE);
+      for (size_t j = 1; j < 2 * NUMBER_OF_SIDES_OF_CIRCLE; j += 2)
+      {
+        points.push_back({ centre.x + (radius * unitCircle[j].x), centre.y + (radius * unitCircle[j].y) });
+      }
+    }
+    else if (const Triangle* triangle = dynamic_cast<const Triangle*>(shape))
+    {
+      points.insert(points.end(), { (*triangle)[0], (*triangle)[1], (*triangle)[2] });
+    }
+    else if (const Polygon* polygon = dynamic_cast<const Polygon*>(shape))
+    {
+      for (size_t j = 0; j < polygon->getSize(); ++j)
+      {
+        points.push_back((*polygon)[j]);
+      }
+    }
+    else
+    {
+      points.resize(points.size() + 4);
+      getCorners(shape->getOrientedFrameRect(), &points[points.size() - 4]);
+    }
+  }
+  hull_ = klimchuk::getConvexHull(points.data(), points.size());
+  enclosingCircle_ = klimchuk::getEnclosingCircle(hull_.data(), hull_.size());
+  isHullCached_ = true;
+}
+
+void klimchuk::CompositeShape::transformHull(const point_t& centre, const point_t& newCentre, double coefficient,
+  double cosinusOfAngle, double sinusOfAngle)
+{
+  auto transform = [&centre, &newCentre, coefficient, cosinusOfAngle, sinusOfAngle](const point_t& point)
+  {
+    const point_t offset{ point.x - centre.x, point.y - centre.y };
+    return point_t{ newCentre.x + (coefficient * ((cosinusOfAngle * offset.x) - (sinusOfAngle * offset.y))),
+      newCentre.y + (coefficient * ((sinusOfAngle * offset.x) + (cosinusOfAngle * offset.y))) };
+  };
+  for (point_t& point : hull_)
+  {
+    point = transform(point);
+  }
+  enclosingCircle_ = circle_t{ transform(enclosingCircle_.pos), coefficient * enclosingCircle_.radius };
+  isHullCached_ = true;
 }
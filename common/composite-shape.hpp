@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <initializer_list>
+#include <vector>
 #include "shape.hpp"
 
 namespace klimchuk
@@ -10,9 +11,16 @@ namespace klimchuk
   class CompositeShape : public Shape
   {
   public:
+    enum class Curve
+    {
+      MORTON,
+      HILBERT
+    };
+
     CompositeShape(const ShapePtr& shape);
     CompositeShape(const CompositeShape& rhs);
     CompositeShape(CompositeShape&& rhs) noexcept;
+    virtual ~CompositeShape();
     CompositeShape& operator=(const CompositeShape& rhs);
     CompositeShape& operator=(CompositeShape&& rhs) noexcept;
 
@@ -22,17 +30,43 @@ namespace klimchuk
     void add(const ShapePtr& shape);
     void remove(size_t index);
     size_t getSize() const;
+    std::vector<size_t> getSpatialOrder(Curve curve = Curve::HILBERT) const;
 
     virtual double getArea() const override;
+    double getUnionArea(size_t numberOfThreads = 1) const;
     virtual rectangle_t getFrameRect() const override;
+    virtual oriented_rectangle_t getOrientedFrameRect() const override;
+    std::vector<point_t> getConvexHull() const;
+    circle_t getEnclosingCircle() const;
+    rectangle_t getHullFrameRect() const;
     virtual void move(const point_t& point) override;
     virtual void move(double moveAbscissa, double moveOrdinate);
     virtual void scale(double coefficient) override;
     virtual point_t getCentre() const override;
     virtual void rotate(double angle) override;
+    virtual uint64_t getHash() const override;
   private:
+    friend class Shape;
+    friend class JournalPlayer;
+
     size_t size_;
+    size_t capacity_;
     std::unique_ptr<ShapePtr[]> arrayOfShapes_;
+    mutable bool isHullCached_;
+    mutable std::vector<point_t> hull_;
+    mutable circle_t enclosingCircle_;
+    mutable bool isHashCached_;
+    mutable uint64_t hash_;
+
+    CompositeShape();
+
+    void addOwner(Shape& shape);
+    void removeOwner(Shape& shape);
+    void replaceOwner(Shape& shape, const CompositeShape* previousOwner);
+    void invalidateCaches();
+    void cacheHull() const;
+    void transformHull(const point_t& centre, const point_t& newCentre, double coefficient, double cosinusOfAngle,
+      double sinusOfAngle);
   };
 }
 
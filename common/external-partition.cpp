@@ -0,0 +1,466 @@
+#include "external-partition.hpp"
+#include <stdexcept>
+#include <cstdio>
+#include <cmath>
+#include <cfloat>
+#include <memory>
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <functional>
+
+namespace
+{
+  typedef std::unique_ptr<std::FILE, int (*)(std::FILE*)> File;
+
+  struct frame_record_t
+  {
+    klimchuk::rectangle_t frame;
+    uint64_t id;
+  };
+
+  struct active_t
+  {
+    klimchuk::rectangle_t frame;
+    uint64_t layer;
+  };
+
+  const size_t MIN_SIZE_OF_MEMORY = 64 << 10;
+  const size_t SIZE_OF_BLOCK = 256;
+  const size_t MAX_BUCKETS_OF_SHAPE = 16;
+  const size_t MIN_SIZE_TO_COMPACT = 4096;
+
+  File openFile(const std::string& path, const char* mode)
+  {
+    File file(std::fopen(path.c_str(), mode), std::fclose);
+    if (!file)
+    {
+      throw std::runtime_error("partitionExternally: Can't open file.");
+    }
+    return file;
+  }
+
+  File makeTemporaryFile()
+  {
+    File file(std::tmpfile(), std::fclose);
+    if (!file)
+    {
+      throw std::runtime_error("partitionExternally: Can't create temporary file.");
+    }
+    return file;
+  }
+
+  double getLeft(const klimchuk::rectangle_t& frame)
+  {
+    return frame.pos.x - (frame.width / 2);
+  }
+
+  double getRight(const klimchuk::rectangle_t& frame)
+  {
+    return frame.pos.x + (frame.width / 2);
+  }
+
+  bool isBefore(const frame_record_t& lhs, const frame_record_t& rhs)
+  {
+    const double left = getLeft(lhs.frame);
+    const double otherLeft = getLeft(rhs.frame);
+    return (left < otherLeft) || ((left == otherLeft) && (lhs.id < rhs.id));
+  }
+
+  template < typename T >
+  void writeBlock(std::FILE* file, const T* values, size_t numberOfValues)
+  {
+    if (std::fwrite(values, sizeof(T), numberOfValues, file) != numberOfValues)
+    {
+      throw std::runtime_error("partitionExternally: Can't write file.");
+    }
+  }
+
+  class RunReader
+  {
+  public:
+    explicit RunReader(File&& file):
+      file_(std::move(file)),
+      block_(SIZE_OF_BLOCK),
+      position_{ 0 },
+      size_{ 0 }
+    {
+      std::rewind(file_.get());
+    }
+
+    bool next(frame_record_t& record)
+    {
+      if (position_ == size_)
+      {
+        size_ = std::fread(block_.data(), sizeof(frame_record_t), block_.size(), file_.get());
+        position_ = 0;
+        if (size_ == 0)
+        {
+          if (std::ferror(file_.get()))
+          {
+            throw std::runtime_error("partitionExternally: Can't read temporary file.");
+          }
+          return false;
+        }
+      }
+      record = block_[position_++];
+      return true;
+    }
+  private:
+    File file_;
+    std::vector<frame_record_t> block_;
+    size_t position_;
+    size_t size_;
+  };
+
+  void merge(std::vector<File>& runs, const std::function<void(const frame_record_t&)>& consume)
+  {
+    typedef std::pair<frame_record_t, size_t> Head;
+    auto isAfter = [](const Head& lhs, const Head& rhs)
+    {
+      return isBefore(rhs.first, lhs.first);
+    };
+    std::vector<RunReader> readers;
+    readers.reserve(runs.size());
+    std::priority_queue<Head, std::vector<Head>, decltype(isAfter)> heads(isAfter);
+    for (File& run : runs)
+    {
+      readers.emplace_back(std::move(run));
+      frame_record_t record;
+      if (readers.back().next(record))
+      {
+        heads.push({ record, readers.size() - 1 });
+      }
+    }
+    runs.clear();
+    while (!heads.empty())
+    {
+      Head head = heads.top();
+      heads.pop();
+      consume(head.first);
+      if (readers[head.second].next(head.first))
+      {
+        heads.push(head);
+      }
+    }
+  }
+
+  class Sweep
+  {
+  public:
+    Sweep(std::FILE* file, klimchuk::Matrix::Mode mode, size_t sizeOfMemory, double bottom, double top,
+        double averageHeight):
+      file_{ file },
+      mode_{ mode },
+      sizeOfMemory_{ sizeOfMemory },
+      bottom_{ bottom },
+      numberOfBuckets_{ 1 },
+      heightOfBucket_{ 0.0 },
+      sizeOfFront_{ 0 },
+      sizeAfterCompaction_{ 0 },
+      maxSizeOfFront_{ 0 },
+      numberOfLayers_{ 0 }
+    {
+      const size_t maxNumberOfBuckets = std::max<size_t>(sizeOfMemory_ / (4 * sizeof(std::vector<active_t>)), 1);
+      if ((averageHeight > 0.0) && (top > bottom))
+      {
+        numberOfBuckets_ = static_cast<size_t>(std::min(static_cast<double>(maxNumberOfBuckets),
+          (top - bottom) / averageHeight)) + 1;
+      }
+      heightOfBucket_ = (top - bottom) / numberOfBuckets_;
+      buckets_.resize(numberOfBuckets_);
+      output_.reserve(SIZE_OF_BLOCK);
+    }
+
+    void add(const frame_record_t& record)
+    {
+      const klimchuk::rectangle_t& frame = record.frame;
+      const double left = getLeft(frame);
+      const double tolerance = 8 * DBL_EPSILON * (std::abs(frame.pos.y) + frame.height);
+      const size_t lowest = getBucket(frame.pos.y - (frame.height / 2) - tolerance);
+      const size_t highest = getBucket(frame.pos.y + (frame.height / 2) + tolerance);
+      const bool isLarge = (highest - lowest + 1 > MAX_BUCKETS_OF_SHAPE);
+      usedLayers_.clear();
+      collect(large_, frame, left);
+      if (!isLarge)
+      {
+        for (size_t bucket = lowest; bucket <= highest; ++bucket)
+        {
+          collect(buckets_[bucket], frame, left);
+        }
+      }
+      else
+      {
+        for (std::vector<active_t>& bucket : buckets_)
+        {
+          collect(bucket, frame, left);
+        }
+      }
+      const uint64_t layer = getLayer();
+      numberOfLayers_ = std::max(numberOfLayers_, layer + 1);
+      if (isLarge)
+      {
+        large_.push_back({ frame, layer });
+        ++sizeOfFront_;
+      }
+      else
+      {
+        for (size_t bucket = lowest; bucket <= highest; ++bucket)
+        {
+          buckets_[bucket].push_back({ frame, layer });
+        }
+        sizeOfFront_ += highest - lowest + 1;
+      }
+      maxSizeOfFront_ = std::max(maxSizeOfFront_, sizeOfFront_);
+      if ((sizeOfFront_ > 2 * sizeAfterCompaction_ + MIN_SIZE_TO_COMPACT)
+        || (sizeOfFront_ * sizeof(active_t) > sizeOfMemory_))
+      {
+        compact(left);
+      }
+      output_.push_back({ record.id, layer });
+      if (output_.size() == SIZE_OF_BLOCK)
+      {
+        flush();
+      }
+    }
+
+    void flush()
+    {
+      writeBlock(file_, output_.data(), output_.size());
+      output_.clear();
+    }
+
+    uint64_t getNumberOfLayers() const
+    {
+      return numberOfLayers_;
+    }
+
+    size_t getMaxSizeOfFront() const
+    {
+      return maxSizeOfFront_;
+    }
+  private:
+    std::FILE* file_;
+    klimchuk::Matrix::Mode mode_;
+    size_t sizeOfMemory_;
+    double bottom_;
+    size_t numberOfBuckets_;
+    double heightOfBucket_;
+    std::vector<std::vector<active_t>> buckets_;
+    std::vector<active_t> large_;
+    size_t sizeOfFront_;
+    size_t sizeAfterCompaction_;
+    size_t maxSizeOfFront_;
+    uint64_t numberOfLayers_;
+    std::vector<uint64_t> usedLayers_;
+    std::vector<klimchuk::layer_record_t> output_;
+
+    size_t getBucket(double y) const
+    {
+      if (!(heightOfBucket_ > 0.0) || !(y > bottom_))
+      {
+        return 0;
+      }
+      return static_cast<size_t>(std::min((y - bottom_) / heightOfBucket_, static_cast<double>(numberOfBuckets_ - 1)));
+    }
+
+    bool isExpired(const active_t& active, double left) const
+    {
+      const double right = getRight(active.frame);
+      return right + 8 * DBL_EPSILON * (std::abs(right) + std::abs(left) + active.frame.width) < left;
+    }
+
+    void collect(std::vector<active_t>& bucket, const klimchuk::rectangle_t& frame, double left)
+    {
+      size_t stillActive = 0;
+      for (size_t i = 0; i < bucket.size(); ++i)
+      {
+        if (isExpired(bucket[i], left))
+        {
+          continue;
+        }
+        bucket[stillActive++] = bucket[i];
+        if (klimchuk::areShapesIntersect(bucket[i].frame, frame))
+        {
+          usedLayers_.push_back(bucket[i].layer);
+        }
+      }
+      sizeOfFront_ -= bucket.size() - stillActive;
+      bucket.resize(stillActive);
+    }
+
+    uint64_t getLayer()
+    {
+      if (usedLayers_.empty())
+      {
+        return 0;
+      }
+      if (mode_ == klimchuk::Matrix::Mode::MINIMUM_LAYERS)
+      {
+        return *std::max_element(usedLayers_.begin(), usedLayers_.end()) + 1;
+      }
+      std::sort(usedLayers_.begin(), usedLayers_.end());
+      uint64_t layer = 0;
+      for (uint64_t usedLayer : usedLayers_)
+      {
+        if (usedLayer > layer)
+        {
+          break;
+        }
+        layer = usedLayer + 1;
+      }
+      return layer;
+    }
+
+    void compact(double left)
+    {
+      sizeOfFront_ = 0;
+      for (std::vector<active_t>& bucket : buckets_)
+      {
+        bucket.erase(std::remove_if(bucket.begin(), bucket.end(), [this, left](const active_t& active)
+        {
+          return isExpired(active, left);
+        }), bucket.end());
+        sizeOfFront_ += bucket.size();
+      }
+      large_.erase(std::remove_if(large_.begin(), large_.end(), [this, left](const active_t& active)
+      {
+        return isExpired(active, left);
+      }), large_.end());
+      sizeOfFront_ += large_.size();
+      sizeAfterCompaction_ = sizeOfFront_;
+      if (sizeOfFront_ * sizeof(active_t) > sizeOfMemory_)
+      {
+        throw std::length_error("partitionExternally: Active front exceeds memory limit.");
+      }
+    }
+  };
+}
+
+void klimchuk::writeFrames(std::ostream& stream, const CompositeShape& compositeShape)
+{
+  for (size_t i = 0; i < compositeShape.getSize(); ++i)
+  {
+    const rectangle_t frame = compositeShape[i]->getFrameRect();
+    stream.write(reinterpret_cast<const char*>(&frame), sizeof(rectangle_t));
+  }
+  if (!stream)
+  {
+    throw std::runtime_error("writeFrames: Can't write frames.");
+  }
+}
+
+klimchuk::external_statistics_t klimchuk::partitionExternally(const std::string& pathOfFrames,
+  const std::string& pathOfLayers, size_t sizeOfMemory, Matrix::Mode mode)
+{
+  if (sizeOfMemory < MIN_SIZE_OF_MEMORY)
+  {
+    throw std::invalid_argument("partitionExternally: Memory limit is too small.");
+  }
+  external_statistics_t statistics{ 0, 0, 0, 0, 0 };
+  File input = openFile(pathOfFrames, "rb");
+  const size_t sizeOfRun = sizeOfMemory / sizeof(frame_record_t);
+  std::vector<frame_record_t> run;
+  run.reserve(sizeOfRun);
+  std::vector<rectangle_t> block(SIZE_OF_BLOCK);
+  std::vector<File> runs;
+  double bottom = 0.0;
+  double top = 0.0;
+  double sumOfHeights = 0.0;
+  auto writeRun = [&]()
+  {
+    std::sort(run.begin(), run.end(), isBefore);
+    runs.push_back(makeTemporaryFile());
+    writeBlock(runs.back().get(), run.data(), run.size());
+    run.clear();
+  };
+  while (true)
+  {
+    const size_t numberOfFrames = std::fread(block.data(), sizeof(rectangle_t), block.size(), input.get());
+    for (size_t i = 0; i < numberOfFrames; ++i)
+    {
+      const rectangle_t& frame = block[i];
+      if (!std::isfinite(frame.pos.x) || !std::isfinite(frame.pos.y) || !std::isfinite(frame.width)
+        || !std::isfinite(frame.height) || (frame.width < 0.0) || (frame.height < 0.0))
+      {
+        throw std::invalid_argument("partitionExternally: Invalid frame.");
+      }
+      const double frameBottom = frame.pos.y - (frame.height / 2);
+      const double frameTop = frame.pos.y + (frame.height / 2);
+      bottom = (statistics.numberOfShapes == 0) ? frameBottom : std::min(bottom, frameBottom);
+      top = (statistics.numberOfShapes == 0) ? frameTop : std::max(top, frameTop);
+      sumOfHeights += frame.height;
+      run.push_back({ frame, statistics.numberOfShapes++ });
+      if (run.size() == sizeOfRun)
+      {
+        writeRun();
+      }
+    }
+    if (numberOfFrames < block.size())
+    {
+      break;
+    }
+  }
+  if (std::ferror(input.get()))
+  {
+    throw std::runtime_error("partitionExternally: Can't read frames.");
+  }
+  if (std::ftell(input.get()) % sizeof(rectangle_t) != 0)
+  {
+    throw std::runtime_error("partitionExternally: File of frames is truncated.");
+  }
+  input.reset();
+  if (!run.empty())
+  {
+    writeRun();
+  }
+  run = std::vector<frame_record_t>();
+  statistics.numberOfRuns = runs.size();
+
+  const size_t fanIn = std::max<size_t>(sizeOfMemory / 2 / (SIZE_OF_BLOCK * sizeof(frame_record_t)) - 1, 2);
+  while (runs.size() > fanIn)
+  {
+    std::vector<File> mergedRuns;
+    for (size_t beginning = 0; beginning < runs.size(); beginning += fanIn)
+    {
+      std::vector<File> group;
+      for (size_t i = beginning; i < std::min(beginning + fanIn, runs.size()); ++i)
+      {
+        group.push_back(std::move(runs[i]));
+      }
+      mergedRuns.push_back(makeTemporaryFile());
+      std::FILE* file = mergedRuns.back().get();
+      std::vector<frame_record_t> output;
+      output.reserve(SIZE_OF_BLOCK);
+      merge(group, [file, &output](const frame_record_t& record)
+      {
+        output.push_back(record);
+        if (output.size() == SIZE_OF_BLOCK)
+        {
+          writeBlock(file, output.data(), output.size());
+          output.clear();
+        }
+      });
+      writeBlock(file, output.data(), output.size());
+    }
+    runs.swap(mergedRuns);
+    ++statistics.numberOfMergePasses;
+  }
+
+  File output = openFile(pathOfLayers, "wb");
+  const double averageHeight = (statistics.numberOfShapes == 0) ? 0.0 : sumOfHeights / statistics.numberOfShapes;
+  Sweep sweep(output.get(), mode, sizeOfMemory / 2, bottom, top, averageHeight);
+  merge(runs, [&sweep](const frame_record_t& record)
+  {
+    sweep.add(record);
+  });
+  sweep.flush();
+  ++statistics.numberOfMergePasses;
+  if (std::fflush(output.get()) != 0)
+  {
+    throw std::runtime_error("partitionExternally: Can't write file.");
+  }
+  statistics.numberOfLayers = sweep.getNumberOfLayers();
+  statistics.maxSizeOfFront = sweep.getMaxSizeOfFront();
+  return statistics;
+}
@@ -0,0 +1,33 @@
+#ifndef KLIMCHUK_EXTERNAL_PARTITION
+#define KLIMCHUK_EXTERNAL_PARTITION
+
+#include <cstdint>
+#include <string>
+#include <ostream>
+#include "base-types.hpp"
+#include "composite-shape.hpp"
+#include "matrix.hpp"
+
+namespace klimchuk
+{
+  struct layer_record_t
+  {
+    uint64_t id;
+    uint64_t layer;
+  };
+
+  struct external_statistics_t
+  {
+    uint64_t numberOfShapes;
+    uint64_t numberOfLayers;
+    size_t numberOfRuns;
+    size_t numberOfMergePasses;
+    size_t maxSizeOfFront;
+  };
+
+  void writeFrames(std::ostream& stream, const CompositeShape& compositeShape);
+  external_statistics_t partitionExternally(const std::string& pathOfFrames, const std::string& pathOfLayers,
+    size_t sizeOfMemory = 256 << 20, Matrix::Mode mode = Matrix::Mode::MINIMUM_LAYERS);
+}
+
+#endif
@@ -0,0 +1,206 @@
+#ifndef KLIMCHUK_FRAME_SWEEP
+#define KLIMCHUK_FRAME_SWEEP
+
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+#include <vector>
+#include <random>
+#include <limits>
+#include "base-types.hpp"
+
+namespace klimchuk
+{
+  class FrameSweep
+  {
+  public:
+    explicit FrameSweep(size_t capacity);
+
+    template < typename Report >
+    void run(const rectangle_t* frames, size_t* indexes, size_t numberOfIndexes, Report& report);
+  private:
+    static constexpr size_t NO_NODE = static_cast<size_t>(-1);
+
+    struct active_frame_t
+    {
+      double bottomLine;
+      double topLine;
+      double maxTopLine;
+      double rightLine;
+      double width;
+      size_t index;
+      size_t left;
+      size_t right;
+      uint32_t priority;
+    };
+
+    std::vector<active_frame_t> nodes_;
+    std::vector<size_t> freeNodes_;
+    size_t root_;
+    std::minstd_rand generator_;
+
+    double getMaxTopLine(size_t node) const;
+    void update(size_t node);
+    void insert(const rectangle_t& frame, size_t index, double bottomLine, double topLine);
+    size_t insert(size_t root, size_t node);
+    size_t merge(size_t lhs, size_t rhs);
+
+    template < typename Report >
+    size_t collect(size_t node, double bottomLine, double topLine, double leftLine, Report& report);
+  };
+}
+
+inline klimchuk::FrameSweep::FrameSweep(size_t capacity):
+  nodes_(),
+  freeNodes_(),
+  root_{ NO_NODE },
+  generator_(1)
+{
+  nodes_.reserve(capacity);
+  freeNodes_.reserve(capacity);
+}
+
+template < typename Report >
+void klimchuk::FrameSweep::run(const rectangle_t* frames, size_t* indexes, size_t numberOfIndexes, Report& report)
+{
+  nodes_.clear();
+  freeNodes_.clear();
+  root_ = NO_NODE;
+  generator_.seed(1);
+  std::sort(indexes, indexes + numberOfIndexes, [frames](size_t lhs, size_t rhs)
+  {
+    const double leftLine = frames[lhs].pos.x - (frames[lhs].width / 2);
+    const double otherLeftLine = frames[rhs].pos.x - (frames[rhs].width / 2);
+    return (leftLine < otherLeftLine) || ((leftLine == otherLeftLine) && (lhs < rhs));
+  });
+  for (size_t i = 0; i < numberOfIndexes; ++i)
+  {
+    const size_t current = indexes[i];
+    const rectangle_t& frame = frames[current];
+    const double tolerance = 8 * DBL_EPSILON * (std::abs(frame.pos.y) + frame.height);
+    const double bottomLine = frame.pos.y - (frame.height / 2) - tolerance;
+    const double topLine = frame.pos.y + (frame.height / 2) + tolerance;
+    auto reportPair = [frames, current, &report](size_t other)
+    {
+      if (areShapesIntersect(frames[other], frames[current]))
+      {
+        report(std::min(other, current), std::max(other, current));
+      }
+    };
+    root_ = collect(root_, bottomLine, topLine, frame.pos.x - (frame.width / 2), reportPair);
+    insert(frame, current, bottomLine, topLine);
+  }
+}
+
+inline double klimchuk::FrameSweep::getMaxTopLine(size_t node) const
+{
+  return (node == NO_NODE) ? -std::numeric_limits<double>::infinity() : nodes_[node].maxTopLine;
+}
+
+inline void klimchuk::FrameSweep::update(size_t node)
+{
+  active_frame_t& frame = nodes_[node];
+  frame.maxTopLine = std::max(frame.topLine, std::max(getMaxTopLine(frame.left), getMaxTopLine(frame.right)));
+}
+
+inline void klimchuk::FrameSweep::insert(const rectangle_t& frame, size_t index, double bottomLine, double topLine)
+{
+  size_t node = nodes_.size();
+  if (freeNodes_.empty())
+  {
+    nodes_.emplace_back();
+  }
+  else
+  {
+    node = freeNodes_.back();
+    freeNodes_.pop_back();
+  }
+  nodes_[node] = active_frame_t{ bottomLine, topLine, topLine, frame.pos.x + (frame.width / 2), frame.width, index,
+    NO_NODE, NO_NODE, static_cast<uint32_t>(generator_()) };
+  root_ = insert(root_, node);
+}
+
+inline size_t klimchuk::FrameSweep::insert(size_t root, size_t node)
+{
+  if (root == NO_NODE)
+  {
+    return node;
+  }
+  if (nodes_[node].bottomLine < nodes_[root].bottomLine)
+  {
+    const size_t child = insert(nodes_[root].left, node);
+    nodes_[root].left = child;
+    if (nodes_[child].priority > nodes_[root].priority)
+    {
+      nodes_[root].left = nodes_[child].right;
+      nodes_[child].right = root;
+      update(root);
+      update(child);
+      return child;
+    }
+  }
+  else
+  {
+    const size_t child = insert(nodes_[root].right, node);
+    nodes_[root].right = child;
+    if (nodes_[child].priority > nodes_[root].priority)
+    {
+      nodes_[root].right = nodes_[child].left;
+      nodes_[child].left = root;
+      update(root);
+      update(child);
+      return child;
+    }
+  }
+  update(root);
+  return root;
+}
+
+inline size_t klimchuk::FrameSweep::merge(size_t lhs, size_t rhs)
+{
+  if ((lhs == NO_NODE) || (rhs == NO_NODE))
+  {
+    return (lhs == NO_NODE) ? rhs : lhs;
+  }
+  if (nodes_[lhs].priority > nodes_[rhs].priority)
+  {
+    nodes_[lhs].right = merge(nodes_[lhs].right, rhs);
+    update(lhs);
+    return lhs;
+  }
+  nodes_[rhs].left = merge(lhs, nodes_[rhs].left);
+  update(rhs);
+  return rhs;
+}
+
+template < typename Report >
+size_t klimchuk::FrameSweep::collect(size_t node, double bottomLine, double topLine, double leftLine, Report& report)
+{
+  if ((node == NO_NODE) || (nodes_[node].maxTopLine < bottomLine))
+  {
+    return node;
+  }
+  nodes_[node].left = collect(nodes_[node].left, bottomLine, topLine, leftLine, report);
+  const bool isBelowTop = nodes_[node].bottomLine <= topLine;
+  if (isBelowTop)
+  {
+    nodes_[node].right = collect(nodes_[node].right, bottomLine, topLine, leftLine, report);
+  }
+  const active_frame_t& frame = nodes_[node];
+  const double tolerance = 8 * DBL_EPSILON * (std::abs(frame.rightLine) + std::abs(leftLine) + frame.width);
+  if (frame.rightLine + tolerance < leftLine)
+  {
+    freeNodes_.push_back(node);
+    return merge(frame.left, frame.right);
+  }
+  if (isBelowTop && (frame.topLine >= bottomLine))
+  {
+    report(frame.index);
+  }
+  update(node);
+  return node;
+}
+
+#endif
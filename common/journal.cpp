@@ -0,0 +1,499 @@
+#include "journal.hpp"
+#include <stdexcept>
+#include <cstring>
+#include <cmath>
+#include "circle.hpp"
+#include "rectangle.hpp"
+#include "triangle.hpp"
+#include "polygon.hpp"
+#include "composite-shape.hpp"
+#include "matrix.hpp"
+
+namespace
+{
+  const char MAGIC[8] = { 'K', 'L', 'J', 'O', 'U', 'R', 'N', '\0' };
+  const uint32_t VERSION = 1;
+  const size_t SIZE_OF_BUFFER = 65536;
+}
+
+std::atomic<klimchuk::Journal*> klimchuk::Journal::active_{ nullptr };
+thread_local size_t klimchuk::Journal::depth_ = 0;
+
+klimchuk::Journal::Journal(std::ostream& stream):
+  stream_{ stream },
+  mutex_(),
+  buffer_(),
+  identifiers_(),
+  nextIdentifier_{ 0 },
+  numberOfRecords_{ 0 }
+{
+  Journal* expected = nullptr;
+  if (!active_.compare_exchange_strong(expected, this))
+  {
+    throw std::logic_error("Journal: Another journal is already recording.");
+  }
+  buffer_.reserve(SIZE_OF_BUFFER + 256);
+  buffer_.insert(buffer_.end(), MAGIC, MAGIC + sizeof(MAGIC));
+  buffer_.resize(buffer_.size() + sizeof(VERSION));
+  std::memcpy(buffer_.data() + sizeof(MAGIC), &VERSION, sizeof(VERSION));
+}
+
+klimchuk::Journal::~Journal()
+{
+  active_.store(nullptr, std::memory_order_release);
+  std::lock_guard<std::mutex> lock(mutex_);
+  stream_.write(buffer_.data(), buffer_.size());
+  stream_.flush();
+}
+
+uint64_t klimchuk::Journal::getIdentifier(const Shape& shape)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  const uint64_t identifier = identify(shape);
+  writeIfFull();
+  return identifier;
+}
+
+uint64_t klimchuk::Journal::getIdentifier(const Matrix& matrix)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  const uint64_t identifier = identify(matrix);
+  writeIfFull();
+  return identifier;
+}
+
+size_t klimchuk::Journal::getNumberOfRecords() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return numberOfRecords_;
+}
+
+void klimchuk::Journal::flush()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  stream_.write(buffer_.data(), buffer_.size());
+  stream_.flush();
+  buffer_.clear();
+  if (!stream_)
+  {
+    throw std::runtime_error("Journal: Can't write journal.");
+  }
+}
+
+void klimchuk::Journal::record(Operation operation, uint64_t identifier, double first, double second)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  writeOperation(operation);
+  writeVarint(identifier);
+  writeDouble(first);
+  if ((operation == Operation::MOVE_TO) || (operation == Operation::MOVE_BY))
+  {
+    writeDouble(second);
+  }
+  writeIfFull();
+}
+
+void klimchuk::Journal::record(Operation operation, uint64_t identifier, uint64_t other)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  writeOperation(operation);
+  writeVarint(identifier);
+  writeVarint(other);
+  writeIfFull();
+}
+
+void klimchuk::Journal::erase(const void* object)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::unordered_map<const void*, uint64_t>::iterator iterator = identifiers_.find(object);
+  if (iterator == identifiers_.end())
+  {
+    return;
+  }
+  writeOperation(Operation::FORGET);
+  writeVarint(iterator->second);
+  identifiers_.erase(iterator);
+  writeIfFull();
+}
+
+uint64_t klimchuk::Journal::identify(const Shape& shape)
+{
+  std::unordered_map<const void*, uint64_t>::const_iterator iterator = identifiers_.find(&shape);
+  if (iterator != identifiers_.end())
+  {
+    return iterator->second;
+  }
+  if (const CompositeShape* compositeShape = dynamic_cast<const CompositeShape*>(&shape))
+  {
+    size_t size = 0;
+    try
+    {
+      size = compositeShape->getSize();
+    }
+    catch (const std::domain_error&)
+    {}
+    std::vector<uint64_t> children(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+      children[i] = identify(*(*compositeShape)[i]);
+    }
+    writeOperation(Operation::COMPOSITE_SHAPE);
+    writeVarint(nextIdentifier_);
+    writeVarint(children.size());
+    for (uint64_t child : children)
+    {
+      writeVarint(child);
+    }
+  }
+  else if (const Circle* circle = dynamic_cast<const Circle*>(&shape))
+  {
+    writeOperation(Operation::CIRCLE);
+    writeVarint(nextIdentifier_);
+    writeDouble(circle->getCentre().x);
+    writeDouble(circle->getCentre().y);
+    writeDouble(circle->getRadius());
+  }
+  else if (const Rectangle* rectangle = dynamic_cast<const Rectangle*>(&shape))
+  {
+    const oriented_rectangle_t frame = rectangle->getOrientedFrameRect();
+    writeOperation(Operation::RECTANGLE);
+    writeVarint(nextIdentifier_);
+    writeDouble(frame.width);
+    writeDouble(frame.height);
+    writeDouble(frame.pos.x);
+    writeDouble(frame.pos.y);
+    writeDouble(frame.axis.x);
+    writeDouble(frame.axis.y);
+  }
+  else if (const Triangle* triangle = dynamic_cast<const Triangle*>(&shape))
+  {
+    writeOperation(Operation::TRIANGLE);
+    writeVarint(nextIdentifier_);
+    for (size_t i = 0; i < 3; ++i)
+    {
+      writeDouble((*triangle)[i].x);
+      writeDouble((*triangle)[i].y);
+    }
+  }
+  else if (const Polygon* polygon = dynamic_cast<const Polygon*>(&shape))
+  {
+    writeOperation(Operation::POLYGON);
+    writeVarint(nextIdentifier_);
+    writeVarint(polygon->getSize());
+    for (size_t i = 0; i < polygon->getSize(); ++i)
+    {
+      writeDouble((*polygon)[i].x);
+      writeDouble((*polygon)[i].y);
+    }
+  }
+  else
+  {
+    throw std::invalid_argument("Journal: Unsupported type of shape.");
+  }
+  identifiers_[&shape] = nextIdentifier_;
+  return nextIdentifier_++;
+}
+
+uint64_t klimchuk::Journal::identify(const Matrix& matrix)
+{
+  std::unordered_map<const void*, uint64_t>::const_iterator iterator = identifiers_.find(&matrix);
+  if (iterator != identifiers_.end())
+  {
+    return iterator->second;
+  }
+  std::vector<uint64_t> shapes(matrix.sizeOfMatrix_);
+  for (size_t i = 0; i < matrix.sizeOfMatrix_; ++i)
+  {
+    shapes[i] = identify(*matrix.shapes_[i]);
+  }
+  writeOperation(Operation::MATRIX);
+  writeVarint(nextIdentifier_);
+  writeVarint(static_cast<uint64_t>(matrix.mode_));
+  writeVarint(static_cast<uint64_t>(matrix.filter_));
+  writeVarint(shapes.size());
+  for (uint64_t shape : shapes)
+  {
+    writeVarint(shape);
+  }
+  identifiers_[&matrix] = nextIdentifier_;
+  return nextIdentifier_++;
+}
+
+void klimchuk::Journal::writeOperation(Operation operation)
+{
+  buffer_.push_back(static_cast<char>(operation));
+  ++numberOfRecords_;
+}
+
+void klimchuk::Journal::writeVarint(uint64_t value)
+{
+  while (value >= 0x80)
+  {
+    buffer_.push_back(static_cast<char>(value | 0x80));
+    value >>= 7;
+  }
+  buffer_.push_back(static_cast<char>(value));
+}
+
+void klimchuk::Journal::writeDouble(double value)
+{
+  char bytes[sizeof(double)];
+  std::memcpy(bytes, &value, sizeof(double));
+  buffer_.insert(buffer_.end(), bytes, bytes + sizeof(double));
+}
+
+void klimchuk::Journal::writeIfFull()
+{
+  if (buffer_.size() >= SIZE_OF_BUFFER)
+  {
+    stream_.write(buffer_.data(), buffer_.size());
+    buffer_.clear();
+  }
+}
+
+klimchuk::JournalPlayer::JournalPlayer(std::istream& stream):
+  stream_{ stream },
+  operation_{ Journal::Operation::FORGET },
+  identifier_{ 0 },
+  other_{ 0 },
+  arguments_{},
+  points_(),
+  identifiers_(),
+  shapes_(),
+  matrices_(),
+  numberOfRecords_{ 0 }
+{
+  char magic[sizeof(MAGIC)] = {};
+  uint32_t version = 0;
+  stream_.read(magic, sizeof(magic));
+  stream_.read(reinterpret_cast<char*>(&version), sizeof(version));
+  if (!stream_ || (std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) || (version != VERSION))
+  {
+    throw std::runtime_error("JournalPlayer: Invalid header of journal.");
+  }
+}
+
+klimchuk::JournalPlayer::~JournalPlayer() = default;
+
+bool klimchuk::JournalPlayer::read()
+{
+  const std::istream::int_type operation = stream_.get();
+  if (operation == std::istream::traits_type::eof())
+  {
+    return false;
+  }
+  if (operation > static_cast<std::istream::int_type>(Journal::Operation::MATRIX_UPDATE))
+  {
+    throw std::runtime_error("JournalPlayer: Unknown operation.");
+  }
+  operation_ = static_cast<Journal::Operation>(operation);
+  identifier_ = readVarint();
+  switch (operation_)
+  {
+  case Journal::Operation::CIRCLE:
+  case Journal::Operation::SCALE:
+  case Journal::Operation::ROTATE:
+  case Journal::Operation::MOVE_TO:
+  case Journal::Operation::MOVE_BY:
+  case Journal::Operation::RECTANGLE:
+  case Journal::Operation::TRIANGLE:
+  {
+    const size_t numberOfArguments = (operation_ == Journal::Operation::CIRCLE) ? 3
+        : ((operation_ == Journal::Operation::SCALE) || (operation_ == Journal::Operation::ROTATE)) ? 1
+        : ((operation_ == Journal::Operation::MOVE_TO) || (operation_ == Journal::Operation::MOVE_BY)) ? 2 : 6;
+    for (size_t i = 0; i < numberOfArguments; ++i)
+    {
+      arguments_[i] = readDouble();
+    }
+    break;
+  }
+  case Journal::Operation::POLYGON:
+    points_.resize(readVarint());
+    for (point_t& point : points_)
+    {
+      point.x = readDouble();
+      point.y = readDouble();
+    }
+    break;
+  case Journal::Operation::MATRIX:
+    arguments_[0] = static_cast<double>(readVarint());
+    arguments_[1] = static_cast<double>(readVarint());
+    [[fallthrough]];
+  case Journal::Operation::COMPOSITE_SHAPE:
+    identifiers_.resize(readVarint());
+    for (uint64_t& identifier : identifiers_)
+    {
+      identifier = readVarint();
+    }
+    break;
+  case Journal::Operation::ADD:
+  case Journal::Operation::REMOVE:
+  case Journal::Operation::MATRIX_ADD:
+  case Journal::Operation::MATRIX_REMOVE:
+  case Journal::Operation::MATRIX_UPDATE:
+    other_ = readVarint();
+    break;
+  case Journal::Operation::FORGET:
+    break;
+  }
+  ++numberOfRecords_;
+  return true;
+}
+
+void klimchuk::JournalPlayer::execute()
+{
+  switch (operation_)
+  {
+  case Journal::Operation::CIRCLE:
+    shapes_[identifier_] = std::make_shared<Circle>(arguments_[0], arguments_[1], arguments_[2]);
+    break;
+  case Journal::Operation::RECTANGLE:
+  {
+    std::shared_ptr<Shape> rectangle = std::make_shared<Rectangle>(arguments_[0], arguments_[1], arguments_[2],
+        arguments_[3]);
+    rectangle->rotate(std::atan2(arguments_[5], arguments_[4]) * 180 / M_PI);
+    shapes_[identifier_] = rectangle;
+    break;
+  }
+  case Journal::Operation::TRIANGLE:
+    shapes_[identifier_] = std::make_shared<Triangle>(point_t{ arguments_[0], arguments_[1] },
+        point_t{ arguments_[2], arguments_[3] }, point_t{ arguments_[4], arguments_[5] });
+    break;
+  case Journal::Operation::POLYGON:
+    shapes_[identifier_] = std::make_shared<Polygon>(points_.data(), points_.size());
+    break;
+  case Journal::Operation::COMPOSITE_SHAPE:
+  {
+    if (identifiers_.empty())
+    {
+      shapes_[identifier_] = std::shared_ptr<CompositeShape>(new CompositeShape());
+      break;
+    }
+    std::shared_ptr<CompositeShape> compositeShape = std::make_shared<CompositeShape>(getShape(identifiers_[0]));
+    for (size_t i = 1; i < identifiers_.size(); ++i)
+    {
+      compositeShape->add(getShape(identifiers_[i]));
+    }
+    shapes_[identifier_] = compositeShape;
+    break;
+  }
+  case Journal::Operation::MATRIX:
+  {
+    std::unique_ptr<Matrix> matrix = std::make_unique<Matrix>(static_cast<Matrix::Mode>(arguments_[0]),
+        static_cast<Matrix::Filter>(arguments_[1]));
+    for (uint64_t identifier : identifiers_)
+    {
+      matrix->add(getShape(identifier));
+    }
+    matrices_[identifier_] = std::move(matrix);
+    break;
+  }
+  case Journal::Operation::FORGET:
+    shapes_.erase(identifier_);
+    matrices_.erase(identifier_);
+    break;
+  case Journal::Operation::MOVE_TO:
+    getShape(identifier_)->move(point_t{ arguments_[0], arguments_[1] });
+    break;
+  case Journal::Operation::MOVE_BY:
+    getShape(identifier_)->move(arguments_[0], arguments_[1]);
+    break;
+  case Journal::Operation::SCALE:
+    getShape(identifier_)->scale(arguments_[0]);
+    break;
+  case Journal::Operation::ROTATE:
+    getShape(identifier_)->rotate(arguments_[0]);
+    break;
+  case Journal::Operation::ADD:
+  case Journal::Operation::REMOVE:
+  {
+    std::shared_ptr<CompositeShape> compositeShape = std::dynamic_pointer_cast<CompositeShape>(getShape(identifier_));
+    if (!compositeShape)
+    {
+      throw std::runtime_error("JournalPlayer: Shape is not composite.");
+    }
+    if (operation_ == Journal::Operation::ADD)
+    {
+      compositeShape->add(getShape(other_));
+    }
+    else
+    {
+      compositeShape->remove(other_);
+    }
+    break;
+  }
+  case Journal::Operation::MATRIX_ADD:
+    findMatrix(identifier_).add(getShape(other_));
+    break;
+  case Journal::Operation::MATRIX_REMOVE:
+    findMatrix(identifier_).remove(getShape(other_));
+    break;
+  case Journal::Operation::MATRIX_UPDATE:
+    findMatrix(identifier_).update(getShape(other_));
+    break;
+  }
+}
+
+klimchuk::Journal::Operation klimchuk::JournalPlayer::getOperation() const
+{
+  return operation_;
+}
+
+size_t klimchuk::JournalPlayer::getNumberOfRecords() const
+{
+  return numberOfRecords_;
+}
+
+std::shared_ptr<klimchuk::Shape> klimchuk::JournalPlayer::getShape(uint64_t identifier) const
+{
+  std::unordered_map<uint64_t, std::shared_ptr<Shape>>::const_iterator iterator = shapes_.find(identifier);
+  if (iterator == shapes_.end())
+  {
+    throw std::runtime_error("JournalPlayer: Unknown shape.");
+  }
+  return iterator->second;
+}
+
+const klimchuk::Matrix& klimchuk::JournalPlayer::getMatrix(uint64_t identifier) const
+{
+  return findMatrix(identifier);
+}
+
+uint64_t klimchuk::JournalPlayer::readVarint()
+{
+  uint64_t value = 0;
+  for (unsigned int shift = 0; shift < 64; shift += 7)
+  {
+    const std::istream::int_type byte = stream_.get();
+    if (byte == std::istream::traits_type::eof())
+    {
+      break;
+    }
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0)
+    {
+      return value;
+    }
+  }
+  throw std::runtime_error("JournalPlayer: Journal is truncated.");
+}
+
+double klimchuk::JournalPlayer::readDouble()
+{
+  double value = 0.0;
+  if (!stream_.read(reinterpret_cast<char*>(&value), sizeof(value)))
+  {
+    throw std::runtime_error("JournalPlayer: Journal is truncated.");
+  }
+  return value;
+}
+
+klimchuk::Matrix& klimchuk::JournalPlayer::findMatrix(uint64_t identifier) const
+{
+  std::unordered_map<uint64_t, std::unique_ptr<Matrix>>::const_iterator iterator = matrices_.find(identifier);
+  if (iterator == matrices_.end())
+  {
+    throw std::runtime_error("JournalPlayer: Unknown matrix.");
+  }
+  return *iterator->second;
+}
@@ -0,0 +1,228 @@
+#ifndef KLIMCHUK_JOURNAL
+#define KLIMCHUK_JOURNAL
+
+#include <cstdint>
+#include <exception>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <istream>
+#include <ostream>
+#include <vector>
+#include <unordered_map>
+#include "base-types.hpp"
+
+namespace klimchuk
+{
+  class Shape;
+  class Matrix;
+
+  class Journal
+  {
+  public:
+    enum class Operation : uint8_t
+    {
+      CIRCLE,
+      RECTANGLE,
+      TRIANGLE,
+      POLYGON,
+      COMPOSITE_SHAPE,
+      MATRIX,
+      FORGET,
+      MOVE_TO,
+      MOVE_BY,
+      SCALE,
+      ROTATE,
+      ADD,
+      REMOVE,
+      MATRIX_ADD,
+      MATRIX_REMOVE,
+      MATRIX_UPDATE
+    };
+
+    class Scope
+    {
+    public:
+      Scope(Operation operation, const Shape& shape, double first, double second = 0.0);
+      Scope(Operation operation, const Shape& compositeShape, size_t index);
+      Scope(Operation operation, const Shape& compositeShape, const std::shared_ptr<Shape>& shape);
+      Scope(Operation operation, const Matrix& matrix, const std::shared_ptr<Shape>& shape);
+      Scope(const Scope& rhs) = delete;
+      ~Scope();
+
+      Scope& operator=(const Scope& rhs) = delete;
+    private:
+      Journal* journal_;
+      bool isRecording_;
+      int numberOfExceptions_;
+      Operation operation_;
+      uint64_t identifier_;
+      uint64_t other_;
+      double first_;
+      double second_;
+    };
+
+    explicit Journal(std::ostream& stream);
+    Journal(const Journal& rhs) = delete;
+    ~Journal();
+
+    Journal& operator=(const Journal& rhs) = delete;
+
+    uint64_t getIdentifier(const Shape& shape);
+    uint64_t getIdentifier(const Matrix& matrix);
+    size_t getNumberOfRecords() const;
+    void flush();
+
+    static Journal* getActive();
+    static void forget(const void* object);
+  private:
+    static std::atomic<Journal*> active_;
+    static thread_local size_t depth_;
+
+    std::ostream& stream_;
+    mutable std::mutex mutex_;
+    std::vector<char> buffer_;
+    std::unordered_map<const void*, uint64_t> identifiers_;
+    uint64_t nextIdentifier_;
+    size_t numberOfRecords_;
+
+    void record(Operation operation, uint64_t identifier, double first, double second);
+    void record(Operation operation, uint64_t identifier, uint64_t other);
+    void erase(const void* object);
+    uint64_t identify(const Shape& shape);
+    uint64_t identify(const Matrix& matrix);
+    void writeOperation(Operation operation);
+    void writeVarint(uint64_t value);
+    void writeDouble(double value);
+    void writeIfFull();
+  };
+
+  class JournalPlayer
+  {
+  public:
+    explicit JournalPlayer(std::istream& stream);
+    ~JournalPlayer();
+
+    bool read();
+    void execute();
+    Journal::Operation getOperation() const;
+    size_t getNumberOfRecords() const;
+    std::shared_ptr<Shape> getShape(uint64_t identifier) const;
+    const Matrix& getMatrix(uint64_t identifier) const;
+  private:
+    std::istream& stream_;
+    Journal::Operation operation_;
+    uint64_t identifier_;
+    uint64_t other_;
+    double arguments_[6];
+    std::vector<point_t> points_;
+    std::vector<uint64_t> identifiers_;
+    std::unordered_map<uint64_t, std::shared_ptr<Shape>> shapes_;
+    std::unordered_map<uint64_t, std::unique_ptr<Matrix>> matrices_;
+    size_t numberOfRecords_;
+
+    uint64_t readVarint();
+    double readDouble();
+    Matrix& findMatrix(uint64_t identifier) const;
+  };
+}
+
+inline klimchuk::Journal* klimchuk::Journal::getActive()
+{
+  return active_.load(std::memory_order_acquire);
+}
+
+inline void klimchuk::Journal::forget(const void* object)
+{
+  if (Journal* journal = getActive())
+  {
+    journal->erase(object);
+  }
+}
+
+inline klimchuk::Journal::Scope::Scope(Operation operation, const Shape& shape, double first, double second):
+  journal_{ getActive() },
+  isRecording_{ journal_ && (depth_ == 0) },
+  numberOfExceptions_{ std::uncaught_exceptions() },
+  operation_{ operation },
+  identifier_{ isRecording_ ? journal_->getIdentifier(shape) : 0 },
+  other_{ 0 },
+  first_{ first },
+  second_{ second }
+{
+  if (journal_)
+  {
+    ++depth_;
+  }
+}
+
+inline klimchuk::Journal::Scope::Scope(Operation operation, const Shape& compositeShape, size_t index):
+  journal_{ getActive() },
+  isRecording_{ journal_ && (depth_ == 0) },
+  numberOfExceptions_{ std::uncaught_exceptions() },
+  operation_{ operation },
+  identifier_{ isRecording_ ? journal_->getIdentifier(compositeShape) : 0 },
+  other_{ index },
+  first_{ 0.0 },
+  second_{ 0.0 }
+{
+  if (journal_)
+  {
+    ++depth_;
+  }
+}
+
+inline klimchuk::Journal::Scope::Scope(Operation operation, const Shape& compositeShape,
+    const std::shared_ptr<Shape>& shape):
+  journal_{ getActive() },
+  isRecording_{ journal_ && (depth_ == 0) && shape },
+  numberOfExceptions_{ std::uncaught_exceptions() },
+  operation_{ operation },
+  identifier_{ isRecording_ ? journal_->getIdentifier(compositeShape) : 0 },
+  other_{ isRecording_ ? journal_->getIdentifier(*shape) : 0 },
+  first_{ 0.0 },
+  second_{ 0.0 }
+{
+  if (journal_)
+  {
+    ++depth_;
+  }
+}
+
+inline klimchuk::Journal::Scope::Scope(Operation operation, const Matrix& matrix, const std::shared_ptr<Shape>& shape):
+  journal_{ getActive() },
+  isRecording_{ journal_ && (depth_ == 0) && shape },
+  numberOfExceptions_{ std::uncaught_exceptions() },
+  operation_{ operation },
+  identifier_{ isRecording_ ? journal_->getIdentifier(matrix) : 0 },
+  other_{ isRecording_ ? journal_->getIdentifier(*shape) : 0 },
+  first_{ 0.0 },
+  second_{ 0.0 }
+{
+  if (journal_)
+  {
+    ++depth_;
+  }
+}
+
+inline klimchuk::Journal::Scope::~Scope()
+{
+  if (journal_)
+  {
+    --depth_;
+  }
+  if (isRecording_ && (std::uncaught_exceptions() == numberOfExceptions_))
+  {
+    if ((operation_ == Operation::ADD) || (operation_ == Operation::REMOVE) || (operation_ == Operation::MATRIX_ADD)
+        || (operation_ == Operation::MATRIX_REMOVE) || (operation_ == Operation::MATRIX_UPDATE))
+    {
+      journal_->record(operation_, identifier_, other_);
+    }
+    else
+    {
+      journal_->record(operation_, identifier_, first_, second_);
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,255 @@
+#include "layer-generator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cfloat>
+
+namespace
+{
+  const size_t NUMBER_OF_SHAPES_BETWEEN_CHECKS = 32;
+  const double MAX_CELLS_OF_SHAPE = 16.0;
+  const double CELLS_PER_SHAPE = 4.0;
+  const double SHARE_OF_OUTLIERS = 0.01;
+
+  double getQuantile(std::vector<double>& values, double share)
+  {
+    std::vector<double>::iterator quantile = values.begin() + static_cast<size_t>(share * (values.size() - 1));
+    std::nth_element(values.begin(), quantile, values.end());
+    return *quantile;
+  }
+
+  size_t clamp(double index, size_t numberOfCells)
+  {
+    return static_cast<size_t>(std::min(std::max(index, 0.0), static_cast<double>(numberOfCells - 1)));
+  }
+}
+
+klimchuk::LayerGenerator::LayerGenerator(CompositeShape& compositeShape, Matrix::Filter filter):
+  filter_{ filter },
+  origin_{ 0.0, 0.0 },
+  sizeOfCell_{ 0.0 },
+  numberOfColumns_{ 1 },
+  numberOfRows_{ 1 },
+  position_{ 0 },
+  numberOfLayers_{ 0 }
+{
+  const size_t numberOfShapes = compositeShape.getSize();
+  shapes_.reserve(numberOfShapes);
+  frames_.reserve(numberOfShapes);
+  remaining_.reserve(numberOfShapes);
+  if (filter_ == Matrix::Filter::ORIENTED_FRAME)
+  {
+    orientedFrames_.reserve(numberOfShapes);
+  }
+  std::vector<double> abscissas;
+  std::vector<double> ordinates;
+  for (size_t i = 0; i < numberOfShapes; ++i)
+  {
+    shapes_.push_back(compositeShape[i]);
+    frames_.push_back(shapes_[i]->getFrameRect());
+    if (filter_ == Matrix::Filter::ORIENTED_FRAME)
+    {
+      orientedFrames_.push_back(shapes_[i]->getOrientedFrameRect());
+    }
+    const rectangle_t& frame = frames_[i];
+    if (std::isfinite(frame.pos.x) && std::isfinite(frame.pos.y) && std::isfinite(frame.width)
+      && std::isfinite(frame.height))
+    {
+      abscissas.push_back(frame.pos.x);
+      ordinates.push_back(frame.pos.y);
+      sizeOfCell_ += std::max(frame.width, frame.height);
+    }
+    remaining_.push_back(i);
+  }
+  if (abscissas.empty())
+  {
+    return;
+  }
+  sizeOfCell_ /= abscissas.size();
+  if (!(sizeOfCell_ > 0.0))
+  {
+    sizeOfCell_ = 1.0;
+  }
+  origin_ = { getQuantile(abscissas, SHARE_OF_OUTLIERS), getQuantile(ordinates, SHARE_OF_OUTLIERS) };
+  const double width = getQuantile(abscissas, 1.0 - SHARE_OF_OUTLIERS) - origin_.x;
+  const double height = getQuantile(ordinates, 1.0 - SHARE_OF_OUTLIERS) - origin_.y;
+  while ((width / sizeOfCell_ + 1) * (height / sizeOfCell_ + 1) > CELLS_PER_SHAPE * numberOfShapes)
+  {
+    sizeOfCell_ *= 2;
+  }
+  numberOfColumns_ = static_cast<size_t>(width / sizeOfCell_) + 1;
+  numberOfRows_ = static_cast<size_t>(height / sizeOfCell_) + 1;
+  cells_.resize(numberOfColumns_ * numberOfRows_);
+}
+
+klimchuk::LayerGenerator::Status klimchuk::LayerGenerator::resume(std::vector<Shape::ShapePtr>& layer,
+  Clock::duration budget)
+{
+  const Clock::time_point now = Clock::now();
+  if (budget >= Clock::time_point::max() - now)
+  {
+    return advance(layer, false, now);
+  }
+  return advance(layer, true, now + std::max(budget, Clock::duration::zero()));
+}
+
+bool klimchuk::LayerGenerator::next(std::vector<Shape::ShapePtr>& layer)
+{
+  return advance(layer, false, Clock::time_point()) == Status::LAYER;
+}
+
+bool klimchuk::LayerGenerator::isFinished() const
+{
+  return remaining_.empty();
+}
+
+size_t klimchuk::LayerGenerator::getNumberOfLayers() const
+{
+  return numberOfLayers_;
+}
+
+size_t klimchuk::LayerGenerator::getNumberOfRemainingShapes() const
+{
+  return remaining_.size();
+}
+
+klimchuk::Matrix::Filter klimchuk::LayerGenerator::getFilter() const
+{
+  return filter_;
+}
+
+klimchuk::LayerGenerator::Status klimchuk::LayerGenerator::advance(std::vector<Shape::ShapePtr>& layer,
+  bool hasDeadline, const Clock::time_point& deadline)
+{
+  if (remaining_.empty())
+  {
+    return Status::FINISHED;
+  }
+  size_t numberOfProcessed = 0;
+  while (position_ < remaining_.size())
+  {
+    if (hasDeadline && (numberOfProcessed != 0) && (numberOfProcessed % NUMBER_OF_SHAPES_BETWEEN_CHECKS == 0)
+      && (Clock::now() >= deadline))
+    {
+      return Status::SUSPENDED;
+    }
+    const size_t index = remaining_[position_];
+    if (isBlocked(index))
+    {
+      deferred_.push_back(index);
+    }
+    else
+    {
+      accepted_.push_back(index);
+    }
+    insert(index);
+    ++position_;
+    ++numberOfProcessed;
+  }
+  finishLayer(layer);
+  return Status::LAYER;
+}
+
+bool klimchuk::LayerGenerator::getCells(size_t index, size_t& minColumn, size_t& minRow, size_t& maxColumn,
+  size_t& maxRow) const
+{
+  if (cells_.empty())
+  {
+    return false;
+  }
+  const rectangle_t& frame = frames_[index];
+  const double halfWidth = frame.width / 2 + 8 * DBL_EPSILON * (std::abs(frame.pos.x) + frame.width);
+  const double halfHeight = frame.height / 2 + 8 * DBL_EPSILON * (std::abs(frame.pos.y) + frame.height);
+  const double left = std::floor((frame.pos.x - halfWidth - origin_.x) / sizeOfCell_);
+  const double right = std::floor((frame.pos.x + halfWidth - origin_.x) / sizeOfCell_);
+  const double bottom = std::floor((frame.pos.y - halfHeight - origin_.y) / sizeOfCell_);
+  const double top = std::floor((frame.pos.y + halfHeight - origin_.y) / sizeOfCell_);
+  if (!std::isfinite(left) || !std::isfinite(right) || !std::isfinite(bottom) || !std::isfinite(top))
+  {
+    return false;
+  }
+  minColumn = clamp(left, numberOfColumns_);
+  maxColumn = clamp(right, numberOfColumns_);
+  minRow = clamp(bottom, numberOfRows_);
+  maxRow = clamp(top, numberOfRows_);
+  return static_cast<double>(maxColumn - minColumn + 1) * (maxRow - minRow + 1) <= MAX_CELLS_OF_SHAPE;
+}
+
+bool klimchuk::LayerGenerator::isBlocked(size_t index) const
+{
+  auto areIntersecting = [this, index](size_t other)
+  {
+    return areShapesIntersect(frames_[index], frames_[other])
+      && ((filter_ == Matrix::Filter::FRAME) || areShapesIntersect(orientedFrames_[index], orientedFrames_[other]));
+  };
+  size_t minColumn = 0;
+  size_t minRow = 0;
+  size_t maxColumn = 0;
+  size_t maxRow = 0;
+  if (!getCells(index, minColumn, minRow, maxColumn, maxRow))
+  {
+    return std::any_of(remaining_.begin(), remaining_.begin() + position_, areIntersecting);
+  }
+  if (std::any_of(largeShapes_.begin(), largeShapes_.end(), areIntersecting))
+  {
+    return true;
+  }
+  for (size_t row = minRow; row <= maxRow; ++row)
+  {
+    for (size_t column = minColumn; column <= maxColumn; ++column)
+    {
+      const std::vector<size_t>& cell = cells_[row * numberOfColumns_ + column];
+      if (std::any_of(cell.begin(), cell.end(), areIntersecting))
+      {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void klimchuk::LayerGenerator::insert(size_t index)
+{
+  size_t minColumn = 0;
+  size_t minRow = 0;
+  size_t maxColumn = 0;
+  size_t maxRow = 0;
+  if (!getCells(index, minColumn, minRow, maxColumn, maxRow))
+  {
+    largeShapes_.push_back(index);
+    return;
+  }
+  for (size_t row = minRow; row <= maxRow; ++row)
+  {
+    for (size_t column = minColumn; column <= maxColumn; ++column)
+    {
+      std::vector<size_t>& cell = cells_[row * numberOfColumns_ + column];
+      if (cell.empty())
+      {
+        usedCells_.push_back(row * numberOfColumns_ + column);
+      }
+      cell.push_back(index);
+    }
+  }
+}
+
+void klimchuk::LayerGenerator::finishLayer(std::vector<Shape::ShapePtr>& layer)
+{
+  layer.clear();
+  layer.reserve(accepted_.size());
+  for (size_t index : accepted_)
+  {
+    layer.push_back(shapes_[index]);
+    shapes_[index].reset();
+  }
+  accepted_.clear();
+  remaining_.swap(deferred_);
+  deferred_.clear();
+  position_ = 0;
+  for (size_t cell : usedCells_)
+  {
+    cells_[cell].clear();
+  }
+  usedCells_.clear();
+  largeShapes_.clear();
+  ++numberOfLayers_;
+}
@@ -0,0 +1,59 @@
+#ifndef KLIMCHUK_LAYER_GENERATOR
+#define KLIMCHUK_LAYER_GENERATOR
+
+#include <vector>
+#include <chrono>
+#include "shape.hpp"
+#include "matrix.hpp"
+#include "composite-shape.hpp"
+
+namespace klimchuk
+{
+  class LayerGenerator
+  {
+  public:
+    typedef std::chrono::steady_clock Clock;
+
+    enum class Status
+    {
+      LAYER,
+      SUSPENDED,
+      FINISHED
+    };
+
+    LayerGenerator(CompositeShape& compositeShape, Matrix::Filter filter = Matrix::Filter::FRAME);
+
+    Status resume(std::vector<Shape::ShapePtr>& layer, Clock::duration budget);
+    bool next(std::vector<Shape::ShapePtr>& layer);
+
+    bool isFinished() const;
+    size_t getNumberOfLayers() const;
+    size_t getNumberOfRemainingShapes() const;
+    Matrix::Filter getFilter() const;
+  private:
+    Matrix::Filter filter_;
+    std::vector<Shape::ShapePtr> shapes_;
+    std::vector<rectangle_t> frames_;
+    std::vector<oriented_rectangle_t> orientedFrames_;
+    point_t origin_;
+    double sizeOfCell_;
+    size_t numberOfColumns_;
+    size_t numberOfRows_;
+    std::vector<size_t> remaining_;
+    std::vector<size_t> deferred_;
+    size_t position_;
+    std::vector<size_t> accepted_;
+    std::vector<std::vector<size_t>> cells_;
+    std::vector<size_t> usedCells_;
+    std::vector<size_t> largeShapes_;
+    size_t numberOfLayers_;
+
+    Status advance(std::vector<Shape::ShapePtr>& layer, bool hasDeadline, const Clock::time_point& deadline);
+    bool getCells(size_t index, size_t& minColumn, size_t& minRow, size_t& maxColumn, size_t& maxRow) const;
+    bool isBlocked(size_t index) const;
+    void insert(size_t index);
+    void finishLayer(std::vector<Shape::ShapePtr>& layer);
+  };
+}
+
+#endif
@@ -0,0 +1,421 @@
+#include "mapped-scene.hpp"
+#include <stdexcept>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "circle.hpp"
+#include "rectangle.hpp"
+#include "triangle.hpp"
+#include "polygon.hpp"
+
+namespace
+{
+  const char MAGIC[8] = { 'K', 'L', 'S', 'C', 'E', 'N', 'E', '\0' };
+  const uint32_t VERSION = 1;
+  const uint32_t BYTE_ORDER_MARK = 0x01020304;
+  const size_t ALIGNMENT = 64;
+
+  size_t align(size_t offset)
+  {
+    return (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+  }
+}
+
+void klimchuk::writeScene(std::ostream& stream, const CompositeShape& compositeShape, const Matrix* matrix)
+{
+  std::vector<MappedScene::record_t> records;
+  std::vector<circle_t> circles;
+  std::vector<oriented_rectangle_t> rectangles;
+  std::vector<uint64_t> outlineBeginnings{ 0 };
+  std::vector<point_t> points;
+  std::unordered_map<const Shape*, uint64_t> indexes;
+  auto addShape = [&](const Shape::ConstShapePtr& shape, uint64_t parent, auto& addChild) -> void
+  {
+    const uint64_t index = records.size();
+    records.push_back(MappedScene::record_t{ MappedScene::Type::COMPOSITE, 0, parent, 0 });
+    if (const CompositeShape* group = dynamic_cast<const CompositeShape*>(shape.get()))
+    {
+      for (size_t i = 0; i < group->getSize(); ++i)
+      {
+        addChild((*group)[i], index, addChild);
+      }
+      records[index].index = records.size();
+    }
+    else if (const Circle* circle = dynamic_cast<const Circle*>(shape.get()))
+    {
+      records[index].type = MappedScene::Type::CIRCLE;
+      records[index].index = circles.size();
+      circles.push_back(circle_t{ circle->getCentre(), circle->getRadius() });
+    }
+    else if (const Rectangle* rectangle = dynamic_cast<const Rectangle*>(shape.get()))
+    {
+      records[index].type = MappedScene::Type::RECTANGLE;
+      records[index].index = rectangles.size();
+      rectangles.push_back(rectangle->getOrientedFrameRect());
+    }
+    else if (const Triangle* triangle = dynamic_cast<const Triangle*>(shape.get()))
+    {
+      records[index].type = MappedScene::Type::TRIANGLE;
+      records[index].index = outlineBeginnings.size() - 1;
+      points.insert(points.end(), { (*triangle)[0], (*triangle)[1], (*triangle)[2] });
+      outlineBeginnings.push_back(points.size());
+    }
+    else if (const Polygon* polygon = dynamic_cast<const Polygon*>(shape.get()))
+    {
+      records[index].type = MappedScene::Type::POLYGON;
+      records[index].index = outlineBeginnings.size() - 1;
+      for (size_t i = 0; i < polygon->getSize(); ++i)
+      {
+        points.push_back((*polygon)[i]);
+      }
+      outlineBeginnings.push_back(points.size());
+    }
+    else
+    {
+      throw std::invalid_argument("writeScene: Unsupported type of shape.");
+    }
+  };
+  for (size_t i = 0; i < compositeShape.getSize(); ++i)
+  {
+    indexes[compositeShape[i].get()] = records.size();
+    addShape(compositeShape[i], MappedScene::NO_PARENT, addShape);
+  }
+
+  std::vector<uint64_t> layerBeginnings{ 0 };
+  std::vector<uint64_t> layerShapes;
+  if (matrix)
+  {
+    for (size_t i = 0; i < matrix->getNumberOFLayers(); ++i)
+    {
+      for (size_t j = 0; j < matrix->getSizeOfLayer(i); ++j)
+      {
+        std::unordered_map<const Shape*, uint64_t>::const_iterator index = indexes.find((*matrix)[i][j].get());
+        if (index == indexes.end())
+        {
+          throw std::invalid_argument("writeScene: Matrix contains shape which is not in scene.");
+        }
+        layerShapes.push_back(index->second);
+      }
+      layerBeginnings.push_back(layerShapes.size());
+    }
+  }
+
+  MappedScene::header_t header{};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.byteOrder = BYTE_ORDER_MARK;
+  header.numberOfRecords = records.size();
+  header.numberOfCircles = circles.size();
+  header.numberOfRectangles = rectangles.size();
+  header.numberOfOutlines = outlineBeginnings.size() - 1;
+  header.numberOfPoints = points.size();
+  header.numberOfLayers = layerBeginnings.size() - 1;
+  header.sizeOfMatrix = layerShapes.size();
+  const std::pair<const void*, size_t> sections[7] = { { records.data(), records.size() * sizeof(MappedScene::record_t) },
+    { circles.data(), circles.size() * sizeof(circle_t) },
+    { rectangles.data(), rectangles.size() * sizeof(oriented_rectangle_t) },
+    { outlineBeginnings.data(), outlineBeginnings.size() * sizeof(uint64_t) },
+    { points.data(), points.size() * sizeof(point_t) },
+    { layerBeginnings.data(), layerBeginnings.size() * sizeof(uint64_t) },
+    { layerShapes.data(), layerShapes.size() * sizeof(uint64_t) } };
+  size_t offset = align(sizeof(header));
+  for (size_t i = 0; i < 7; ++i)
+  {
+    header.offsets[i] = offset;
+    offset = align(offset + sections[i].second);
+  }
+
+  const char padding[ALIGNMENT] = {};
+  stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  offset = sizeof(header);
+  for (size_t i = 0; i < 7; ++i)
+  {
+    stream.write(padding, header.offsets[i] - offset);
+    stream.write(static_cast<const char*>(sections[i].first), sections[i].second);
+    offset = header.offsets[i] + sections[i].second;
+  }
+  stream.write(padding, align(offset) - offset);
+  if (!stream)
+  {
+    throw std::runtime_error("writeScene: Can't write scene.");
+  }
+}
+
+klimchuk::MappedScene::MappedScene(const std::string& path):
+  data_{ nullptr },
+  sizeOfData_{ 0 },
+  header_{ nullptr },
+  records_{ nullptr },
+  circles_{ nullptr },
+  rectangles_{ nullptr },
+  outlineBeginnings_{ nullptr },
+  points_{ nullptr },
+  layerBeginnings_{ nullptr },
+  layerShapes_{ nullptr }
+{
+  const int file = ::open(path.c_str(), O_RDONLY);
+  if (file < 0)
+  {
+    throw std::runtime_error("MappedScene: Can't open file.");
+  }
+  struct stat status;
+  if ((::fstat(file, &status) != 0) || (static_cast<size_t>(status.st_size) < sizeof(header_t)))
+  {
+    ::close(file);
+    throw std::runtime_error("MappedScene: File is not a scene.");
+  }
+  sizeOfData_ = status.st_size;
+  data_ = ::mmap(nullptr, sizeOfData_, PROT_READ, MAP_PRIVATE, file, 0);
+  ::close(file);
+  if (data_ == MAP_FAILED)
+  {
+    data_ = nullptr;
+    throw std::runtime_error("MappedScene: Can't map file.");
+  }
+
+  const char* bytes = static_cast<const char*>(data_);
+  header_ = reinterpret_cast<const header_t*>(bytes);
+  bool isValid = (std::memcmp(header_->magic, MAGIC, sizeof(MAGIC)) == 0) && (header_->version == VERSION)
+      && (header_->byteOrder == BYTE_ORDER_MARK) && (header_->numberOfOutlines < sizeOfData_ / sizeof(uint64_t))
+      && (header_->numberOfLayers < sizeOfData_ / sizeof(uint64_t));
+  const size_t sizes[7][2] = { { header_->numberOfRecords, sizeof(record_t) },
+    { header_->numberOfCircles, sizeof(circle_t) },
+    { header_->numberOfRectangles, sizeof(oriented_rectangle_t) },
+    { header_->numberOfOutlines + 1, sizeof(uint64_t) },
+    { header_->numberOfPoints, sizeof(point_t) },
+    { header_->numberOfLayers + 1, sizeof(uint64_t) },
+    { header_->sizeOfMatrix, sizeof(uint64_t) } };
+  for (size_t i = 0; isValid && (i < 7); ++i)
+  {
+    const uint64_t offset = header_->offsets[i];
+    isValid = (offset % ALIGNMENT == 0) && (offset <= sizeOfData_) && (sizes[i][0] <= (sizeOfData_ - offset) / sizes[i][1]);
+  }
+  if (!isValid)
+  {
+    ::munmap(data_, sizeOfData_);
+    throw std::runtime_error("MappedScene: File is not a scene.");
+  }
+  records_ = reinterpret_cast<const record_t*>(bytes + header_->offsets[0]);
+  circles_ = reinterpret_cast<const circle_t*>(bytes + header_->offsets[1]);
+  rectangles_ = reinterpret_cast<const oriented_rectangle_t*>(bytes + header_->offsets[2]);
+  outlineBeginnings_ = reinterpret_cast<const uint64_t*>(bytes + header_->offsets[3]);
+  points_ = reinterpret_cast<const point_t*>(bytes + header_->offsets[4]);
+  layerBeginnings_ = reinterpret_cast<const uint64_t*>(bytes + header_->offsets[5]);
+  layerShapes_ = reinterpret_cast<const uint64_t*>(bytes + header_->offsets[6]);
+  if ((outlineBeginnings_[header_->numberOfOutlines] != header_->numberOfPoints)
+      || (layerBeginnings_[header_->numberOfLayers] != header_->sizeOfMatrix))
+  {
+    ::munmap(data_, sizeOfData_);
+    throw std::runtime_error("MappedScene: File is not a scene.");
+  }
+}
+
+klimchuk::MappedScene::MappedScene(MappedScene&& rhs) noexcept:
+  data_{ rhs.data_ },
+  sizeOfData_{ rhs.sizeOfData_ },
+  header_{ rhs.header_ },
+  records_{ rhs.records_ },
+  circles_{ rhs.circles_ },
+  rectangles_{ rhs.rectangles_ },
+  outlineBeginnings_{ rhs.outlineBeginnings_ },
+  points_{ rhs.points_ },
+  layerBeginnings_{ rhs.layerBeginnings_ },
+  layerShapes_{ rhs.layerShapes_ }
+{
+  rhs.data_ = nullptr;
+  rhs.sizeOfData_ = 0;
+}
+
+klimchuk::MappedScene::~MappedScene()
+{
+  if (data_)
+  {
+    ::munmap(data_, sizeOfData_);
+  }
+}
+
+klimchuk::MappedScene& klimchuk::MappedScene::operator=(MappedScene&& rhs) noexcept
+{
+  if (this != &rhs)
+  {
+    std::swap(data_, rhs.data_);
+    std::swap(sizeOfData_, rhs.sizeOfData_);
+    std::swap(header_, rhs.header_);
+    std::swap(records_, rhs.records_);
+    std::swap(circles_, rhs.circles_);
+    std::swap(rectangles_, rhs.rectangles_);
+    std::swap(outlineBeginnings_, rhs.outlineBeginnings_);
+    std::swap(points_, rhs.points_);
+    std::swap(layerBeginnings_, rhs.layerBeginnings_);
+    std::swap(layerShapes_, rhs.layerShapes_);
+  }
+  return *this;
+}
+
+const klimchuk::MappedScene::record_t& klimchuk::MappedScene::operator[](size_t index) const
+{
+  if (index >= header_->numberOfRecords)
+  {
+    throw std::out_of_range("MappedScene: Invalid index to access.");
+  }
+  return records_[index];
+}
+
+size_t klimchuk::MappedScene::getSize() const
+{
+  return header_->numberOfRecords;
+}
+
+klimchuk::circle_t klimchuk::MappedScene::getCircle(size_t index) const
+{
+  const record_t& record = getRecord(index, Type::CIRCLE);
+  if (record.index >= header_->numberOfCircles)
+  {
+    throw std::runtime_error("MappedScene: File is corrupted.");
+  }
+  return circles_[record.index];
+}
+
+klimchuk::oriented_rectangle_t klimchuk::MappedScene::getRectangle(size_t index) const
+{
+  const record_t& record = getRecord(index, Type::RECTANGLE);
+  if (record.index >= header_->numberOfRectangles)
+  {
+    throw std::runtime_error("MappedScene: File is corrupted.");
+  }
+  return rectangles_[record.index];
+}
+
+const klimchuk::point_t* klimchuk::MappedScene::getVertices(size_t index) const
+{
+  const record_t& record = (*this)[index];
+  const record_t& outline = getRecord(index, (record.type == Type::TRIANGLE) ? Type::TRIANGLE : Type::POLYGON);
+  if ((outline.index >= header_->numberOfOutlines) || (outlineBeginnings_[outline.index] > header_->numberOfPoints))
+  {
+    throw std::runtime_error("MappedScene: File is corrupted.");
+  }
+  return points_ + outlineBeginnings_[outline.index];
+}
+
+size_t klimchuk::MappedScene::getNumberOfVertices(size_t index) const
+{
+  const point_t* vertices = getVertices(index);
+  const size_t end = outlineBeginnings_[records_[index].index + 1];
+  if ((end < static_cast<size_t>(vertices - points_)) || (end > header_->numberOfPoints))
+  {
+    throw std::runtime_error("MappedScene: File is corrupted.");
+  }
+  return end - (vertices - points_);
+}
+
+size_t klimchuk::MappedScene::getNumberOfLayers() const
+{
+  return header_->numberOfLayers;
+}
+
+size_t klimchuk::MappedScene::getSizeOfLayer(size_t indexOfLayer) const
+{
+  getLayer(indexOfLayer);
+  return layerBeginnings_[indexOfLayer + 1] - layerBeginnings_[indexOfLayer];
+}
+
+const uint64_t* klimchuk::MappedScene::getLayer(size_t indexOfLayer) const
+{
+  if (indexOfLayer >= header_->numberOfLayers)
+  {
+    throw std::out_of_range("MappedScene: Invalid index of layer.");
+  }
+  if ((layerBeginnings_[indexOfLayer] > layerBeginnings_[indexOfLayer + 1])
+      || (layerBeginnings_[indexOfLayer + 1] > header_->sizeOfMatrix))
+  {
+    throw std::runtime_error("MappedScene: File is corrupted.");
+  }
+  return layerShapes_ + layerBeginnings_[indexOfLayer];
+}
+
+klimchuk::CompositeShape klimchuk::MappedScene::getCompositeShape() const
+{
+  if (header_->numberOfRecords == 0)
+  {
+    throw std::domain_error("MappedScene: Scene is empty.");
+  }
+  size_t index = 0;
+  CompositeShape compositeShape(makeShape(index));
+  while (index < header_->numberOfRecords)
+  {
+    compositeShape.add(makeShape(index));
+  }
+  return compositeShape;
+}
+
+const klimchuk::MappedScene::record_t& klimchuk::MappedScene::getRecord(size_t index, Type type) const
+{
+  const record_t& record = (*this)[index];
+  if (record.type != type)
+  {
+    throw std::invalid_argument("MappedScene: Shape has another type.");
+  }
+  return record;
+}
+
+klimchuk::Shape::ShapePtr klimchuk::MappedScene::makeShape(size_t& index) const
+{
+  const record_t& record = (*this)[index];
+  switch (record.type)
+  {
+  case Type::CIRCLE:
+  {
+    const circle_t circle = getCircle(index++);
+    return std::make_shared<Circle>(circle.pos.x, circle.pos.y, circle.radius);
+  }
+  case Type::RECTANGLE:
+  {
+    const oriented_rectangle_t frame = getRectangle(index++);
+    Shape::ShapePtr rectangle = std::make_shared<Rectangle>(frame.width, frame.height, frame.pos.x, frame.pos.y);
+    rectangle->rotate(std::atan2(frame.axis.y, frame.axis.x) * 180 / M_PI);
+    return rectangle;
+  }
+  case Type::TRIANGLE:
+  {
+    const point_t* vertices = getVertices(index);
+    if (getNumberOfVertices(index++) != 3)
+    {
+      throw std::runtime_error("MappedScene: File is corrupted.");
+    }
+    return std::make_shared<Triangle>(vertices[0], vertices[1], vertices[2]);
+  }
+  case Type::POLYGON:
+  {
+    const point_t* vertices = getVertices(index);
+    const size_t numberOfVertices = getNumberOfVertices(index++);
+    return std::make_shared<Polygon>(vertices, numberOfVertices);
+  }
+  case Type::COMPOSITE:
+  {
+    const size_t end = record.index;
+    if ((end <= index + 1) || (end > header_->numberOfRecords))
+    {
+      throw std::runtime_error("MappedScene: File is corrupted.");
+    }
+    ++index;
+    std::shared_ptr<CompositeShape> compositeShape = std::make_shared<CompositeShape>(makeShape(index));
+    while (index < end)
+    {
+      compositeShape->add(makeShape(index));
+    }
+    if (index != end)
+    {
+      throw std::runtime_error("MappedScene: File is corrupted.");
+    }
+    return compositeShape;
+  }
+  default:
+    throw std::runtime_error("MappedScene: File is corrupted.");
+  }
+}
@@ -0,0 +1,89 @@
+#ifndef KLIMCHUK_MAPPED_SCENE
+#define KLIMCHUK_MAPPED_SCENE
+
+#include <cstdint>
+#include <string>
+#include <ostream>
+#include "base-types.hpp"
+#include "composite-shape.hpp"
+#include "matrix.hpp"
+
+namespace klimchuk
+{
+  void writeScene(std::ostream& stream, const CompositeShape& compositeShape, const Matrix* matrix = nullptr);
+
+  class MappedScene
+  {
+  public:
+    enum class Type : uint32_t
+    {
+      CIRCLE,
+      RECTANGLE,
+      TRIANGLE,
+      POLYGON,
+      COMPOSITE
+    };
+
+    struct record_t
+    {
+      Type type;
+      uint32_t reserved;
+      uint64_t parent;
+      uint64_t index;
+    };
+
+    static constexpr uint64_t NO_PARENT = UINT64_MAX;
+
+    explicit MappedScene(const std::string& path);
+    MappedScene(const MappedScene& rhs) = delete;
+    MappedScene(MappedScene&& rhs) noexcept;
+    ~MappedScene();
+
+    MappedScene& operator=(const MappedScene& rhs) = delete;
+    MappedScene& operator=(MappedScene&& rhs) noexcept;
+    const record_t& operator[](size_t index) const;
+
+    size_t getSize() const;
+    circle_t getCircle(size_t index) const;
+    oriented_rectangle_t getRectangle(size_t index) const;
+    const point_t* getVertices(size_t index) const;
+    size_t getNumberOfVertices(size_t index) const;
+    size_t getNumberOfLayers() const;
+    size_t getSizeOfLayer(size_t indexOfLayer) const;
+    const uint64_t* getLayer(size_t indexOfLayer) const;
+    CompositeShape getCompositeShape() const;
+  private:
+    struct header_t
+    {
+      char magic[8];
+      uint32_t version;
+      uint32_t byteOrder;
+      uint64_t numberOfRecords;
+      uint64_t numberOfCircles;
+      uint64_t numberOfRectangles;
+      uint64_t numberOfOutlines;
+      uint64_t numberOfPoints;
+      uint64_t numberOfLayers;
+      uint64_t sizeOfMatrix;
+      uint64_t offsets[7];
+    };
+
+    friend void writeScene(std::ostream& stream, const CompositeShape& compositeShape, const Matrix* matrix);
+
+    void* data_;
+    size_t sizeOfData_;
+    const header_t* header_;
+    const record_t* records_;
+    const circle_t* circles_;
+    const oriented_rectangle_t* rectangles_;
+    const uint64_t* outlineBeginnings_;
+    const point_t* points_;
+    const uint64_t* layerBeginnings_;
+    const uint64_t* layerShapes_;
+
+    const record_t& getRecord(size_t index, Type type) const;
+    Shape::ShapePtr makeShape(size_t& index) const;
+  };
+}
+
+#endif
@@ -1,6 +1,24 @@
 #include "matrix.hpp"
 #include <stdexcept>
 #include <memory>
+#include <algorithm>
+
+namespace
+{
+  const size_t NO_WITNESS = static_cast<size_t>(-1);
+  const size_t LOST_WITNESS = NO_WITNESS - 1;
+
+  struct change_t
+  {
+    size_t index;
+    klimchuk::rectangle_t oldFrame;
+    klimchuk::rectangle_t newFrame;
+    klimchuk::oriented_rectangle_t oldOrientedFrame;
+    klimchuk::oriented_rectangle_t newOrientedFrame;
+    size_t oldLayer;
+    size_t newLayer;
+  };
+}
 
 klimchuk::Matrix::Layer::Layer(Shape::ShapePtr* shapePtr, size_t sizeOfLayer):
   sizeOfLayer_{ sizeOfLayer },
@@ -33,22 +51,43 @@ klimchuk::Shape::ConstShapePtr klimchuk::Matrix::Layer::operator[](size_t index)
   return layer_[index];
 }
 
-klimchuk::Matrix::Matrix() :
+klimchuk::Matrix::Matrix(Mode mode, Filter filter) :
+  mode_{ mode },
+  filter_{ filter },
   sizeOfMatrix_{ 0 },
   numberOfLayers_{ 0 },
   matrix_{ nullptr },
-  sizesOfLayers_{ nullptr }
+  sizesOfLayers_{ nullptr },
+  capacity_{ 0 },
+  shapes_{ nullptr },
+  frames_{ nullptr },
+  orientedFrames_{ nullptr },
+  layersOfShapes_{ nullptr },
+  witnesses_{ nullptr }
 {}
 
 klimchuk::Matrix::Matrix(const Matrix& rhs):
+  mode_{ rhs.mode_ },
+  filter_{ rhs.filter_ },
   sizeOfMatrix_{ rhs.sizeOfMatrix_ },
   numberOfLayers_{ rhs.numberOfLayers_ },
   matrix_{ std::make_unique<Shape::ShapePtr[]>(sizeOfMatrix_) },
-  sizesOfLayers_{ std::make_unique<size_t[]>(numberOfLayers_) }
+  sizesOfLayers_{ std::make_unique<size_t[]>(numberOfLayers_) },
+  capacity_{ rhs.sizeOfMatrix_ },
+  shapes_{ std::make_unique<Shape::ShapePtr[]>(capacity_) },
+  frames_{ std::make_unique<rectangle_t[]>(capacity_) },
+  orientedFrames_{ std::make_unique<oriented_rectangle_t[]>(capacity_) },
+  layersOfShapes_{ std::make_unique<size_t[]>(capacity_) },
+  witnesses_{ std::make_unique<size_t[]>(capacity_) }
 {
   for (size_t i = 0; i < sizeOfMatrix_; ++i)
   {
     matrix_[i] = rhs.matrix_[i];
+    shapes_[i] = rhs.shapes_[i];
+    frames_[i] = rhs.frames_[i];
+    orientedFrames_[i] = rhs.orientedFrames_[i];
+    layersOfShapes_[i] = rhs.layersOfShapes_[i];
+    witnesses_[i] = rhs.witnesses_[i];
   }
   for (size_t i = 0; i < numberOfLayers_; ++i)
   {
@@ -57,11 +96,29 @@ klimchuk::Matrix::Matrix(const Matrix& rhs):
 }
 
 klimchuk::Matrix::Matrix(Matrix&& rhs) noexcept:
+  mode_{ rhs.mode_ },
+  filter_{ rhs.filter_ },
   sizeOfMatrix_{ rhs.sizeOfMatrix_ },
   numberOfLayers_{ rhs.numberOfLayers_ },
   matrix_{ std::move(rhs.matrix_) },
-  sizesOfLayers_{ std::move(rhs.sizesOfLayers_) }
-{}
+  sizesOfLayers_{ std::move(rhs.sizesOfLayers_) },
+  capacity_{ rhs.capacity_ },
+  shapes_{ std::move(rhs.shapes_) },
+  frames_{ std::move(rhs.frames_) },
+  orientedFrames_{ std::move(rhs.orientedFrames_) },
+  layersOfShapes_{ std::move(rhs.layersOfShapes_) },
+  witnesses_{ std::move(rhs.witnesses_) }
+{
+  rhs.sizeOfMatrix_ = 0;
+  rhs.numberOfLayers_ = 0;
+  rhs.capacity_ = 0;
+  Journal::forget(&rhs);
+}
+
+klimchuk::Matrix::~Matrix()
+{
+  Journal::forget(this);
+}
 
 klimchuk::Matrix& klimchuk::Matrix::operator=(const Matrix& rhs)
 {
@@ -69,18 +126,8 @@ klimchuk::Matrix& klimchuk::Matrix::operator=(const Matrix& rhs)
   {
     return *this;
   }
-  sizeOfMatrix_ = rhs.sizeOfMatrix_;
-  numberOfLayers_ = rhs.numberOfLayers_;
-  matrix_ = std::make_unique<Shape::ShapePtr[]>(sizeOfMatrix_);
-  for (size_t i = 0; i < sizeOfMatrix_; ++i)
-  {
-    matrix_[i] = rhs.matrix_[i];
-  }
-  sizesOfLayers_ = std::make_unique<size_t[]>(numberOfLayers_);
-  for (size_t i = 0; i < numberOfLayers_; ++i)
-  {
-    sizesOfLayers_[i] = rhs.sizesOfLayers_[i];
-  }
+  Matrix temp(rhs);
+  *this = std::move(temp);
   return *this;
 }
 
@@ -90,10 +137,23 @@ klimchuk::Matrix& klimchuk::Matrix::operator=(Matrix&& rhs) noexcept
   {
     return *this;
   }
+  Journal::forget(this);
+  Journal::forget(&rhs);
+  mode_ = rhs.mode_;
+  filter_ = rhs.filter_;
   sizeOfMatrix_ = rhs.sizeOfMatrix_;
   numberOfLayers_ = rhs.numberOfLayers_;
   matrix_ = std::move(rhs.matrix_);
   sizesOfLayers_ = std::move(rhs.sizesOfLayers_);
+  capacity_ = rhs.capacity_;
+  shapes_ = std::move(rhs.shapes_);
+  frames_ = std::move(rhs.frames_);
+  orientedFrames_ = std::move(rhs.orientedFrames_);
+  layersOfShapes_ = std::move(rhs.layersOfShapes_);
+  witnesses_ = std::move(rhs.witnesses_);
+  rhs.sizeOfMatrix_ = 0;
+  rhs.numberOfLayers_ = 0;
+  rhs.capacity_ = 0;
   return *this;
 }
 
@@ -139,47 +199,89 @@ size_t klimchuk::Matrix::getIndexOfBeginningOfLayer(size_t indexOfLayer) const
 
 void klimchuk::Matrix::add(const Shape::ShapePtr& shape)
 {
+  const Journal::Scope scope(Journal::Operation::MATRIX_ADD, *this, shape);
   if (!shape)
   {
     throw std::invalid_argument("Matrix: invalid argument to add");
   }
-  size_t indexOfLayer = getIndexOfLayerToAdd(shape);
-  if (indexOfLayer < numberOfLayers_)
+  if (sizeOfMatrix_ == capacity_)
   {
-    size_t indexForAdd = getIndexInMatrixForShape(indexOfLayer);
-    ++sizeOfMatrix_;
-    ++sizesOfLayers_[indexOfLayer];
-    std::unique_ptr<Shape::ShapePtr[]> tempMatrix = std::make_unique<Shape::ShapePtr[]>(sizeOfMatrix_);
-    for (size_t i = 0; i < indexForAdd; ++i)
-    {
-      tempMatrix[i] = matrix_[i];
-    }
-    tempMatrix[indexForAdd] = shape;
-    for (size_t i = indexForAdd + 1; i < sizeOfMatrix_; ++i)
+    size_t newCapacity = (capacity_ == 0) ? 1 : (capacity_ * 2);
+    std::unique_ptr<Shape::ShapePtr[]> tempShapes = std::make_unique<Shape::ShapePtr[]>(newCapacity);
+    std::unique_ptr<rectangle_t[]> tempFrames = std::make_unique<rectangle_t[]>(newCapacity);
+    std::unique_ptr<oriented_rectangle_t[]> tempOrientedFrames = std::make_unique<oriented_rectangle_t[]>(newCapacity);
+    std::unique_ptr<size_t[]> tempLayers = std::make_unique<size_t[]>(newCapacity);
+    std::unique_ptr<size_t[]> tempWitnesses = std::make_unique<size_t[]>(newCapacity);
+    for (size_t i = 0; i < sizeOfMatrix_; ++i)
     {
-      tempMatrix[i] = matrix_[i - 1];
+      tempShapes[i] = shapes_[i];
+      tempFrames[i] = frames_[i];
+      tempOrientedFrames[i] = orientedFrames_[i];
+      tempLayers[i] = layersOfShapes_[i];
+      tempWitnesses[i] = witnesses_[i];
     }
-    matrix_.swap(tempMatrix);
+    shapes_.swap(tempShapes);
+    frames_.swap(tempFrames);
+    orientedFrames_.swap(tempOrientedFrames);
+    layersOfShapes_.swap(tempLayers);
+    witnesses_.swap(tempWitnesses);
+    capacity_ = newCapacity;
   }
-  else
+  shapes_[sizeOfMatrix_] = shape;
+  frames_[sizeOfMatrix_] = shape->getFrameRect();
+  if (filter_ == Filter::ORIENTED_FRAME)
+  {
+    orientedFrames_[sizeOfMatrix_] = shape->getOrientedFrameRect();
+  }
+  computeLayer(sizeOfMatrix_);
+  ++sizeOfMatrix_;
+  arrange();
+}
+
+void klimchuk::Matrix::remove(const Shape::ShapePtr& shape)
+{
+  const Journal::Scope scope(Journal::Operation::MATRIX_REMOVE, *this, shape);
+  size_t index = getIndexOfShape(shape);
+  rectangle_t oldFrame = frames_[index];
+  oriented_rectangle_t oldOrientedFrame = orientedFrames_[index];
+  size_t oldLayer = layersOfShapes_[index];
+  for (size_t i = index; i < sizeOfMatrix_ - 1; ++i)
   {
-    ++numberOfLayers_;
-    std::unique_ptr<size_t[]> tempSizesOfLayers = std::make_unique<size_t[]>(numberOfLayers_);
-    for (size_t i = 0; i < numberOfLayers_ - 1; ++i)
+    shapes_[i] = shapes_[i + 1];
+    frames_[i] = frames_[i + 1];
+    orientedFrames_[i] = orientedFrames_[i + 1];
+    layersOfShapes_[i] = layersOfShapes_[i + 1];
+    witnesses_[i] = witnesses_[i + 1];
+    if (witnesses_[i] == index)
     {
-      tempSizesOfLayers[i] = sizesOfLayers_[i];
+      witnesses_[i] = LOST_WITNESS;
     }
-    tempSizesOfLayers[numberOfLayers_ - 1] = 1;
-    sizesOfLayers_.swap(tempSizesOfLayers);
-    ++sizeOfMatrix_;
-    std::unique_ptr<Shape::ShapePtr[]> tempMatrix = std::make_unique<Shape::ShapePtr[]>(sizeOfMatrix_);
-    for (size_t i = 0; i < sizeOfMatrix_ - 1; ++i)
+    else if ((witnesses_[i] > index) && (witnesses_[i] < LOST_WITNESS))
     {
-      tempMatrix[i] = matrix_[i];
+      --witnesses_[i];
     }
-    tempMatrix[sizeOfMatrix_ - 1] = shape;
-    matrix_.swap(tempMatrix);
   }
+  --sizeOfMatrix_;
+  shapes_[sizeOfMatrix_].reset();
+  relayer(index, NO_WITNESS, oldFrame, oldOrientedFrame, oldLayer);
+  arrange();
+}
+
+void klimchuk::Matrix::update(const Shape::ShapePtr& shape)
+{
+  const Journal::Scope scope(Journal::Operation::MATRIX_UPDATE, *this, shape);
+  size_t index = getIndexOfShape(shape);
+  rectangle_t oldFrame = frames_[index];
+  oriented_rectangle_t oldOrientedFrame = orientedFrames_[index];
+  size_t oldLayer = layersOfShapes_[index];
+  frames_[index] = shape->getFrameRect();
+  if (filter_ == Filter::ORIENTED_FRAME)
+  {
+    orientedFrames_[index] = shape->getOrientedFrameRect();
+  }
+  computeLayer(index);
+  relayer(index + 1, index, oldFrame, oldOrientedFrame, oldLayer);
+  arrange();
 }
 
 size_t klimchuk::Matrix::getIndexOfLayerToAdd(const Shape::ShapePtr& shape) const
@@ -188,18 +290,30 @@ size_t klimchuk::Matrix::getIndexOfLayerToAdd(const Shape::ShapePtr& shape) cons
   {
     throw std::invalid_argument("Matrix: ivalid argument to compute index");
   }
-  size_t index = 0;
-  bool isFind = false;
-  for (size_t i = 0; i < sizeOfMatrix_ && !isFind; ++i)
+  rectangle_t frame = shape->getFrameRect();
+  oriented_rectangle_t orientedFrame{ frame.width, frame.height, frame.pos, { 1.0, 0.0 } };
+  if (filter_ == Filter::ORIENTED_FRAME)
   {
-    if (areShapesIntersect(matrix_[i]->getFrameRect(), shape->getFrameRect()))
+    orientedFrame = shape->getOrientedFrameRect();
+  }
+  if (mode_ == Mode::MINIMUM_LAYERS)
+  {
+    size_t index = 0;
+    for (size_t i = 0; i < sizeOfMatrix_; ++i)
     {
-      index = getIndexOfLayerForShape(i) + 1;
+      if ((layersOfShapes_[i] >= index) && areIntersecting(i, frame, orientedFrame))
+      {
+        index = layersOfShapes_[i] + 1;
+      }
     }
-    else
+    return index;
+  }
+  size_t index = numberOfLayers_;
+  for (size_t i = 0; i < sizeOfMatrix_; ++i)
+  {
+    if ((layersOfShapes_[i] < index) && !areIntersecting(i, frame, orientedFrame))
     {
-      index = getIndexOfLayerForShape(i);
-      isFind = true;
+      index = layersOfShapes_[i];
     }
   }
   return index;
@@ -252,3 +366,157 @@ size_t klimchuk::Matrix::getSizeOfLayer(size_t indexOfLayer) const
   }
   return sizesOfLayers_[indexOfLayer];
 }
+
+klimchuk::Matrix::Mode klimchuk::Matrix::getMode() const
+{
+  return mode_;
+}
+
+klimchuk::Matrix::Filter klimchuk::Matrix::getFilter() const
+{
+  return filter_;
+}
+
+size_t klimchuk::Matrix::getIndexOfShape(const Shape::ShapePtr& shape) const
+{
+  if (!shape)
+  {
+    throw std::invalid_argument("Matrix: invalid argument to find");
+  }
+  for (size_t i = 0; i < sizeOfMatrix_; ++i)
+  {
+    if (shapes_[i] == shape)
+    {
+      return i;
+    }
+  }
+  throw std::invalid_argument("Matrix: Shape is not in matrix.");
+}
+
+bool klimchuk::Matrix::areIntersecting(size_t indexOfShape, const rectangle_t& frame,
+  const oriented_rectangle_t& orientedFrame) const
+{
+  return areShapesIntersect(frames_[indexOfShape], frame)
+    && ((filter_ == Filter::FRAME) || areShapesIntersect(orientedFrames_[indexOfShape], orientedFrame));
+}
+
+void klimchuk::Matrix::computeLayer(size_t indexOfShape)
+{
+  if (mode_ == Mode::MINIMUM_LAYERS)
+  {
+    size_t layer = 0;
+    size_t witness = NO_WITNESS;
+    for (size_t i = 0; i < indexOfShape; ++i)
+    {
+      if ((layersOfShapes_[i] >= layer) && areIntersecting(i, frames_[indexOfShape], orientedFrames_[indexOfShape]))
+      {
+        layer = layersOfShapes_[i] + 1;
+        witness = i;
+      }
+    }
+    layersOfShapes_[indexOfShape] = layer;
+    witnesses_[indexOfShape] = witness;
+    return;
+  }
+  size_t layer = NO_WITNESS;
+  size_t witness = NO_WITNESS;
+  size_t numberOfLayers = 0;
+  for (size_t i = 0; i < indexOfShape; ++i)
+  {
+    numberOfLayers = std::max(numberOfLayers, layersOfShapes_[i] + 1);
+    if ((layersOfShapes_[i] < layer) && !areIntersecting(i, frames_[indexOfShape], orientedFrames_[indexOfShape]))
+    {
+      layer = layersOfShapes_[i];
+      witness = i;
+    }
+  }
+  layersOfShapes_[indexOfShape] = (witness == NO_WITNESS) ? numberOfLayers : layer;
+  witnesses_[indexOfShape] = witness;
+}
+
+void klimchuk::Matrix::relayer(size_t beginning, size_t indexOfShape, const rectangle_t& oldFrame,
+  const oriented_rectangle_t& oldOrientedFrame, size_t oldLayer)
+{
+  if (beginning >= sizeOfMatrix_)
+  {
+    return;
+  }
+  std::unique_ptr<change_t[]> changes = std::make_unique<change_t[]>(sizeOfMatrix_ - beginning + 1);
+  size_t numberOfChanges = 0;
+  if (indexOfShape == NO_WITNESS)
+  {
+    changes[numberOfChanges++] = change_t{ indexOfShape, oldFrame, oldFrame, oldOrientedFrame, oldOrientedFrame,
+      oldLayer, NO_WITNESS };
+  }
+  else
+  {
+    changes[numberOfChanges++] = change_t{ indexOfShape, oldFrame, frames_[indexOfShape], oldOrientedFrame,
+      orientedFrames_[indexOfShape], oldLayer, layersOfShapes_[indexOfShape] };
+  }
+  for (size_t i = beginning; i < sizeOfMatrix_; ++i)
+  {
+    bool isAffected = (witnesses_[i] == LOST_WITNESS);
+    for (size_t j = 0; (j < numberOfChanges) && !isAffected; ++j)
+    {
+      const change_t& change = changes[j];
+      bool wasIntersecting = areIntersecting(i, change.oldFrame, change.oldOrientedFrame);
+      bool isRemoved = (change.newLayer == NO_WITNESS);
+      bool isIntersecting = !isRemoved && areIntersecting(i, change.newFrame, change.newOrientedFrame);
+      if (!isRemoved && (wasIntersecting == isIntersecting) && (change.oldLayer == change.newLayer))
+      {
+        continue;
+      }
+      if (mode_ == Mode::MINIMUM_LAYERS)
+      {
+        isAffected = (wasIntersecting && (witnesses_[i] == change.index))
+          || (!isRemoved && isIntersecting && (change.newLayer >= layersOfShapes_[i]));
+      }
+      else
+      {
+        isAffected = (witnesses_[i] == NO_WITNESS)
+          || (!wasIntersecting && (witnesses_[i] == change.index))
+          || (!isRemoved && !isIntersecting && (change.newLayer < layersOfShapes_[i]));
+      }
+    }
+    if (isAffected)
+    {
+      size_t layer = layersOfShapes_[i];
+      computeLayer(i);
+      if (layer != layersOfShapes_[i])
+      {
+        changes[numberOfChanges++] = change_t{ i, frames_[i], frames_[i], orientedFrames_[i], orientedFrames_[i],
+          layer, layersOfShapes_[i] };
+      }
+    }
+  }
+}
+
+void klimchuk::Matrix::arrange()
+{
+  numberOfLayers_ = 0;
+  for (size_t i = 0; i < sizeOfMatrix_; ++i)
+  {
+    numberOfLayers_ = std::max(numberOfLayers_, layersOfShapes_[i] + 1);
+  }
+  if (sizeOfMatrix_ == 0)
+  {
+    matrix_.reset();
+    sizesOfLayers_.reset();
+    return;
+  }
+  sizesOfLayers_ = std::make_unique<size_t[]>(numberOfLayers_);
+  for (size_t i = 0; i < sizeOfMatrix_; ++i)
+  {
+    ++sizesOfLayers_[layersOfShapes_[i]];
+  }
+  std::unique_ptr<size_t[]> nextIndexes = std::make_unique<size_t[]>(numberOfLayers_);
+  for (size_t i = 1; i < numberOfLayers_; ++i)
+  {
+    nextIndexes[i] = nextIndexes[i - 1] + sizesOfLayers_[i - 1];
+  }
+  matrix_ = std::make_unique<Shape::ShapePtr[]>(sizeOfMatrix_);
+  for (size_t i = 0; i < sizeOfMatrix_; ++i)
+  {
+    matrix_[nextIndexes[layersOfShapes_[i]]++] = shapes_[i];
+  }
+}
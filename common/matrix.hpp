@@ -2,13 +2,29 @@
 #define KLIMCHUK_MATRIX
 
 #include <memory>
+#include <vector>
+#include <utility>
 #include "shape.hpp"
 
 namespace klimchuk
 {
+  class CompositeShape;
+
   class Matrix
   {
   public:
+    enum class Mode
+    {
+      FIRST_FIT,
+      MINIMUM_LAYERS
+    };
+
+    enum class Filter
+    {
+      FRAME,
+      ORIENTED_FRAME
+    };
+
     class Layer
     {
     public:
@@ -21,10 +37,11 @@ namespace klimchuk
       Layer(Shape::ShapePtr* shapePtr, size_t sizeOfLayer);
     };
 
-    Matrix();
+    Matrix(Mode mode = Mode::FIRST_FIT, Filter filter = Filter::FRAME);
 
     Matrix(const Matrix& rhs);
     Matrix(Matrix&& rhs) noexcept;
+    ~Matrix();
 
     Matrix& operator=(const Matrix& rhs);
     Matrix& operator=(Matrix&& rhs) noexcept;
@@ -32,6 +49,8 @@ namespace klimchuk
     Layer operator[](size_t index);
 
     void add(const Shape::ShapePtr& shape);
+    void remove(const Shape::ShapePtr& shape);
+    void update(const Shape::ShapePtr& shape);
 
     size_t getIndexOfBeginningOfLayer(size_t indexOfLayer) const;
     size_t getIndexOfLayerToAdd(const Shape::ShapePtr& shape) const;
@@ -41,11 +60,33 @@ namespace klimchuk
     size_t getSizeOfMatrix() const;
     size_t getNumberOFLayers() const;
     size_t getSizeOfLayer(size_t indexOfLayer) const;
+    Mode getMode() const;
+    Filter getFilter() const;
   private:
+    friend class Journal;
+    friend Matrix partition(CompositeShape& compositeShape, Mode mode, Filter filter);
+    friend Matrix partition(CompositeShape& compositeShape, const std::vector<std::pair<size_t, size_t>>& intersections,
+      Mode mode, Filter filter);
+
+    Mode mode_;
+    Filter filter_;
     size_t sizeOfMatrix_;
     size_t numberOfLayers_;
     std::unique_ptr<Shape::ShapePtr[]> matrix_;
     std::unique_ptr<size_t[]> sizesOfLayers_;
+    size_t capacity_;
+    std::unique_ptr<Shape::ShapePtr[]> shapes_;
+    std::unique_ptr<rectangle_t[]> frames_;
+    std::unique_ptr<oriented_rectangle_t[]> orientedFrames_;
+    std::unique_ptr<size_t[]> layersOfShapes_;
+    std::unique_ptr<size_t[]> witnesses_;
+
+    size_t getIndexOfShape(const Shape::ShapePtr& shape) const;
+    bool areIntersecting(size_t indexOfShape, const rectangle_t& frame, const oriented_rectangle_t& orientedFrame) const;
+    void computeLayer(size_t indexOfShape);
+    void relayer(size_t beginning, size_t indexOfShape, const rectangle_t& oldFrame,
+      const oriented_rectangle_t& oldOrientedFrame, size_t oldLayer);
+    void arrange();
   };
 }
 
@@ -0,0 +1,86 @@
+#include "outline.hpp"
+#include <stdexcept>
+#include <algorithm>
+#include "composite-shape.hpp"
+#include "circle.hpp"
+#include "rectangle.hpp"
+#include "triangle.hpp"
+#include "polygon.hpp"
+
+namespace
+{
+  void addPolygon(klimchuk::outlines_t& outlines, std::vector<klimchuk::point_t>& points)
+  {
+    double area = 0.0;
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      const klimchuk::point_t& next = points[(i + 1) % points.size()];
+      area += (points[i].x * next.y) - (points[i].y * next.x);
+    }
+    if (area == 0.0)
+    {
+      return;
+    }
+    if (area < 0.0)
+    {
+      std::reverse(points.begin(), points.end());
+    }
+    double minX = points[0].x;
+    double maxX = points[0].x;
+    double minY = points[0].y;
+    double maxY = points[0].y;
+    for (const klimchuk::point_t& point : points)
+    {
+      minX = std::min(minX, point.x);
+      maxX = std::max(maxX, point.x);
+      minY = std::min(minY, point.y);
+      maxY = std::max(maxY, point.y);
+    }
+    outlines.outlines.push_back(klimchuk::outline_t{ outlines.vertices.size(), outlines.vertices.size() + points.size(),
+      { 0.0, 0.0 }, 0.0 });
+    outlines.vertices.insert(outlines.vertices.end(), points.begin(), points.end());
+    outlines.frames.push_back(klimchuk::rectangle_t{ maxX - minX, maxY - minY, { (minX + maxX) / 2, (minY + maxY) / 2 } });
+  }
+}
+
+void klimchuk::addOutlines(outlines_t& outlines, const Shape::ConstShapePtr& shape, double tolerance)
+{
+  if (!shape)
+  {
+    throw std::invalid_argument("addOutlines: Parametr is not shape.");
+  }
+  std::vector<point_t> points;
+  if (const CompositeShape* compositeShape = dynamic_cast<const CompositeShape*>(shape.get()))
+  {
+    for (size_t i = 0; i < compositeShape->getSize(); ++i)
+    {
+      addOutlines(outlines, (*compositeShape)[i], tolerance);
+    }
+  }
+  else if (const Circle* circle = dynamic_cast<const Circle*>(shape.get()))
+  {
+    outlines.outlines.push_back(outline_t{ outlines.vertices.size(), outlines.vertices.size(), circle->getCentre(),
+      circle->getRadius() });
+    outlines.frames.push_back(circle->getFrameRect());
+  }
+  else if (const Rectangle* rectangle = dynamic_cast<const Rectangle*>(shape.get()))
+  {
+    points.resize(4);
+    getCorners(rectangle->getOrientedFrameRect(), points.data());
+    addPolygon(outlines, points);
+  }
+  else if (const Triangle* triangle = dynamic_cast<const Triangle*>(shape.get()))
+  {
+    points = { (*triangle)[0], (*triangle)[1], (*triangle)[2] };
+    addPolygon(outlines, points);
+  }
+  else if (const Polygon* polygon = dynamic_cast<const Polygon*>(shape.get()))
+  {
+    points = polygon->getPointsOfLevel(polygon->getLevelOfDetail(tolerance));
+    addPolygon(outlines, points);
+  }
+  else
+  {
+    throw std::invalid_argument("addOutlines: Unsupported type of shape.");
+  }
+}
@@ -0,0 +1,27 @@
+#ifndef KLIMCHUK_OUTLINE
+#define KLIMCHUK_OUTLINE
+
+#include <vector>
+#include "shape.hpp"
+
+namespace klimchuk
+{
+  struct outline_t
+  {
+    size_t begin;
+    size_t end;
+    point_t centre;
+    double radius;
+  };
+
+  struct outlines_t
+  {
+    std::vector<outline_t> outlines;
+    std::vector<point_t> vertices;
+    std::vector<rectangle_t> frames;
+  };
+
+  void addOutlines(outlines_t& outlines, const Shape::ConstShapePtr& shape, double tolerance = 0.0);
+}
+
+#endif
@@ -0,0 +1,161 @@
+#include "partition.hpp"
+#include <stdexcept>
+#include <algorithm>
+#include <vector>
+#include "frame-sweep.hpp"
+
+klimchuk::Matrix klimchuk::partition(CompositeShape& compositeShape, Matrix::Mode mode, Matrix::Filter filter)
+{
+  size_t numberOfShapes = compositeShape.getSize();
+  const std::vector<size_t> order = compositeShape.getSpatialOrder();
+  std::unique_ptr<rectangle_t[]> orderedFrames = std::make_unique<rectangle_t[]>(numberOfShapes);
+  for (size_t i = 0; i < numberOfShapes; ++i)
+  {
+    orderedFrames[i] = compositeShape[order[i]]->getFrameRect();
+  }
+  std::vector<intersection_t> intersections = findIntersections(orderedFrames.get(), numberOfShapes);
+  orderedFrames.reset();
+  for (intersection_t& intersection : intersections)
+  {
+    intersection = std::minmax(order[intersection.first], order[intersection.second]);
+  }
+  return partition(compositeShape, intersections, mode, filter);
+}
+
+klimchuk::Matrix klimchuk::partition(CompositeShape& compositeShape, const std::vector<intersection_t>& intersections,
+  Matrix::Mode mode, Matrix::Filter filter)
+{
+  Matrix matrix(mode, filter);
+  size_t numberOfShapes = compositeShape.getSize();
+  matrix.capacity_ = numberOfShapes;
+  matrix.shapes_ = std::make_unique<Shape::ShapePtr[]>(numberOfShapes);
+  matrix.frames_ = std::make_unique<rectangle_t[]>(numberOfShapes);
+  matrix.orientedFrames_ = std::make_unique<oriented_rectangle_t[]>(numberOfShapes);
+  matrix.layersOfShapes_ = std::make_unique<size_t[]>(numberOfShapes);
+  matrix.witnesses_ = std::make_unique<size_t[]>(numberOfShapes);
+  for (size_t i = 0; i < numberOfShapes; ++i)
+  {
+    matrix.shapes_[i] = compositeShape[i];
+    matrix.frames_[i] = matrix.shapes_[i]->getFrameRect();
+    if (filter == Matrix::Filter::ORIENTED_FRAME)
+    {
+      matrix.orientedFrames_[i] = matrix.shapes_[i]->getOrientedFrameRect();
+    }
+  }
+
+  std::unique_ptr<size_t[]> beginnings = std::make_unique<size_t[]>(numberOfShapes + 1);
+  for (const intersection_t& intersection : intersections)
+  {
+    if ((intersection.first >= intersection.second) || (intersection.second >= numberOfShapes))
+    {
+      throw std::invalid_argument("partition: Invalid intersection.");
+    }
+    ++beginnings[intersection.second + 1];
+  }
+  for (size_t i = 0; i < numberOfShapes; ++i)
+  {
+    beginnings[i + 1] += beginnings[i];
+  }
+  std::unique_ptr<size_t[]> predecessors = std::make_unique<size_t[]>(intersections.size());
+  std::unique_ptr<size_t[]> nextIndexes = std::make_unique<size_t[]>(numberOfShapes);
+  for (size_t i = 0; i < numberOfShapes; ++i)
+  {
+    nextIndexes[i] = beginnings[i];
+  }
+  for (const intersection_t& intersection : intersections)
+  {
+    if ((filter == Matrix::Filter::FRAME) || areShapesIntersect(matrix.orientedFrames_[intersection.first],
+      matrix.orientedFrames_[intersection.second]))
+    {
+      predecessors[nextIndexes[intersection.second]++] = intersection.first;
+    }
+  }
+
+  const size_t noWitness = static_cast<size_t>(-1);
+  std::vector<std::vector<size_t>> layers;
+  std::vector<size_t> numbersOfPredecessors;
+  for (size_t i = 0; i < numberOfShapes; ++i)
+  {
+    size_t* first = &predecessors[beginnings[i]];
+    size_t* last = &predecessors[nextIndexes[i]];
+    std::sort(first, last);
+    last = std::unique(first, last);
+    size_t layer = 0;
+    size_t witness = noWitness;
+    if (mode == Matrix::Mode::MINIMUM_LAYERS)
+    {
+      for (const size_t* predecessor = first; predecessor != last; ++predecessor)
+      {
+        if (matrix.layersOfShapes_[*predecessor] >= layer)
+        {
+          layer = matrix.layersOfShapes_[*predecessor] + 1;
+          witness = *predecessor;
+        }
+      }
+    }
+    else
+    {
+      for (const size_t* predecessor = first; predecessor != last; ++predecessor)
+      {
+        ++numbersOfPredecessors[matrix.layersOfShapes_[*predecessor]];
+      }
+      layer = layers.size();
+      for (size_t j = 0; j < layers.size(); ++j)
+      {
+        if (layers[j].size() > numbersOfPredecessors[j])
+        {
+          layer = j;
+          const size_t* predecessor = first;
+          for (size_t member : layers[j])
+          {
+            while ((predecessor != last) && (*predecessor < member))
+            {
+              ++predecessor;
+            }
+            if ((predecessor == last) || (*predecessor != member))
+            {
+              witness = member;
+              break;
+            }
+          }
+          break;
+        }
+      }
+      for (const size_t* predecessor = first; predecessor != last; ++predecessor)
+      {
+        numbersOfPredecessors[matrix.layersOfShapes_[*predecessor]] = 0;
+      }
+      if (layer == layers.size())
+      {
+        layers.emplace_back();
+        numbersOfPredecessors.push_back(0);
+      }
+      layers[layer].push_back(i);
+    }
+    matrix.layersOfShapes_[i] = layer;
+    matrix.witnesses_[i] = witness;
+  }
+  matrix.sizeOfMatrix_ = numberOfShapes;
+  matrix.arrange();
+  return matrix;
+}
+
+std::vector<klimchuk::intersection_t> klimchuk::findIntersections(const rectangle_t* frames, size_t numberOfFrames)
+{
+  if (!frames && (numberOfFrames != 0))
+  {
+    throw std::invalid_argument("findIntersections: Array of frames is empty.");
+  }
+  std::vector<intersection_t> intersections;
+  std::unique_ptr<size_t[]> order = std::make_unique<size_t[]>(numberOfFrames);
+  for (size_t i = 0; i < numberOfFrames; ++i)
+  {
+    order[i] = i;
+  }
+  auto report = [&intersections](size_t first, size_t second)
+  {
+    intersections.emplace_back(first, second);
+  };
+  FrameSweep(numberOfFrames).run(frames, order.get(), numberOfFrames, report);
+  return intersections;
+}
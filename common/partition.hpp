@@ -0,0 +1,20 @@
+#ifndef KLIMCHUK_PARTITION
+#define KLIMCHUK_PARTITION
+
+#include <vector>
+#include <utility>
+#include "matrix.hpp"
+#include "composite-shape.hpp"
+
+namespace klimchuk
+{
+  typedef std::pair<size_t, size_t> intersection_t;
+
+  Matrix partition(CompositeShape& compositeShape, Matrix::Mode mode = Matrix::Mode::FIRST_FIT,
+    Matrix::Filter filter = Matrix::Filter::FRAME);
+  Matrix partition(CompositeShape& compositeShape, const std::vector<intersection_t>& intersections,
+    Matrix::Mode mode = Matrix::Mode::FIRST_FIT, Matrix::Filter filter = Matrix::Filter::FRAME);
+  std::vector<intersection_t> findIntersections(const rectangle_t* frames, size_t numberOfFrames);
+}
+
+#endif
@@ -0,0 +1,190 @@
+#include "pipeline.hpp"
+#include <stdexcept>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <exception>
+#include <algorithm>
+#include "spsc-queue.hpp"
+#include "scene-reader.hpp"
+
+namespace
+{
+  typedef std::chrono::steady_clock Clock;
+  typedef klimchuk::SpscQueue<klimchuk::Shape::ShapePtr> Queue;
+
+  const size_t NUMBER_OF_YIELDS = 16;
+  const size_t MAX_SLEEP_SHIFT = 10;
+
+  double getSeconds(const Clock::time_point& start)
+  {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+  }
+
+  void wait(size_t& attempt)
+  {
+    if (attempt < NUMBER_OF_YIELDS)
+    {
+      std::this_thread::yield();
+    }
+    else
+    {
+      const size_t shift = std::min(attempt - NUMBER_OF_YIELDS, MAX_SLEEP_SHIFT);
+      std::this_thread::sleep_for(std::chrono::microseconds(static_cast<size_t>(1) << shift));
+    }
+    ++attempt;
+  }
+
+  bool push(Queue& queue, klimchuk::Shape::ShapePtr&& shape, const std::atomic<bool>& isCancelled)
+  {
+    size_t attempt = 0;
+    while (!queue.tryPush(std::move(shape)))
+    {
+      if (isCancelled.load(std::memory_order_relaxed))
+      {
+        return false;
+      }
+      wait(attempt);
+    }
+    return true;
+  }
+
+  bool pop(Queue& queue, klimchuk::Shape::ShapePtr& shape, const std::atomic<bool>& isCancelled)
+  {
+    size_t attempt = 0;
+    while (!queue.tryPop(shape))
+    {
+      if (isCancelled.load(std::memory_order_relaxed))
+      {
+        return false;
+      }
+      wait(attempt);
+    }
+    return true;
+  }
+}
+
+klimchuk::pipeline_statistics_t klimchuk::runPipeline(std::istream& stream, const Transform& transform,
+    Matrix& matrix, size_t capacityOfQueues)
+{
+  if (!transform)
+  {
+    throw std::invalid_argument("runPipeline: Transform is empty.");
+  }
+  Queue parsed(capacityOfQueues);
+  Queue transformed(capacityOfQueues);
+  std::atomic<bool> isCancelled{ false };
+  std::exception_ptr errors[3];
+  pipeline_statistics_t statistics{ 0, 0.0, 0.0, 0.0, 0.0 };
+  const Clock::time_point start = Clock::now();
+
+  std::thread parser([&]()
+  {
+    try
+    {
+      SceneReader reader(stream);
+      while (true)
+      {
+        const Clock::time_point beginning = Clock::now();
+        Shape::ShapePtr shape = reader.next();
+        statistics.parsing += getSeconds(beginning);
+        const bool isLast = !shape;
+        if (!push(parsed, std::move(shape), isCancelled) || isLast)
+        {
+          break;
+        }
+      }
+    }
+    catch (...)
+    {
+      errors[0] = std::current_exception();
+      isCancelled = true;
+    }
+  });
+
+  std::thread transformer([&]()
+  {
+    try
+    {
+      Shape::ShapePtr shape;
+      while (pop(parsed, shape, isCancelled))
+      {
+        const bool isLast = !shape;
+        if (!isLast)
+        {
+          const Clock::time_point beginning = Clock::now();
+          transform(shape);
+          statistics.transforming += getSeconds(beginning);
+        }
+        if (!push(transformed, std::move(shape), isCancelled) || isLast)
+        {
+          break;
+        }
+      }
+    }
+    catch (...)
+    {
+      errors[1] = std::current_exception();
+      isCancelled = true;
+    }
+  });
+
+  try
+  {
+    Shape::ShapePtr shape;
+    while (pop(transformed, shape, isCancelled) && shape)
+    {
+      const Clock::time_point beginning = Clock::now();
+      matrix.add(shape);
+      statistics.partitioning += getSeconds(beginning);
+      ++statistics.numberOfShapes;
+    }
+  }
+  catch (...)
+  {
+    errors[2] = std::current_exception();
+    isCancelled = true;
+  }
+  parser.join();
+  transformer.join();
+  for (const std::exception_ptr& error : errors)
+  {
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
+  }
+  statistics.total = getSeconds(start);
+  return statistics;
+}
+
+klimchuk::pipeline_statistics_t klimchuk::runSequentially(std::istream& stream, const Transform& transform,
+    Matrix& matrix)
+{
+  if (!transform)
+  {
+    throw std::invalid_argument("runSequentially: Transform is empty.");
+  }
+  pipeline_statistics_t statistics{ 0, 0.0, 0.0, 0.0, 0.0 };
+  const Clock::time_point start = Clock::now();
+  SceneReader reader(stream);
+  while (true)
+  {
+    Clock::time_point beginning = Clock::now();
+    Shape::ShapePtr shape = reader.next();
+    statistics.parsing += getSeconds(beginning);
+    if (!shape)
+    {
+      break;
+    }
+    beginning = Clock::now();
+    transform(shape);
+    statistics.transforming += getSeconds(beginning);
+    beginning = Clock::now();
+    matrix.add(shape);
+    statistics.partitioning += getSeconds(beginning);
+    ++statistics.numberOfShapes;
+  }
+  statistics.total = getSeconds(start);
+  return statistics;
+}
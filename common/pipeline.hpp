@@ -0,0 +1,27 @@
+#ifndef KLIMCHUK_PIPELINE
+#define KLIMCHUK_PIPELINE
+
+#include <istream>
+#include <functional>
+#include "shape.hpp"
+#include "matrix.hpp"
+
+namespace klimchuk
+{
+  struct pipeline_statistics_t
+  {
+    size_t numberOfShapes;
+    double parsing;
+    double transforming;
+    double partitioning;
+    double total;
+  };
+
+  typedef std::function<void(const Shape::ShapePtr&)> Transform;
+
+  pipeline_statistics_t runPipeline(std::istream& stream, const Transform& transform, Matrix& matrix,
+    size_t capacityOfQueues = 1024);
+  pipeline_statistics_t runSequentially(std::istream& stream, const Transform& transform, Matrix& matrix);
+}
+
+#endif
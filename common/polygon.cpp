@@ -2,22 +2,406 @@
 #include <stdexcept>
 #include <cmath>
 #include <algorithm>
+#include <queue>
+#include <set>
+#include <numeric>
+#include <utility>
+#include <random>
+#include "predicates.hpp"
+#include "vertex-encoding.hpp"
+
+namespace
+{
+  const uint64_t HASH_SEED = 4;
+  const size_t MIN_SIZE_FOR_LEVELS = 16;
+  const size_t MAX_NUMBER_OF_LEVELS = 8;
+
+  double getDistanceToSegment(const klimchuk::point_t& point, const klimchuk::point_t& begin,
+    const klimchuk::point_t& end)
+  {
+    const klimchuk::point_t segment{ end.x - begin.x, end.y - begin.y };
+    const double squaredLength = (segment.x * segment.x) + (segment.y * segment.y);
+    double ratio = 0.0;
+    if (squaredLength > 0.0)
+    {
+      ratio = std::min(1.0, std::max(0.0, (((point.x - begin.x) * segment.x) + ((point.y - begin.y) * segment.y))
+        / squaredLength));
+    }
+    return std::hypot(point.x - begin.x - (ratio * segment.x), point.y - begin.y - (ratio * segment.y));
+  }
+
+  double getAreaOfTriangle(const klimchuk::point_t& a, const klimchuk::point_t& b, const klimchuk::point_t& c)
+  {
+    return std::abs(((b.x - a.x) * (c.y - a.y)) - ((b.y - a.y) * (c.x - a.x))) / 2;
+  }
+
+  template < typename Node >
+  uint32_t getWritableNode(std::vector<Node>& nodes, uint32_t index, uint32_t firstOfVersion)
+  {
+    if (index >= firstOfVersion)
+    {
+      return index;
+    }
+    nodes.push_back(nodes[index]);
+    return static_cast<uint32_t>(nodes.size() - 1);
+  }
+
+  template < typename Node, typename Piece >
+  uint32_t mergeNodes(std::vector<Node>& nodes, const std::vector<Piece>& pieces, uint32_t lower, uint32_t upper,
+    uint32_t firstOfVersion)
+  {
+    if ((lower == 0) || (upper == 0))
+    {
+      return lower + upper;
+    }
+    if (pieces[nodes[lower].piece].priority > pieces[nodes[upper].piece].priority)
+    {
+      const uint32_t node = getWritableNode(nodes, lower, firstOfVersion);
+      const uint32_t right = mergeNodes(nodes, pieces, nodes[node].right, upper, firstOfVersion);
+      nodes[node].right = right;
+      return node;
+    }
+    const uint32_t node = getWritableNode(nodes, upper, firstOfVersion);
+    const uint32_t left = mergeNodes(nodes, pieces, lower, nodes[node].left, firstOfVersion);
+    nodes[node].left = left;
+    return node;
+  }
+
+  template < typename Node, typename IsBelow >
+  std::pair<uint32_t, uint32_t> splitNodes(std::vector<Node>& nodes, uint32_t root, const IsBelow& isBelow,
+    uint32_t firstOfVersion)
+  {
+    if (root == 0)
+    {
+      return { 0, 0 };
+    }
+    const uint32_t node = getWritableNode(nodes, root, firstOfVersion);
+    if (isBelow(nodes[node].piece))
+    {
+      const std::pair<uint32_t, uint32_t> parts = splitNodes(nodes, nodes[node].right, isBelow, firstOfVersion);
+      nodes[node].right = parts.first;
+      return { node, parts.second };
+    }
+    const std::pair<uint32_t, uint32_t> parts = splitNodes(nodes, nodes[node].left, isBelow, firstOfVersion);
+    nodes[node].left = parts.second;
+    return { parts.first, node };
+  }
+
+  bool isAbove(const klimchuk::point_t& lhs, const klimchuk::point_t& rhs)
+  {
+    return (lhs.y > rhs.y) || ((lhs.y == rhs.y) && (lhs.x < rhs.x));
+  }
+
+  std::vector<std::pair<size_t, size_t>> getMonotoneDiagonals(const std::vector<klimchuk::point_t>& ring)
+  {
+    const size_t size = ring.size();
+    std::vector<size_t> order(size);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&ring](size_t lhs, size_t rhs)
+    {
+      return isAbove(ring[lhs], ring[rhs]);
+    });
+    double sweepX = 0.0;
+    double sweepY = 0.0;
+    auto getX = [&ring, &sweepX, &sweepY, size](size_t edge)
+    {
+      if (edge == size)
+      {
+        return sweepX;
+      }
+      const klimchuk::point_t& begin = ring[edge];
+      const klimchuk::point_t& end = ring[(edge + 1) % size];
+      if (begin.y == end.y)
+      {
+        return std::max(begin.x, end.x);
+      }
+      return begin.x + ((sweepY - begin.y) * (end.x - begin.x) / (end.y - begin.y));
+    };
+    auto isLess = [&getX](size_t lhs, size_t rhs)
+    {
+      const double lhsX = getX(lhs);
+      const double rhsX = getX(rhs);
+      return (lhsX < rhsX) || ((lhsX == rhsX) && (lhs < rhs));
+    };
+    typedef std::set<size_t, decltype(isLess)> status_t;
+    status_t status(isLess);
+    std::vector<status_t::iterator> positions(size, status.end());
+    std::vector<size_t> helpers(size, 0);
+    std::vector<bool> isMerge(size, false);
+    std::vector<std::pair<size_t, size_t>> diagonals;
+
+    for (size_t vertex : order)
+    {
+      sweepX = ring[vertex].x;
+      sweepY = ring[vertex].y;
+      const size_t previous = (vertex + size - 1) % size;
+      const size_t next = (vertex + 1) % size;
+      const bool isPreviousBelow = isAbove(ring[vertex], ring[previous]);
+      const bool isNextBelow = isAbove(ring[vertex], ring[next]);
+      const bool isConvex = getOrientation(ring[previous], ring[vertex], ring[next]) > 0.0;
+      auto connectHelper = [&diagonals, &helpers, &isMerge, vertex](size_t edge)
+      {
+        if (isMerge[helpers[edge]])
+        {
+          diagonals.push_back({ vertex, helpers[edge] });
+        }
+      };
+      auto getLeftEdge = [&status, size]()
+      {
+        status_t::iterator position = status.lower_bound(size);
+        if (position == status.begin())
+        {
+          throw std::invalid_argument("Polygon: Polygon is not simple.");
+        }
+        return *std::prev(position);
+      };
+      auto insertEdge = [&status, &positions, &helpers, vertex]()
+      {
+        helpers[vertex] = vertex;
+        positions[vertex] = status.insert(vertex).first;
+      };
+      auto eraseEdge = [&status, &positions, &connectHelper](size_t edge)
+      {
+        connectHelper(edge);
+        if (positions[edge] != status.end())
+        {
+          status.erase(positions[edge]);
+          positions[edge] = status.end();
+        }
+      };
+      if (isPreviousBelow && isNextBelow)
+      {
+        if (!isConvex)
+        {
+          const size_t left = getLeftEdge();
+          diagonals.push_back({ vertex, helpers[left] });
+          helpers[left] = vertex;
+        }
+        insertEdge();
+      }
+      else if (!isPreviousBelow && !isNextBelow)
+      {
+        eraseEdge(previous);
+        if (!isConvex)
+        {
+          isMerge[vertex] = true;
+          const size_t left = getLeftEdge();
+          connectHelper(left);
+          helpers[left] = vertex;
+        }
+      }
+      else if (!isPreviousBelow)
+      {
+        eraseEdge(previous);
+        insertEdge();
+      }
+      else
+      {
+        const size_t left = getLeftEdge();
+        connectHelper(left);
+        helpers[left] = vertex;
+      }
+    }
+    return diagonals;
+  }
+
+  std::vector<std::vector<size_t>> getMonotonePieces(const std::vector<klimchuk::point_t>& ring,
+    const std::vector<std::pair<size_t, size_t>>& diagonals)
+  {
+    const size_t size = ring.size();
+    std::vector<std::vector<size_t>> neighbours(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+      neighbours[i] = { (i + size - 1) % size, (i + 1) % size };
+    }
+    for (const std::pair<size_t, size_t>& diagonal : diagonals)
+    {
+      neighbours[diagonal.first].push_back(diagonal.second);
+      neighbours[diagonal.second].push_back(diagonal.first);
+    }
+    std::vector<std::vector<bool>> isVisited(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+      const klimchuk::point_t& centre = ring[i];
+      std::sort(neighbours[i].begin(), neighbours[i].end(), [&ring, &centre](size_t lhs, size_t rhs)
+      {
+        return std::atan2(ring[lhs].y - centre.y, ring[lhs].x - centre.x)
+          < std::atan2(ring[rhs].y - centre.y, ring[rhs].x - centre.x);
+      });
+      isVisited[i].assign(neighbours[i].size(), false);
+    }
+    auto getPosition = [&neighbours](size_t vertex, size_t neighbour)
+    {
+      return static_cast<size_t>(std::find(neighbours[vertex].begin(), neighbours[vertex].end(), neighbour)
+        - neighbours[vertex].begin());
+    };
+
+    std::vector<std::vector<size_t>> pieces;
+    for (size_t start = 0; start < size; ++start)
+    {
+      for (size_t k = 0; k < neighbours[start].size(); ++k)
+      {
+        if (isVisited[start][k] || (neighbours[start][k] == (start + size - 1) % size))
+        {
+          continue;
+        }
+        std::vector<size_t> piece;
+        size_t from = start;
+        size_t position = k;
+        while (!isVisited[from][position])
+        {
+          isVisited[from][position] = true;
+          piece.push_back(from);
+          const size_t to = neighbours[from][position];
+          const size_t degree = neighbours[to].size();
+          position = (getPosition(to, from) + degree - 1) % degree;
+          from = to;
+        }
+        pieces.push_back(std::move(piece));
+      }
+    }
+    return pieces;
+  }
+
+  void triangulateMonotonePiece(const std::vector<klimchuk::point_t>& ring, const std::vector<size_t>& piece,
+    std::vector<size_t>& triangles)
+  {
+    auto addTriangle = [&ring, &triangles](size_t a, size_t b, size_t c)
+    {
+      if (getOrientation(ring[a], ring[b], ring[c]) < 0.0)
+      {
+        std::swap(b, c);
+      }
+      triangles.insert(triangles.end(), { a, b, c });
+    };
+    const size_t size = piece.size();
+    size_t top = 0;
+    size_t bottom = 0;
+    for (size_t i = 1; i < size; ++i)
+    {
+      top = isAbove(ring[piece[i]], ring[piece[top]]) ? i : top;
+      bottom = isAbove(ring[piece[bottom]], ring[piece[i]]) ? i : bottom;
+    }
+    std::vector<bool> isLeft(size, false);
+    for (size_t i = top; i != bottom; i = (i + 1) % size)
+    {
+      isLeft[i] = true;
+    }
+    std::vector<size_t> order(size);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&ring, &piece](size_t lhs, size_t rhs)
+    {
+      return isAbove(ring[piece[lhs]], ring[piece[rhs]]);
+    });
+
+    std::vector<size_t> stack{ order[0], order[1] };
+    for (size_t j = 2; j + 1 < size; ++j)
+    {
+      const size_t current = order[j];
+      if (isLeft[current] != isLeft[stack.back()])
+      {
+        for (size_t i = 0; i + 1 < stack.size(); ++i)
+        {
+          addTriangle(piece[current], piece[stack[i]], piece[stack[i + 1]]);
+        }
+        stack = { order[j - 1], current };
+      }
+      else
+      {
+        size_t last = stack.back();
+        stack.pop_back();
+        while (!stack.empty())
+        {
+          const double turn = getOrientation(ring[piece[current]], ring[piece[last]], ring[piece[stack.back()]]);
+          if (isLeft[current] ? (turn >= 0.0) : (turn <= 0.0))
+          {
+            break;
+          }
+          addTriangle(piece[current], piece[last], piece[stack.back()]);
+          last = stack.back();
+          stack.pop_back();
+        }
+        stack.push_back(last);
+        stack.push_back(current);
+      }
+    }
+    for (size_t i = 0; i + 1 < stack.size(); ++i)
+    {
+      addTriangle(piece[order[size - 1]], piece[stack[i]], piece[stack[i + 1]]);
+    }
+  }
+}
 
 klimchuk::Polygon::Polygon(const std::initializer_list<point_t> points):
-  size_{ points.size() },
-  points_{ std::make_unique<point_t[]>(size_) }
+  Polygon(points.begin(), points.size())
+{}
+
+klimchuk::Polygon::Polygon(const point_t* points, size_t size):
+  size_{ size },
+  points_{ std::make_unique<point_t[]>(size_) },
+  cache_{ nullptr }
 {
   if (size_ < 3)
   {
     throw std::length_error("Polygon: Invalid initializer list to construct object");
   }
-  size_t i = 0;
-  for (point_t element : points)
+  for (size_t i = 0; i < size_; ++i)
   {
-    points_[i] = element;
-    ++i;
+    points_[i] = points[i];
   }
-  if (getArea() == 0.0)
+  checkPoints();
+}
+
+klimchuk::Polygon::Polygon(const uint8_t* encoded, size_t sizeOfEncoded):
+  size_{ getNumberOfEncodedVertices(encoded, sizeOfEncoded) },
+  points_{ std::make_unique<point_t[]>(size_) },
+  cache_{ nullptr }
+{
+  if (size_ < 3)
+  {
+    throw std::length_error("Polygon: Invalid encoded block to construct object");
+  }
+  decodeVertices(encoded, sizeOfEncoded, points_.get());
+  checkPoints();
+}
+
+klimchuk::Polygon::Polygon(Polygon&& rhs) noexcept:
+  Shape(rhs),
+  size_{ rhs.size_ },
+  points_{ std::move(rhs.points_) },
+  cache_{ rhs.cache_.exchange(nullptr) }
+{}
+
+klimchuk::Polygon::~Polygon()
+{
+  delete cache_.load();
+}
+
+klimchuk::Polygon& klimchuk::Polygon::operator=(Polygon&& rhs) noexcept
+{
+  if (this != &rhs)
+  {
+    Shape::operator=(rhs);
+    size_ = rhs.size_;
+    points_ = std::move(rhs.points_);
+    delete cache_.exchange(rhs.cache_.exchange(nullptr));
+  }
+  return *this;
+}
+
+void klimchuk::Polygon::checkPoints() const
+{
+  size_t other = 1;
+  while ((other < size_) && (points_[other].x == points_[0].x) && (points_[other].y == points_[0].y))
+  {
+    ++other;
+  }
+  size_t third = other + 1;
+  while ((third < size_) && (getOrientation(points_[0], points_[other], points_[third]) == 0.0))
+  {
+    ++third;
+  }
+  if ((third >= size_) || (getArea() == 0.0))
   {
     throw std::invalid_argument("Polygot: Area of polygon should be more than zero");
   }
@@ -71,8 +455,14 @@ klimchuk::rectangle_t klimchuk::Polygon::getFrameRect() const
   return rectangle_t{ maxX - minX, maxY - minY, frameCenter};
 }
 
+klimchuk::oriented_rectangle_t klimchuk::Polygon::getOrientedFrameRect() const
+{
+  return getMinimumAreaRect(points_.get(), size_);
+}
+
 void klimchuk::Polygon::move(const point_t& point)
 {
+  const Journal::Scope scope(Journal::Operation::MOVE_TO, *this, point.x, point.y);
   point_t centreOfPolygon = getCentre();
   double moveAbscissa = point.x - centreOfPolygon.x;
   double moveOrdinate = point.y - centreOfPolygon.y;
@@ -81,15 +471,23 @@ void klimchuk::Polygon::move(const point_t& point)
 
 void klimchuk::Polygon::move(double moveAbscissa, double moveOrdinate)
 {
+  const Journal::Scope scope(Journal::Operation::MOVE_BY, *this, moveAbscissa, moveOrdinate);
   for (size_t i = 0; i < size_; ++i)
   {
     points_[i].x += moveAbscissa;
     points_[i].y += moveOrdinate;
   }
+  if (cache_t* cache = cache_.load(std::memory_order_acquire))
+  {
+    cache->transform.shift.x += moveAbscissa;
+    cache->transform.shift.y += moveOrdinate;
+  }
+  invalidateOwners();
 }
 
 void klimchuk::Polygon::scale(double coefficient)
 {
+  const Journal::Scope scope(Journal::Operation::SCALE, *this, coefficient);
   if (coefficient <= 0.0)
   {
     throw std::invalid_argument("Polygon: Coefficient for scaling must be more, than zero");
@@ -98,10 +496,23 @@ void klimchuk::Polygon::scale(double coefficient)
   point_t resultOfScaling = { 0.0, 0.0 };
   for (size_t i = 0; i < size_; ++i)
   {
-    resultOfScaling.x = (points_[i].x - centreOfPolygon.x) * coefficient;
-    resultOfScaling.y = (points_[i].y - centreOfPolygon.y) * coefficient;
+    resultOfScaling.x = centreOfPolygon.x + (points_[i].x - centreOfPolygon.x) * coefficient;
+    resultOfScaling.y = centreOfPolygon.y + (points_[i].y - centreOfPolygon.y) * coefficient;
     points_[i] = resultOfScaling;
   }
+  if (cache_t* cache = cache_.load(std::memory_order_acquire))
+  {
+    for (level_t& level : cache->levels)
+    {
+      level.error *= coefficient;
+    }
+    transform_t& transform = cache->transform;
+    transform.cosine *= coefficient;
+    transform.sine *= coefficient;
+    transform.shift.x = centreOfPolygon.x + (transform.shift.x - centreOfPolygon.x) * coefficient;
+    transform.shift.y = centreOfPolygon.y + (transform.shift.y - centreOfPolygon.y) * coefficient;
+  }
+  invalidateOwners();
 }
 
 klimchuk::point_t klimchuk::Polygon::getCentre() const
@@ -119,6 +530,7 @@ klimchuk::point_t klimchuk::Polygon::getCentre() const
 
 void klimchuk::Polygon::rotate(double angle)
 {
+  const Journal::Scope scope(Journal::Operation::ROTATE, *this, angle);
   angle *= M_PI / 180;
   double cosinusOfAngle = cos(angle);
   double sinusOfAngle = sin(angle);
@@ -131,9 +543,519 @@ void klimchuk::Polygon::rotate(double angle)
     points_[i].x = resultOfRotating.x * cosinusOfAngle - resultOfRotating.y * sinusOfAngle + centreOfPolygon.x;
     points_[i].y = resultOfRotating.y * cosinusOfAngle + resultOfRotating.x * sinusOfAngle + centreOfPolygon.y;
   }
+  if (cache_t* cache = cache_.load(std::memory_order_acquire))
+  {
+    const transform_t transform = cache->transform;
+    cache->transform.cosine = transform.cosine * cosinusOfAngle - transform.sine * sinusOfAngle;
+    cache->transform.sine = transform.sine * cosinusOfAngle + transform.cosine * sinusOfAngle;
+    resultOfRotating.x = transform.shift.x - centreOfPolygon.x;
+    resultOfRotating.y = transform.shift.y - centreOfPolygon.y;
+    cache->transform.shift.x = resultOfRotating.x * cosinusOfAngle - resultOfRotating.y * sinusOfAngle
+      + centreOfPolygon.x;
+    cache->transform.shift.y = resultOfRotating.y * cosinusOfAngle + resultOfRotating.x * sinusOfAngle
+      + centreOfPolygon.y;
+  }
+  invalidateOwners();
+}
+
+uint64_t klimchuk::Polygon::getHash() const
+{
+  uint64_t hash = hashCombine(HASH_SEED, static_cast<uint64_t>(size_));
+  for (size_t i = 0; i < size_; ++i)
+  {
+    hash = hashCombine(hash, points_[i]);
+  }
+  return hash;
 }
 
 size_t klimchuk::Polygon::getSize() const
 {
   return size_;
 }
+
+klimchuk::Polygon klimchuk::Polygon::simplify(double tolerance, Simplification method) const
+{
+  if (tolerance < 0.0)
+  {
+    throw std::invalid_argument("Polygon: Tolerance must not be negative.");
+  }
+  std::vector<size_t> indexes = getSimplifiedIndexes(tolerance, method);
+  std::vector<point_t> points(indexes.size());
+  for (size_t i = 0; i < indexes.size(); ++i)
+  {
+    points[i] = points_[indexes[i]];
+  }
+  return Polygon(points.data(), points.size());
+}
+
+size_t klimchuk::Polygon::getNumberOfLevels() const
+{
+  cacheLevels();
+  return getCache().levels.size() + 1;
+}
+
+size_t klimchuk::Polygon::getLevelOfDetail(double tolerance) const
+{
+  cacheLevels();
+  const std::vector<level_t>& levels = getCache().levels;
+  size_t level = 0;
+  while ((level < levels.size()) && (levels[level].error <= tolerance))
+  {
+    ++level;
+  }
+  return level;
+}
+
+double klimchuk::Polygon::getErrorOfLevel(size_t level) const
+{
+  cacheLevels();
+  const std::vector<level_t>& levels = getCache().levels;
+  if (level > levels.size())
+  {
+    throw std::out_of_range("Polygon: Invalid level of detail.");
+  }
+  return (level == 0) ? 0.0 : levels[level - 1].error;
+}
+
+std::vector<klimchuk::point_t> klimchuk::Polygon::getPointsOfLevel(size_t level) const
+{
+  cacheLevels();
+  const std::vector<level_t>& levels = getCache().levels;
+  if (level > levels.size())
+  {
+    throw std::out_of_range("Polygon: Invalid level of detail.");
+  }
+  if (level == 0)
+  {
+    return std::vector<point_t>(points_.get(), points_.get() + size_);
+  }
+  const std::vector<size_t>& indexes = levels[level - 1].indexes;
+  std::vector<point_t> points(indexes.size());
+  for (size_t i = 0; i < indexes.size(); ++i)
+  {
+    points[i] = points_[indexes[i]];
+  }
+  return points;
+}
+
+std::vector<size_t> klimchuk::Polygon::getTriangulation() const
+{
+  cache_t& cache = getCache();
+  std::call_once(cache.areTrianglesCached, [this, &cache]()
+  {
+    double area = 0.0;
+    for (size_t i = 0; i < size_; ++i)
+    {
+      const point_t& next = points_[(i + 1) % size_];
+      area += (points_[i].x * next.y) - (points_[i].y * next.x);
+    }
+    std::vector<size_t> order;
+    for (size_t i = 0; i < size_; ++i)
+    {
+      const point_t& next = points_[(i + 1) % size_];
+      if ((points_[i].x != next.x) || (points_[i].y != next.y))
+      {
+        order.push_back(i);
+      }
+    }
+    if (area < 0.0)
+    {
+      std::reverse(order.begin(), order.end());
+    }
+    std::vector<point_t> ring(order.size());
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+      ring[i] = points_[order[i]];
+    }
+    std::vector<size_t> triangles;
+    triangles.reserve(3 * (ring.size() - 2));
+    for (const std::vector<size_t>& piece : getMonotonePieces(ring, getMonotoneDiagonals(ring)))
+    {
+      triangulateMonotonePiece(ring, piece, triangles);
+    }
+    for (size_t& index : triangles)
+    {
+      index = order[index];
+    }
+    cache.triangles = std::move(triangles);
+  });
+  return cache.triangles;
+}
+
+bool klimchuk::Polygon::contains(const point_t& point) const
+{
+  cacheSlabs();
+  const std::vector<double>& slabs = getCache().slabs;
+  const point_t pointOfSlabs = getPointOfSlabs(point);
+  if ((pointOfSlabs.x < slabs.front()) || (pointOfSlabs.x >= slabs.back()))
+  {
+    return false;
+  }
+  const size_t slab = std::upper_bound(slabs.begin(), slabs.end(), pointOfSlabs.x) - slabs.begin() - 1;
+  return isInsideSlab(slab, pointOfSlabs);
+}
+
+std::vector<bool> klimchuk::Polygon::contains(const point_t* points, size_t numberOfPoints) const
+{
+  if (!points && (numberOfPoints != 0))
+  {
+    throw std::invalid_argument("Polygon: Array of points is empty.");
+  }
+  cacheSlabs();
+  const std::vector<double>& slabs = getCache().slabs;
+  std::vector<point_t> pointsOfSlabs(numberOfPoints);
+  for (size_t i = 0; i < numberOfPoints; ++i)
+  {
+    pointsOfSlabs[i] = getPointOfSlabs(points[i]);
+  }
+  std::vector<size_t> order(numberOfPoints);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&pointsOfSlabs](size_t lhs, size_t rhs)
+  {
+    return pointsOfSlabs[lhs].x < pointsOfSlabs[rhs].x;
+  });
+  std::vector<bool> results(numberOfPoints, false);
+  size_t slab = 0;
+  for (size_t index : order)
+  {
+    const point_t& point = pointsOfSlabs[index];
+    if ((point.x < slabs.front()) || (point.x >= slabs.back()))
+    {
+      continue;
+    }
+    while (slabs[slab + 1] <= point.x)
+    {
+      ++slab;
+    }
+    results[index] = isInsideSlab(slab, point);
+  }
+  return results;
+}
+
+std::vector<uint8_t> klimchuk::Polygon::encode(double quantum) const
+{
+  return encodeVertices(points_.get(), size_, quantum);
+}
+
+std::vector<size_t> klimchuk::Polygon::getSimplifiedIndexes(double tolerance, Simplification method) const
+{
+  std::vector<bool> isKept(size_, method == Simplification::VISVALINGAM);
+  if (method == Simplification::DOUGLAS_PEUCKER)
+  {
+    size_t farthest = 0;
+    double maxDistance = 0.0;
+    for (size_t i = 1; i < size_; ++i)
+    {
+      const double distance = std::hypot(points_[i].x - points_[0].x, points_[i].y - points_[0].y);
+      if (distance > maxDistance)
+      {
+        maxDistance = distance;
+        farthest = i;
+      }
+    }
+    isKept[0] = true;
+    isKept[farthest] = true;
+    std::vector<std::pair<size_t, size_t>> chains{ { 0, farthest }, { farthest, size_ } };
+    while (!chains.empty())
+    {
+      const std::pair<size_t, size_t> chain = chains.back();
+      chains.pop_back();
+      const point_t& begin = points_[chain.first];
+      const point_t& end = points_[chain.second % size_];
+      size_t splitter = chain.first;
+      double maxDeviation = tolerance;
+      for (size_t i = chain.first + 1; i < chain.second; ++i)
+      {
+        const double deviation = getDistanceToSegment(points_[i], begin, end);
+        if (deviation > maxDeviation)
+        {
+          maxDeviation = deviation;
+          splitter = i;
+        }
+      }
+      if (splitter != chain.first)
+      {
+        isKept[splitter] = true;
+        chains.push_back({ chain.first, splitter });
+        chains.push_back({ splitter, chain.second });
+      }
+    }
+    if (std::count(isKept.begin(), isKept.end(), true) < 3)
+    {
+      size_t widest = 0;
+      double maxArea = -1.0;
+      for (size_t i = 0; i < size_; ++i)
+      {
+        const double area = getAreaOfTriangle(points_[0], points_[farthest], points_[i]);
+        if (area > maxArea)
+        {
+          maxArea = area;
+          widest = i;
+        }
+      }
+      isKept[widest] = true;
+    }
+  }
+  else
+  {
+    std::vector<size_t> previous(size_);
+    std::vector<size_t> next(size_);
+    std::vector<double> areas(size_);
+    typedef std::pair<double, size_t> candidate_t;
+    std::priority_queue<candidate_t, std::vector<candidate_t>, std::greater<candidate_t>> candidates;
+    for (size_t i = 0; i < size_; ++i)
+    {
+      previous[i] = (i + size_ - 1) % size_;
+      next[i] = (i + 1) % size_;
+      areas[i] = getAreaOfTriangle(points_[previous[i]], points_[i], points_[next[i]]);
+      candidates.push({ areas[i], i });
+    }
+    const double maxArea = tolerance * tolerance;
+    size_t size = size_;
+    while ((size > 3) && !candidates.empty() && (candidates.top().first <= maxArea))
+    {
+      const candidate_t candidate = candidates.top();
+      candidates.pop();
+      const size_t index = candidate.second;
+      if (!isKept[index] || (candidate.first != areas[index]))
+      {
+        continue;
+      }
+      isKept[index] = false;
+      --size;
+      next[previous[index]] = next[index];
+      previous[next[index]] = previous[index];
+      for (size_t neighbour : { previous[index], next[index] })
+      {
+        areas[neighbour] = std::max(candidate.first,
+          getAreaOfTriangle(points_[previous[neighbour]], points_[neighbour], points_[next[neighbour]]));
+        candidates.push({ areas[neighbour], neighbour });
+      }
+    }
+  }
+
+  std::vector<size_t> indexes;
+  for (size_t i = 0; i < size_; ++i)
+  {
+    if (isKept[i])
+    {
+      indexes.push_back(i);
+    }
+  }
+  double area = 0.0;
+  for (size_t i = 0; i < indexes.size(); ++i)
+  {
+    const point_t& point = points_[indexes[i]];
+    const point_t& nextPoint = points_[indexes[(i + 1) % indexes.size()]];
+    area += (point.x * nextPoint.y) - (point.y * nextPoint.x);
+  }
+  if (area == 0.0)
+  {
+    indexes.resize(size_);
+    for (size_t i = 0; i < size_; ++i)
+    {
+      indexes[i] = i;
+    }
+  }
+  return indexes;
+}
+
+void klimchuk::Polygon::cacheLevels() const
+{
+  cache_t& cache = getCache();
+  std::call_once(cache.areLevelsCached, [this, &cache]()
+  {
+    if (size_ < MIN_SIZE_FOR_LEVELS)
+    {
+      return;
+    }
+    const rectangle_t frame = getFrameRect();
+    const double extent = std::max(frame.width, frame.height);
+    size_t sizeOfLevel = size_;
+    for (double tolerance = extent / 1024; (tolerance < extent / 2) && (cache.levels.size() < MAX_NUMBER_OF_LEVELS)
+      && (sizeOfLevel > 4); tolerance *= 2)
+    {
+      std::vector<size_t> indexes = getSimplifiedIndexes(tolerance, Simplification::DOUGLAS_PEUCKER);
+      if (4 * indexes.size() <= 3 * sizeOfLevel)
+      {
+        sizeOfLevel = indexes.size();
+        cache.levels.push_back({ tolerance, std::move(indexes) });
+      }
+    }
+  });
+}
+
+void klimchuk::Polygon::cacheSlabs() const
+{
+  cache_t& cache = getCache();
+  std::call_once(cache.areSlabsCached, [this, &cache]()
+  {
+    const std::vector<size_t> triangles = getTriangulation();
+    std::minstd_rand generator(static_cast<uint32_t>(size_));
+    std::vector<piece_t> pieces;
+    pieces.reserve(2 * triangles.size() / 3);
+    for (size_t i = 0; i < triangles.size(); i += 3)
+    {
+      point_t vertices[3] = { points_[triangles[i]], points_[triangles[i + 1]], points_[triangles[i + 2]] };
+      std::sort(vertices, vertices + 3, [](const point_t& lhs, const point_t& rhs)
+      {
+        return lhs.x < rhs.x;
+      });
+      const double orientation = getOrientation(vertices[0], vertices[2], vertices[1]);
+      if (orientation == 0.0)
+      {
+        continue;
+      }
+      const line_t longest{ vertices[0], vertices[2] };
+      const line_t left{ vertices[0], vertices[1] };
+      const line_t right{ vertices[1], vertices[2] };
+      if (vertices[0].x < vertices[1].x)
+      {
+        pieces.push_back((orientation > 0.0) ? piece_t{ longest, left, 0 } : piece_t{ left, longest, 0 });
+      }
+      if (vertices[1].x < vertices[2].x)
+      {
+        pieces.push_back((orientation > 0.0) ? piece_t{ longest, right, 0 } : piece_t{ right, longest, 0 });
+      }
+    }
+    for (piece_t& piece : pieces)
+    {
+      piece.priority = static_cast<uint32_t>(generator());
+    }
+
+    std::vector<double> slabs(size_);
+    for (size_t i = 0; i < size_; ++i)
+    {
+      slabs[i] = points_[i].x;
+    }
+    std::sort(slabs.begin(), slabs.end());
+    slabs.erase(std::unique(slabs.begin(), slabs.end()), slabs.end());
+    auto getSlab = [&slabs](double x)
+    {
+      return static_cast<size_t>(std::lower_bound(slabs.begin(), slabs.end(), x) - slabs.begin());
+    };
+    std::vector<size_t> beginnings(slabs.size() + 1, 0);
+    std::vector<size_t> endings(slabs.size() + 1, 0);
+    auto getBeginning = [&getSlab](const piece_t& piece)
+    {
+      return getSlab(std::max(piece.bottom.left.x, piece.top.left.x));
+    };
+    auto getEnding = [&getSlab](const piece_t& piece)
+    {
+      return getSlab(std::min(piece.bottom.right.x, piece.top.right.x));
+    };
+    for (const piece_t& piece : pieces)
+    {
+      ++beginnings[getBeginning(piece) + 1];
+      ++endings[getEnding(piece) + 1];
+    }
+    std::partial_sum(beginnings.begin(), beginnings.end(), beginnings.begin());
+    std::partial_sum(endings.begin(), endings.end(), endings.begin());
+    std::vector<uint32_t> piecesByBeginning(pieces.size());
+    std::vector<uint32_t> piecesByEnding(pieces.size());
+    std::vector<size_t> nextBeginnings(beginnings.begin(), beginnings.end() - 1);
+    std::vector<size_t> nextEndings(endings.begin(), endings.end() - 1);
+    for (size_t i = 0; i < pieces.size(); ++i)
+    {
+      piecesByBeginning[nextBeginnings[getBeginning(pieces[i])]++] = static_cast<uint32_t>(i);
+      piecesByEnding[nextEndings[getEnding(pieces[i])]++] = static_cast<uint32_t>(i);
+    }
+
+    auto isBelow = [&pieces](uint32_t lhs, uint32_t rhs)
+    {
+      const line_t& lower = pieces[lhs].bottom;
+      const line_t& upper = pieces[rhs].bottom;
+      if (lower.left.x >= upper.left.x)
+      {
+        const double side = getOrientation(upper.left, upper.right, lower.left);
+        return (side != 0.0) ? (side < 0.0) : (getOrientation(upper.left, upper.right, lower.right) < 0.0);
+      }
+      const double side = getOrientation(lower.left, lower.right, upper.left);
+      return (side != 0.0) ? (side > 0.0) : (getOrientation(lower.left, lower.right, upper.right) > 0.0);
+    };
+    std::vector<slab_node_t> nodes(1, slab_node_t{ 0, 0, 0 });
+    std::vector<uint32_t> roots(slabs.size() - 1, 0);
+    uint32_t root = 0;
+    for (size_t slab = 0; slab + 1 < slabs.size(); ++slab)
+    {
+      const uint32_t firstOfVersion = static_cast<uint32_t>(nodes.size());
+      for (size_t i = endings[slab]; i < endings[slab + 1]; ++i)
+      {
+        const uint32_t removed = piecesByEnding[i];
+        const std::pair<uint32_t, uint32_t> lower = splitNodes(nodes, root, [&isBelow, removed](uint32_t piece)
+        {
+          return (piece != removed) && isBelow(piece, removed);
+        }, firstOfVersion);
+        const std::pair<uint32_t, uint32_t> upper = splitNodes(nodes, lower.second, [removed](uint32_t piece)
+        {
+          return piece == removed;
+        }, firstOfVersion);
+        root = mergeNodes(nodes, pieces, lower.first, upper.second, firstOfVersion);
+      }
+      for (size_t i = beginnings[slab]; i < beginnings[slab + 1]; ++i)
+      {
+        const uint32_t added = piecesByBeginning[i];
+        const std::pair<uint32_t, uint32_t> parts = splitNodes(nodes, root, [&isBelow, added](uint32_t piece)
+        {
+          return isBelow(piece, added);
+        }, firstOfVersion);
+        nodes.push_back(slab_node_t{ added, 0, 0 });
+        const uint32_t node = static_cast<uint32_t>(nodes.size() - 1);
+        root = mergeNodes(nodes, pieces, mergeNodes(nodes, pieces, parts.first, node, firstOfVersion), parts.second,
+          firstOfVersion);
+      }
+      roots[slab] = root;
+    }
+    cache.slabs = std::move(slabs);
+    cache.slabRoots = std::move(roots);
+    cache.slabPieces = std::move(pieces);
+    cache.slabNodes = std::move(nodes);
+    cache.transform = transform_t{ 1.0, 0.0, { 0.0, 0.0 } };
+  });
+}
+
+klimchuk::Polygon::cache_t& klimchuk::Polygon::getCache() const
+{
+  cache_t* cache = cache_.load(std::memory_order_acquire);
+  if (!cache)
+  {
+    std::unique_ptr<cache_t> created = std::make_unique<cache_t>();
+    created->transform = transform_t{ 1.0, 0.0, { 0.0, 0.0 } };
+    if (cache_.compare_exchange_strong(cache, created.get(), std::memory_order_acq_rel, std::memory_order_acquire))
+    {
+      cache = created.release();
+    }
+  }
+  return *cache;
+}
+
+klimchuk::point_t klimchuk::Polygon::getPointOfSlabs(const point_t& point) const
+{
+  const transform_t& transform = getCache().transform;
+  const double x = point.x - transform.shift.x;
+  const double y = point.y - transform.shift.y;
+  const double norm = (transform.cosine * transform.cosine) + (transform.sine * transform.sine);
+  return point_t{ ((transform.cosine * x) + (transform.sine * y)) / norm,
+    ((transform.cosine * y) - (transform.sine * x)) / norm };
+}
+
+bool klimchuk::Polygon::isInsideSlab(size_t slab, const point_t& point) const
+{
+  const cache_t& cache = getCache();
+  const piece_t* below = nullptr;
+  uint32_t node = cache.slabRoots[slab];
+  while (node != 0)
+  {
+    const piece_t& piece = cache.slabPieces[cache.slabNodes[node].piece];
+    if (getOrientation(piece.bottom.left, piece.bottom.right, point) > 0.0)
+    {
+      below = &piece;
+      node = cache.slabNodes[node].right;
+    }
+    else
+    {
+      node = cache.slabNodes[node].left;
+    }
+  }
+  return below && (getOrientation(below->top.left, below->top.right, point) <= 0.0);
+}
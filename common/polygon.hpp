@@ -2,6 +2,10 @@
 #define KLIMcHUK_POLYGON
 
 #include <initializer_list>
+#include <cstdint>
+#include <vector>
+#include <mutex>
+#include <atomic>
 #include "shape.hpp"
 
 namespace klimchuk
@@ -9,20 +13,101 @@ namespace klimchuk
   class Polygon : public Shape
   {
   public:
+    enum class Simplification
+    {
+      DOUGLAS_PEUCKER,
+      VISVALINGAM
+    };
+
     Polygon(const std::initializer_list<point_t> points);
+    Polygon(const point_t* points, size_t size);
+    Polygon(const uint8_t* encoded, size_t sizeOfEncoded);
+    Polygon(Polygon&& rhs) noexcept;
+    ~Polygon();
+    Polygon& operator=(Polygon&& rhs) noexcept;
     const point_t operator[](size_t index) const;
     point_t operator[](size_t index);
     double getArea() const override;
     rectangle_t getFrameRect() const override;
+    oriented_rectangle_t getOrientedFrameRect() const override;
     void move(const point_t& point) override;
     void move(double moveAbscissa, double moveOrdinate) override;
     void scale(double coefficient) override;
     point_t getCentre() const override;
     void rotate(double angle) override;
+    uint64_t getHash() const override;
     size_t getSize() const;
+
+    Polygon simplify(double tolerance, Simplification method = Simplification::DOUGLAS_PEUCKER) const;
+    size_t getNumberOfLevels() const;
+    size_t getLevelOfDetail(double tolerance) const;
+    double getErrorOfLevel(size_t level) const;
+    std::vector<point_t> getPointsOfLevel(size_t level) const;
+
+    std::vector<size_t> getTriangulation() const;
+    bool contains(const point_t& point) const;
+    std::vector<bool> contains(const point_t* points, size_t numberOfPoints) const;
+
+    std::vector<uint8_t> encode(double quantum) const;
   private:
+    struct level_t
+    {
+      double error;
+      std::vector<size_t> indexes;
+    };
+
+    struct line_t
+    {
+      point_t left;
+      point_t right;
+    };
+
+    struct piece_t
+    {
+      line_t bottom;
+      line_t top;
+      uint32_t priority;
+    };
+
+    struct slab_node_t
+    {
+      uint32_t piece;
+      uint32_t left;
+      uint32_t right;
+    };
+
+    struct transform_t
+    {
+      double cosine;
+      double sine;
+      point_t shift;
+    };
+
+    struct cache_t
+    {
+      std::once_flag areLevelsCached;
+      std::vector<level_t> levels;
+      std::once_flag areTrianglesCached;
+      std::vector<size_t> triangles;
+      std::once_flag areSlabsCached;
+      std::vector<double> slabs;
+      std::vector<uint32_t> slabRoots;
+      std::vector<piece_t> slabPieces;
+      std::vector<slab_node_t> slabNodes;
+      transform_t transform;
+    };
+
     size_t size_;
     std::unique_ptr<point_t[]> points_;
+    mutable std::atomic<cache_t*> cache_;
+
+    void checkPoints() const;
+    cache_t& getCache() const;
+    std::vector<size_t> getSimplifiedIndexes(double tolerance, Simplification method) const;
+    void cacheLevels() const;
+    void cacheSlabs() const;
+    point_t getPointOfSlabs(const point_t& point) const;
+    bool isInsideSlab(size_t slab, const point_t& point) const;
   };
 }
 
@@ -0,0 +1,154 @@
+#include "predicates.hpp"
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace
+{
+  typedef std::vector<double> expansion_t;
+
+  const double EPSILON = std::numeric_limits<double>::epsilon() / 2;
+  const double ORIENTATION_ERROR_BOUND = (3.0 + 16.0 * EPSILON) * EPSILON;
+  const double IN_CIRCLE_ERROR_BOUND = (10.0 + 96.0 * EPSILON) * EPSILON;
+
+  void addExact(double a, double b, double& sum, double& error)
+  {
+    sum = a + b;
+    const double virtualB = sum - a;
+    const double virtualA = sum - virtualB;
+    error = (a - virtualA) + (b - virtualB);
+  }
+
+  void grow(expansion_t& expansion, double value)
+  {
+    size_t size = 0;
+    for (double component : expansion)
+    {
+      double error = 0.0;
+      addExact(value, component, value, error);
+      if (error != 0.0)
+      {
+        expansion[size++] = error;
+      }
+    }
+    expansion.resize(size);
+    if (value != 0.0)
+    {
+      expansion.push_back(value);
+    }
+  }
+
+  expansion_t getDifference(double a, double b)
+  {
+    expansion_t expansion{ a };
+    grow(expansion, -b);
+    return expansion;
+  }
+
+  expansion_t add(expansion_t lhs, const expansion_t& rhs)
+  {
+    for (double component : rhs)
+    {
+      grow(lhs, component);
+    }
+    return lhs;
+  }
+
+  expansion_t multiply(const expansion_t& lhs, const expansion_t& rhs)
+  {
+    expansion_t product;
+    for (double left : lhs)
+    {
+      for (double right : rhs)
+      {
+        const double value = left * right;
+        grow(product, std::fma(left, right, -value));
+        grow(product, value);
+      }
+    }
+    return product;
+  }
+
+  expansion_t negate(expansion_t expansion)
+  {
+    for (double& component : expansion)
+    {
+      component = -component;
+    }
+    return expansion;
+  }
+
+  double estimate(const expansion_t& expansion)
+  {
+    double value = 0.0;
+    for (double component : expansion)
+    {
+      value += component;
+    }
+    return value;
+  }
+}
+
+double klimchuk::getOrientation(const point_t& a, const point_t& b, const point_t& c)
+{
+  const double left = (a.x - c.x) * (b.y - c.y);
+  const double right = (a.y - c.y) * (b.x - c.x);
+  const double determinant = left - right;
+  if (std::abs(determinant) >= ORIENTATION_ERROR_BOUND * (std::abs(left) + std::abs(right)))
+  {
+    return determinant;
+  }
+  const double products[][2] = { { a.x, b.y }, { -a.x, c.y }, { -c.x, b.y }, { -a.y, b.x }, { a.y, c.x }, { c.y, b.x } };
+  expansion_t expansion;
+  for (const double (&product)[2] : products)
+  {
+    const double value = product[0] * product[1];
+    grow(expansion, std::fma(product[0], product[1], -value));
+    grow(expansion, value);
+  }
+  return estimate(expansion);
+}
+
+double klimchuk::getInCircle(const point_t& a, const point_t& b, const point_t& c, const point_t& d)
+{
+  const double adx = a.x - d.x;
+  const double ady = a.y - d.y;
+  const double bdx = b.x - d.x;
+  const double bdy = b.y - d.y;
+  const double cdx = c.x - d.x;
+  const double cdy = c.y - d.y;
+  const double bdxcdy = bdx * cdy;
+  const double cdxbdy = cdx * bdy;
+  const double cdxady = cdx * ady;
+  const double adxcdy = adx * cdy;
+  const double adxbdy = adx * bdy;
+  const double bdxady = bdx * ady;
+  const double aLift = (adx * adx) + (ady * ady);
+  const double bLift = (bdx * bdx) + (bdy * bdy);
+  const double cLift = (cdx * cdx) + (cdy * cdy);
+  const double determinant = (aLift * (bdxcdy - cdxbdy)) + (bLift * (cdxady - adxcdy)) + (cLift * (adxbdy - bdxady));
+  const double permanent = ((std::abs(bdxcdy) + std::abs(cdxbdy)) * aLift)
+      + ((std::abs(cdxady) + std::abs(adxcdy)) * bLift) + ((std::abs(adxbdy) + std::abs(bdxady)) * cLift);
+  if (std::abs(determinant) > IN_CIRCLE_ERROR_BOUND * permanent)
+  {
+    return determinant;
+  }
+  const expansion_t exactAdx = getDifference(a.x, d.x);
+  const expansion_t exactAdy = getDifference(a.y, d.y);
+  const expansion_t exactBdx = getDifference(b.x, d.x);
+  const expansion_t exactBdy = getDifference(b.y, d.y);
+  const expansion_t exactCdx = getDifference(c.x, d.x);
+  const expansion_t exactCdy = getDifference(c.y, d.y);
+  auto getLift = [](const expansion_t& dx, const expansion_t& dy)
+  {
+    return add(multiply(dx, dx), multiply(dy, dy));
+  };
+  auto getMinor = [](const expansion_t& dx1, const expansion_t& dy1, const expansion_t& dx2, const expansion_t& dy2)
+  {
+    return add(multiply(dx1, dy2), negate(multiply(dy1, dx2)));
+  };
+  const expansion_t exact = add(add(multiply(getLift(exactAdx, exactAdy), getMinor(exactBdx, exactBdy, exactCdx, exactCdy)),
+      multiply(getLift(exactBdx, exactBdy), getMinor(exactCdx, exactCdy, exactAdx, exactAdy))),
+      multiply(getLift(exactCdx, exactCdy), getMinor(exactAdx, exactAdy, exactBdx, exactBdy)));
+  return estimate(exact);
+}
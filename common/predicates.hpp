@@ -0,0 +1,12 @@
+#ifndef KLIMCHUK_PREDICATES
+#define KLIMCHUK_PREDICATES
+
+#include "base-types.hpp"
+
+namespace klimchuk
+{
+  double getOrientation(const point_t& a, const point_t& b, const point_t& c);
+  double getInCircle(const point_t& a, const point_t& b, const point_t& c, const point_t& d);
+}
+
+#endif
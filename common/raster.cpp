@@ -0,0 +1,375 @@
+#include "raster.hpp"
+#include <stdexcept>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <exception>
+#include <cmath>
+
+namespace
+{
+  const size_t SIZE_OF_TILE = 64;
+
+  template < typename Function >
+  void runInThreads(size_t numberOfThreads, Function function)
+  {
+    std::vector<std::exception_ptr> errors(numberOfThreads);
+    auto run = [&function, &errors](size_t indexOfThread)
+    {
+      try
+      {
+        function(indexOfThread);
+      }
+      catch (...)
+      {
+        errors[indexOfThread] = std::current_exception();
+      }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(numberOfThreads - 1);
+    try
+    {
+      for (size_t i = 1; i < numberOfThreads; ++i)
+      {
+        threads.emplace_back(run, i);
+      }
+    }
+    catch (...)
+    {
+      for (std::thread& thread : threads)
+      {
+        thread.join();
+      }
+      throw;
+    }
+    run(0);
+    for (std::thread& thread : threads)
+    {
+      thread.join();
+    }
+    for (const std::exception_ptr& error : errors)
+    {
+      if (error)
+      {
+        std::rethrow_exception(error);
+      }
+    }
+  }
+
+  void flatten(klimchuk::outlines_t& outlines, std::vector<size_t>& layers,
+    const std::vector<klimchuk::Shape::ConstShapePtr>& shapes, const std::vector<size_t>& layersOfShapes,
+    double tolerance, size_t numberOfThreads)
+  {
+    numberOfThreads = std::max<size_t>(1, std::min(numberOfThreads, shapes.size()));
+    std::vector<klimchuk::outlines_t> parts(numberOfThreads);
+    std::vector<std::vector<size_t>> layersOfParts(numberOfThreads);
+    runInThreads(numberOfThreads, [&](size_t indexOfThread)
+    {
+      klimchuk::outlines_t& part = parts[indexOfThread];
+      const size_t last = shapes.size() * (indexOfThread + 1) / numberOfThreads;
+      for (size_t i = shapes.size() * indexOfThread / numberOfThreads; i < last; ++i)
+      {
+        klimchuk::addOutlines(part, shapes[i], tolerance);
+        layersOfParts[indexOfThread].resize(part.outlines.size(), layersOfShapes[i]);
+      }
+    });
+
+    size_t numberOfOutlines = 0;
+    size_t numberOfVertices = 0;
+    for (const klimchuk::outlines_t& part : parts)
+    {
+      numberOfOutlines += part.outlines.size();
+      numberOfVertices += part.vertices.size();
+    }
+    outlines.outlines.reserve(numberOfOutlines);
+    outlines.vertices.reserve(numberOfVertices);
+    outlines.frames.reserve(numberOfOutlines);
+    layers.reserve(numberOfOutlines);
+    for (size_t i = 0; i < numberOfThreads; ++i)
+    {
+      const size_t offset = outlines.vertices.size();
+      for (klimchuk::outline_t outline : parts[i].outlines)
+      {
+        outline.begin += offset;
+        outline.end += offset;
+        outlines.outlines.push_back(outline);
+      }
+      outlines.vertices.insert(outlines.vertices.end(), parts[i].vertices.begin(), parts[i].vertices.end());
+      outlines.frames.insert(outlines.frames.end(), parts[i].frames.begin(), parts[i].frames.end());
+      layers.insert(layers.end(), layersOfParts[i].begin(), layersOfParts[i].end());
+    }
+  }
+}
+
+klimchuk::Raster::Raster(size_t width, size_t height, const rectangle_t& viewport):
+  width_{ width },
+  height_{ height },
+  viewport_{ viewport },
+  pixels_(width * height, 0)
+{
+  if ((width == 0) || (height == 0))
+  {
+    throw std::invalid_argument("Raster: Size of image must be more than zero.");
+  }
+  if ((viewport.width <= 0.0) || (viewport.height <= 0.0))
+  {
+    throw std::invalid_argument("Raster: Viewport must have positive size.");
+  }
+}
+
+void klimchuk::Raster::render(const CompositeShape& compositeShape, Mode mode, size_t numberOfThreads)
+{
+  std::vector<Shape::ConstShapePtr> shapes;
+  std::vector<size_t> layersOfShapes;
+  shapes.reserve(compositeShape.getSize());
+  layersOfShapes.reserve(compositeShape.getSize());
+  for (size_t i = 0; i < compositeShape.getSize(); ++i)
+  {
+    shapes.push_back(compositeShape[i]);
+    layersOfShapes.push_back(i);
+  }
+  fill(shapes, layersOfShapes, mode, numberOfThreads);
+}
+
+void klimchuk::Raster::render(const Matrix& matrix, Mode mode, size_t numberOfThreads)
+{
+  std::vector<Shape::ConstShapePtr> shapes;
+  std::vector<size_t> layersOfShapes;
+  shapes.reserve(matrix.getSizeOfMatrix());
+  layersOfShapes.reserve(matrix.getSizeOfMatrix());
+  for (size_t i = 0; i < matrix.getNumberOFLayers(); ++i)
+  {
+    const Matrix::Layer layer = matrix[i];
+    for (size_t j = 0; j < matrix.getSizeOfLayer(i); ++j)
+    {
+      shapes.push_back(layer[j]);
+      layersOfShapes.push_back(i);
+    }
+  }
+  fill(shapes, layersOfShapes, mode, numberOfThreads);
+}
+
+void klimchuk::Raster::clear()
+{
+  std::fill(pixels_.begin(), pixels_.end(), 0);
+}
+
+unsigned int klimchuk::Raster::operator()(size_t column, size_t row) const
+{
+  if ((column >= width_) || (row >= height_))
+  {
+    throw std::out_of_range("Raster: Invalid index to access.");
+  }
+  return pixels_[(row * width_) + column];
+}
+
+size_t klimchuk::Raster::getWidth() const
+{
+  return width_;
+}
+
+size_t klimchuk::Raster::getHeight() const
+{
+  return height_;
+}
+
+const klimchuk::rectangle_t& klimchuk::Raster::getViewport() const
+{
+  return viewport_;
+}
+
+void klimchuk::Raster::writePgm(std::ostream& stream) const
+{
+  const unsigned int maxValue = std::max(1u, *std::max_element(pixels_.begin(), pixels_.end()));
+  stream << "P5\n" << width_ << ' ' << height_ << "\n255\n";
+  std::vector<char> row(width_);
+  for (size_t i = 0; i < height_; ++i)
+  {
+    for (size_t j = 0; j < width_; ++j)
+    {
+      row[j] = static_cast<char>(static_cast<unsigned long long>(pixels_[(i * width_) + j]) * 255 / maxValue);
+    }
+    stream.write(row.data(), row.size());
+  }
+  if (!stream)
+  {
+    throw std::runtime_error("Raster: Can't write image.");
+  }
+}
+
+void klimchuk::Raster::writePpm(std::ostream& stream) const
+{
+  stream << "P6\n" << width_ << ' ' << height_ << "\n255\n";
+  std::vector<char> row(3 * width_);
+  for (size_t i = 0; i < height_; ++i)
+  {
+    for (size_t j = 0; j < width_; ++j)
+    {
+      const unsigned int value = pixels_[(i * width_) + j];
+      const unsigned int colour = (value == 0) ? 0 : (value * 2654435761u) | 0x404040u;
+      row[3 * j] = static_cast<char>(colour >> 16);
+      row[(3 * j) + 1] = static_cast<char>(colour >> 8);
+      row[(3 * j) + 2] = static_cast<char>(colour);
+    }
+    stream.write(row.data(), row.size());
+  }
+  if (!stream)
+  {
+    throw std::runtime_error("Raster: Can't write image.");
+  }
+}
+
+void klimchuk::Raster::fill(const std::vector<Shape::ConstShapePtr>& shapes, const std::vector<size_t>& layersOfShapes,
+  Mode mode, size_t numberOfThreads)
+{
+  if (numberOfThreads == 0)
+  {
+    throw std::invalid_argument("Raster: Number of threads must be more than zero.");
+  }
+  outlines_t outlines;
+  std::vector<size_t> layers;
+  flatten(outlines, layers, shapes, layersOfShapes,
+    std::min(viewport_.width / width_, viewport_.height / height_) / 2, numberOfThreads);
+  clear();
+  const double left = viewport_.pos.x - (viewport_.width / 2);
+  const double top = viewport_.pos.y + (viewport_.height / 2);
+  const double sizeOfPixelX = viewport_.width / width_;
+  const double sizeOfPixelY = viewport_.height / height_;
+  auto getColumn = [left, sizeOfPixelX](double x)
+  {
+    return std::ceil(((x - left) / sizeOfPixelX) - 0.5);
+  };
+  auto getRow = [top, sizeOfPixelY](double y)
+  {
+    return std::ceil(((top - y) / sizeOfPixelY) - 0.5);
+  };
+
+  const size_t tilesInRow = (width_ + SIZE_OF_TILE - 1) / SIZE_OF_TILE;
+  const size_t tilesInColumn = (height_ + SIZE_OF_TILE - 1) / SIZE_OF_TILE;
+  const size_t numberOfOutlines = outlines.outlines.size();
+  std::vector<size_t> firstColumns(numberOfOutlines, 0);
+  std::vector<size_t> lastColumns(numberOfOutlines, 0);
+  std::vector<size_t> firstRows(numberOfOutlines, 0);
+  std::vector<size_t> lastRows(numberOfOutlines, 0);
+  for (size_t i = 0; i < numberOfOutlines; ++i)
+  {
+    const rectangle_t& frame = outlines.frames[i];
+    const double firstColumn = std::max(0.0, getColumn(frame.pos.x - (frame.width / 2)));
+    const double lastColumn = std::min(static_cast<double>(width_), getColumn(frame.pos.x + (frame.width / 2)));
+    const double firstRow = std::max(0.0, getRow(frame.pos.y + (frame.height / 2)));
+    const double lastRow = std::min(static_cast<double>(height_), getRow(frame.pos.y - (frame.height / 2)));
+    if ((firstColumn < lastColumn) && (firstRow < lastRow))
+    {
+      firstColumns[i] = static_cast<size_t>(firstColumn);
+      lastColumns[i] = static_cast<size_t>(lastColumn);
+      firstRows[i] = static_cast<size_t>(firstRow);
+      lastRows[i] = static_cast<size_t>(lastRow);
+    }
+  }
+  auto forEachTile = [&](size_t index, auto function)
+  {
+    if (lastRows[index] == 0)
+    {
+      return;
+    }
+    for (size_t row = firstRows[index] / SIZE_OF_TILE; row <= (lastRows[index] - 1) / SIZE_OF_TILE; ++row)
+    {
+      for (size_t column = firstColumns[index] / SIZE_OF_TILE; column <= (lastColumns[index] - 1) / SIZE_OF_TILE;
+        ++column)
+      {
+        function((row * tilesInRow) + column);
+      }
+    }
+  };
+  std::vector<size_t> beginnings(tilesInRow * tilesInColumn + 1, 0);
+  for (size_t i = 0; i < numberOfOutlines; ++i)
+  {
+    forEachTile(i, [&beginnings](size_t tile)
+    {
+      ++beginnings[tile + 1];
+    });
+  }
+  for (size_t i = 0; i + 1 < beginnings.size(); ++i)
+  {
+    beginnings[i + 1] += beginnings[i];
+  }
+  std::vector<size_t> entries(beginnings.back());
+  std::vector<size_t> nextIndexes(beginnings.begin(), beginnings.end() - 1);
+  for (size_t i = 0; i < numberOfOutlines; ++i)
+  {
+    forEachTile(i, [&entries, &nextIndexes, i](size_t tile)
+    {
+      entries[nextIndexes[tile]++] = i;
+    });
+  }
+
+  std::atomic<size_t> nextTile{ 0 };
+  auto renderTiles = [&](size_t)
+  {
+    std::vector<double> crossings;
+    for (size_t tile = nextTile++; tile < tilesInRow * tilesInColumn; tile = nextTile++)
+    {
+      const size_t tileFirstRow = (tile / tilesInRow) * SIZE_OF_TILE;
+      const size_t tileLastRow = std::min(height_, tileFirstRow + SIZE_OF_TILE);
+      const size_t tileFirstColumn = (tile % tilesInRow) * SIZE_OF_TILE;
+      const size_t tileLastColumn = std::min(width_, tileFirstColumn + SIZE_OF_TILE);
+      for (size_t entry = beginnings[tile]; entry < beginnings[tile + 1]; ++entry)
+      {
+        const size_t index = entries[entry];
+        const outline_t& outline = outlines.outlines[index];
+        const unsigned int layer = static_cast<unsigned int>(layers[index] + 1);
+        const size_t firstRow = std::max(tileFirstRow, firstRows[index]);
+        const size_t lastRow = std::min(tileLastRow, lastRows[index]);
+        for (size_t row = firstRow; row < lastRow; ++row)
+        {
+          const double y = top - ((row + 0.5) * sizeOfPixelY);
+          crossings.clear();
+          if (outline.radius > 0.0)
+          {
+            const double distance = y - outline.centre.y;
+            if (std::abs(distance) >= outline.radius)
+            {
+              continue;
+            }
+            const double halfOfChord = std::sqrt((outline.radius * outline.radius) - (distance * distance));
+            crossings.push_back(outline.centre.x - halfOfChord);
+            crossings.push_back(outline.centre.x + halfOfChord);
+          }
+          else
+          {
+            for (size_t k = outline.begin; k < outline.end; ++k)
+            {
+              const point_t& begin = outlines.vertices[k];
+              const point_t& end = outlines.vertices[(k + 1 == outline.end) ? outline.begin : (k + 1)];
+              if ((begin.y > y) != (end.y > y))
+              {
+                crossings.push_back(begin.x + ((y - begin.y) * (end.x - begin.x) / (end.y - begin.y)));
+              }
+            }
+            std::sort(crossings.begin(), crossings.end());
+          }
+          unsigned int* pixels = &pixels_[row * width_];
+          for (size_t k = 0; k + 1 < crossings.size(); k += 2)
+          {
+            const size_t firstColumn = static_cast<size_t>(std::min(static_cast<double>(tileLastColumn),
+              std::max(static_cast<double>(tileFirstColumn), getColumn(crossings[k]))));
+            const size_t lastColumn = static_cast<size_t>(std::min(static_cast<double>(tileLastColumn),
+              std::max(static_cast<double>(tileFirstColumn), getColumn(crossings[k + 1]))));
+            for (size_t column = firstColumn; column < lastColumn; ++column)
+            {
+              if (mode == Mode::COVERAGE)
+              {
+                ++pixels[column];
+              }
+              else
+              {
+                pixels[column] = std::max(pixels[column], layer);
+              }
+            }
+          }
+        }
+      }
+    }
+  };
+  runInThreads(numberOfThreads, renderTiles);
+}
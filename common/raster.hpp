@@ -0,0 +1,46 @@
+#ifndef KLIMCHUK_RASTER
+#define KLIMCHUK_RASTER
+
+#include <vector>
+#include <ostream>
+#include "base-types.hpp"
+#include "composite-shape.hpp"
+#include "matrix.hpp"
+#include "outline.hpp"
+
+namespace klimchuk
+{
+  class Raster
+  {
+  public:
+    enum class Mode
+    {
+      COVERAGE,
+      LAYER_INDEX
+    };
+
+    Raster(size_t width, size_t height, const rectangle_t& viewport);
+
+    void render(const CompositeShape& compositeShape, Mode mode, size_t numberOfThreads = 1);
+    void render(const Matrix& matrix, Mode mode, size_t numberOfThreads = 1);
+    void clear();
+
+    unsigned int operator()(size_t column, size_t row) const;
+    size_t getWidth() const;
+    size_t getHeight() const;
+    const rectangle_t& getViewport() const;
+
+    void writePgm(std::ostream& stream) const;
+    void writePpm(std::ostream& stream) const;
+  private:
+    size_t width_;
+    size_t height_;
+    rectangle_t viewport_;
+    std::vector<unsigned int> pixels_;
+
+    void fill(const std::vector<Shape::ConstShapePtr>& shapes, const std::vector<size_t>& layersOfShapes, Mode mode,
+      size_t numberOfThreads);
+  };
+}
+
+#endif
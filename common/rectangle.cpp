@@ -3,11 +3,17 @@
 #include <algorithm>
 #include <cmath>
 
+namespace
+{
+  const uint64_t HASH_SEED = 2;
+}
+
 klimchuk::Rectangle::Rectangle(double width, double height, double posX, double posY) :
-  corners_ { point_t{ posX - (width / 2), posY + (height / 2) },
-    point_t{ posX + (width / 2), posY + (height / 2) },
-    point_t{ posX + (width / 2), posY - (height / 2) },
-    point_t{ posX - (width / 2), posY - (height / 2)} }
+  centre_{ posX, posY },
+  halfWidth_{ width / 2 },
+  halfHeight_{ height / 2 },
+  cosinus_{ 1.0 },
+  sinus_{ 0.0 }
 {
   if (width <= 0)
   {
@@ -21,73 +27,81 @@ klimchuk::Rectangle::Rectangle(double width, double height, double posX, double
 
 double klimchuk::Rectangle::getArea() const
 {
-  return getHeight() * getWidth();
+  return 4 * halfWidth_ * halfHeight_;
 }
 
 klimchuk::rectangle_t klimchuk::Rectangle::getFrameRect() const
 {
-  double minX = std::min({ corners_[0].x, corners_[1].x, corners_[2].x, corners_[3].x });
-  double maxX = std::max({ corners_[0].x, corners_[1].x, corners_[2].x, corners_[3].x });
-  double minY = std::min({ corners_[0].y, corners_[1].y, corners_[2].y, corners_[3].y });
-  double maxY = std::max({ corners_[0].y, corners_[1].y, corners_[2].y, corners_[3].y });
-  return rectangle_t{ maxX - minX, maxY - minY, klimchuk::point_t{ minX + ((maxX - minX) / 2), minY + ((maxY - minY) / 2)} };
+  const double cosinus = std::abs(cosinus_);
+  const double sinus = std::abs(sinus_);
+  return rectangle_t{ 2 * ((halfWidth_ * cosinus) + (halfHeight_ * sinus)),
+    2 * ((halfWidth_ * sinus) + (halfHeight_ * cosinus)), centre_ };
+}
+
+klimchuk::oriented_rectangle_t klimchuk::Rectangle::getOrientedFrameRect() const
+{
+  return oriented_rectangle_t{ 2 * halfWidth_, 2 * halfHeight_, centre_, { cosinus_, sinus_ } };
 }
 
 void klimchuk::Rectangle::move(const klimchuk::point_t& point)
 {
-  point_t centre = getCentre();
-  move(point.x - centre.x, point.y - centre.y);
+  const Journal::Scope scope(Journal::Operation::MOVE_TO, *this, point.x, point.y);
+  centre_ = point;
+  invalidateOwners();
 }
 
 void klimchuk::Rectangle::move(double moveAbscissa, double moveOrdinate)
 {
-  for (size_t i = 0; i < 4; ++i)
-  {
-    corners_[i].x += moveAbscissa;
-    corners_[i].y += moveOrdinate;
-  }
+  const Journal::Scope scope(Journal::Operation::MOVE_BY, *this, moveAbscissa, moveOrdinate);
+  centre_.x += moveAbscissa;
+  centre_.y += moveOrdinate;
+  invalidateOwners();
 }
 
 klimchuk::point_t klimchuk::Rectangle::getCentre() const
 {
-  return getFrameRect().pos;
+  return centre_;
 }
 
 void klimchuk::Rectangle::scale(double coefficient)
 {
+  const Journal::Scope scope(Journal::Operation::SCALE, *this, coefficient);
   if (coefficient <= 0)
   {
     throw std::invalid_argument("Rectangle: Coefficient must be more, than a zero.");
   }
-  double newWidth = getWidth() * coefficient;
-  double newHeight = getHeight() * coefficient;
-  point_t centre = getCentre();
-  corners_[0] = point_t{ centre.x - (newWidth / 2), centre.y + (newHeight / 2) };
-  corners_[1] = point_t{ centre.x + (newWidth / 2), centre.y + (newHeight / 2) };
-  corners_[2] = point_t{ centre.x + (newWidth / 2), centre.y - (newHeight / 2) };
-  corners_[3] = point_t{ centre.x - (newWidth / 2), centre.y - (newHeight / 2) };
+  halfWidth_ *= coefficient;
+  halfHeight_ *= coefficient;
+  invalidateOwners();
 }
 
 double klimchuk::Rectangle::getHeight() const
 {
-  return sqrt(pow(corners_[1].x - corners_[2].x, 2) + pow(corners_[1].y - corners_[2].y, 2));
+  return 2 * halfHeight_;
 }
 
 double klimchuk::Rectangle::getWidth() const
 {
-  return sqrt(((corners_[1].x - corners_[0].x) * (corners_[1].x - corners_[0].x))
-    + ((corners_[1].y - corners_[0].y) * (corners_[1].y - corners_[0].y)));
+  return 2 * halfWidth_;
 }
 
 void klimchuk::Rectangle::rotate(double angle)
 {
+  const Journal::Scope scope(Journal::Operation::ROTATE, *this, angle);
   angle *= M_PI / 180;
-  double cosinusOfAngle = cos(angle);
-  double sinusOfAngle = sin(angle);
-  point_t centre = getCentre();
-  for (size_t i = 0; i < 4; ++i)
-  {
-    corners_[i] = { centre.x + (cosinusOfAngle * (corners_[i].x - centre.x)) - (sinusOfAngle * (corners_[i].y - centre.y)),
-      centre.y + (sinusOfAngle * (corners_[i].x - centre.x)) + (cosinusOfAngle * (corners_[i].y - centre.y)) };
-  }
+  const double cosinusOfAngle = std::cos(angle);
+  const double sinusOfAngle = std::sin(angle);
+  const double cosinus = (cosinus_ * cosinusOfAngle) - (sinus_ * sinusOfAngle);
+  const double sinus = (sinus_ * cosinusOfAngle) + (cosinus_ * sinusOfAngle);
+  const double correction = (3.0 - ((cosinus * cosinus) + (sinus * sinus))) / 2;
+  cosinus_ = cosinus * correction;
+  sinus_ = sinus * correction;
+  invalidateOwners();
+}
+
+uint64_t klimchuk::Rectangle::getHash() const
+{
+  uint64_t hash = hashCombine(hashCombine(HASH_SEED, centre_), halfWidth_);
+  hash = hashCombine(hashCombine(hash, halfHeight_), cosinus_);
+  return hashCombine(hash, sinus_);
 }
@@ -11,6 +11,7 @@ namespace klimchuk
     Rectangle(double width, double height, double posX, double posY);
     double getArea() const override;
     rectangle_t getFrameRect() const override;
+    oriented_rectangle_t getOrientedFrameRect() const override;
     void move(const point_t& point) override;
     void move(double moveAbscissa, double moveOrdinate) override;
     point_t getCentre() const override;
@@ -18,8 +19,13 @@ namespace klimchuk
     double getHeight() const;
     double getWidth() const;
     void rotate(double angle) override;
+    uint64_t getHash() const override;
   private:
-    point_t corners_[4];
+    point_t centre_;
+    double halfWidth_;
+    double halfHeight_;
+    double cosinus_;
+    double sinus_;
   };
 }
 
@@ -0,0 +1,160 @@
+#include "scene-diff.hpp"
+#include <unordered_map>
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+  typedef klimchuk::scene_change_t Change;
+
+  std::vector<size_t> getLongestIncreasingSubsequence(const std::vector<std::pair<size_t, size_t>>& matches)
+  {
+    std::vector<size_t> tails;
+    std::vector<size_t> predecessors(matches.size(), Change::NO_INDEX);
+    for (size_t i = 0; i < matches.size(); ++i)
+    {
+      std::vector<size_t>::iterator tail = std::lower_bound(tails.begin(), tails.end(), matches[i].second,
+        [&matches](size_t index, size_t value)
+      {
+        return matches[index].second < value;
+      });
+      if (tail != tails.begin())
+      {
+        predecessors[i] = *(tail - 1);
+      }
+      if (tail == tails.end())
+      {
+        tails.push_back(i);
+      }
+      else
+      {
+        *tail = i;
+      }
+    }
+    std::vector<size_t> subsequence;
+    for (size_t i = tails.empty() ? Change::NO_INDEX : tails.back(); i != Change::NO_INDEX; i = predecessors[i])
+    {
+      subsequence.push_back(i);
+    }
+    std::reverse(subsequence.begin(), subsequence.end());
+    return subsequence;
+  }
+
+  void diffComposites(const klimchuk::CompositeShape& oldComposite, const klimchuk::CompositeShape& newComposite,
+    std::vector<Change>& changes)
+  {
+    if (oldComposite.getHash() == newComposite.getHash())
+    {
+      return;
+    }
+    const size_t oldSize = oldComposite.getSize();
+    const size_t newSize = newComposite.getSize();
+    size_t beginning = 0;
+    while ((beginning < std::min(oldSize, newSize))
+      && (oldComposite[beginning]->getHash() == newComposite[beginning]->getHash()))
+    {
+      ++beginning;
+    }
+    size_t oldEnd = oldSize;
+    size_t newEnd = newSize;
+    while ((oldEnd > beginning) && (newEnd > beginning)
+      && (oldComposite[oldEnd - 1]->getHash() == newComposite[newEnd - 1]->getHash()))
+    {
+      --oldEnd;
+      --newEnd;
+    }
+
+    std::unordered_map<uint64_t, std::vector<size_t>> oldIndexes;
+    for (size_t i = oldEnd; i > beginning; --i)
+    {
+      oldIndexes[oldComposite[i - 1]->getHash()].push_back(i - 1);
+    }
+    std::vector<bool> isOldMatched(oldEnd - beginning, false);
+    std::vector<std::pair<size_t, size_t>> matches;
+    std::vector<size_t> addedIndexes;
+    for (size_t i = beginning; i < newEnd; ++i)
+    {
+      std::unordered_map<uint64_t, std::vector<size_t>>::iterator candidates = oldIndexes.find(newComposite[i]->getHash());
+      if ((candidates == oldIndexes.end()) || candidates->second.empty())
+      {
+        addedIndexes.push_back(i);
+        continue;
+      }
+      matches.emplace_back(i, candidates->second.back());
+      isOldMatched[candidates->second.back() - beginning] = true;
+      candidates->second.pop_back();
+    }
+    std::vector<size_t> removedIndexes;
+    for (size_t i = beginning; i < oldEnd; ++i)
+    {
+      if (!isOldMatched[i - beginning])
+      {
+        removedIndexes.push_back(i);
+      }
+    }
+
+    const std::vector<size_t> kept = getLongestIncreasingSubsequence(matches);
+    for (size_t i = 0, j = 0; i < matches.size(); ++i)
+    {
+      if ((j < kept.size()) && (kept[j] == i))
+      {
+        ++j;
+        continue;
+      }
+      changes.push_back({ Change::Type::MOVED, &oldComposite, &newComposite, matches[i].second, matches[i].first,
+        newComposite[matches[i].first] });
+    }
+
+    std::vector<size_t>::iterator removed = removedIndexes.begin();
+    std::vector<size_t>::iterator added = addedIndexes.begin();
+    std::vector<size_t> remainingRemovedIndexes;
+    std::vector<size_t> remainingAddedIndexes;
+    while ((removed != removedIndexes.end()) || (added != addedIndexes.end()))
+    {
+      const klimchuk::CompositeShape* oldChild = nullptr;
+      const klimchuk::CompositeShape* newChild = nullptr;
+      while ((removed != removedIndexes.end())
+        && !(oldChild = dynamic_cast<const klimchuk::CompositeShape*>(oldComposite[*removed].get())))
+      {
+        remainingRemovedIndexes.push_back(*removed++);
+      }
+      while ((added != addedIndexes.end())
+        && !(newChild = dynamic_cast<const klimchuk::CompositeShape*>(newComposite[*added].get())))
+      {
+        remainingAddedIndexes.push_back(*added++);
+      }
+      if (oldChild && newChild)
+      {
+        diffComposites(*oldChild, *newChild, changes);
+        ++removed;
+        ++added;
+      }
+      else if (oldChild)
+      {
+        remainingRemovedIndexes.push_back(*removed++);
+      }
+      else if (newChild)
+      {
+        remainingAddedIndexes.push_back(*added++);
+      }
+    }
+    for (size_t index : remainingRemovedIndexes)
+    {
+      changes.push_back({ Change::Type::REMOVED, &oldComposite, &newComposite, index, Change::NO_INDEX,
+        oldComposite[index] });
+    }
+    for (size_t index : remainingAddedIndexes)
+    {
+      changes.push_back({ Change::Type::ADDED, &oldComposite, &newComposite, Change::NO_INDEX, index,
+        newComposite[index] });
+    }
+  }
+}
+
+std::vector<klimchuk::scene_change_t> klimchuk::diffScenes(const CompositeShape& oldScene,
+  const CompositeShape& newScene)
+{
+  std::vector<scene_change_t> changes;
+  diffComposites(oldScene, newScene, changes);
+  return changes;
+}
@@ -0,0 +1,34 @@
+#ifndef KLIMCHUK_SCENE_DIFF
+#define KLIMCHUK_SCENE_DIFF
+
+#include <vector>
+#include "shape.hpp"
+#include "composite-shape.hpp"
+
+namespace klimchuk
+{
+  struct scene_change_t
+  {
+    // A child edited in place is reported as REMOVED from oldIndex and ADDED at newIndex, since the diff matches
+    // children by hash; MOVED only reports an unchanged child whose order among its siblings changed.
+    enum class Type
+    {
+      ADDED,
+      REMOVED,
+      MOVED
+    };
+
+    static constexpr size_t NO_INDEX = static_cast<size_t>(-1);
+
+    Type type;
+    const CompositeShape* oldParent;
+    const CompositeShape* newParent;
+    size_t oldIndex;
+    size_t newIndex;
+    Shape::ConstShapePtr shape;
+  };
+
+  std::vector<scene_change_t> diffScenes(const CompositeShape& oldScene, const CompositeShape& newScene);
+}
+
+#endif
@@ -0,0 +1,229 @@
+#include "scene-reader.hpp"
+#include <stdexcept>
+#include <charconv>
+#include <cstring>
+#include <cmath>
+#include <string>
+#include "circle.hpp"
+#include "rectangle.hpp"
+#include "triangle.hpp"
+#include "polygon.hpp"
+
+namespace
+{
+  bool isSpace(char symbol)
+  {
+    return (symbol == ' ') || (symbol == '\t') || (symbol == '\r');
+  }
+
+  bool isKind(const char* first, const char* last, const char* kind)
+  {
+    const size_t length = std::strlen(kind);
+    return (static_cast<size_t>(last - first) == length) && (std::memcmp(first, kind, length) == 0);
+  }
+}
+
+klimchuk::SceneReader::SceneReader(std::istream& stream, size_t sizeOfBuffer, size_t maxLengthOfLine):
+  stream_{ stream },
+  buffer_(sizeOfBuffer),
+  begin_{ 0 },
+  end_{ 0 },
+  maxLengthOfLine_{ maxLengthOfLine },
+  lineNumber_{ 0 },
+  numbers_(),
+  points_()
+{
+  if ((sizeOfBuffer == 0) || (maxLengthOfLine < sizeOfBuffer))
+  {
+    throw std::invalid_argument("SceneReader: Invalid size of buffer.");
+  }
+}
+
+klimchuk::Shape::ShapePtr klimchuk::SceneReader::next()
+{
+  const char* first = nullptr;
+  const char* last = nullptr;
+  while (readLine(first, last))
+  {
+    while ((first != last) && isSpace(*first))
+    {
+      ++first;
+    }
+    if ((first != last) && (*first != '#'))
+    {
+      return parseLine(first, last);
+    }
+  }
+  return nullptr;
+}
+
+size_t klimchuk::SceneReader::getLineNumber() const
+{
+  return lineNumber_;
+}
+
+bool klimchuk::SceneReader::readLine(const char*& first, const char*& last)
+{
+  size_t searched = begin_;
+  while (true)
+  {
+    const void* newLine = std::memchr(buffer_.data() + searched, '\n', end_ - searched);
+    if (newLine)
+    {
+      first = buffer_.data() + begin_;
+      last = static_cast<const char*>(newLine);
+      begin_ = last - buffer_.data() + 1;
+      ++lineNumber_;
+      return true;
+    }
+    if (!stream_)
+    {
+      if (begin_ == end_)
+      {
+        return false;
+      }
+      first = buffer_.data() + begin_;
+      last = buffer_.data() + end_;
+      begin_ = end_;
+      ++lineNumber_;
+      return true;
+    }
+    if (begin_ > 0)
+    {
+      std::memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+      end_ -= begin_;
+      begin_ = 0;
+    }
+    searched = end_;
+    if (end_ == buffer_.size())
+    {
+      if (buffer_.size() >= maxLengthOfLine_)
+      {
+        ++lineNumber_;
+        fail("Line is too long");
+      }
+      buffer_.resize(std::min(2 * buffer_.size(), maxLengthOfLine_));
+    }
+    stream_.read(buffer_.data() + end_, buffer_.size() - end_);
+    end_ += stream_.gcount();
+    if (stream_.bad())
+    {
+      throw std::runtime_error("SceneReader: Can't read stream.");
+    }
+  }
+}
+
+klimchuk::Shape::ShapePtr klimchuk::SceneReader::parseLine(const char* first, const char* last)
+{
+  const char* kind = first;
+  while ((first != last) && !isSpace(*first))
+  {
+    ++first;
+  }
+  const char* endOfKind = first;
+  numbers_.clear();
+  while (true)
+  {
+    while ((first != last) && isSpace(*first))
+    {
+      ++first;
+    }
+    if (first == last)
+    {
+      break;
+    }
+    double number = 0.0;
+    const std::from_chars_result result = std::from_chars(first, last, number);
+    if ((result.ec != std::errc()) || ((result.ptr != last) && !isSpace(*result.ptr)) || !std::isfinite(number))
+    {
+      fail("Invalid number");
+    }
+    numbers_.push_back(number);
+    first = result.ptr;
+  }
+
+  const double* numbers = numbers_.data();
+  const size_t size = numbers_.size();
+  try
+  {
+    if (isKind(kind, endOfKind, "circle"))
+    {
+      if (size != 3)
+      {
+        fail("Circle needs centre and radius");
+      }
+      return std::make_shared<Circle>(numbers[0], numbers[1], numbers[2]);
+    }
+    if (isKind(kind, endOfKind, "rectangle"))
+    {
+      if ((size != 4) && (size != 5))
+      {
+        fail("Rectangle needs width, height, centre and optional angle");
+      }
+      Shape::ShapePtr rectangle = std::make_shared<Rectangle>(numbers[0], numbers[1], numbers[2], numbers[3]);
+      if (size == 5)
+      {
+        rectangle->rotate(numbers[4]);
+      }
+      return rectangle;
+    }
+    if (isKind(kind, endOfKind, "triangle"))
+    {
+      if (size != 6)
+      {
+        fail("Triangle needs three points");
+      }
+      return std::make_shared<Triangle>(point_t{ numbers[0], numbers[1] }, point_t{ numbers[2], numbers[3] },
+        point_t{ numbers[4], numbers[5] });
+    }
+    if (isKind(kind, endOfKind, "polygon"))
+    {
+      if (size % 2 != 0)
+      {
+        fail("Polygon needs pairs of coordinates");
+      }
+      points_.resize(size / 2);
+      for (size_t i = 0; i < points_.size(); ++i)
+      {
+        points_[i] = { numbers[2 * i], numbers[(2 * i) + 1] };
+      }
+      return std::make_shared<Polygon>(points_.data(), points_.size());
+    }
+  }
+  catch (const std::logic_error& error)
+  {
+    fail(error.what());
+  }
+  fail("Unknown kind of shape");
+}
+
+void klimchuk::SceneReader::fail(const std::string& message) const
+{
+  const bool isFinished = !message.empty() && (message.back() == '.');
+  throw std::runtime_error("SceneReader: Line " + std::to_string(lineNumber_) + ": " + message + (isFinished ? "" : "."));
+}
+
+klimchuk::CompositeShape klimchuk::readScene(std::istream& stream)
+{
+  SceneReader reader(stream);
+  Shape::ShapePtr shape = reader.next();
+  if (!shape)
+  {
+    throw std::runtime_error("readScene: Scene is empty.");
+  }
+  CompositeShape compositeShape(shape);
+  while ((shape = reader.next()))
+  {
+    compositeShape.add(shape);
+  }
+  return compositeShape;
+}
+
+void klimchuk::readScene(std::istream& stream, Matrix& matrix)
+{
+  SceneReader reader(stream);
+  while (Shape::ShapePtr shape = reader.next())
+  {
+    matrix.add(shape);
+  }
+}
@@ -0,0 +1,39 @@
+#ifndef KLIMCHUK_SCENE_READER
+#define KLIMCHUK_SCENE_READER
+
+#include <istream>
+#include <vector>
+#include <string>
+#include "shape.hpp"
+#include "composite-shape.hpp"
+#include "matrix.hpp"
+
+namespace klimchuk
+{
+  class SceneReader
+  {
+  public:
+    explicit SceneReader(std::istream& stream, size_t sizeOfBuffer = 65536, size_t maxLengthOfLine = 16777216);
+
+    Shape::ShapePtr next();
+    size_t getLineNumber() const;
+  private:
+    std::istream& stream_;
+    std::vector<char> buffer_;
+    size_t begin_;
+    size_t end_;
+    size_t maxLengthOfLine_;
+    size_t lineNumber_;
+    std::vector<double> numbers_;
+    std::vector<point_t> points_;
+
+    bool readLine(const char*& first, const char*& last);
+    Shape::ShapePtr parseLine(const char* first, const char* last);
+    [[noreturn]] void fail(const std::string& message) const;
+  };
+
+  CompositeShape readScene(std::istream& stream);
+  void readScene(std::istream& stream, Matrix& matrix);
+}
+
+#endif
@@ -2,24 +2,55 @@
 #define KLIMCHUK_ABSTRACT_SHAPE
 
 #include <memory>
+#include <cstdint>
 #include "base-types.hpp"
+#include "journal.hpp"
 
 namespace klimchuk
 {
+  class CompositeShape;
+
   class Shape
   {
   public:
     typedef std::shared_ptr<Shape> ShapePtr;
     typedef std::shared_ptr<const Shape> ConstShapePtr;
 
-    virtual ~Shape() = default;
+    virtual ~Shape()
+    {
+      Journal::forget(this);
+    }
+
+    Shape& operator=(const Shape&)
+    {
+      Journal::forget(this);
+      invalidateOwners();
+      return *this;
+    }
+
     virtual double getArea() const = 0;
     virtual rectangle_t getFrameRect() const = 0;
+    virtual oriented_rectangle_t getOrientedFrameRect() const = 0;
     virtual void move(const point_t& point) = 0;
     virtual void move(double moveAbscissa, double moveOrdinate) = 0;
     virtual void scale(double coefficient) = 0;
     virtual point_t getCentre() const = 0;
     virtual void rotate(double angle) = 0;
+    virtual uint64_t getHash() const = 0;
+  protected:
+    Shape():
+      owners_{ 0 }
+    {}
+
+    Shape(const Shape&):
+      owners_{ 0 }
+    {}
+
+    void invalidateOwners();
+  private:
+    friend class CompositeShape;
+
+    uintptr_t owners_;
   };
 }
 
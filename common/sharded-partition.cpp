@@ -0,0 +1,260 @@
+#include "sharded-partition.hpp"
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <cfloat>
+#include <cstdint>
+#include <cerrno>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "partition.hpp"
+#include "frame-sweep.hpp"
+
+namespace
+{
+  const size_t SIZE_OF_OUTPUT_BUFFER = 512;
+  std::atomic<unsigned int> numberOfSegments{ 0 };
+
+  struct Mapping
+  {
+    void* data;
+    size_t size;
+
+    Mapping():
+      data{ nullptr },
+      size{ 0 }
+    {}
+
+    ~Mapping()
+    {
+      if (data)
+      {
+        ::munmap(data, size);
+      }
+    }
+  };
+
+  void createSegment(const std::string& name, size_t size, Mapping& mapping)
+  {
+    const int file = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (file < 0)
+    {
+      throw std::runtime_error("partitionInProcesses: Can't create shared memory.");
+    }
+    mapping.size = std::max<size_t>(size, 1);
+    void* data = MAP_FAILED;
+    if (::ftruncate(file, static_cast<off_t>(mapping.size)) == 0)
+    {
+      data = ::mmap(nullptr, mapping.size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    }
+    ::close(file);
+    if (data == MAP_FAILED)
+    {
+      ::shm_unlink(name.c_str());
+      throw std::runtime_error("partitionInProcesses: Can't map shared memory.");
+    }
+    mapping.data = data;
+  }
+
+  struct File
+  {
+    int descriptor;
+
+    File():
+      descriptor{ -1 }
+    {}
+
+    ~File()
+    {
+      if (descriptor >= 0)
+      {
+        ::close(descriptor);
+      }
+    }
+  };
+
+  void createShard(const std::string& name, File& file)
+  {
+    file.descriptor = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (file.descriptor < 0)
+    {
+      throw std::runtime_error("partitionInProcesses: Can't create shared memory.");
+    }
+    ::shm_unlink(name.c_str());
+  }
+
+  void openShard(const File& file, Mapping& mapping)
+  {
+    struct stat status;
+    if ((::fstat(file.descriptor, &status) != 0) || (status.st_size % (2 * sizeof(uint64_t)) != 0))
+    {
+      throw std::runtime_error("partitionInProcesses: Worker failed.");
+    }
+    if (status.st_size == 0)
+    {
+      return;
+    }
+    void* data = ::mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_SHARED, file.descriptor, 0);
+    if (data == MAP_FAILED)
+    {
+      throw std::runtime_error("partitionInProcesses: Worker failed.");
+    }
+    mapping.data = data;
+    mapping.size = static_cast<size_t>(status.st_size);
+  }
+
+  bool writeShard(int file, const uint64_t* data, size_t size)
+  {
+    const char* bytes = reinterpret_cast<const char*>(data);
+    size_t numberOfBytes = size * sizeof(uint64_t);
+    while (numberOfBytes > 0)
+    {
+      const ssize_t written = ::write(file, bytes, numberOfBytes);
+      if (written < 0)
+      {
+        if (errno == EINTR)
+        {
+          continue;
+        }
+        return false;
+      }
+      bytes += written;
+      numberOfBytes -= static_cast<size_t>(written);
+    }
+    return true;
+  }
+
+  double getTolerance(double coordinate, double size)
+  {
+    return 8 * DBL_EPSILON * (std::abs(coordinate) + size);
+  }
+
+  bool findShardIntersections(const klimchuk::rectangle_t* frames, size_t numberOfFrames, double beginning,
+    double end, size_t* indexes, klimchuk::FrameSweep& sweep, int file)
+  {
+    size_t numberOfIndexes = 0;
+    for (size_t i = 0; i < numberOfFrames; ++i)
+    {
+      const klimchuk::rectangle_t& frame = frames[i];
+      const double tolerance = getTolerance(frame.pos.x, frame.width);
+      if ((frame.pos.x - (frame.width / 2) - tolerance <= end)
+        && (frame.pos.x + (frame.width / 2) + tolerance >= beginning))
+      {
+        indexes[numberOfIndexes++] = i;
+      }
+    }
+    uint64_t buffer[2 * SIZE_OF_OUTPUT_BUFFER];
+    size_t size = 0;
+    bool isWritten = true;
+    auto report = [frames, beginning, end, file, &buffer, &size, &isWritten](size_t first, size_t second)
+    {
+      const double reference = std::max(frames[first].pos.x - (frames[first].width / 2),
+        frames[second].pos.x - (frames[second].width / 2));
+      if ((reference < beginning) || (reference >= end))
+      {
+        return;
+      }
+      buffer[size++] = first;
+      buffer[size++] = second;
+      if (size == 2 * SIZE_OF_OUTPUT_BUFFER)
+      {
+        isWritten = isWritten && writeShard(file, buffer, size);
+        size = 0;
+      }
+    };
+    sweep.run(frames, indexes, numberOfIndexes, report);
+    return isWritten && writeShard(file, buffer, size);
+  }
+}
+
+klimchuk::Matrix klimchuk::partitionInProcesses(CompositeShape& compositeShape, size_t numberOfProcesses,
+  Matrix::Mode mode, Matrix::Filter filter)
+{
+  if (numberOfProcesses == 0)
+  {
+    throw std::invalid_argument("partitionInProcesses: Number of processes must be positive.");
+  }
+  const size_t numberOfShapes = compositeShape.getSize();
+  const std::string prefix = "/klimchuk-" + std::to_string(::getpid()) + "-" + std::to_string(numberOfSegments++);
+  Mapping frames;
+  createSegment(prefix, numberOfShapes * sizeof(rectangle_t), frames);
+  ::shm_unlink(prefix.c_str());
+  rectangle_t* sharedFrames = static_cast<rectangle_t*>(frames.data);
+  std::vector<double> centres(numberOfShapes);
+  for (size_t i = 0; i < numberOfShapes; ++i)
+  {
+    sharedFrames[i] = compositeShape[i]->getFrameRect();
+    if (!std::isfinite(sharedFrames[i].pos.x) || !std::isfinite(sharedFrames[i].width))
+    {
+      throw std::invalid_argument("partitionInProcesses: Frame is not finite.");
+    }
+    centres[i] = sharedFrames[i].pos.x;
+  }
+  std::vector<double> boundaries(numberOfProcesses + 1);
+  boundaries.front() = -std::numeric_limits<double>::infinity();
+  boundaries.back() = std::numeric_limits<double>::infinity();
+  for (size_t i = 1; i < numberOfProcesses; ++i)
+  {
+    std::vector<double>::iterator boundary = centres.begin() + (i * numberOfShapes / numberOfProcesses);
+    std::nth_element(centres.begin(), boundary, centres.end());
+    boundaries[i] = *boundary;
+  }
+
+  std::unique_ptr<File[]> shards = std::make_unique<File[]>(numberOfProcesses);
+  for (size_t i = 0; i < numberOfProcesses; ++i)
+  {
+    createShard(prefix + "-" + std::to_string(i), shards[i]);
+  }
+  std::unique_ptr<size_t[]> indexes = std::make_unique<size_t[]>(numberOfShapes);
+  FrameSweep sweep(numberOfShapes);
+
+  std::vector<pid_t> workers;
+  workers.reserve(numberOfProcesses);
+  for (size_t i = 0; i < numberOfProcesses; ++i)
+  {
+    const pid_t worker = ::fork();
+    if (worker == 0)
+    {
+      ::_exit(findShardIntersections(sharedFrames, numberOfShapes, boundaries[i], boundaries[i + 1], indexes.get(),
+        sweep, shards[i].descriptor) ? 0 : 1);
+    }
+    if (worker < 0)
+    {
+      break;
+    }
+    workers.push_back(worker);
+  }
+  bool areWorkersSucceeded = (workers.size() == numberOfProcesses);
+  for (pid_t worker : workers)
+  {
+    int status = 0;
+    while ((::waitpid(worker, &status, 0) < 0) && (errno == EINTR))
+    {}
+    areWorkersSucceeded = areWorkersSucceeded && WIFEXITED(status) && (WEXITSTATUS(status) == 0);
+  }
+  if (!areWorkersSucceeded)
+  {
+    throw std::runtime_error("partitionInProcesses: Worker failed.");
+  }
+
+  std::vector<intersection_t> intersections;
+  for (size_t i = 0; i < numberOfProcesses; ++i)
+  {
+    Mapping shard;
+    openShard(shards[i], shard);
+    const uint64_t* input = static_cast<const uint64_t*>(shard.data);
+    for (size_t j = 0; j < shard.size / sizeof(uint64_t); j += 2)
+    {
+      intersections.emplace_back(input[j], input[j + 1]);
+    }
+  }
+  return partition(compositeShape, intersections, mode, filter);
+}
@@ -0,0 +1,13 @@
+#ifndef KLIMCHUK_SHARDED_PARTITION
+#define KLIMCHUK_SHARDED_PARTITION
+
+#include "matrix.hpp"
+#include "composite-shape.hpp"
+
+namespace klimchuk
+{
+  Matrix partitionInProcesses(CompositeShape& compositeShape, size_t numberOfProcesses,
+    Matrix::Mode mode = Matrix::Mode::FIRST_FIT, Matrix::Filter filter = Matrix::Filter::FRAME);
+}
+
+#endif
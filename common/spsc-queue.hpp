@@ -0,0 +1,103 @@
+#ifndef KLIMCHUK_SPSC_QUEUE
+#define KLIMCHUK_SPSC_QUEUE
+
+#include <cstddef>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace klimchuk
+{
+  template <typename T>
+  class SpscQueue
+  {
+  public:
+    explicit SpscQueue(size_t capacity);
+    SpscQueue(const SpscQueue& rhs) = delete;
+
+    SpscQueue& operator=(const SpscQueue& rhs) = delete;
+
+    bool tryPush(T&& value);
+    bool tryPop(T& value);
+    size_t getCapacity() const;
+  private:
+    static constexpr size_t SIZE_OF_CACHE_LINE = 64;
+
+    const size_t mask_;
+    const std::unique_ptr<T[]> buffer_;
+    alignas(SIZE_OF_CACHE_LINE) std::atomic<size_t> head_;
+    size_t cachedTail_;
+    alignas(SIZE_OF_CACHE_LINE) std::atomic<size_t> tail_;
+    size_t cachedHead_;
+
+    static size_t roundCapacity(size_t capacity);
+  };
+}
+
+template <typename T>
+klimchuk::SpscQueue<T>::SpscQueue(size_t capacity):
+  mask_{ roundCapacity(capacity) - 1 },
+  buffer_{ std::make_unique<T[]>(mask_ + 1) },
+  head_{ 0 },
+  cachedTail_{ 0 },
+  tail_{ 0 },
+  cachedHead_{ 0 }
+{}
+
+template <typename T>
+bool klimchuk::SpscQueue<T>::tryPush(T&& value)
+{
+  const size_t tail = tail_.load(std::memory_order_relaxed);
+  if (tail - cachedHead_ > mask_)
+  {
+    cachedHead_ = head_.load(std::memory_order_acquire);
+    if (tail - cachedHead_ > mask_)
+    {
+      return false;
+    }
+  }
+  buffer_[tail & mask_] = std::move(value);
+  tail_.store(tail + 1, std::memory_order_release);
+  return true;
+}
+
+template <typename T>
+bool klimchuk::SpscQueue<T>::tryPop(T& value)
+{
+  const size_t head = head_.load(std::memory_order_relaxed);
+  if (head == cachedTail_)
+  {
+    cachedTail_ = tail_.load(std::memory_order_acquire);
+    if (head == cachedTail_)
+    {
+      return false;
+    }
+  }
+  value = std::move(buffer_[head & mask_]);
+  head_.store(head + 1, std::memory_order_release);
+  return true;
+}
+
+template <typename T>
+size_t klimchuk::SpscQueue<T>::getCapacity() const
+{
+  return mask_ + 1;
+}
+
+template <typename T>
+size_t klimchuk::SpscQueue<T>::roundCapacity(size_t capacity)
+{
+  if ((capacity == 0) || (capacity > (static_cast<size_t>(1) << ((sizeof(size_t) * 8) - 2))))
+  {
+    throw std::invalid_argument("SpscQueue: Invalid capacity.");
+  }
+  size_t powerOfTwo = 1;
+  while (powerOfTwo < capacity)
+  {
+    powerOfTwo *= 2;
+  }
+  return powerOfTwo;
+}
+
+#endif
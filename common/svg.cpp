@@ -0,0 +1,957 @@
+#include "svg.hpp"
+#include <stdexcept>
+#include <charconv>
+#include <algorithm>
+#include <cstring>
+#include <cctype>
+#include <cmath>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include "circle.hpp"
+#include "rectangle.hpp"
+#include "triangle.hpp"
+#include "polygon.hpp"
+#include "predicates.hpp"
+
+namespace
+{
+  const double TOLERANCE_OF_SIMILARITY = 1e-9;
+
+  struct transform_t
+  {
+    double a;
+    double b;
+    double c;
+    double d;
+    double e;
+    double f;
+  };
+
+  struct tag_t
+  {
+    const char* first;
+    const char* last;
+    size_t line;
+  };
+
+  struct group_t
+  {
+    transform_t transform;
+    bool isGroup;
+    std::vector<klimchuk::Shape::ShapePtr> shapes;
+  };
+
+  const transform_t IDENTITY{ 1.0, 0.0, 0.0, 1.0, 0.0, 0.0 };
+
+  transform_t multiply(const transform_t& lhs, const transform_t& rhs)
+  {
+    return transform_t{ (lhs.a * rhs.a) + (lhs.c * rhs.b), (lhs.b * rhs.a) + (lhs.d * rhs.b),
+      (lhs.a * rhs.c) + (lhs.c * rhs.d), (lhs.b * rhs.c) + (lhs.d * rhs.d),
+      (lhs.a * rhs.e) + (lhs.c * rhs.f) + lhs.e, (lhs.b * rhs.e) + (lhs.d * rhs.f) + lhs.f };
+  }
+
+  klimchuk::point_t apply(const transform_t& transform, const klimchuk::point_t& point)
+  {
+    return { (transform.a * point.x) + (transform.c * point.y) + transform.e,
+      (transform.b * point.x) + (transform.d * point.y) + transform.f };
+  }
+
+  bool hasArea(const std::vector<klimchuk::point_t>& points)
+  {
+    if (points.size() < 3)
+    {
+      return false;
+    }
+    double area = 0.0;
+    bool isCollinear = true;
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      const klimchuk::point_t& next = points[(i + 1) % points.size()];
+      area += (points[i].x * next.y) - (points[i].y * next.x);
+      isCollinear = isCollinear && (klimchuk::getOrientation(points[0], points[1], points[i]) == 0.0);
+    }
+    return !isCollinear && (area != 0.0);
+  }
+
+  bool isSpace(char symbol)
+  {
+    return (symbol == ' ') || (symbol == '\t') || (symbol == '\n') || (symbol == '\r');
+  }
+
+  bool isSeparator(char symbol)
+  {
+    return isSpace(symbol) || (symbol == ',');
+  }
+
+  bool parseNumber(const char*& first, const char* last, double& number)
+  {
+    while ((first != last) && isSeparator(*first))
+    {
+      ++first;
+    }
+    if ((first != last) && (*first == '+'))
+    {
+      ++first;
+    }
+    const std::from_chars_result result = std::from_chars(first, last, number);
+    if ((result.ec != std::errc()) || !std::isfinite(number))
+    {
+      return false;
+    }
+    first = result.ptr;
+    return true;
+  }
+
+  class TagReader
+  {
+  public:
+    TagReader(std::istream& stream, size_t sizeOfBuffer, size_t maxLengthOfTag):
+      stream_{ stream },
+      buffer_(sizeOfBuffer),
+      begin_{ 0 },
+      end_{ 0 },
+      maxLengthOfTag_{ maxLengthOfTag },
+      lineNumber_{ 1 }
+    {
+      if ((sizeOfBuffer < 16) || (maxLengthOfTag < sizeOfBuffer))
+      {
+        throw std::invalid_argument("readSvg: Invalid size of buffer.");
+      }
+    }
+
+    bool next(tag_t& tag)
+    {
+      while (true)
+      {
+        const void* opening = std::memchr(buffer_.data() + begin_, '<', end_ - begin_);
+        const size_t position = opening ? (static_cast<const char*>(opening) - buffer_.data()) : end_;
+        lineNumber_ += std::count(buffer_.data() + begin_, buffer_.data() + position, '\n');
+        begin_ = position;
+        if (opening)
+        {
+          break;
+        }
+        if (!fill())
+        {
+          return false;
+        }
+      }
+      while ((end_ - begin_ < 9) && fill())
+      {}
+      const char* terminator = ">";
+      size_t lengthOfOpening = 1;
+      if (startsWith("<!--"))
+      {
+        terminator = "-->";
+        lengthOfOpening = 4;
+      }
+      else if (startsWith("<![CDATA["))
+      {
+        terminator = "]]>";
+        lengthOfOpening = 9;
+      }
+      const size_t lengthOfTerminator = std::strlen(terminator);
+      size_t scanned = lengthOfOpening;
+      char quote = '\0';
+      while (true)
+      {
+        for (size_t i = begin_ + scanned; i < end_; ++i)
+        {
+          const char symbol = buffer_[i];
+          if (lengthOfTerminator == 1)
+          {
+            if (quote != '\0')
+            {
+              quote = (symbol == quote) ? '\0' : quote;
+              continue;
+            }
+            if ((symbol == '"') || (symbol == '\''))
+            {
+              quote = symbol;
+              continue;
+            }
+          }
+          if ((symbol == '>') && (i + 1 >= begin_ + lengthOfOpening + lengthOfTerminator)
+              && (std::memcmp(buffer_.data() + i + 1 - lengthOfTerminator, terminator, lengthOfTerminator) == 0))
+          {
+            tag = tag_t{ buffer_.data() + begin_ + 1, buffer_.data() + i, lineNumber_ };
+            lineNumber_ += std::count(buffer_.data() + begin_, buffer_.data() + i, '\n');
+            begin_ = i + 1;
+            return true;
+          }
+        }
+        scanned = end_ - begin_;
+        if (!fill())
+        {
+          throw std::runtime_error("readSvg: Line " + std::to_string(lineNumber_) + ": Tag is not closed.");
+        }
+      }
+    }
+  private:
+    std::istream& stream_;
+    std::vector<char> buffer_;
+    size_t begin_;
+    size_t end_;
+    size_t maxLengthOfTag_;
+    size_t lineNumber_;
+
+    bool startsWith(const char* prefix) const
+    {
+      const size_t length = std::strlen(prefix);
+      return (end_ - begin_ >= length) && (std::memcmp(buffer_.data() + begin_, prefix, length) == 0);
+    }
+
+    bool fill()
+    {
+      if (!stream_)
+      {
+        return false;
+      }
+      if (begin_ > 0)
+      {
+        std::memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+        end_ -= begin_;
+        begin_ = 0;
+      }
+      if (end_ == buffer_.size())
+      {
+        if (buffer_.size() >= maxLengthOfTag_)
+        {
+          throw std::runtime_error("readSvg: Line " + std::to_string(lineNumber_) + ": Tag is too long.");
+        }
+        buffer_.resize(std::min(2 * buffer_.size(), maxLengthOfTag_));
+      }
+      stream_.read(buffer_.data() + end_, buffer_.size() - end_);
+      const size_t numberOfRead = stream_.gcount();
+      end_ += numberOfRead;
+      if (stream_.bad())
+      {
+        throw std::runtime_error("readSvg: Can't read stream.");
+      }
+      return numberOfRead > 0;
+    }
+  };
+
+  class SvgParser
+  {
+  public:
+    explicit SvgParser(std::istream& stream, size_t sizeOfBuffer, size_t maxLengthOfTag):
+      reader_(stream, sizeOfBuffer, maxLengthOfTag),
+      groups_{ group_t{ IDENTITY, false, {} } },
+      attributes_(),
+      points_(),
+      line_{ 0 }
+    {}
+
+    std::vector<klimchuk::Shape::ShapePtr> parse()
+    {
+      tag_t tag{ nullptr, nullptr, 0 };
+      size_t skippedDepth = 0;
+      while (reader_.next(tag))
+      {
+        line_ = tag.line;
+        const char* first = tag.first;
+        const char* last = tag.last;
+        if ((first == last) || (*first == '!') || (*first == '?'))
+        {
+          continue;
+        }
+        if (*first == '/')
+        {
+          if (skippedDepth > 0)
+          {
+            --skippedDepth;
+          }
+          else if (groups_.size() > 1)
+          {
+            close();
+          }
+          continue;
+        }
+        const bool isSelfClosing = (*(last - 1) == '/');
+        last -= isSelfClosing ? 1 : 0;
+        const char* endOfName = first;
+        while ((endOfName != last) && !isSpace(*endOfName))
+        {
+          ++endOfName;
+        }
+        const std::string_view name(first, endOfName - first);
+        if (skippedDepth > 0)
+        {
+          skippedDepth += isSelfClosing ? 0 : 1;
+          continue;
+        }
+        if ((name == "defs") || (name == "clipPath") || (name == "mask") || (name == "pattern") || (name == "symbol")
+            || (name == "marker") || (name == "linearGradient") || (name == "radialGradient"))
+        {
+          skippedDepth = isSelfClosing ? 0 : 1;
+          continue;
+        }
+        parseAttributes(endOfName, last);
+        const transform_t transform = multiply(groups_.back().transform, getTransform());
+        if (name == "rect")
+        {
+          addRectangle(transform);
+        }
+        else if (name == "circle")
+        {
+          addCircle(transform);
+        }
+        else if (name == "polygon")
+        {
+          addPolygon(transform);
+        }
+        else if (name == "path")
+        {
+          addPath(transform);
+        }
+        if (!isSelfClosing)
+        {
+          groups_.push_back(group_t{ transform, name == "g", {} });
+        }
+      }
+      while (groups_.size() > 1)
+      {
+        close();
+      }
+      return std::move(groups_.front().shapes);
+    }
+  private:
+    TagReader reader_;
+    std::vector<group_t> groups_;
+    std::vector<std::pair<std::string_view, std::string_view>> attributes_;
+    std::vector<klimchuk::point_t> points_;
+    size_t line_;
+
+    [[noreturn]] void fail(const std::string& message) const
+    {
+      const bool isFinished = !message.empty() && (message.back() == '.');
+      throw std::runtime_error("readSvg: Line " + std::to_string(line_) + ": " + message + (isFinished ? "" : "."));
+    }
+
+    void parseAttributes(const char* first, const char* last)
+    {
+      attributes_.clear();
+      while (true)
+      {
+        while ((first != last) && isSpace(*first))
+        {
+          ++first;
+        }
+        if (first == last)
+        {
+          return;
+        }
+        const char* name = first;
+        while ((first != last) && (*first != '=') && !isSpace(*first))
+        {
+          ++first;
+        }
+        const std::string_view attribute(name, first - name);
+        while ((first != last) && isSpace(*first))
+        {
+          ++first;
+        }
+        if ((first == last) || (*first != '='))
+        {
+          fail("Invalid attribute");
+        }
+        ++first;
+        while ((first != last) && isSpace(*first))
+        {
+          ++first;
+        }
+        if ((first == last) || ((*first != '"') && (*first != '\'')))
+        {
+          fail("Invalid attribute");
+        }
+        const char quote = *first++;
+        const char* value = first;
+        while ((first != last) && (*first != quote))
+        {
+          ++first;
+        }
+        if (first == last)
+        {
+          fail("Invalid attribute");
+        }
+        attributes_.emplace_back(attribute, std::string_view(value, first - value));
+        ++first;
+      }
+    }
+
+    const std::string_view* findAttribute(std::string_view name) const
+    {
+      for (const std::pair<std::string_view, std::string_view>& attribute : attributes_)
+      {
+        if (attribute.first == name)
+        {
+          return &attribute.second;
+        }
+      }
+      return nullptr;
+    }
+
+    double getLength(std::string_view name)
+    {
+      const std::string_view* value = findAttribute(name);
+      if (!value)
+      {
+        return 0.0;
+      }
+      const char* first = value->data();
+      const char* last = first + value->size();
+      double length = 0.0;
+      if (!parseNumber(first, last, length))
+      {
+        fail("Invalid number");
+      }
+      if ((last - first >= 2) && (first[0] == 'p') && (first[1] == 'x'))
+      {
+        first += 2;
+      }
+      while ((first != last) && isSpace(*first))
+      {
+        ++first;
+      }
+      if (first != last)
+      {
+        fail("Unsupported unit of length");
+      }
+      return length;
+    }
+
+    transform_t getTransform()
+    {
+      const std::string_view* value = findAttribute("transform");
+      transform_t transform = IDENTITY;
+      if (!value)
+      {
+        return transform;
+      }
+      const char* first = value->data();
+      const char* last = first + value->size();
+      while (true)
+      {
+        while ((first != last) && isSeparator(*first))
+        {
+          ++first;
+        }
+        if (first == last)
+        {
+          return transform;
+        }
+        const char* name = first;
+        while ((first != last) && (*first != '(') && !isSpace(*first))
+        {
+          ++first;
+        }
+        const std::string_view function(name, first - name);
+        while ((first != last) && isSpace(*first))
+        {
+          ++first;
+        }
+        if ((first == last) || (*first != '('))
+        {
+          fail("Invalid transform");
+        }
+        ++first;
+        double arguments[6] = {};
+        size_t numberOfArguments = 0;
+        while (true)
+        {
+          while ((first != last) && isSeparator(*first))
+          {
+            ++first;
+          }
+          if ((first != last) && (*first == ')'))
+          {
+            ++first;
+            break;
+          }
+          if ((numberOfArguments == 6) || !parseNumber(first, last, arguments[numberOfArguments++]))
+          {
+            fail("Invalid transform");
+          }
+        }
+        transform = multiply(transform, makeTransform(function, arguments, numberOfArguments));
+      }
+    }
+
+    transform_t makeTransform(std::string_view function, const double* arguments, size_t numberOfArguments)
+    {
+      const double radians = arguments[0] * M_PI / 180;
+      if ((function == "matrix") && (numberOfArguments == 6))
+      {
+        return transform_t{ arguments[0], arguments[1], arguments[2], arguments[3], arguments[4], arguments[5] };
+      }
+      if ((function == "translate") && ((numberOfArguments == 1) || (numberOfArguments == 2)))
+      {
+        return transform_t{ 1.0, 0.0, 0.0, 1.0, arguments[0], arguments[1] };
+      }
+      if ((function == "scale") && ((numberOfArguments == 1) || (numberOfArguments == 2)))
+      {
+        return transform_t{ arguments[0], 0.0, 0.0, (numberOfArguments == 2) ? arguments[1] : arguments[0], 0.0, 0.0 };
+      }
+      if ((function == "rotate") && ((numberOfArguments == 1) || (numberOfArguments == 3)))
+      {
+        const transform_t rotation{ std::cos(radians), std::sin(radians), -std::sin(radians), std::cos(radians), 0.0, 0.0 };
+        const transform_t there{ 1.0, 0.0, 0.0, 1.0, arguments[1], arguments[2] };
+        const transform_t back{ 1.0, 0.0, 0.0, 1.0, -arguments[1], -arguments[2] };
+        return multiply(there, multiply(rotation, back));
+      }
+      if ((function == "skewX") && (numberOfArguments == 1))
+      {
+        return transform_t{ 1.0, 0.0, std::tan(radians), 1.0, 0.0, 0.0 };
+      }
+      if ((function == "skewY") && (numberOfArguments == 1))
+      {
+        return transform_t{ 1.0, std::tan(radians), 0.0, 1.0, 0.0, 0.0 };
+      }
+      fail("Invalid transform");
+    }
+
+    void add(const klimchuk::Shape::ShapePtr& shape, const transform_t& transform)
+    {
+      const double scale = std::hypot(transform.a, transform.b);
+      const bool isRotation = (std::abs(transform.a - transform.d) <= TOLERANCE_OF_SIMILARITY * scale)
+          && (std::abs(transform.b + transform.c) <= TOLERANCE_OF_SIMILARITY * scale);
+      const bool isReflection = (std::abs(transform.a + transform.d) <= TOLERANCE_OF_SIMILARITY * scale)
+          && (std::abs(transform.b - transform.c) <= TOLERANCE_OF_SIMILARITY * scale);
+      if ((!isRotation && !isReflection) || !(scale > 0.0))
+      {
+        fail("Only rotations, reflections, translations and uniform scaling are supported for this shape");
+      }
+      const klimchuk::point_t centre = shape->getCentre();
+      const klimchuk::point_t newCentre = apply(transform, centre);
+      if (scale != 1.0)
+      {
+        shape->scale(scale);
+      }
+      double angle = std::atan2(transform.b, transform.a);
+      if (!isRotation)
+      {
+        const klimchuk::point_t axis = shape->getOrientedFrameRect().axis;
+        angle -= 2 * std::atan2(axis.y, axis.x);
+      }
+      if (angle != 0.0)
+      {
+        shape->rotate(angle * 180 / M_PI);
+      }
+      shape->move(newCentre.x - centre.x, newCentre.y - centre.y);
+      groups_.back().shapes.push_back(shape);
+    }
+
+    void addRectangle(const transform_t& transform)
+    {
+      const double width = getLength("width");
+      const double height = getLength("height");
+      try
+      {
+        add(std::make_shared<klimchuk::Rectangle>(width, height, getLength("x") + (width / 2),
+          getLength("y") + (height / 2)), transform);
+      }
+      catch (const std::logic_error& error)
+      {
+        fail(error.what());
+      }
+    }
+
+    void addCircle(const transform_t& transform)
+    {
+      try
+      {
+        add(std::make_shared<klimchuk::Circle>(getLength("cx"), getLength("cy"), getLength("r")), transform);
+      }
+      catch (const std::logic_error& error)
+      {
+        fail(error.what());
+      }
+    }
+
+    void addRing(const transform_t& transform)
+    {
+      points_.erase(std::unique(points_.begin(), points_.end(), [](const klimchuk::point_t& lhs,
+        const klimchuk::point_t& rhs)
+      {
+        return (lhs.x == rhs.x) && (lhs.y == rhs.y);
+      }), points_.end());
+      if ((points_.size() > 1) && (points_.front().x == points_.back().x) && (points_.front().y == points_.back().y))
+      {
+        points_.pop_back();
+      }
+      for (klimchuk::point_t& point : points_)
+      {
+        point = apply(transform, point);
+      }
+      if (!hasArea(points_))
+      {
+        points_.clear();
+        return;
+      }
+      try
+      {
+        if (points_.size() == 3)
+        {
+          groups_.back().shapes.push_back(std::make_shared<klimchuk::Triangle>(points_[0], points_[1], points_[2]));
+        }
+        else
+        {
+          groups_.back().shapes.push_back(std::make_shared<klimchuk::Polygon>(points_.data(), points_.size()));
+        }
+      }
+      catch (const std::logic_error& error)
+      {
+        fail(error.what());
+      }
+      points_.clear();
+    }
+
+    void addPolygon(const transform_t& transform)
+    {
+      const std::string_view* value = findAttribute("points");
+      if (!value)
+      {
+        fail("Polygon has no points");
+      }
+      const char* first = value->data();
+      const char* last = first + value->size();
+      points_.clear();
+      while (true)
+      {
+        while ((first != last) && isSeparator(*first))
+        {
+          ++first;
+        }
+        if (first == last)
+        {
+          break;
+        }
+        klimchuk::point_t point{ 0.0, 0.0 };
+        if (!parseNumber(first, last, point.x) || !parseNumber(first, last, point.y))
+        {
+          fail("Invalid number");
+        }
+        points_.push_back(point);
+      }
+      addRing(transform);
+    }
+
+    void addPath(const transform_t& transform)
+    {
+      const std::string_view* value = findAttribute("d");
+      if (!value)
+      {
+        fail("Path has no data");
+      }
+      const char* first = value->data();
+      const char* last = first + value->size();
+      const size_t firstShape = groups_.back().shapes.size();
+      points_.clear();
+      klimchuk::point_t current{ 0.0, 0.0 };
+      klimchuk::point_t start{ 0.0, 0.0 };
+      char command = '\0';
+      while (true)
+      {
+        while ((first != last) && isSeparator(*first))
+        {
+          ++first;
+        }
+        if (first == last)
+        {
+          break;
+        }
+        if (std::isalpha(static_cast<unsigned char>(*first)))
+        {
+          command = *first++;
+          if ((command == 'Z') || (command == 'z'))
+          {
+            if (!points_.empty())
+            {
+              addRing(transform);
+            }
+            current = start;
+            continue;
+          }
+          if (std::strchr("MmLlHhVv", command) == nullptr)
+          {
+            fail("Only straight segments are supported in path");
+          }
+        }
+        const bool isRelative = std::islower(static_cast<unsigned char>(command));
+        double x = 0.0;
+        double y = 0.0;
+        switch (command)
+        {
+        case 'M':
+        case 'm':
+        case 'L':
+        case 'l':
+          if (!parseNumber(first, last, x) || !parseNumber(first, last, y))
+          {
+            fail("Invalid number");
+          }
+          current = isRelative ? klimchuk::point_t{ current.x + x, current.y + y } : klimchuk::point_t{ x, y };
+          break;
+        case 'H':
+        case 'h':
+          if (!parseNumber(first, last, x))
+          {
+            fail("Invalid number");
+          }
+          current.x = isRelative ? (current.x + x) : x;
+          break;
+        case 'V':
+        case 'v':
+          if (!parseNumber(first, last, y))
+          {
+            fail("Invalid number");
+          }
+          current.y = isRelative ? (current.y + y) : y;
+          break;
+        default:
+          fail("Path data must start with a command");
+        }
+        if ((command == 'M') || (command == 'm'))
+        {
+          if (points_.size() > 1)
+          {
+            addRing(transform);
+          }
+          points_.clear();
+          start = current;
+          command = (command == 'M') ? 'L' : 'l';
+        }
+        else if (points_.empty())
+        {
+          points_.push_back(start);
+        }
+        points_.push_back(current);
+      }
+      if (points_.size() > 1)
+      {
+        addRing(transform);
+      }
+      std::vector<klimchuk::Shape::ShapePtr>& shapes = groups_.back().shapes;
+      if (shapes.size() > firstShape + 1)
+      {
+        std::shared_ptr<klimchuk::CompositeShape> compositeShape
+            = std::make_shared<klimchuk::CompositeShape>(shapes[firstShape]);
+        for (size_t i = firstShape + 1; i < shapes.size(); ++i)
+        {
+          compositeShape->add(shapes[i]);
+        }
+        shapes.resize(firstShape);
+        shapes.push_back(compositeShape);
+      }
+    }
+
+    void close()
+    {
+      group_t group = std::move(groups_.back());
+      groups_.pop_back();
+      std::vector<klimchuk::Shape::ShapePtr>& shapes = groups_.back().shapes;
+      if (group.isGroup && !group.shapes.empty())
+      {
+        std::shared_ptr<klimchuk::CompositeShape> compositeShape
+            = std::make_shared<klimchuk::CompositeShape>(group.shapes.front());
+        for (size_t i = 1; i < group.shapes.size(); ++i)
+        {
+          compositeShape->add(group.shapes[i]);
+        }
+        shapes.push_back(compositeShape);
+      }
+      else
+      {
+        shapes.insert(shapes.end(), group.shapes.begin(), group.shapes.end());
+      }
+    }
+  };
+
+  class SvgWriter
+  {
+  public:
+    explicit SvgWriter(std::ostream& stream):
+      stream_{ stream }
+    {}
+
+    void writeHeader(const klimchuk::rectangle_t& frame)
+    {
+      stream_ << "<svg xmlns=\"http://www.w3.org/2000/svg\" viewBox=\"";
+      writeNumber(frame.pos.x - (frame.width / 2));
+      stream_ << ' ';
+      writeNumber(frame.pos.y - (frame.height / 2));
+      stream_ << ' ';
+      writeNumber(frame.width);
+      stream_ << ' ';
+      writeNumber(frame.height);
+      stream_ << "\">\n";
+    }
+
+    void writeFooter()
+    {
+      stream_ << "</svg>\n";
+      if (!stream_)
+      {
+        throw std::runtime_error("writeSvg: Can't write image.");
+      }
+    }
+
+    void writeShape(const klimchuk::Shape& shape, size_t depth)
+    {
+      stream_ << std::string(2 * depth, ' ');
+      if (const klimchuk::CompositeShape* compositeShape = dynamic_cast<const klimchuk::CompositeShape*>(&shape))
+      {
+        stream_ << "<g>\n";
+        for (size_t i = 0; i < compositeShape->getSize(); ++i)
+        {
+          writeShape(*(*compositeShape)[i], depth + 1);
+        }
+        stream_ << std::string(2 * depth, ' ') << "</g>\n";
+      }
+      else if (const klimchuk::Circle* circle = dynamic_cast<const klimchuk::Circle*>(&shape))
+      {
+        stream_ << "<circle cx=\"";
+        writeNumber(circle->getCentre().x);
+        stream_ << "\" cy=\"";
+        writeNumber(circle->getCentre().y);
+        stream_ << "\" r=\"";
+        writeNumber(circle->getRadius());
+        stream_ << "\"/>\n";
+      }
+      else if (const klimchuk::Rectangle* rectangle = dynamic_cast<const klimchuk::Rectangle*>(&shape))
+      {
+        const klimchuk::oriented_rectangle_t frame = rectangle->getOrientedFrameRect();
+        stream_ << "<rect x=\"";
+        writeNumber(-frame.width / 2);
+        stream_ << "\" y=\"";
+        writeNumber(-frame.height / 2);
+        stream_ << "\" width=\"";
+        writeNumber(frame.width);
+        stream_ << "\" height=\"";
+        writeNumber(frame.height);
+        stream_ << "\" transform=\"translate(";
+        writeNumber(frame.pos.x);
+        stream_ << ' ';
+        writeNumber(frame.pos.y);
+        stream_ << ") rotate(";
+        writeNumber(std::atan2(frame.axis.y, frame.axis.x) * 180 / M_PI);
+        stream_ << ")\"/>\n";
+      }
+      else if (const klimchuk::Triangle* triangle = dynamic_cast<const klimchuk::Triangle*>(&shape))
+      {
+        const klimchuk::point_t points[] = { (*triangle)[0], (*triangle)[1], (*triangle)[2] };
+        writePolygon(points, 3);
+      }
+      else if (const klimchuk::Polygon* polygon = dynamic_cast<const klimchuk::Polygon*>(&shape))
+      {
+        const std::vector<klimchuk::point_t> points = polygon->getPointsOfLevel(0);
+        writePolygon(points.data(), points.size());
+      }
+      else
+      {
+        throw std::invalid_argument("writeSvg: Unsupported type of shape.");
+      }
+    }
+
+    void writeLayer(size_t index)
+    {
+      stream_ << "  <g id=\"layer-" << index << "\">\n";
+    }
+
+    void closeLayer()
+    {
+      stream_ << "  </g>\n";
+    }
+  private:
+    std::ostream& stream_;
+
+    void writeNumber(double number)
+    {
+      char buffer[32];
+      const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+      stream_.write(buffer, result.ptr - buffer);
+    }
+
+    void writePolygon(const klimchuk::point_t* points, size_t numberOfPoints)
+    {
+      stream_ << "<polygon points=\"";
+      for (size_t i = 0; i < numberOfPoints; ++i)
+      {
+        stream_ << ((i == 0) ? "" : " ");
+        writeNumber(points[i].x);
+        stream_ << ',';
+        writeNumber(points[i].y);
+      }
+      stream_ << "\"/>\n";
+    }
+  };
+
+  klimchuk::rectangle_t unite(const klimchuk::rectangle_t& lhs, const klimchuk::rectangle_t& rhs)
+  {
+    const double left = std::min(lhs.pos.x - (lhs.width / 2), rhs.pos.x - (rhs.width / 2));
+    const double right = std::max(lhs.pos.x + (lhs.width / 2), rhs.pos.x + (rhs.width / 2));
+    const double bottom = std::min(lhs.pos.y - (lhs.height / 2), rhs.pos.y - (rhs.height / 2));
+    const double top = std::max(lhs.pos.y + (lhs.height / 2), rhs.pos.y + (rhs.height / 2));
+    return klimchuk::rectangle_t{ right - left, top - bottom, { (left + right) / 2, (bottom + top) / 2 } };
+  }
+}
+
+klimchuk::CompositeShape klimchuk::readSvg(std::istream& stream, size_t sizeOfBuffer, size_t maxLengthOfTag)
+{
+  SvgParser parser(stream, sizeOfBuffer, maxLengthOfTag);
+  std::vector<Shape::ShapePtr> shapes = parser.parse();
+  if (shapes.empty())
+  {
+    throw std::runtime_error("readSvg: Image has no shapes.");
+  }
+  CompositeShape compositeShape(shapes.front());
+  for (size_t i = 1; i < shapes.size(); ++i)
+  {
+    compositeShape.add(shapes[i]);
+  }
+  return compositeShape;
+}
+
+void klimchuk::writeSvg(std::ostream& stream, const CompositeShape& compositeShape)
+{
+  SvgWriter writer(stream);
+  rectangle_t frame = compositeShape[0]->getFrameRect();
+  for (size_t i = 1; i < compositeShape.getSize(); ++i)
+  {
+    frame = unite(frame, compositeShape[i]->getFrameRect());
+  }
+  writer.writeHeader(frame);
+  for (size_t i = 0; i < compositeShape.getSize(); ++i)
+  {
+    writer.writeShape(*compositeShape[i], 1);
+  }
+  writer.writeFooter();
+}
+
+void klimchuk::writeSvg(std::ostream& stream, const Matrix& matrix)
+{
+  SvgWriter writer(stream);
+  rectangle_t frame{ 0.0, 0.0, { 0.0, 0.0 } };
+  for (size_t i = 0; i < matrix.getNumberOFLayers(); ++i)
+  {
+    for (size_t j = 0; j < matrix.getSizeOfLayer(i); ++j)
+    {
+      const rectangle_t shapeFrame = matrix[i][j]->getFrameRect();
+      frame = ((i == 0) && (j == 0)) ? shapeFrame : unite(frame, shapeFrame);
+    }
+  }
+  writer.writeHeader(frame);
+  for (size_t i = 0; i < matrix.getNumberOFLayers(); ++i)
+  {
+    writer.writeLayer(i);
+    for (size_t j = 0; j < matrix.getSizeOfLayer(i); ++j)
+    {
+      writer.writeShape(*matrix[i][j], 2);
+    }
+    writer.closeLayer();
+  }
+  writer.writeFooter();
+}
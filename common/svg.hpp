@@ -0,0 +1,16 @@
+#ifndef KLIMCHUK_SVG
+#define KLIMCHUK_SVG
+
+#include <istream>
+#include <ostream>
+#include "composite-shape.hpp"
+#include "matrix.hpp"
+
+namespace klimchuk
+{
+  CompositeShape readSvg(std::istream& stream, size_t sizeOfBuffer = 65536, size_t maxLengthOfTag = 268435456);
+  void writeSvg(std::ostream& stream, const CompositeShape& compositeShape);
+  void writeSvg(std::ostream& stream, const Matrix& matrix);
+}
+
+#endif
@@ -0,0 +1,252 @@
+#include "sweep-and-prune.hpp"
+#include <stdexcept>
+#include <algorithm>
+
+namespace
+{
+  unsigned long long getKey(size_t firstIndex, size_t secondIndex)
+  {
+    if (firstIndex > secondIndex)
+    {
+      std::swap(firstIndex, secondIndex);
+    }
+    return (static_cast<unsigned long long>(firstIndex) << 32) | static_cast<unsigned long long>(secondIndex);
+  }
+
+  klimchuk::SweepAndPrune::IndexPair getPair(unsigned long long key)
+  {
+    return { static_cast<size_t>(key >> 32), static_cast<size_t>(key & 0xFFFFFFFFull) };
+  }
+}
+
+size_t klimchuk::SweepAndPrune::add(const Shape::ShapePtr& shape)
+{
+  if (!shape)
+  {
+    throw std::invalid_argument("SweepAndPrune: Parametr is not shape.");
+  }
+  size_t index = shapes_.size();
+  shapes_.push_back(shape);
+  bounds_.push_back(bounds_t{});
+  refreshBounds(index);
+  for (size_t axis = 0; axis < 2; ++axis)
+  {
+    size_t position = endpoints_[axis].size();
+    endpoints_[axis].push_back(endpoint_t{ bounds_[index].min[axis], index, true });
+    endpoints_[axis].push_back(endpoint_t{ bounds_[index].max[axis], index, false });
+    positions_[axis].push_back(position);
+    positions_[axis].push_back(position + 1);
+    moveEndpoint(axis, position);
+    moveEndpoint(axis, positions_[axis][2 * index + 1]);
+  }
+  return index;
+}
+
+void klimchuk::SweepAndPrune::update(size_t index)
+{
+  if (index >= shapes_.size())
+  {
+    throw std::out_of_range("SweepAndPrune: Invalid index to access.");
+  }
+  refreshBounds(index);
+  for (size_t axis = 0; axis < 2; ++axis)
+  {
+    size_t minPosition = positions_[axis][2 * index];
+    size_t maxPosition = positions_[axis][2 * index + 1];
+    bool isMovingForward = bounds_[index].min[axis] > endpoints_[axis][minPosition].value;
+    endpoints_[axis][minPosition].value = bounds_[index].min[axis];
+    endpoints_[axis][maxPosition].value = bounds_[index].max[axis];
+    if (isMovingForward)
+    {
+      moveEndpoint(axis, maxPosition);
+      moveEndpoint(axis, positions_[axis][2 * index]);
+    }
+    else
+    {
+      moveEndpoint(axis, minPosition);
+      moveEndpoint(axis, positions_[axis][2 * index + 1]);
+    }
+  }
+}
+
+void klimchuk::SweepAndPrune::update()
+{
+  for (size_t i = 0; i < shapes_.size(); ++i)
+  {
+    refreshBounds(i);
+  }
+  for (size_t axis = 0; axis < 2; ++axis)
+  {
+    std::vector<endpoint_t>& endpoints = endpoints_[axis];
+    for (endpoint_t& endpoint : endpoints)
+    {
+      endpoint.value = endpoint.isMin ? bounds_[endpoint.index].min[axis] : bounds_[endpoint.index].max[axis];
+    }
+    for (size_t i = 1; i < endpoints.size(); ++i)
+    {
+      for (size_t j = i; j > 0; --j)
+      {
+        const endpoint_t& current = endpoints[j];
+        const endpoint_t& previous = endpoints[j - 1];
+        if ((current.value > previous.value) || ((current.value == previous.value) && (!current.isMin || previous.isMin)))
+        {
+          break;
+        }
+        swapEndpoints(axis, j - 1);
+      }
+    }
+  }
+}
+
+klimchuk::Shape::ShapePtr klimchuk::SweepAndPrune::operator[](size_t index) const
+{
+  if (index >= shapes_.size())
+  {
+    throw std::out_of_range("SweepAndPrune: Invalid index to access.");
+  }
+  return shapes_[index];
+}
+
+size_t klimchuk::SweepAndPrune::getSize() const
+{
+  return shapes_.size();
+}
+
+bool klimchuk::SweepAndPrune::areOverlapping(size_t firstIndex, size_t secondIndex) const
+{
+  if ((firstIndex >= shapes_.size()) || (secondIndex >= shapes_.size()))
+  {
+    throw std::out_of_range("SweepAndPrune: Invalid index to access.");
+  }
+  return overlaps_.count(getKey(firstIndex, secondIndex)) != 0;
+}
+
+size_t klimchuk::SweepAndPrune::getNumberOfOverlaps() const
+{
+  return overlaps_.size();
+}
+
+std::vector<klimchuk::SweepAndPrune::IndexPair> klimchuk::SweepAndPrune::getOverlaps() const
+{
+  std::vector<IndexPair> overlaps;
+  overlaps.reserve(overlaps_.size());
+  for (unsigned long long key : overlaps_)
+  {
+    overlaps.push_back(getPair(key));
+  }
+  std::sort(overlaps.begin(), overlaps.end());
+  return overlaps;
+}
+
+std::vector<klimchuk::SweepAndPrune::IndexPair> klimchuk::SweepAndPrune::getStartedOverlaps() const
+{
+  std::vector<IndexPair> started;
+  for (const std::pair<const unsigned long long, bool>& change : changes_)
+  {
+    if (!change.second && overlaps_.count(change.first))
+    {
+      started.push_back(getPair(change.first));
+    }
+  }
+  std::sort(started.begin(), started.end());
+  return started;
+}
+
+std::vector<klimchuk::SweepAndPrune::IndexPair> klimchuk::SweepAndPrune::getStoppedOverlaps() const
+{
+  std::vector<IndexPair> stopped;
+  for (const std::pair<const unsigned long long, bool>& change : changes_)
+  {
+    if (change.second && !overlaps_.count(change.first))
+    {
+      stopped.push_back(getPair(change.first));
+    }
+  }
+  std::sort(stopped.begin(), stopped.end());
+  return stopped;
+}
+
+void klimchuk::SweepAndPrune::clearChanges()
+{
+  changes_.clear();
+}
+
+void klimchuk::SweepAndPrune::refreshBounds(size_t index)
+{
+  rectangle_t frame = shapes_[index]->getFrameRect();
+  bounds_[index].min[0] = frame.pos.x - (frame.width / 2);
+  bounds_[index].max[0] = frame.pos.x + (frame.width / 2);
+  bounds_[index].min[1] = frame.pos.y - (frame.height / 2);
+  bounds_[index].max[1] = frame.pos.y + (frame.height / 2);
+}
+
+void klimchuk::SweepAndPrune::moveEndpoint(size_t axis, size_t position)
+{
+  std::vector<endpoint_t>& endpoints = endpoints_[axis];
+  while (position > 0)
+  {
+    const endpoint_t& current = endpoints[position];
+    const endpoint_t& previous = endpoints[position - 1];
+    if ((current.value > previous.value) || ((current.value == previous.value) && (!current.isMin || previous.isMin)))
+    {
+      break;
+    }
+    swapEndpoints(axis, position - 1);
+    --position;
+  }
+  while (position + 1 < endpoints.size())
+  {
+    const endpoint_t& current = endpoints[position];
+    const endpoint_t& next = endpoints[position + 1];
+    if ((current.value < next.value) || ((current.value == next.value) && (current.isMin || !next.isMin)))
+    {
+      break;
+    }
+    swapEndpoints(axis, position);
+    ++position;
+  }
+}
+
+void klimchuk::SweepAndPrune::swapEndpoints(size_t axis, size_t position)
+{
+  std::vector<endpoint_t>& endpoints = endpoints_[axis];
+  std::swap(endpoints[position], endpoints[position + 1]);
+  const endpoint_t& first = endpoints[position];
+  const endpoint_t& second = endpoints[position + 1];
+  positions_[axis][2 * first.index + (first.isMin ? 0 : 1)] = position;
+  positions_[axis][2 * second.index + (second.isMin ? 0 : 1)] = position + 1;
+  if ((first.index == second.index) || (first.isMin == second.isMin))
+  {
+    return;
+  }
+  unsigned long long key = getKey(first.index, second.index);
+  bool isOverlapping = areBoundsOverlapping(first.index, second.index);
+  bool wasOverlapping = overlaps_.count(key) != 0;
+  if (isOverlapping == wasOverlapping)
+  {
+    return;
+  }
+  changes_.emplace(key, wasOverlapping);
+  if (isOverlapping)
+  {
+    overlaps_.insert(key);
+  }
+  else
+  {
+    overlaps_.erase(key);
+  }
+}
+
+bool klimchuk::SweepAndPrune::areBoundsOverlapping(size_t firstIndex, size_t secondIndex) const
+{
+  const bounds_t& first = bounds_[firstIndex];
+  const bounds_t& second = bounds_[secondIndex];
+  for (size_t axis = 0; axis < 2; ++axis)
+  {
+    if ((first.max[axis] < second.min[axis]) || (second.max[axis] < first.min[axis]))
+    {
+      return false;
+    }
+  }
+  return true;
+}
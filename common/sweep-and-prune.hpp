@@ -0,0 +1,58 @@
+#ifndef KLIMCHUK_SWEEP_AND_PRUNE
+#define KLIMCHUK_SWEEP_AND_PRUNE
+
+#include <vector>
+#include <utility>
+#include <unordered_map>
+#include <unordered_set>
+#include "shape.hpp"
+
+namespace klimchuk
+{
+  class SweepAndPrune
+  {
+  public:
+    typedef std::pair<size_t, size_t> IndexPair;
+
+    size_t add(const Shape::ShapePtr& shape);
+    void update(size_t index);
+    void update();
+
+    Shape::ShapePtr operator[](size_t index) const;
+    size_t getSize() const;
+
+    bool areOverlapping(size_t firstIndex, size_t secondIndex) const;
+    size_t getNumberOfOverlaps() const;
+    std::vector<IndexPair> getOverlaps() const;
+    std::vector<IndexPair> getStartedOverlaps() const;
+    std::vector<IndexPair> getStoppedOverlaps() const;
+    void clearChanges();
+  private:
+    struct endpoint_t
+    {
+      double value;
+      size_t index;
+      bool isMin;
+    };
+
+    struct bounds_t
+    {
+      double min[2];
+      double max[2];
+    };
+
+    std::vector<Shape::ShapePtr> shapes_;
+    std::vector<bounds_t> bounds_;
+    std::vector<endpoint_t> endpoints_[2];
+    std::vector<size_t> positions_[2];
+    std::unordered_set<unsigned long long> overlaps_;
+    std::unordered_map<unsigned long long, bool> changes_;
+
+    void refreshBounds(size_t index);
+    void moveEndpoint(size_t axis, size_t position);
+    void swapEndpoints(size_t axis, size_t position);
+    bool areBoundsOverlapping(size_t firstIndex, size_t secondIndex) const;
+  };
+}
+
+#endif
@@ -0,0 +1,149 @@
+#include <stdexcept>
+#include <cmath>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include "boost/test/unit_test.hpp"
+#include "base-types.hpp"
+
+const double EPSILON = 0.000001;
+
+BOOST_AUTO_TEST_SUITE(base_types_oriented_rectangles)
+
+BOOST_AUTO_TEST_CASE(oriented_rectangles_intersection)
+{
+  const double half = std::sqrt(0.5);
+  const klimchuk::oriented_rectangle_t diamond{ 2.0, 2.0, { 0.0, 0.0 }, { half, half } };
+  const klimchuk::oriented_rectangle_t square{ 2.0, 2.0, { 2.3, 0.0 }, { 1.0, 0.0 } };
+  BOOST_CHECK(klimchuk::areShapesIntersect(diamond, square));
+  const klimchuk::oriented_rectangle_t cornerSquare{ 2.0, 2.0, { 1.9, 1.9 }, { 1.0, 0.0 } };
+  BOOST_CHECK(klimchuk::areShapesIntersect(klimchuk::getFrameRect(diamond), klimchuk::getFrameRect(cornerSquare)));
+  BOOST_CHECK(!klimchuk::areShapesIntersect(diamond, cornerSquare));
+  BOOST_CHECK(klimchuk::areShapesIntersect(cornerSquare, square));
+}
+
+BOOST_AUTO_TEST_CASE(oriented_rectangle_frame)
+{
+  const double half = std::sqrt(0.5);
+  klimchuk::rectangle_t frame = klimchuk::getFrameRect({ 4.0, 2.0, { 1.0, -1.0 }, { half, -half } });
+  BOOST_CHECK_CLOSE(frame.width, 6.0 * half, EPSILON);
+  BOOST_CHECK_CLOSE(frame.height, 6.0 * half, EPSILON);
+  BOOST_CHECK_CLOSE(frame.pos.x, 1.0, EPSILON);
+  BOOST_CHECK_CLOSE(frame.pos.y, -1.0, EPSILON);
+}
+
+BOOST_AUTO_TEST_CASE(oriented_rectangle_corners)
+{
+  const klimchuk::point_t expected[4] = { { 1.0, 1.0 }, { 1.0, -3.0 }, { 3.0, -3.0 }, { 3.0, 1.0 } };
+  klimchuk::point_t corners[4];
+  klimchuk::getCorners({ 4.0, 2.0, { 2.0, -1.0 }, { 0.0, 1.0 } }, corners);
+  for (size_t i = 0; i < 4; ++i)
+  {
+    BOOST_CHECK_CLOSE(corners[i].x, expected[i].x, EPSILON);
+    BOOST_CHECK_CLOSE(corners[i].y, expected[i].y, EPSILON);
+  }
+  BOOST_CHECK_THROW(klimchuk::getCorners({ 4.0, 2.0, { 2.0, -1.0 }, { 0.0, 1.0 } }, nullptr), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(minimum_area_rect_of_rotated_rectangle)
+{
+  const double angle = 0.3;
+  const klimchuk::point_t axis{ std::cos(angle), std::sin(angle) };
+  const klimchuk::point_t points[6] = { { 0.0, 0.0 }, { 4.0 * axis.x, 4.0 * axis.y },
+    { 4.0 * axis.x - axis.y, 4.0 * axis.y + axis.x }, { -axis.y, axis.x },
+    { 2.0 * axis.x - 0.5 * axis.y, 2.0 * axis.y + 0.5 * axis.x }, { 4.0 * axis.x, 4.0 * axis.y } };
+  klimchuk::oriented_rectangle_t rectangle = klimchuk::getMinimumAreaRect(points, 6);
+  BOOST_CHECK_CLOSE(rectangle.width * rectangle.height, 4.0, EPSILON);
+  BOOST_CHECK_CLOSE(rectangle.pos.x, 2.0 * axis.x - 0.5 * axis.y, EPSILON);
+  BOOST_CHECK_CLOSE(rectangle.pos.y, 2.0 * axis.y + 0.5 * axis.x, EPSILON);
+  BOOST_CHECK_SMALL((rectangle.axis.x * axis.y - rectangle.axis.y * axis.x)
+    * (rectangle.axis.x * axis.x + rectangle.axis.y * axis.y), EPSILON);
+}
+
+BOOST_AUTO_TEST_CASE(minimum_area_rect_matches_projection_on_every_edge)
+{
+  std::mt19937 generator(3);
+  std::uniform_real_distribution<double> coordinate(-10.0, 10.0);
+  std::vector<klimchuk::point_t> points(500);
+  for (klimchuk::point_t& point : points)
+  {
+    const double x = coordinate(generator);
+    point = { x, (coordinate(generator) * 0.3) + (x * 0.5) };
+  }
+  const std::vector<klimchuk::point_t> hull = klimchuk::getConvexHull(points.data(), points.size());
+  double expectedArea = -1.0;
+  for (size_t i = 0; i < hull.size(); ++i)
+  {
+    const klimchuk::point_t& begin = hull[i];
+    const klimchuk::point_t& end = hull[(i + 1) % hull.size()];
+    const double length = std::hypot(end.x - begin.x, end.y - begin.y);
+    const klimchuk::point_t axis{ (end.x - begin.x) / length, (end.y - begin.y) / length };
+    double minU = 0.0;
+    double maxU = 0.0;
+    double maxV = 0.0;
+    for (const klimchuk::point_t& point : hull)
+    {
+      const double u = (point.x - begin.x) * axis.x + (point.y - begin.y) * axis.y;
+      minU = std::min(minU, u);
+      maxU = std::max(maxU, u);
+      maxV = std::max(maxV, (point.y - begin.y) * axis.x - (point.x - begin.x) * axis.y);
+    }
+    const double area = (maxU - minU) * maxV;
+    expectedArea = ((expectedArea < 0.0) || (area < expectedArea)) ? area : expectedArea;
+  }
+  const klimchuk::oriented_rectangle_t rectangle = klimchuk::getMinimumAreaRect(points.data(), points.size());
+  BOOST_CHECK_CLOSE(rectangle.width * rectangle.height, expectedArea, EPSILON);
+  for (const klimchuk::point_t& point : points)
+  {
+    const double u = (point.x - rectangle.pos.x) * rectangle.axis.x + (point.y - rectangle.pos.y) * rectangle.axis.y;
+    const double v = (point.y - rectangle.pos.y) * rectangle.axis.x - (point.x - rectangle.pos.x) * rectangle.axis.y;
+    BOOST_CHECK_LE(std::abs(u), rectangle.width / 2 + EPSILON);
+    BOOST_CHECK_LE(std::abs(v), rectangle.height / 2 + EPSILON);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(minimum_area_rect_invalid_argument)
+{
+  BOOST_CHECK_THROW(klimchuk::getMinimumAreaRect(nullptr, 3), std::invalid_argument);
+  const klimchuk::point_t point{ 1.0, 2.0 };
+  BOOST_CHECK_THROW(klimchuk::getMinimumAreaRect(&point, 0), std::invalid_argument);
+  klimchuk::oriented_rectangle_t rectangle = klimchuk::getMinimumAreaRect(&point, 1);
+  BOOST_CHECK_CLOSE(rectangle.pos.x, 1.0, EPSILON);
+  BOOST_CHECK_EQUAL(rectangle.width, 0.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(base_types_hull_and_enclosing_circle)
+
+BOOST_AUTO_TEST_CASE(convex_hull_drops_inner_points)
+{
+  const klimchuk::point_t points[6] = { { 0.0, 0.0 }, { 2.0, 0.0 }, { 1.0, 1.0 }, { 2.0, 2.0 }, { 0.0, 2.0 },
+    { 1.0, 0.0 } };
+  std::vector<klimchuk::point_t> hull = klimchuk::getConvexHull(points, 6);
+  BOOST_REQUIRE_EQUAL(hull.size(), 4);
+  double area = 0.0;
+  for (size_t i = 0; i < hull.size(); ++i)
+  {
+    area += (hull[i].x * hull[(i + 1) % hull.size()].y) - (hull[i].y * hull[(i + 1) % hull.size()].x);
+  }
+  BOOST_CHECK_CLOSE(area / 2, 4.0, EPSILON);
+  BOOST_CHECK_THROW(klimchuk::getConvexHull(nullptr, 2), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(enclosing_circle_of_acute_and_obtuse_triangles)
+{
+  const klimchuk::point_t acute[4] = { { -1.0, 0.0 }, { 1.0, 0.0 }, { 0.0, std::sqrt(3.0) }, { 0.0, 0.5 } };
+  klimchuk::circle_t circle = klimchuk::getEnclosingCircle(acute, 4);
+  BOOST_CHECK_CLOSE(circle.radius, 2.0 / std::sqrt(3.0), EPSILON);
+  BOOST_CHECK_SMALL(circle.pos.x, EPSILON);
+  BOOST_CHECK_CLOSE(circle.pos.y, 1.0 / std::sqrt(3.0), EPSILON);
+
+  const klimchuk::point_t obtuse[3] = { { -2.0, 1.0 }, { 2.0, 1.0 }, { 0.0, 1.5 } };
+  circle = klimchuk::getEnclosingCircle(obtuse, 3);
+  BOOST_CHECK_CLOSE(circle.radius, 2.0, EPSILON);
+  BOOST_CHECK_CLOSE(circle.pos.y, 1.0, EPSILON);
+  BOOST_CHECK_THROW(klimchuk::getEnclosingCircle(obtuse, 0), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
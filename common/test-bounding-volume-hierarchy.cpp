@@ -0,0 +1,224 @@
+#include <stdexcept>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include "boost/test/unit_test.hpp"
+#include "bounding-volume-hierarchy.hpp"
+#include "composite-shape.hpp"
+#include "circle.hpp"
+#include "rectangle.hpp"
+#include "triangle.hpp"
+
+namespace
+{
+  std::vector<klimchuk::Shape::ShapePtr> collectLeaves(klimchuk::CompositeShape& compositeShape)
+  {
+    std::vector<klimchuk::Shape::ShapePtr> leaves;
+    for (size_t i = 0; i < compositeShape.getSize(); ++i)
+    {
+      klimchuk::Shape::ShapePtr shape = compositeShape[i];
+      std::shared_ptr<klimchuk::CompositeShape> child = std::dynamic_pointer_cast<klimchuk::CompositeShape>(shape);
+      if (child)
+      {
+        std::vector<klimchuk::Shape::ShapePtr> nested = collectLeaves(*child);
+        leaves.insert(leaves.end(), nested.begin(), nested.end());
+      }
+      else
+      {
+        leaves.push_back(shape);
+      }
+    }
+    return leaves;
+  }
+
+  std::shared_ptr<klimchuk::CompositeShape> makeNestedScene(unsigned int seed)
+  {
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<double> position(-100.0, 100.0);
+    std::uniform_real_distribution<double> size(0.5, 5.0);
+    std::shared_ptr<klimchuk::CompositeShape> scene = std::make_shared<klimchuk::CompositeShape>(
+      std::make_shared<klimchuk::Circle>(0.0, 0.0, 1.0));
+    for (size_t i = 0; i < 20; ++i)
+    {
+      std::shared_ptr<klimchuk::CompositeShape> group = std::make_shared<klimchuk::CompositeShape>(
+        std::make_shared<klimchuk::Rectangle>(size(generator), size(generator), position(generator), position(generator)));
+      for (size_t j = 0; j < 30; ++j)
+      {
+        group->add(std::make_shared<klimchuk::Circle>(position(generator), position(generator), size(generator)));
+      }
+      scene->add(group);
+      scene->add(std::make_shared<klimchuk::Rectangle>(size(generator), size(generator), position(generator),
+        position(generator)));
+    }
+    return scene;
+  }
+
+  std::vector<klimchuk::Shape::ShapePtr> sorted(std::vector<klimchuk::Shape::ShapePtr> shapes)
+  {
+    std::sort(shapes.begin(), shapes.end());
+    return shapes;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(BoundingVolumeHierarchy_construction)
+
+BOOST_AUTO_TEST_CASE(BoundingVolumeHierarchy_covers_all_leaves)
+{
+  std::shared_ptr<klimchuk::CompositeShape> scene = makeNestedScene(1);
+  klimchuk::BoundingVolumeHierarchy hierarchy(*scene);
+  BOOST_CHECK_EQUAL(hierarchy.getSize(), collectLeaves(*scene).size());
+  klimchuk::BoundingVolumeHierarchy flatHierarchy(*scene, false);
+  BOOST_CHECK_EQUAL(flatHierarchy.getSize(), hierarchy.getSize());
+  BOOST_CHECK_EQUAL(flatHierarchy.getDepth(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(BoundingVolumeHierarchy_rebalances_flat_composite)
+{
+  klimchuk::CompositeShape scene(std::make_shared<klimchuk::Circle>(0.0, 0.0, 1.0));
+  for (size_t i = 1; i < 4096; ++i)
+  {
+    scene.add(std::make_shared<klimchuk::Circle>(static_cast<double>(i % 64) * 3.0, static_cast<double>(i / 64) * 3.0, 1.0));
+  }
+  klimchuk::BoundingVolumeHierarchy hierarchy(scene);
+  BOOST_CHECK_EQUAL(hierarchy.getSize(), 4096);
+  BOOST_CHECK_LE(hierarchy.getDepth(), 20);
+  BOOST_CHECK_EQUAL(hierarchy.queryPoint({ 30.0, 30.0 }).size(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(BoundingVolumeHierarchy_queries)
+
+BOOST_AUTO_TEST_CASE(BoundingVolumeHierarchy_overlap_and_point_queries_match_brute_force)
+{
+  std::shared_ptr<klimchuk::CompositeShape> scene = makeNestedScene(2);
+  std::vector<klimchuk::Shape::ShapePtr> leaves = collectLeaves(*scene);
+  klimchuk::BoundingVolumeHierarchy hierarchy(*scene);
+  klimchuk::BoundingVolumeHierarchy flatHierarchy(*scene, false);
+  const klimchuk::rectangle_t area{ 40.0, 30.0, { 10.0, -5.0 } };
+  std::vector<klimchuk::Shape::ShapePtr> expected;
+  for (const klimchuk::Shape::ShapePtr& leaf : leaves)
+  {
+    if (klimchuk::areShapesIntersect(leaf->getFrameRect(), area))
+    {
+      expected.push_back(leaf);
+    }
+  }
+  BOOST_CHECK(sorted(hierarchy.queryOverlap(area)) == sorted(expected));
+  BOOST_CHECK(sorted(flatHierarchy.queryOverlap(area)) == sorted(expected));
+
+  const klimchuk::point_t point = leaves[7]->getCentre();
+  std::vector<klimchuk::Shape::ShapePtr> hits = hierarchy.queryPoint(point);
+  BOOST_CHECK(std::find(hits.begin(), hits.end(), leaves[7]) != hits.end());
+  for (const klimchuk::Shape::ShapePtr& hit : hits)
+  {
+    BOOST_CHECK(klimchuk::areShapesIntersect(hit->getFrameRect(), klimchuk::rectangle_t{ 0.0, 0.0, point }));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(BoundingVolumeHierarchy_oriented_overlap_query)
+{
+  std::shared_ptr<klimchuk::CompositeShape> scene = makeNestedScene(5);
+  std::vector<klimchuk::Shape::ShapePtr> leaves = collectLeaves(*scene);
+  for (size_t i = 0; i < leaves.size(); ++i)
+  {
+    leaves[i]->rotate(static_cast<double>(i * 13));
+  }
+  klimchuk::BoundingVolumeHierarchy hierarchy(*scene);
+  const klimchuk::oriented_rectangle_t area{ 80.0, 6.0, { 0.0, 0.0 }, { 0.6, 0.8 } };
+  std::vector<klimchuk::Shape::ShapePtr> expected;
+  for (const klimchuk::Shape::ShapePtr& leaf : leaves)
+  {
+    if (klimchuk::areShapesIntersect(leaf->getOrientedFrameRect(), area))
+    {
+      expected.push_back(leaf);
+    }
+  }
+  std::vector<klimchuk::Shape::ShapePtr> hits = hierarchy.queryOrientedOverlap(area);
+  BOOST_CHECK(sorted(hits) == sorted(expected));
+  BOOST_CHECK_LT(hits.size(), hierarchy.queryOverlap(klimchuk::getFrameRect(area)).size());
+}
+
+BOOST_AUTO_TEST_CASE(BoundingVolumeHierarchy_ray_query)
+{
+  klimchuk::CompositeShape scene(std::make_shared<klimchuk::Circle>(10.0, 0.0, 1.0));
+  scene.add(std::make_shared<klimchuk::Rectangle>(2.0, 2.0, 5.0, 0.0));
+  scene.add(std::make_shared<klimchuk::Rectangle>(2.0, 2.0, 5.0, 5.0));
+  scene.add(std::make_shared<klimchuk::Circle>(-5.0, 0.0, 1.0));
+  klimchuk::BoundingVolumeHierarchy hierarchy(scene);
+  std::vector<klimchuk::Shape::ShapePtr> hits = hierarchy.queryRay({ 0.0, 0.0 }, { 1.0, 0.0 });
+  BOOST_REQUIRE_EQUAL(hits.size(), 2);
+  BOOST_CHECK_EQUAL(hits[0], scene[1]);
+  BOOST_CHECK_EQUAL(hits[1], scene[0]);
+  BOOST_CHECK_EQUAL(hierarchy.queryRay({ 0.0, 0.0 }, { 1.0, 1.0 }).size(), 1);
+  BOOST_CHECK_THROW(hierarchy.queryRay({ 0.0, 0.0 }, { 0.0, 0.0 }), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(BoundingVolumeHierarchy_refitting)
+
+BOOST_AUTO_TEST_CASE(BoundingVolumeHierarchy_refit_after_moving_leaf_and_composite)
+{
+  std::shared_ptr<klimchuk::CompositeShape> scene = makeNestedScene(3);
+  klimchuk::BoundingVolumeHierarchy hierarchy(*scene);
+  klimchuk::Shape::ShapePtr leaf = scene->operator[](2);
+  leaf->move({ 500.0, 500.0 });
+  hierarchy.refit(leaf);
+  std::vector<klimchuk::Shape::ShapePtr> hits = hierarchy.queryPoint({ 500.0, 500.0 });
+  BOOST_REQUIRE_EQUAL(hits.size(), 1);
+  BOOST_CHECK_EQUAL(hits[0], leaf);
+
+  klimchuk::Shape::ShapePtr group = scene->operator[](1);
+  group->move(1000.0, 0.0);
+  group->rotate(45.0);
+  hierarchy.refit(group);
+  klimchuk::rectangle_t frame = group->getFrameRect();
+  std::vector<klimchuk::Shape::ShapePtr> expected;
+  for (const klimchuk::Shape::ShapePtr& shape : collectLeaves(*scene))
+  {
+    if (klimchuk::areShapesIntersect(shape->getFrameRect(), frame))
+    {
+      expected.push_back(shape);
+    }
+  }
+  BOOST_CHECK(sorted(hierarchy.queryOverlap(frame)) == sorted(expected));
+  BOOST_CHECK_CLOSE(hierarchy.getFrameRect().pos.x + hierarchy.getFrameRect().width / 2,
+    frame.pos.x + frame.width / 2, 0.000001);
+}
+
+BOOST_AUTO_TEST_CASE(BoundingVolumeHierarchy_keeps_coherent_groups)
+{
+  klimchuk::CompositeShape scene(std::make_shared<klimchuk::Circle>(0.0, 0.0, 1.0));
+  for (size_t i = 0; i < 16; ++i)
+  {
+    std::shared_ptr<klimchuk::CompositeShape> group = std::make_shared<klimchuk::CompositeShape>(
+      std::make_shared<klimchuk::Circle>(static_cast<double>(i) * 100.0, 0.0, 1.0));
+    for (size_t j = 1; j < 20; ++j)
+    {
+      group->add(std::make_shared<klimchuk::Circle>(static_cast<double>(i) * 100.0 + static_cast<double>(j),
+        static_cast<double>(j), 1.0));
+    }
+    scene.add(group);
+  }
+  klimchuk::BoundingVolumeHierarchy hierarchy(scene);
+  klimchuk::BoundingVolumeHierarchy flatHierarchy(scene, false);
+  BOOST_CHECK_EQUAL(hierarchy.getSize(), flatHierarchy.getSize());
+  BOOST_CHECK_EQUAL(hierarchy.queryPoint({ 500.0, -0.5 }).size(), 1);
+
+  klimchuk::Shape::ShapePtr group = scene[6];
+  group->move(0.0, 1000.0);
+  hierarchy.refit(group);
+  BOOST_CHECK_EQUAL(hierarchy.queryOverlap(group->getFrameRect()).size(), 20);
+  BOOST_CHECK(hierarchy.queryPoint({ 500.0, -0.5 }).empty());
+}
+
+BOOST_AUTO_TEST_CASE(BoundingVolumeHierarchy_refit_unknown_shape)
+{
+  std::shared_ptr<klimchuk::CompositeShape> scene = makeNestedScene(4);
+  klimchuk::BoundingVolumeHierarchy hierarchy(*scene);
+  BOOST_CHECK_THROW(hierarchy.refit(nullptr), std::invalid_argument);
+  BOOST_CHECK_THROW(hierarchy.refit(std::make_shared<klimchuk::Circle>(0.0, 0.0, 1.0)), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
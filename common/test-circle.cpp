@@ -143,3 +143,48 @@ BOOST_AUTO_TEST_CASE(circle_rotating_correctness)
 }
 
 BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(circle_tessellation)
+
+BOOST_AUTO_TEST_CASE(circle_tessellation_meets_tolerance)
+{
+  klimchuk::Circle circle(3.0, -2.0, 5.0);
+  for (double tolerance : { 1.0, 0.1, 0.001 })
+  {
+    std::vector<klimchuk::point_t> points = circle.tessellate(tolerance);
+    BOOST_REQUIRE_EQUAL(points.size(), klimchuk::Circle::getNumberOfSegments(5.0, tolerance));
+    BOOST_CHECK_LE(5.0 * (1.0 - std::cos(M_PI / points.size())), tolerance);
+    BOOST_CHECK_GT(5.0 * (1.0 - std::cos(2 * M_PI / points.size())), tolerance);
+    for (const klimchuk::point_t& point : points)
+    {
+      BOOST_CHECK_CLOSE(std::hypot(point.x - 3.0, point.y + 2.0), 5.0, EPSILON);
+    }
+  }
+  BOOST_CHECK_EQUAL(klimchuk::Circle::getNumberOfSegments(1.0, 10.0), 8);
+  BOOST_CHECK_EQUAL(klimchuk::Circle::getNumberOfSegments(1.0e9, 1.0e-9), 65536);
+}
+
+BOOST_AUTO_TEST_CASE(circle_tessellation_shares_unit_circle)
+{
+  const klimchuk::point_t* unitCircle = klimchuk::Circle::getUnitCircle(64);
+  BOOST_CHECK_EQUAL(klimchuk::Circle::getUnitCircle(64), unitCircle);
+  BOOST_CHECK_NE(klimchuk::Circle::getUnitCircle(32), unitCircle);
+  BOOST_CHECK_CLOSE(unitCircle[16].y, 1.0, EPSILON);
+  std::vector<klimchuk::point_t> points{ { 0.0, 0.0 } };
+  klimchuk::Circle::tessellate(points, { 1.0, 1.0 }, 2.0, 64);
+  BOOST_REQUIRE_EQUAL(points.size(), 65);
+  BOOST_CHECK_CLOSE(points[1].x, 3.0, EPSILON);
+  BOOST_CHECK_CLOSE(points[17].y, 3.0, EPSILON);
+}
+
+BOOST_AUTO_TEST_CASE(circle_tessellation_invalid_arguments)
+{
+  klimchuk::Circle circle(0.0, 0.0, 1.0);
+  BOOST_CHECK_THROW(circle.tessellate(0.0), std::invalid_argument);
+  BOOST_CHECK_THROW(klimchuk::Circle::getNumberOfSegments(-1.0, 0.1), std::invalid_argument);
+  BOOST_CHECK_THROW(klimchuk::Circle::getUnitCircle(2), std::invalid_argument);
+  BOOST_CHECK_THROW(klimchuk::Circle::getUnitCircle(48), std::invalid_argument);
+  BOOST_CHECK_THROW(klimchuk::Circle::getUnitCircle(131072), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,154 @@
+#include <stdexcept>
+#include <cmath>
+#include "boost/test/unit_test.hpp"
+#include "test-scenes.hpp"
+#include "clipper.hpp"
+#include "circle.hpp"
+#include "rectangle.hpp"
+#include "triangle.hpp"
+#include "polygon.hpp"
+
+const double EPSILON = 0.000001;
+
+namespace
+{
+  double getAreaOfFragment(const klimchuk::Clipper& clipper, size_t index)
+  {
+    const klimchuk::point_t* vertices = clipper.getVertices();
+    double area = 0.0;
+    for (size_t i = clipper[index].begin; i < clipper[index].end; ++i)
+    {
+      const klimchuk::point_t& next = vertices[(i + 1 == clipper[index].end) ? clipper[index].begin : (i + 1)];
+      area += (vertices[i].x * next.y) - (vertices[i].y * next.x);
+    }
+    return area / 2;
+  }
+
+  klimchuk::CompositeShape makeScene(size_t numberOfShapes, unsigned int seed)
+  {
+    return klimchuk::test::makeScene(std::make_shared<klimchuk::Circle>(0.0, 0.0, 3.0),
+      numberOfShapes, seed, 20.0, 6.0, "CRT", 11.0);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(Clipper_construction)
+
+BOOST_AUTO_TEST_CASE(Clipper_invalid_arguments)
+{
+  BOOST_CHECK_THROW(klimchuk::Clipper(klimchuk::rectangle_t{ 0.0, 1.0, { 0.0, 0.0 } }), std::invalid_argument);
+  BOOST_CHECK_THROW(klimchuk::Clipper(klimchuk::Shape::ConstShapePtr()), std::invalid_argument);
+  BOOST_CHECK_THROW(klimchuk::Clipper(klimchuk::rectangle_t{ 1.0, 1.0, { 0.0, 0.0 } }, 0.0), std::invalid_argument);
+  BOOST_CHECK_THROW(klimchuk::Clipper(std::make_shared<klimchuk::Circle>(0.0, 0.0, 1.0), -1.0),
+    std::invalid_argument);
+  klimchuk::Shape::ConstShapePtr compositeShape = std::make_shared<klimchuk::CompositeShape>(
+    std::make_shared<klimchuk::Circle>(0.0, 0.0, 1.0));
+  BOOST_CHECK_THROW(klimchuk::Clipper{ compositeShape }, std::invalid_argument);
+  klimchuk::Clipper clipper(klimchuk::rectangle_t{ 1.0, 1.0, { 0.0, 0.0 } });
+  BOOST_CHECK_THROW(clipper[0], std::out_of_range);
+  BOOST_CHECK_THROW(clipper.clip(klimchuk::CompositeShape(std::make_shared<klimchuk::Circle>(0.0, 0.0, 1.0)), 0),
+    std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(Clipper_splits_concave_region)
+{
+  klimchuk::Clipper square(std::make_shared<klimchuk::Rectangle>(2.0, 2.0, 0.0, 0.0));
+  BOOST_CHECK(square.isConvex());
+  klimchuk::Clipper circle(std::make_shared<klimchuk::Circle>(0.0, 0.0, 1.0));
+  BOOST_CHECK(circle.isConvex());
+  klimchuk::Clipper corner(std::make_shared<klimchuk::Polygon>(std::initializer_list<klimchuk::point_t>{ { 0.0, 0.0 },
+    { 4.0, 0.0 }, { 4.0, 2.0 }, { 2.0, 2.0 }, { 2.0, 4.0 }, { 0.0, 4.0 } }));
+  BOOST_CHECK(!corner.isConvex());
+  BOOST_CHECK_EQUAL(corner.getNumberOfPieces(), 4);
+  klimchuk::Clipper closedCorner(std::make_shared<klimchuk::Polygon>(std::initializer_list<klimchuk::point_t>{
+    { 0.0, 0.0 }, { 4.0, 0.0 }, { 4.0, 2.0 }, { 2.0, 2.0 }, { 2.0, 2.0 }, { 2.0, 4.0 }, { 0.0, 4.0 }, { 0.0, 0.0 } }));
+  BOOST_CHECK(!closedCorner.isConvex());
+  BOOST_CHECK_EQUAL(closedCorner.getNumberOfPieces(), 4);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(Clipper_clipping)
+
+BOOST_AUTO_TEST_CASE(Clipper_clips_to_viewport)
+{
+  klimchuk::CompositeShape compositeShape(std::make_shared<klimchuk::Rectangle>(4.0, 2.0, 2.0, 0.0));
+  compositeShape.add(std::make_shared<klimchuk::Circle>(0.0, 0.0, 0.5));
+  compositeShape.add(std::make_shared<klimchuk::Triangle>(klimchuk::point_t{ 10.0, 10.0 },
+    klimchuk::point_t{ 11.0, 10.0 }, klimchuk::point_t{ 10.0, 11.0 }));
+  klimchuk::Clipper clipper(klimchuk::rectangle_t{ 4.0, 4.0, { 0.0, 0.0 } });
+  clipper.clip(compositeShape);
+  BOOST_REQUIRE_EQUAL(clipper.getSize(), 2);
+  BOOST_CHECK_EQUAL(clipper[0].source, 0);
+  BOOST_CHECK_CLOSE(getAreaOfFragment(clipper, 0), 4.0, EPSILON);
+  BOOST_CHECK_EQUAL(clipper[1].source, 1);
+  BOOST_CHECK_EQUAL(clipper[1].end - clipper[1].begin, 64);
+  BOOST_CHECK_CLOSE(getAreaOfFragment(clipper, 1), 32 * 0.25 * std::sin(2 * M_PI / 64), EPSILON);
+  for (size_t i = 0; i < clipper.getNumberOfVertices(); ++i)
+  {
+    BOOST_CHECK_LE(clipper.getVertices()[i].x, 2.0 + EPSILON);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Clipper_tessellates_circles_within_tolerance)
+{
+  const klimchuk::CompositeShape compositeShape(std::make_shared<klimchuk::Circle>(0.0, 0.0, 100.0));
+  size_t previousNumberOfVertices = 0;
+  for (double tolerance : { 1.0, 0.1, klimchuk::Clipper::DEFAULT_TOLERANCE })
+  {
+    klimchuk::Clipper clipper(klimchuk::rectangle_t{ 400.0, 400.0, { 0.0, 0.0 } }, tolerance);
+    clipper.clip(compositeShape);
+    BOOST_REQUIRE_EQUAL(clipper.getSize(), 1);
+    const size_t numberOfVertices = clipper[0].end - clipper[0].begin;
+    BOOST_CHECK_EQUAL(numberOfVertices, klimchuk::Circle::getNumberOfSegments(100.0, tolerance));
+    BOOST_CHECK_GT(numberOfVertices, previousNumberOfVertices);
+    BOOST_CHECK_LE(100.0 * (1.0 - std::cos(M_PI / numberOfVertices)), tolerance);
+    previousNumberOfVertices = numberOfVertices;
+  }
+
+  klimchuk::Clipper region(std::make_shared<klimchuk::Circle>(0.0, 0.0, 100.0), 0.1);
+  region.clip(klimchuk::CompositeShape(std::make_shared<klimchuk::Rectangle>(400.0, 400.0, 0.0, 0.0)));
+  BOOST_REQUIRE_EQUAL(region.getSize(), 1);
+  BOOST_CHECK_EQUAL(region[0].end - region[0].begin, klimchuk::Circle::getNumberOfSegments(100.0, 0.1));
+}
+
+BOOST_AUTO_TEST_CASE(Clipper_clips_to_concave_polygon)
+{
+  klimchuk::Clipper clipper(std::make_shared<klimchuk::Polygon>(std::initializer_list<klimchuk::point_t>{ { 0.0, 0.0 },
+    { 0.0, 4.0 }, { 2.0, 4.0 }, { 2.0, 2.0 }, { 4.0, 2.0 }, { 4.0, 0.0 } }));
+  klimchuk::CompositeShape compositeShape(std::make_shared<klimchuk::Rectangle>(10.0, 10.0, 0.0, 0.0));
+  compositeShape.add(std::make_shared<klimchuk::Rectangle>(2.0, 2.0, 3.0, 3.0));
+  compositeShape.add(std::make_shared<klimchuk::Rectangle>(2.0, 2.0, 2.0, 2.0));
+  clipper.clip(compositeShape);
+  BOOST_CHECK_CLOSE(clipper.getArea(), 12.0 + 0.0 + 3.0, EPSILON);
+  for (size_t i = 0; i < clipper.getSize(); ++i)
+  {
+    BOOST_CHECK_NE(clipper[i].source, 1);
+    BOOST_CHECK_GT(getAreaOfFragment(clipper, i), 0.0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Clipper_parallel_clipping_matches_serial)
+{
+  klimchuk::CompositeShape scene = makeScene(500, 3);
+  scene.add(std::make_shared<klimchuk::CompositeShape>(std::make_shared<klimchuk::Circle>(5.0, 5.0, 2.0)));
+  klimchuk::Clipper serial(std::make_shared<klimchuk::Polygon>(std::initializer_list<klimchuk::point_t>{
+    { -15.0, -15.0 }, { 15.0, -15.0 }, { 0.0, 0.0 }, { 15.0, 15.0 }, { -15.0, 15.0 } }));
+  klimchuk::Clipper parallel(serial);
+  serial.clip(scene);
+  parallel.clip(scene, 4);
+  BOOST_REQUIRE_EQUAL(parallel.getSize(), serial.getSize());
+  BOOST_REQUIRE_EQUAL(parallel.getNumberOfVertices(), serial.getNumberOfVertices());
+  for (size_t i = 0; i < serial.getSize(); ++i)
+  {
+    BOOST_CHECK_EQUAL(parallel[i].begin, serial[i].begin);
+    BOOST_CHECK_EQUAL(parallel[i].source, serial[i].source);
+  }
+  BOOST_CHECK_CLOSE(parallel.getArea(), serial.getArea(), EPSILON);
+  BOOST_CHECK_EQUAL(serial[serial.getSize() - 1].source, 500);
+
+  const double area = serial.getArea();
+  serial.clip(scene, 2);
+  BOOST_CHECK_CLOSE(serial.getArea(), area, EPSILON);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
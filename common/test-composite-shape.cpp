@@ -1,4 +1,6 @@
 #include <stdexcept>
+#include <cmath>
+#include <vector>
 #include "boost/test/unit_test.hpp"
 #include "composite-shape.hpp"
 #include "circle.hpp"
@@ -7,6 +9,26 @@
 
 const double EPSILON = 0.000001;
 
+namespace
+{
+  class CountingRectangle : public klimchuk::Rectangle
+  {
+  public:
+    CountingRectangle(double width, double height, double posX, double posY, size_t& numberOfCalls) :
+      Rectangle(width, height, posX, posY),
+      numberOfCalls_(numberOfCalls)
+    {}
+
+    klimchuk::oriented_rectangle_t getOrientedFrameRect() const override
+    {
+      ++numberOfCalls_;
+      return Rectangle::getOrientedFrameRect();
+    }
+  private:
+    size_t& numberOfCalls_;
+  };
+}
+
 BOOST_AUTO_TEST_SUITE(CompositeShape_constructors)
 
 BOOST_AUTO_TEST_CASE(CompositeShape_constructor_valid)
@@ -352,3 +374,157 @@ BOOST_AUTO_TEST_CASE(CompositeShape_rotating_correctness)
 }
 
 BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(CompositeShape_oriented_frame_rect)
+
+BOOST_AUTO_TEST_CASE(CompositeShape_oriented_frame_rect_after_rotating)
+{
+  klimchuk::CompositeShape compositeShape(std::make_shared<klimchuk::Rectangle>(4.0, 2.0, 0.0, 0.0));
+  compositeShape.add(std::make_shared<klimchuk::Rectangle>(4.0, 2.0, 4.0, 0.0));
+  compositeShape.rotate(30.0);
+  klimchuk::oriented_rectangle_t frame = compositeShape.getOrientedFrameRect();
+  BOOST_CHECK_CLOSE(frame.width * frame.height, 16.0, EPSILON);
+  BOOST_CHECK_LT(frame.width * frame.height, compositeShape.getFrameRect().width * compositeShape.getFrameRect().height);
+}
+
+BOOST_AUTO_TEST_CASE(CompositeShape_oriented_frame_rect_contains_circle)
+{
+  klimchuk::CompositeShape compositeShape(std::make_shared<klimchuk::Circle>(1.0, 2.0, 3.0));
+  klimchuk::oriented_rectangle_t frame = compositeShape.getOrientedFrameRect();
+  BOOST_CHECK_CLOSE(frame.width, 6.0, EPSILON);
+  BOOST_CHECK_CLOSE(frame.height, 6.0, EPSILON);
+  BOOST_CHECK_CLOSE(frame.pos.x, 1.0, EPSILON);
+  BOOST_CHECK_CLOSE(frame.pos.y, 2.0, EPSILON);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(CompositeShape_hull_and_enclosing_circle)
+
+BOOST_AUTO_TEST_CASE(CompositeShape_hull_follows_transformations)
+{
+  klimchuk::CompositeShape compositeShape(std::make_shared<klimchuk::Rectangle>(4.0, 2.0, 0.0, 0.0));
+  compositeShape.add(std::make_shared<klimchuk::Triangle>(klimchuk::point_t{ 3.0, 0.0 }, klimchuk::point_t{ 6.0, 0.0 },
+    klimchuk::point_t{ 3.0, 3.0 }));
+  BOOST_CHECK_EQUAL(compositeShape.getConvexHull().size(), 5);
+  BOOST_CHECK_CLOSE(compositeShape.getEnclosingCircle().radius, 4.0625, EPSILON);
+
+  compositeShape.move(1.0, -2.0);
+  compositeShape.rotate(90.0);
+  compositeShape.scale(2.0);
+  const klimchuk::circle_t circle = compositeShape.getEnclosingCircle();
+  const klimchuk::rectangle_t frame = compositeShape.getHullFrameRect();
+  klimchuk::CompositeShape rebuilt(compositeShape[0]);
+  rebuilt.add(compositeShape[1]);
+  const klimchuk::rectangle_t expected = rebuilt.getHullFrameRect();
+  BOOST_CHECK_CLOSE(frame.width, 8.0, EPSILON);
+  BOOST_CHECK_CLOSE(frame.height, 16.0, EPSILON);
+  BOOST_CHECK_CLOSE(frame.pos.x, expected.pos.x, EPSILON);
+  BOOST_CHECK_CLOSE(frame.pos.y, expected.pos.y, EPSILON);
+  BOOST_CHECK_CLOSE(circle.radius, 2.0 * 4.0625, EPSILON);
+  BOOST_CHECK_CLOSE(circle.pos.x, rebuilt.getEnclosingCircle().pos.x, EPSILON);
+  BOOST_CHECK_CLOSE(circle.pos.y, rebuilt.getEnclosingCircle().pos.y, EPSILON);
+}
+
+BOOST_AUTO_TEST_CASE(CompositeShape_hull_contains_circles_and_nested_composites)
+{
+  klimchuk::CompositeShape compositeShape(std::make_shared<klimchuk::Circle>(0.0, 0.0, 2.0));
+  std::shared_ptr<klimchuk::CompositeShape> nested = std::make_shared<klimchuk::CompositeShape>(
+    std::make_shared<klimchuk::Rectangle>(2.0, 2.0, 10.0, 0.0));
+  compositeShape.add(nested);
+  const klimchuk::circle_t circle = compositeShape.getEnclosingCircle();
+  BOOST_CHECK_GE(circle.radius, 85.0 / 13.0);
+  BOOST_CHECK_LE(circle.radius, 85.0 / 13.0 + 0.05);
+  const klimchuk::rectangle_t frame = compositeShape.getHullFrameRect();
+  BOOST_CHECK_CLOSE(frame.width, 13.0, EPSILON);
+  BOOST_CHECK_CLOSE(frame.height, 4.0, EPSILON);
+
+  nested->move(5.0, 0.0);
+  compositeShape.add(std::make_shared<klimchuk::Rectangle>(1.0, 1.0, -10.0, 0.0));
+  BOOST_CHECK_CLOSE(compositeShape.getHullFrameRect().width, 26.5, EPSILON);
+}
+
+BOOST_AUTO_TEST_CASE(CompositeShape_cached_hull_does_not_visit_children)
+{
+  const size_t numberOfShapes = 1000;
+  size_t numberOfCalls = 0;
+  std::vector<std::shared_ptr<CountingRectangle>> rectangles;
+  for (size_t i = 0; i < numberOfShapes; ++i)
+  {
+    rectangles.push_back(std::make_shared<CountingRectangle>(1.0, 2.0, static_cast<double>(i),
+      static_cast<double>(i % 7), numberOfCalls));
+  }
+  std::shared_ptr<klimchuk::CompositeShape> group = std::make_shared<klimchuk::CompositeShape>(rectangles[0]);
+  for (size_t i = 1; i < numberOfShapes; ++i)
+  {
+    group->add(rectangles[i]);
+  }
+  std::shared_ptr<klimchuk::CompositeShape> compositeShape = group;
+  for (size_t i = 0; i < 100; ++i)
+  {
+    compositeShape = std::make_shared<klimchuk::CompositeShape>(compositeShape);
+  }
+  const klimchuk::rectangle_t frame = compositeShape->getHullFrameRect();
+  BOOST_CHECK_EQUAL(numberOfCalls, numberOfShapes);
+  for (size_t i = 0; i < 100; ++i)
+  {
+    compositeShape->getHullFrameRect();
+    compositeShape->getConvexHull();
+    compositeShape->getEnclosingCircle();
+  }
+  BOOST_CHECK_EQUAL(numberOfCalls, numberOfShapes);
+
+  group->move(0.0, 5.0);
+  BOOST_CHECK_CLOSE(compositeShape->getHullFrameRect().pos.y, frame.pos.y + 5.0, EPSILON);
+  BOOST_CHECK_EQUAL(numberOfCalls, numberOfShapes);
+  rectangles[0]->move(-1.0, 0.0);
+  BOOST_CHECK_CLOSE(compositeShape->getHullFrameRect().width, frame.width + 1.0, EPSILON);
+  BOOST_CHECK_EQUAL(numberOfCalls, 2 * numberOfShapes);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(CompositeShape_spatial_order)
+
+BOOST_AUTO_TEST_CASE(CompositeShape_morton_order)
+{
+  klimchuk::CompositeShape compositeShape(std::make_shared<klimchuk::Rectangle>(1.0, 1.0, 1.0, 1.0));
+  compositeShape.add(std::make_shared<klimchuk::Circle>(1.0, 0.0, 0.5));
+  compositeShape.add(std::make_shared<klimchuk::Rectangle>(1.0, 1.0, 0.0, 1.0));
+  compositeShape.add(std::make_shared<klimchuk::Circle>(0.0, 0.0, 0.5));
+  const std::vector<size_t> order = compositeShape.getSpatialOrder(klimchuk::CompositeShape::Curve::MORTON);
+  const std::vector<size_t> expected{ 3, 1, 2, 0 };
+  BOOST_CHECK_EQUAL_COLLECTIONS(order.begin(), order.end(), expected.begin(), expected.end());
+  BOOST_CHECK_CLOSE(compositeShape[0]->getCentre().x, 1.0, EPSILON);
+}
+
+BOOST_AUTO_TEST_CASE(CompositeShape_hilbert_order_visits_neighbours)
+{
+  const size_t side = 4;
+  klimchuk::CompositeShape compositeShape(std::make_shared<klimchuk::Circle>(0.0, 0.0, 0.25));
+  for (size_t i = 1; i < side * side; ++i)
+  {
+    const size_t cell = (i * 7) % (side * side);
+    compositeShape.add(std::make_shared<klimchuk::Circle>(static_cast<double>(cell % side),
+      static_cast<double>(cell / side), 0.25));
+  }
+  const std::vector<size_t> order = compositeShape.getSpatialOrder();
+  BOOST_REQUIRE_EQUAL(order.size(), side * side);
+  std::vector<bool> isVisited(side * side, false);
+  for (size_t i = 0; i < order.size(); ++i)
+  {
+    BOOST_REQUIRE_LT(order[i], side * side);
+    BOOST_CHECK(!isVisited[order[i]]);
+    isVisited[order[i]] = true;
+    if (i > 0)
+    {
+      const klimchuk::point_t previous = compositeShape[order[i - 1]]->getCentre();
+      const klimchuk::point_t current = compositeShape[order[i]]->getCentre();
+      BOOST_CHECK_CLOSE(std::abs(current.x - previous.x) + std::abs(current.y - previous.y), 1.0, EPSILON);
+    }
+  }
+  BOOST_CHECK_EQUAL(compositeShape[order.front()]->getCentre().x, 0.0);
+  BOOST_CHECK_EQUAL(compositeShape[order.front()]->getCentre().y, 0.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
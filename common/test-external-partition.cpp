@@ -0,0 +1,173 @@
+#include <stdexcept>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <unistd.h>
+#include "boost/test/unit_test.hpp"
+#include "test-scenes.hpp"
+#include "external-partition.hpp"
+#include "rectangle.hpp"
+
+namespace
+{
+  struct TemporaryFile
+  {
+    std::string path;
+
+    TemporaryFile():
+      path("/tmp/klimchuk-layers-XXXXXX")
+    {
+      ::close(::mkstemp(&path[0]));
+    }
+
+    ~TemporaryFile()
+    {
+      ::unlink(path.c_str());
+    }
+  };
+
+  klimchuk::CompositeShape makeScene(size_t numberOfShapes, unsigned int seed)
+  {
+    return klimchuk::test::makeScene(std::make_shared<klimchuk::Rectangle>(3.0, 190.0, 0.0, 0.0),
+      numberOfShapes, seed, 100.0, 9.0, "CRRRR");
+  }
+
+  std::vector<klimchuk::layer_record_t> readLayers(const std::string& path)
+  {
+    std::ifstream stream(path, std::ios::binary);
+    std::vector<klimchuk::layer_record_t> records;
+    klimchuk::layer_record_t record{ 0, 0 };
+    while (stream.read(reinterpret_cast<char*>(&record), sizeof(record)))
+    {
+      records.push_back(record);
+    }
+    return records;
+  }
+
+  std::vector<uint64_t> getExpectedLayers(const klimchuk::CompositeShape& scene, klimchuk::Matrix::Mode mode)
+  {
+    std::vector<klimchuk::rectangle_t> frames;
+    std::vector<size_t> order;
+    for (size_t i = 0; i < scene.getSize(); ++i)
+    {
+      frames.push_back(scene[i]->getFrameRect());
+      order.push_back(i);
+    }
+    std::sort(order.begin(), order.end(), [&frames](size_t lhs, size_t rhs)
+    {
+      const double left = frames[lhs].pos.x - frames[lhs].width / 2;
+      const double otherLeft = frames[rhs].pos.x - frames[rhs].width / 2;
+      return (left < otherLeft) || ((left == otherLeft) && (lhs < rhs));
+    });
+    std::vector<uint64_t> layers(frames.size());
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+      std::vector<uint64_t> usedLayers;
+      for (size_t j = 0; j < i; ++j)
+      {
+        if (klimchuk::areShapesIntersect(frames[order[i]], frames[order[j]]))
+        {
+          usedLayers.push_back(layers[order[j]]);
+        }
+      }
+      uint64_t layer = 0;
+      if (mode == klimchuk::Matrix::Mode::MINIMUM_LAYERS)
+      {
+        for (uint64_t usedLayer : usedLayers)
+        {
+          layer = std::max(layer, usedLayer + 1);
+        }
+      }
+      else
+      {
+        while (std::find(usedLayers.begin(), usedLayers.end(), layer) != usedLayers.end())
+        {
+          ++layer;
+        }
+      }
+      layers[order[i]] = layer;
+    }
+    return layers;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(External_partition)
+
+BOOST_AUTO_TEST_CASE(External_partition_matches_in_memory_sweep)
+{
+  const klimchuk::CompositeShape scene = makeScene(6000, 9);
+  TemporaryFile frames;
+  {
+    std::ofstream stream(frames.path, std::ios::binary);
+    klimchuk::writeFrames(stream, scene);
+  }
+  for (klimchuk::Matrix::Mode mode : { klimchuk::Matrix::Mode::FIRST_FIT, klimchuk::Matrix::Mode::MINIMUM_LAYERS })
+  {
+    TemporaryFile layers;
+    const klimchuk::external_statistics_t statistics = klimchuk::partitionExternally(frames.path, layers.path,
+      64 << 10, mode);
+    BOOST_CHECK_EQUAL(statistics.numberOfShapes, scene.getSize());
+    BOOST_CHECK_EQUAL(statistics.numberOfRuns, 4);
+    BOOST_CHECK_EQUAL(statistics.numberOfMergePasses, 2);
+    const std::vector<uint64_t> expected = getExpectedLayers(scene, mode);
+    const std::vector<klimchuk::layer_record_t> records = readLayers(layers.path);
+    BOOST_REQUIRE_EQUAL(records.size(), scene.getSize());
+    std::vector<bool> isSeen(scene.getSize(), false);
+    bool areLayersEqual = true;
+    double left = -1.0e9;
+    bool isSorted = true;
+    for (const klimchuk::layer_record_t& record : records)
+    {
+      BOOST_REQUIRE_LT(record.id, scene.getSize());
+      BOOST_CHECK(!isSeen[record.id]);
+      isSeen[record.id] = true;
+      areLayersEqual = areLayersEqual && (record.layer == expected[record.id]);
+      const klimchuk::rectangle_t frame = scene[record.id]->getFrameRect();
+      isSorted = isSorted && (left <= frame.pos.x - frame.width / 2);
+      left = frame.pos.x - frame.width / 2;
+    }
+    BOOST_CHECK(areLayersEqual);
+    BOOST_CHECK(isSorted);
+    BOOST_CHECK_EQUAL(statistics.numberOfLayers, *std::max_element(expected.begin(), expected.end()) + 1);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(External_partition_handles_empty_input)
+{
+  TemporaryFile frames;
+  TemporaryFile layers;
+  const klimchuk::external_statistics_t statistics = klimchuk::partitionExternally(frames.path, layers.path);
+  BOOST_CHECK_EQUAL(statistics.numberOfShapes, 0);
+  BOOST_CHECK_EQUAL(statistics.numberOfLayers, 0);
+  BOOST_CHECK(readLayers(layers.path).empty());
+}
+
+BOOST_AUTO_TEST_CASE(External_partition_reports_errors)
+{
+  TemporaryFile frames;
+  TemporaryFile layers;
+  BOOST_CHECK_THROW(klimchuk::partitionExternally("/tmp/klimchuk-frames-which-do-not-exist", layers.path),
+    std::runtime_error);
+  BOOST_CHECK_THROW(klimchuk::partitionExternally(frames.path, layers.path, 1024), std::invalid_argument);
+  {
+    std::ofstream stream(frames.path, std::ios::binary);
+    klimchuk::CompositeShape scene(std::make_shared<klimchuk::Rectangle>(1.0, 1.0, 0.0, 0.0));
+    klimchuk::writeFrames(stream, scene);
+    stream.write("abc", 3);
+  }
+  BOOST_CHECK_THROW(klimchuk::partitionExternally(frames.path, layers.path), std::runtime_error);
+  {
+    std::ofstream stream(frames.path, std::ios::binary);
+    klimchuk::CompositeShape scene(std::make_shared<klimchuk::Rectangle>(1.0, 100.0, 0.0, 0.0));
+    for (size_t i = 1; i < 2000; ++i)
+    {
+      scene.add(std::make_shared<klimchuk::Rectangle>(1.0, 100.0, 0.001 * i, 0.0));
+    }
+    klimchuk::writeFrames(stream, scene);
+  }
+  BOOST_CHECK_THROW(klimchuk::partitionExternally(frames.path, layers.path, 64 << 10), std::length_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,195 @@
+#include <stdexcept>
+#include <sstream>
+#include <string>
+#include <memory>
+#include "boost/test/unit_test.hpp"
+#include "journal.hpp"
+#include "circle.hpp"
+#include "rectangle.hpp"
+#include "triangle.hpp"
+#include "polygon.hpp"
+#include "composite-shape.hpp"
+#include "matrix.hpp"
+
+const double EPSILON = 0.000001;
+
+namespace
+{
+  void replay(klimchuk::JournalPlayer& player)
+  {
+    while (player.read())
+    {
+      player.execute();
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(Journal_recording)
+
+BOOST_AUTO_TEST_CASE(Journal_replays_session)
+{
+  klimchuk::Shape::ShapePtr circle = std::make_shared<klimchuk::Circle>(0.0, 0.0, 1.0);
+  klimchuk::Shape::ShapePtr rectangle = std::make_shared<klimchuk::Rectangle>(2.0, 1.0, 5.0, 0.0);
+  klimchuk::Shape::ShapePtr triangle = std::make_shared<klimchuk::Triangle>(klimchuk::point_t{ 0.0, 0.0 },
+    klimchuk::point_t{ 3.0, 0.0 }, klimchuk::point_t{ 0.0, 3.0 });
+  klimchuk::Shape::ShapePtr polygon = std::make_shared<klimchuk::Polygon>(std::initializer_list<klimchuk::point_t>{
+    { 0.0, 0.0 }, { 4.0, 0.0 }, { 4.0, 4.0 }, { 2.0, 1.0 }, { 0.0, 4.0 } });
+  klimchuk::CompositeShape compositeShape(circle);
+  klimchuk::Matrix matrix;
+  uint64_t identifierOfCompositeShape = 0;
+  uint64_t identifierOfMatrix = 0;
+  uint64_t identifierOfRectangle = 0;
+  std::ostringstream stream;
+  {
+    klimchuk::Journal journal(stream);
+    compositeShape.add(rectangle);
+    compositeShape.add(polygon);
+    compositeShape.move(1.0, 1.0);
+    compositeShape.rotate(30.0);
+    compositeShape.scale(2.0);
+    rectangle->move({ -3.0, 2.0 });
+    compositeShape.remove(0);
+    matrix.add(circle);
+    matrix.add(rectangle);
+    matrix.add(triangle);
+    triangle->move(20.0, 0.0);
+    matrix.update(triangle);
+    matrix.remove(circle);
+    polygon->scale(0.5);
+    identifierOfCompositeShape = journal.getIdentifier(compositeShape);
+    identifierOfMatrix = journal.getIdentifier(matrix);
+    identifierOfRectangle = journal.getIdentifier(*rectangle);
+  }
+  std::istringstream input(stream.str());
+  klimchuk::JournalPlayer player(input);
+  replay(player);
+  const klimchuk::Shape::ShapePtr copy = player.getShape(identifierOfCompositeShape);
+  BOOST_CHECK_CLOSE(copy->getArea(), compositeShape.getArea(), EPSILON);
+  BOOST_CHECK_CLOSE(copy->getFrameRect().pos.x, compositeShape.getFrameRect().pos.x, EPSILON);
+  BOOST_CHECK_CLOSE(copy->getFrameRect().width, compositeShape.getFrameRect().width, EPSILON);
+  BOOST_CHECK_CLOSE(player.getShape(identifierOfRectangle)->getCentre().y, rectangle->getCentre().y, EPSILON);
+  const klimchuk::Matrix& copyOfMatrix = player.getMatrix(identifierOfMatrix);
+  BOOST_REQUIRE_EQUAL(copyOfMatrix.getNumberOFLayers(), matrix.getNumberOFLayers());
+  BOOST_CHECK_EQUAL(copyOfMatrix.getSizeOfMatrix(), 2);
+  for (size_t i = 0; i < matrix.getNumberOFLayers(); ++i)
+  {
+    BOOST_CHECK_EQUAL(copyOfMatrix.getSizeOfLayer(i), matrix.getSizeOfLayer(i));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Journal_records_only_outermost_calls)
+{
+  klimchuk::CompositeShape compositeShape(std::make_shared<klimchuk::Circle>(0.0, 0.0, 1.0));
+  compositeShape.add(std::make_shared<klimchuk::Polygon>(std::initializer_list<klimchuk::point_t>{ { 0.0, 0.0 },
+    { 4.0, 0.0 }, { 4.0, 4.0 } }));
+  std::ostringstream stream;
+  klimchuk::Journal journal(stream);
+  compositeShape.move({ 3.0, 3.0 });
+  BOOST_CHECK_EQUAL(journal.getNumberOfRecords(), 4);
+  compositeShape.rotate(45.0);
+  BOOST_CHECK_EQUAL(journal.getNumberOfRecords(), 5);
+}
+
+BOOST_AUTO_TEST_CASE(Journal_forgets_destroyed_objects)
+{
+  std::ostringstream stream;
+  {
+    klimchuk::Journal journal(stream);
+    for (size_t i = 0; i < 10; ++i)
+    {
+      klimchuk::Circle circle(i, 0.0, 1.0);
+      circle.scale(2.0);
+      klimchuk::Rectangle rectangle(1.0, 2.0, i, 0.0);
+      rectangle.rotate(10.0);
+    }
+    BOOST_CHECK_EQUAL(journal.getNumberOfRecords(), 60);
+  }
+  std::istringstream input(stream.str());
+  klimchuk::JournalPlayer player(input);
+  replay(player);
+  BOOST_CHECK_EQUAL(player.getNumberOfRecords(), 60);
+  BOOST_CHECK_THROW(player.getShape(0), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(Journal_forgets_assigned_shapes)
+{
+  std::shared_ptr<klimchuk::Circle> circle = std::make_shared<klimchuk::Circle>(0.0, 0.0, 1.0);
+  std::shared_ptr<klimchuk::Polygon> polygon = std::make_shared<klimchuk::Polygon>(
+    std::initializer_list<klimchuk::point_t>{ { 0.0, 0.0 }, { 4.0, 0.0 }, { 4.0, 4.0 } });
+  uint64_t identifierOfCircle = 0;
+  uint64_t identifierOfPolygon = 0;
+  std::ostringstream stream;
+  {
+    klimchuk::Journal journal(stream);
+    circle->move(1.0, 1.0);
+    polygon->scale(2.0);
+    const uint64_t oldIdentifierOfCircle = journal.getIdentifier(*circle);
+    *circle = klimchuk::Circle(5.0, 5.0, 10.0);
+    circle->move(1.0, 1.0);
+    *polygon = klimchuk::Polygon({ { 0.0, 0.0 }, { 1.0, 0.0 }, { 1.0, 1.0 }, { 0.0, 1.0 } });
+    polygon->move(2.0, 0.0);
+    identifierOfCircle = journal.getIdentifier(*circle);
+    identifierOfPolygon = journal.getIdentifier(*polygon);
+    BOOST_CHECK_NE(identifierOfCircle, oldIdentifierOfCircle);
+  }
+  std::istringstream input(stream.str());
+  klimchuk::JournalPlayer player(input);
+  replay(player);
+  BOOST_CHECK_CLOSE(player.getShape(identifierOfCircle)->getCentre().x, 6.0, EPSILON);
+  BOOST_CHECK_CLOSE(player.getShape(identifierOfCircle)->getArea(), circle->getArea(), EPSILON);
+  BOOST_CHECK_CLOSE(player.getShape(identifierOfPolygon)->getArea(), 1.0, EPSILON);
+  BOOST_CHECK_CLOSE(player.getShape(identifierOfPolygon)->getCentre().x, polygon->getCentre().x, EPSILON);
+}
+
+BOOST_AUTO_TEST_CASE(Journal_skips_rejected_operations)
+{
+  klimchuk::Circle circle(0.0, 0.0, 1.0);
+  klimchuk::CompositeShape compositeShape(std::make_shared<klimchuk::Rectangle>(2.0, 1.0, 5.0, 0.0));
+  klimchuk::CompositeShape movedCompositeShape(std::move(compositeShape));
+  uint64_t identifierOfCompositeShape = 0;
+  std::ostringstream stream;
+  {
+    klimchuk::Journal journal(stream);
+    BOOST_CHECK_THROW(circle.scale(-1.0), std::invalid_argument);
+    circle.scale(3.0);
+    BOOST_CHECK_THROW(movedCompositeShape.scale(0.0), std::invalid_argument);
+    BOOST_CHECK_THROW(movedCompositeShape.remove(0), std::length_error);
+    BOOST_CHECK_THROW(movedCompositeShape.remove(3), std::out_of_range);
+    BOOST_CHECK_THROW(compositeShape.move(1.0, 1.0), std::domain_error);
+    movedCompositeShape.add(std::make_shared<klimchuk::Circle>(1.0, 1.0, 2.0));
+    identifierOfCompositeShape = journal.getIdentifier(movedCompositeShape);
+  }
+  std::istringstream input(stream.str());
+  klimchuk::JournalPlayer player(input);
+  size_t numberOfOperations = 0;
+  while (player.read())
+  {
+    player.execute();
+    numberOfOperations += (player.getOperation() == klimchuk::Journal::Operation::SCALE)
+      || (player.getOperation() == klimchuk::Journal::Operation::ADD);
+  }
+  BOOST_CHECK_EQUAL(numberOfOperations, 2);
+  BOOST_CHECK_CLOSE(player.getShape(0)->getArea(), circle.getArea(), EPSILON);
+  BOOST_CHECK_CLOSE(player.getShape(identifierOfCompositeShape)->getArea(), movedCompositeShape.getArea(), EPSILON);
+}
+
+BOOST_AUTO_TEST_CASE(Journal_rejects_invalid_use)
+{
+  std::ostringstream stream;
+  {
+    klimchuk::Journal journal(stream);
+    BOOST_CHECK(klimchuk::Journal::getActive() == &journal);
+    BOOST_CHECK_THROW(klimchuk::Journal other(stream), std::logic_error);
+    klimchuk::Circle circle(0.0, 0.0, 1.0);
+    circle.move(1.0, 1.0);
+  }
+  BOOST_CHECK(!klimchuk::Journal::getActive());
+  std::istringstream invalid("KLSCENE");
+  BOOST_CHECK_THROW(klimchuk::JournalPlayer player(invalid), std::runtime_error);
+  const std::string text = stream.str();
+  std::istringstream truncated(text.substr(0, text.size() - 3));
+  klimchuk::JournalPlayer player(truncated);
+  BOOST_CHECK_THROW(replay(player), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,103 @@
+#include <vector>
+#include <chrono>
+#include "boost/test/unit_test.hpp"
+#include "test-scenes.hpp"
+#include "layer-generator.hpp"
+#include "partition.hpp"
+#include "rectangle.hpp"
+
+namespace
+{
+  using klimchuk::test::getLayers;
+
+  klimchuk::CompositeShape makeScene(size_t numberOfShapes, unsigned int seed)
+  {
+    return klimchuk::test::makeScene(std::make_shared<klimchuk::Rectangle>(120.0, 0.5, 0.0, 0.0),
+      numberOfShapes, seed, 40.0, 8.0, "CRRR");
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(LayerGenerator_layers)
+
+BOOST_AUTO_TEST_CASE(LayerGenerator_matches_minimum_layers_partition)
+{
+  klimchuk::CompositeShape scene = makeScene(400, 5);
+  for (size_t i = 0; i < scene.getSize(); i += 3)
+  {
+    scene[i]->rotate(static_cast<double>(i * 11));
+  }
+  for (klimchuk::Matrix::Filter filter : { klimchuk::Matrix::Filter::FRAME, klimchuk::Matrix::Filter::ORIENTED_FRAME })
+  {
+    klimchuk::Matrix matrix = klimchuk::partition(scene, klimchuk::Matrix::Mode::MINIMUM_LAYERS, filter);
+    klimchuk::LayerGenerator generator(scene, filter);
+    BOOST_CHECK_EQUAL(generator.getNumberOfRemainingShapes(), scene.getSize());
+    klimchuk::test::layers_t layers;
+    std::vector<klimchuk::Shape::ShapePtr> layer;
+    while (generator.next(layer))
+    {
+      BOOST_CHECK(!layer.empty());
+      for (const klimchuk::Shape::ShapePtr& shape : layer)
+      {
+        layers[shape] = generator.getNumberOfLayers() - 1;
+      }
+    }
+    BOOST_CHECK(generator.isFinished());
+    BOOST_CHECK_EQUAL(generator.getNumberOfRemainingShapes(), 0);
+    BOOST_CHECK_EQUAL(generator.getNumberOfLayers(), matrix.getNumberOFLayers());
+    BOOST_CHECK(layers == getLayers(matrix));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(LayerGenerator_resumes_within_budget)
+{
+  klimchuk::CompositeShape scene = makeScene(1000, 7);
+  klimchuk::Matrix matrix = klimchuk::partition(scene, klimchuk::Matrix::Mode::MINIMUM_LAYERS);
+  klimchuk::LayerGenerator generator(scene);
+  klimchuk::test::layers_t layers;
+  std::vector<klimchuk::Shape::ShapePtr> layer;
+  size_t numberOfSuspensions = 0;
+  klimchuk::LayerGenerator::Status status = klimchuk::LayerGenerator::Status::SUSPENDED;
+  while (status != klimchuk::LayerGenerator::Status::FINISHED)
+  {
+    status = generator.resume(layer, std::chrono::nanoseconds(0));
+    if (status == klimchuk::LayerGenerator::Status::SUSPENDED)
+    {
+      ++numberOfSuspensions;
+    }
+    else if (status == klimchuk::LayerGenerator::Status::LAYER)
+    {
+      for (const klimchuk::Shape::ShapePtr& shape : layer)
+      {
+        layers[shape] = generator.getNumberOfLayers() - 1;
+      }
+    }
+  }
+  BOOST_CHECK_GE(numberOfSuspensions, scene.getSize() / 32 - 1);
+  BOOST_CHECK(layers == getLayers(matrix));
+  BOOST_CHECK(generator.resume(layer, std::chrono::seconds(1)) == klimchuk::LayerGenerator::Status::FINISHED);
+  BOOST_CHECK(!generator.next(layer));
+}
+
+BOOST_AUTO_TEST_CASE(LayerGenerator_handles_degenerate_frames)
+{
+  klimchuk::CompositeShape scene(std::make_shared<klimchuk::Rectangle>(1.0, 1.0, 0.0, 0.0));
+  scene.add(std::make_shared<klimchuk::Rectangle>(1.0, 1.0, 1.0, 0.0));
+  scene.add(std::make_shared<klimchuk::Rectangle>(1.0, 1.0, 2.0, 0.0));
+  scene.add(std::make_shared<klimchuk::Rectangle>(1.0, 1.0, 1.0e12, 0.0));
+  scene.add(std::make_shared<klimchuk::Rectangle>(1.0e13, 1.0, 0.0, 0.0));
+  klimchuk::Matrix matrix = klimchuk::partition(scene, klimchuk::Matrix::Mode::MINIMUM_LAYERS);
+  klimchuk::LayerGenerator generator(scene);
+  klimchuk::test::layers_t layers;
+  std::vector<klimchuk::Shape::ShapePtr> layer;
+  while (generator.next(layer))
+  {
+    for (const klimchuk::Shape::ShapePtr& shape : layer)
+    {
+      layers[shape] = generator.getNumberOfLayers() - 1;
+    }
+  }
+  BOOST_CHECK_EQUAL(generator.getNumberOfLayers(), 4);
+  BOOST_CHECK(layers == getLayers(matrix));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,181 @@
+#include <stdexcept>
+#include <fstream>
+#include <string>
+#include <cstdlib>
+#include <cstdint>
+#include <unistd.h>
+#include "boost/test/unit_test.hpp"
+#include "mapped-scene.hpp"
+#include "partition.hpp"
+#include "circle.hpp"
+#include "rectangle.hpp"
+#include "triangle.hpp"
+#include "polygon.hpp"
+
+const double EPSILON = 0.000001;
+
+namespace
+{
+  struct TemporaryFile
+  {
+    std::string path;
+
+    TemporaryFile():
+      path("/tmp/klimchuk-scene-XXXXXX")
+    {
+      ::close(::mkstemp(&path[0]));
+    }
+
+    ~TemporaryFile()
+    {
+      ::unlink(path.c_str());
+    }
+  };
+
+  klimchuk::CompositeShape makeScene()
+  {
+    klimchuk::CompositeShape compositeShape(std::make_shared<klimchuk::Circle>(1.0, 2.0, 3.0));
+    klimchuk::Shape::ShapePtr rectangle = std::make_shared<klimchuk::Rectangle>(4.0, 2.0, 0.0, 0.0);
+    rectangle->rotate(30.0);
+    compositeShape.add(rectangle);
+    std::shared_ptr<klimchuk::CompositeShape> nested = std::make_shared<klimchuk::CompositeShape>(
+      std::make_shared<klimchuk::Triangle>(klimchuk::point_t{ 0.0, 0.0 }, klimchuk::point_t{ 2.0, 0.0 },
+      klimchuk::point_t{ 0.0, 2.0 }));
+    nested->add(std::make_shared<klimchuk::Polygon>(std::initializer_list<klimchuk::point_t>{ { 0.0, 0.0 },
+      { 4.0, 0.0 }, { 4.0, 4.0 }, { 2.0, 1.0 }, { 0.0, 4.0 } }));
+    compositeShape.add(nested);
+    compositeShape.add(std::make_shared<klimchuk::Circle>(20.0, 20.0, 1.0));
+    return compositeShape;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(MappedScene_loading)
+
+BOOST_AUTO_TEST_CASE(MappedScene_exposes_columns)
+{
+  klimchuk::CompositeShape compositeShape = makeScene();
+  TemporaryFile file;
+  {
+    std::ofstream stream(file.path, std::ios::binary);
+    klimchuk::writeScene(stream, compositeShape);
+  }
+  klimchuk::MappedScene scene(file.path);
+  BOOST_REQUIRE_EQUAL(scene.getSize(), 6);
+  BOOST_CHECK(scene[0].type == klimchuk::MappedScene::Type::CIRCLE);
+  BOOST_CHECK_EQUAL(scene[0].parent, klimchuk::MappedScene::NO_PARENT);
+  BOOST_CHECK_CLOSE(scene.getCircle(0).radius, 3.0, EPSILON);
+  BOOST_CHECK_CLOSE(scene.getRectangle(1).width, 4.0, EPSILON);
+  BOOST_CHECK_CLOSE(scene.getRectangle(1).axis.y, 0.5, EPSILON);
+  BOOST_CHECK(scene[2].type == klimchuk::MappedScene::Type::COMPOSITE);
+  BOOST_CHECK_EQUAL(scene[2].index, 5);
+  BOOST_CHECK_EQUAL(scene[3].parent, 2);
+  BOOST_CHECK_EQUAL(scene.getNumberOfVertices(3), 3);
+  BOOST_CHECK_EQUAL(scene.getNumberOfVertices(4), 5);
+  BOOST_CHECK_CLOSE(scene.getVertices(4)[3].y, 1.0, EPSILON);
+  BOOST_CHECK_CLOSE(scene.getCircle(5).pos.x, 20.0, EPSILON);
+  BOOST_CHECK_EQUAL(scene.getNumberOfLayers(), 0);
+
+  klimchuk::CompositeShape loaded = scene.getCompositeShape();
+  BOOST_REQUIRE_EQUAL(loaded.getSize(), compositeShape.getSize());
+  BOOST_CHECK_CLOSE(loaded.getArea(), compositeShape.getArea(), EPSILON);
+  BOOST_CHECK_CLOSE(loaded[1]->getFrameRect().width, compositeShape[1]->getFrameRect().width, EPSILON);
+  BOOST_CHECK_CLOSE(loaded[2]->getFrameRect().height, compositeShape[2]->getFrameRect().height, EPSILON);
+}
+
+BOOST_AUTO_TEST_CASE(MappedScene_exposes_layers)
+{
+  klimchuk::CompositeShape compositeShape = makeScene();
+  klimchuk::Matrix matrix = klimchuk::partition(compositeShape, klimchuk::Matrix::Mode::MINIMUM_LAYERS);
+  TemporaryFile file;
+  {
+    std::ofstream stream(file.path, std::ios::binary);
+    klimchuk::writeScene(stream, compositeShape, &matrix);
+  }
+  klimchuk::MappedScene scene(file.path);
+  klimchuk::MappedScene moved(std::move(scene));
+  BOOST_REQUIRE_EQUAL(moved.getNumberOfLayers(), matrix.getNumberOFLayers());
+  const size_t indexes[] = { 0, 1, 2, 5 };
+  for (size_t i = 0; i < matrix.getNumberOFLayers(); ++i)
+  {
+    BOOST_REQUIRE_EQUAL(moved.getSizeOfLayer(i), matrix.getSizeOfLayer(i));
+    for (size_t j = 0; j < matrix.getSizeOfLayer(i); ++j)
+    {
+      size_t child = 0;
+      while (compositeShape[child] != matrix[i][j])
+      {
+        ++child;
+      }
+      BOOST_CHECK_EQUAL(moved.getLayer(i)[j], indexes[child]);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(MappedScene_move_assignment_exchanges_mappings)
+{
+  klimchuk::CompositeShape compositeShape = makeScene();
+  TemporaryFile firstFile;
+  TemporaryFile secondFile;
+  {
+    std::ofstream stream(firstFile.path, std::ios::binary);
+    klimchuk::writeScene(stream, compositeShape);
+  }
+  compositeShape.remove(3);
+  {
+    std::ofstream stream(secondFile.path, std::ios::binary);
+    klimchuk::writeScene(stream, compositeShape);
+  }
+  klimchuk::MappedScene scene(firstFile.path);
+  klimchuk::MappedScene other(secondFile.path);
+  scene = std::move(other);
+  BOOST_REQUIRE_EQUAL(scene.getSize(), 5);
+  BOOST_CHECK_CLOSE(scene.getCircle(0).radius, 3.0, EPSILON);
+  BOOST_REQUIRE_EQUAL(other.getSize(), 6);
+  BOOST_CHECK_CLOSE(other.getCircle(5).pos.x, 20.0, EPSILON);
+  BOOST_CHECK_EQUAL(other.getNumberOfVertices(4), 5);
+
+  klimchuk::MappedScene moved(std::move(other));
+  other = std::move(scene);
+  BOOST_CHECK_EQUAL(other.getSize(), 5);
+  BOOST_CHECK_EQUAL(moved.getSize(), 6);
+}
+
+BOOST_AUTO_TEST_CASE(MappedScene_invalid_access)
+{
+  BOOST_CHECK_THROW(klimchuk::MappedScene("/tmp/klimchuk-scene-which-does-not-exist"), std::runtime_error);
+  TemporaryFile file;
+  {
+    std::ofstream stream(file.path, std::ios::binary);
+    stream << std::string(512, 'x');
+  }
+  BOOST_CHECK_THROW(klimchuk::MappedScene{ file.path }, std::runtime_error);
+  {
+    std::ofstream stream(file.path, std::ios::binary);
+    klimchuk::writeScene(stream, makeScene());
+  }
+  klimchuk::MappedScene scene(file.path);
+  BOOST_CHECK_THROW(scene[6], std::out_of_range);
+  BOOST_CHECK_THROW(scene.getCircle(1), std::invalid_argument);
+  BOOST_CHECK_THROW(scene.getVertices(0), std::invalid_argument);
+  BOOST_CHECK_THROW(scene.getLayer(0), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(MappedScene_rejects_overflowing_counts)
+{
+  TemporaryFile file;
+  for (std::streamoff offset : { 40, 56 })
+  {
+    {
+      std::ofstream stream(file.path, std::ios::binary);
+      klimchuk::writeScene(stream, makeScene());
+    }
+    {
+      std::fstream stream(file.path, std::ios::binary | std::ios::in | std::ios::out);
+      const uint64_t count = UINT64_MAX;
+      stream.seekp(offset);
+      stream.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    }
+    BOOST_CHECK_THROW(klimchuk::MappedScene{ file.path }, std::runtime_error);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,4 +1,6 @@
 #include <stdexcept>
+#include <random>
+#include <vector>
 #include "boost/test/unit_test.hpp"
 #include "matrix.hpp"
 #include "circle.hpp"
@@ -162,3 +164,180 @@ BOOST_AUTO_TEST_CASE(Matrix_adding_new_shape_at_new_raw)
 }
 
 BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(Matrix_check_correctness_removing_and_updating)
+
+BOOST_AUTO_TEST_CASE(Matrix_removing_and_updating_invalid_shape)
+{
+  std::shared_ptr<klimchuk::Circle> circle = std::make_shared<klimchuk::Circle>(2.0, 2.0, 3);
+  klimchuk::Matrix matrix;
+  BOOST_CHECK_THROW(matrix.remove(nullptr), std::invalid_argument);
+  BOOST_CHECK_THROW(matrix.update(circle), std::invalid_argument);
+  matrix.add(circle);
+  BOOST_CHECK_THROW(matrix.remove(std::make_shared<klimchuk::Circle>(2.0, 2.0, 3)), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(Matrix_removing_shape)
+{
+  std::shared_ptr<klimchuk::Circle> circle = std::make_shared<klimchuk::Circle>(2.0, 2.0, 2);
+  std::shared_ptr<klimchuk::Rectangle> rectangle = std::make_shared<klimchuk::Rectangle>(10.0, 6.0, 1.0, 3.0);
+  std::shared_ptr<klimchuk::Triangle> triangle = std::make_shared<klimchuk::Triangle>(klimchuk::point_t{ -5.0, 1.0 },
+    klimchuk::point_t{ -2, 3 }, klimchuk::point_t{ -2, -2 });
+  klimchuk::Matrix matrix;
+  matrix.add(circle);
+  matrix.add(rectangle);
+  matrix.add(triangle);
+  matrix.remove(circle);
+  BOOST_CHECK_EQUAL(matrix.getSizeOfMatrix(), 2);
+  BOOST_CHECK_EQUAL(matrix.getNumberOFLayers(), 2);
+  BOOST_CHECK_EQUAL(matrix[0][0], rectangle);
+  BOOST_CHECK_EQUAL(matrix[1][0], triangle);
+  matrix.remove(rectangle);
+  matrix.remove(triangle);
+  BOOST_CHECK_EQUAL(matrix.getSizeOfMatrix(), 0);
+  BOOST_CHECK_EQUAL(matrix.getNumberOFLayers(), 0);
+  BOOST_CHECK_THROW(matrix[0], std::domain_error);
+}
+
+BOOST_AUTO_TEST_CASE(Matrix_updating_moved_shape)
+{
+  std::shared_ptr<klimchuk::Circle> circle = std::make_shared<klimchuk::Circle>(2.0, 2.0, 2);
+  std::shared_ptr<klimchuk::Rectangle> rectangle = std::make_shared<klimchuk::Rectangle>(10.0, 6.0, 1.0, 3.0);
+  klimchuk::Matrix matrix;
+  matrix.add(circle);
+  matrix.add(rectangle);
+  BOOST_CHECK_EQUAL(matrix.getNumberOFLayers(), 2);
+  rectangle->move(40.0, 0.0);
+  matrix.update(rectangle);
+  BOOST_CHECK_EQUAL(matrix.getNumberOFLayers(), 1);
+  BOOST_CHECK_EQUAL(matrix[0][0], circle);
+  BOOST_CHECK_EQUAL(matrix[0][1], rectangle);
+}
+
+BOOST_AUTO_TEST_CASE(Matrix_incremental_changes_match_full_rebuild)
+{
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> position(-20.0, 20.0);
+  std::uniform_real_distribution<double> step(-2.0, 2.0);
+  std::uniform_real_distribution<double> size(0.5, 6.0);
+  std::vector<klimchuk::Shape::ShapePtr> shapes;
+  klimchuk::Matrix matrix;
+  for (size_t i = 0; i < 60; ++i)
+  {
+    shapes.push_back(std::make_shared<klimchuk::Rectangle>(size(generator), size(generator),
+      position(generator), position(generator)));
+    matrix.add(shapes.back());
+  }
+  for (size_t iteration = 0; iteration < 100; ++iteration)
+  {
+    size_t index = generator() % shapes.size();
+    if ((iteration % 10 == 9) && (shapes.size() > 1))
+    {
+      matrix.remove(shapes[index]);
+      shapes.erase(shapes.begin() + index);
+    }
+    else
+    {
+      shapes[index]->move(step(generator) * 3.0, step(generator) * 3.0);
+      shapes[index]->rotate(step(generator) * 20.0);
+      matrix.update(shapes[index]);
+    }
+    klimchuk::Matrix rebuilt;
+    for (const klimchuk::Shape::ShapePtr& shape : shapes)
+    {
+      rebuilt.add(shape);
+    }
+    BOOST_REQUIRE_EQUAL(matrix.getSizeOfMatrix(), rebuilt.getSizeOfMatrix());
+    BOOST_REQUIRE_EQUAL(matrix.getNumberOFLayers(), rebuilt.getNumberOFLayers());
+    for (size_t i = 0; i < rebuilt.getNumberOFLayers(); ++i)
+    {
+      BOOST_REQUIRE_EQUAL(matrix.getSizeOfLayer(i), rebuilt.getSizeOfLayer(i));
+      for (size_t j = 0; j < rebuilt.getSizeOfLayer(i); ++j)
+      {
+        BOOST_CHECK_EQUAL(matrix[i][j], rebuilt[i][j]);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(Matrix_oriented_frame_filter)
+
+BOOST_AUTO_TEST_CASE(Matrix_oriented_frame_filter_separates_rotated_shapes)
+{
+  std::shared_ptr<klimchuk::Rectangle> first = std::make_shared<klimchuk::Rectangle>(10.0, 1.0, 0.0, 0.0);
+  std::shared_ptr<klimchuk::Rectangle> second = std::make_shared<klimchuk::Rectangle>(10.0, 1.0, -2.0, 2.0);
+  first->rotate(45.0);
+  second->rotate(45.0);
+  klimchuk::Matrix matrix;
+  matrix.add(first);
+  matrix.add(second);
+  klimchuk::Matrix orientedMatrix(klimchuk::Matrix::Mode::FIRST_FIT, klimchuk::Matrix::Filter::ORIENTED_FRAME);
+  orientedMatrix.add(first);
+  orientedMatrix.add(second);
+  BOOST_CHECK(orientedMatrix.getFilter() == klimchuk::Matrix::Filter::ORIENTED_FRAME);
+  BOOST_CHECK_EQUAL(matrix.getNumberOFLayers(), 2);
+  BOOST_CHECK_EQUAL(orientedMatrix.getNumberOFLayers(), 1);
+
+  second->move(1.5, -1.5);
+  orientedMatrix.update(second);
+  BOOST_CHECK_EQUAL(orientedMatrix.getNumberOFLayers(), 2);
+  klimchuk::Matrix copy(orientedMatrix);
+  BOOST_CHECK(copy.getFilter() == klimchuk::Matrix::Filter::ORIENTED_FRAME);
+  BOOST_CHECK_EQUAL(copy.getIndexOfLayerToAdd(std::make_shared<klimchuk::Rectangle>(1.0, 1.0, 4.0, -4.0)), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Matrix_oriented_frame_filter_incremental_changes_match_full_rebuild)
+{
+  std::mt19937 generator(23);
+  std::uniform_real_distribution<double> position(-15.0, 15.0);
+  std::uniform_real_distribution<double> size(1.0, 8.0);
+  std::uniform_real_distribution<double> angle(0.0, 90.0);
+  std::vector<klimchuk::Shape::ShapePtr> shapes;
+  for (size_t i = 0; i < 40; ++i)
+  {
+    shapes.push_back(std::make_shared<klimchuk::Rectangle>(size(generator), 0.5, position(generator),
+      position(generator)));
+    shapes.back()->rotate(angle(generator));
+  }
+  for (klimchuk::Matrix::Mode mode : { klimchuk::Matrix::Mode::FIRST_FIT, klimchuk::Matrix::Mode::MINIMUM_LAYERS })
+  {
+    std::vector<klimchuk::Shape::ShapePtr> current = shapes;
+    klimchuk::Matrix matrix(mode, klimchuk::Matrix::Filter::ORIENTED_FRAME);
+    for (const klimchuk::Shape::ShapePtr& shape : current)
+    {
+      matrix.add(shape);
+    }
+    for (size_t iteration = 0; iteration < 30; ++iteration)
+    {
+      size_t index = generator() % current.size();
+      if (iteration % 5 == 4)
+      {
+        matrix.remove(current[index]);
+        current.erase(current.begin() + index);
+      }
+      else
+      {
+        current[index]->rotate(angle(generator));
+        matrix.update(current[index]);
+      }
+      klimchuk::Matrix rebuilt(mode, klimchuk::Matrix::Filter::ORIENTED_FRAME);
+      for (const klimchuk::Shape::ShapePtr& shape : current)
+      {
+        rebuilt.add(shape);
+      }
+      BOOST_REQUIRE_EQUAL(matrix.getNumberOFLayers(), rebuilt.getNumberOFLayers());
+      for (size_t i = 0; i < matrix.getNumberOFLayers(); ++i)
+      {
+        BOOST_REQUIRE_EQUAL(matrix.getSizeOfLayer(i), rebuilt.getSizeOfLayer(i));
+        for (size_t j = 0; j < matrix.getSizeOfLayer(i); ++j)
+        {
+          BOOST_REQUIRE_EQUAL(matrix[i][j], rebuilt[i][j]);
+        }
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
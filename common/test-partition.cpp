@@ -0,0 +1,220 @@
+#include <stdexcept>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include "boost/test/unit_test.hpp"
+#include "test-scenes.hpp"
+#include "partition.hpp"
+#include "circle.hpp"
+#include "rectangle.hpp"
+
+namespace
+{
+  using klimchuk::test::getLayers;
+
+  klimchuk::CompositeShape makeScene(size_t numberOfShapes, unsigned int seed)
+  {
+    return klimchuk::test::makeScene(std::make_shared<klimchuk::Circle>(0.0, 0.0, 4.0),
+      numberOfShapes, seed, 30.0, 8.0, "R");
+  }
+
+  std::vector<klimchuk::intersection_t> getIntersections(const std::vector<klimchuk::rectangle_t>& frames)
+  {
+    std::vector<klimchuk::intersection_t> intersections;
+    for (size_t i = 0; i < frames.size(); ++i)
+    {
+      for (size_t j = i + 1; j < frames.size(); ++j)
+      {
+        if (klimchuk::areShapesIntersect(frames[i], frames[j]))
+        {
+          intersections.push_back({ i, j });
+        }
+      }
+    }
+    return intersections;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(Partition_intersections)
+
+BOOST_AUTO_TEST_CASE(Partition_intersections_match_brute_force)
+{
+  klimchuk::CompositeShape scene = makeScene(300, 3);
+  std::vector<klimchuk::rectangle_t> frames;
+  for (size_t i = 0; i < scene.getSize(); ++i)
+  {
+    frames.push_back(scene[i]->getFrameRect());
+  }
+  std::vector<klimchuk::intersection_t> intersections = klimchuk::findIntersections(frames.data(), frames.size());
+  std::sort(intersections.begin(), intersections.end());
+  BOOST_CHECK(intersections == getIntersections(frames));
+}
+
+BOOST_AUTO_TEST_CASE(Partition_intersections_of_long_and_touching_frames)
+{
+  std::vector<klimchuk::rectangle_t> frames;
+  for (size_t i = 0; i < 200; ++i)
+  {
+    frames.push_back({ 100.0 + static_cast<double>(i % 7), 1.0, { static_cast<double>(i % 5), 1.0 * i } });
+  }
+  for (size_t i = 0; i < 20; ++i)
+  {
+    frames.push_back({ 1.0, 50.0 + 10.0 * i, { 40.0 + 3.0 * i, 5.0 * i } });
+  }
+  frames.push_back({ 0.0, 0.0, { 40.0, 0.0 } });
+  std::vector<klimchuk::intersection_t> intersections = klimchuk::findIntersections(frames.data(), frames.size());
+  std::sort(intersections.begin(), intersections.end());
+  BOOST_CHECK(intersections == getIntersections(frames));
+}
+
+BOOST_AUTO_TEST_CASE(Partition_intersections_invalid_argument)
+{
+  BOOST_CHECK_THROW(klimchuk::findIntersections(nullptr, 3), std::invalid_argument);
+  BOOST_CHECK(klimchuk::findIntersections(nullptr, 0).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(Partition_modes)
+
+BOOST_AUTO_TEST_CASE(Partition_first_fit_matches_adding)
+{
+  klimchuk::CompositeShape scene = makeScene(100, 5);
+  klimchuk::Matrix matrix = klimchuk::partition(scene);
+  klimchuk::Matrix expected;
+  for (size_t i = 0; i < scene.getSize(); ++i)
+  {
+    expected.add(scene[i]);
+  }
+  BOOST_CHECK(matrix.getMode() == klimchuk::Matrix::Mode::FIRST_FIT);
+  BOOST_CHECK(getLayers(matrix) == getLayers(expected));
+}
+
+BOOST_AUTO_TEST_CASE(Partition_from_intersections_matches_adding)
+{
+  klimchuk::CompositeShape scene = makeScene(150, 17);
+  for (size_t i = 0; i < scene.getSize(); i += 2)
+  {
+    scene[i]->rotate(static_cast<double>(i * 13));
+  }
+  std::vector<klimchuk::rectangle_t> frames;
+  for (size_t i = 0; i < scene.getSize(); ++i)
+  {
+    frames.push_back(scene[i]->getFrameRect());
+  }
+  const std::vector<klimchuk::intersection_t> intersections = klimchuk::findIntersections(frames.data(), frames.size());
+  for (klimchuk::Matrix::Mode mode : { klimchuk::Matrix::Mode::FIRST_FIT, klimchuk::Matrix::Mode::MINIMUM_LAYERS })
+  {
+    for (klimchuk::Matrix::Filter filter : { klimchuk::Matrix::Filter::FRAME, klimchuk::Matrix::Filter::ORIENTED_FRAME })
+    {
+      klimchuk::Matrix matrix = klimchuk::partition(scene, intersections, mode, filter);
+      klimchuk::Matrix expected(mode, filter);
+      for (size_t i = 0; i < scene.getSize(); ++i)
+      {
+        expected.add(scene[i]);
+      }
+      BOOST_CHECK(getLayers(matrix) == getLayers(expected));
+      scene[7]->move(3.0, 1.0);
+      matrix.update(scene[7]);
+      expected.update(scene[7]);
+      BOOST_CHECK(getLayers(matrix) == getLayers(expected));
+      scene[7]->move(-3.0, -1.0);
+    }
+  }
+  BOOST_CHECK_THROW(klimchuk::partition(scene, { { 3, 3 } }), std::invalid_argument);
+  BOOST_CHECK_THROW(klimchuk::partition(scene, { { 3, scene.getSize() } }), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(Partition_minimum_layers_keeps_paint_order)
+{
+  klimchuk::CompositeShape scene = makeScene(200, 9);
+  klimchuk::Matrix matrix = klimchuk::partition(scene, klimchuk::Matrix::Mode::MINIMUM_LAYERS);
+  BOOST_CHECK_EQUAL(matrix.getSizeOfMatrix(), scene.getSize());
+  klimchuk::test::layers_t layers = getLayers(matrix);
+  std::vector<size_t> longestChains(scene.getSize(), 1);
+  size_t longestChain = 0;
+  for (size_t j = 0; j < scene.getSize(); ++j)
+  {
+    for (size_t i = 0; i < j; ++i)
+    {
+      if (klimchuk::areShapesIntersect(scene[i]->getFrameRect(), scene[j]->getFrameRect()))
+      {
+        BOOST_CHECK_LT(layers[scene[i]], layers[scene[j]]);
+        longestChains[j] = std::max(longestChains[j], longestChains[i] + 1);
+      }
+    }
+    longestChain = std::max(longestChain, longestChains[j]);
+  }
+  BOOST_CHECK_EQUAL(matrix.getNumberOFLayers(), longestChain);
+}
+
+BOOST_AUTO_TEST_CASE(Partition_minimum_layers_matches_adding)
+{
+  klimchuk::CompositeShape scene = makeScene(150, 11);
+  klimchuk::Matrix matrix = klimchuk::partition(scene, klimchuk::Matrix::Mode::MINIMUM_LAYERS);
+  klimchuk::Matrix expected(klimchuk::Matrix::Mode::MINIMUM_LAYERS);
+  for (size_t i = 0; i < scene.getSize(); ++i)
+  {
+    expected.add(scene[i]);
+  }
+  BOOST_CHECK(getLayers(matrix) == getLayers(expected));
+}
+
+BOOST_AUTO_TEST_CASE(Partition_minimum_layers_incremental_changes_match_full_rebuild)
+{
+  klimchuk::CompositeShape scene = makeScene(80, 13);
+  klimchuk::Matrix matrix = klimchuk::partition(scene, klimchuk::Matrix::Mode::MINIMUM_LAYERS);
+  std::vector<klimchuk::Shape::ShapePtr> shapes;
+  for (size_t i = 0; i < scene.getSize(); ++i)
+  {
+    shapes.push_back(scene[i]);
+  }
+  std::mt19937 generator(17);
+  std::uniform_real_distribution<double> step(-6.0, 6.0);
+  for (size_t iteration = 0; iteration < 60; ++iteration)
+  {
+    size_t index = generator() % shapes.size();
+    if (iteration % 6 == 5)
+    {
+      matrix.remove(shapes[index]);
+      shapes.erase(shapes.begin() + index);
+    }
+    else
+    {
+      shapes[index]->move(step(generator), step(generator));
+      matrix.update(shapes[index]);
+    }
+    klimchuk::Matrix rebuilt(klimchuk::Matrix::Mode::MINIMUM_LAYERS);
+    for (const klimchuk::Shape::ShapePtr& shape : shapes)
+    {
+      rebuilt.add(shape);
+    }
+    BOOST_REQUIRE(getLayers(matrix) == getLayers(rebuilt));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(Partition_oriented_frame_filter)
+
+BOOST_AUTO_TEST_CASE(Partition_oriented_frame_filter_matches_adding)
+{
+  klimchuk::CompositeShape scene = makeScene(150, 19);
+  for (size_t i = 0; i < scene.getSize(); ++i)
+  {
+    scene[i]->rotate(static_cast<double>(i * 7));
+  }
+  for (klimchuk::Matrix::Mode mode : { klimchuk::Matrix::Mode::FIRST_FIT, klimchuk::Matrix::Mode::MINIMUM_LAYERS })
+  {
+    klimchuk::Matrix matrix = klimchuk::partition(scene, mode, klimchuk::Matrix::Filter::ORIENTED_FRAME);
+    klimchuk::Matrix expected(mode, klimchuk::Matrix::Filter::ORIENTED_FRAME);
+    for (size_t i = 0; i < scene.getSize(); ++i)
+    {
+      expected.add(scene[i]);
+    }
+    BOOST_CHECK(getLayers(matrix) == getLayers(expected));
+    BOOST_CHECK_LE(matrix.getNumberOFLayers(), klimchuk::partition(scene, mode).getNumberOFLayers());
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,146 @@
+#include <stdexcept>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "boost/test/unit_test.hpp"
+#include "spsc-queue.hpp"
+#include "pipeline.hpp"
+
+const double EPSILON = 0.000001;
+
+namespace
+{
+  std::string makeScene(size_t numberOfShapes)
+  {
+    std::ostringstream text;
+    for (size_t i = 0; i < numberOfShapes; ++i)
+    {
+      const double x = static_cast<double>((i * 37) % 101);
+      const double y = static_cast<double>((i * 53) % 97);
+      if (i % 3 == 0)
+      {
+        text << "circle " << x << ' ' << y << " 1.5\n";
+      }
+      else if (i % 3 == 1)
+      {
+        text << "rectangle 2 1 " << x << ' ' << y << " 30\n";
+      }
+      else
+      {
+        text << "triangle " << x << ' ' << y << ' ' << x + 2 << ' ' << y << ' ' << x << ' ' << y + 2 << '\n';
+      }
+    }
+    return text.str();
+  }
+
+  void transform(const klimchuk::Shape::ShapePtr& shape)
+  {
+    shape->rotate(15.0);
+    shape->scale(1.5);
+    shape->move(10.0, -10.0);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(SpscQueue_operations)
+
+BOOST_AUTO_TEST_CASE(SpscQueue_keeps_order_and_bounds)
+{
+  klimchuk::SpscQueue<int> queue(5);
+  BOOST_CHECK_EQUAL(queue.getCapacity(), 8);
+  for (int i = 0; i < 8; ++i)
+  {
+    BOOST_CHECK(queue.tryPush(std::move(i)));
+  }
+  BOOST_CHECK(!queue.tryPush(8));
+  int value = -1;
+  BOOST_CHECK(queue.tryPop(value));
+  BOOST_CHECK_EQUAL(value, 0);
+  BOOST_CHECK(queue.tryPush(8));
+  for (int i = 1; i <= 8; ++i)
+  {
+    BOOST_CHECK(queue.tryPop(value));
+    BOOST_CHECK_EQUAL(value, i);
+  }
+  BOOST_CHECK(!queue.tryPop(value));
+  BOOST_CHECK_THROW(klimchuk::SpscQueue<int>(0), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(SpscQueue_transfers_between_threads)
+{
+  klimchuk::SpscQueue<size_t> queue(16);
+  const size_t numberOfValues = 200000;
+  std::thread producer([&]()
+  {
+    for (size_t i = 1; i <= numberOfValues; ++i)
+    {
+      size_t value = i;
+      while (!queue.tryPush(std::move(value)))
+      {
+        std::this_thread::yield();
+      }
+    }
+  });
+  size_t expected = 1;
+  bool isOrdered = true;
+  while (expected <= numberOfValues)
+  {
+    size_t value = 0;
+    if (!queue.tryPop(value))
+    {
+      std::this_thread::yield();
+      continue;
+    }
+    isOrdered = isOrdered && (value == expected);
+    ++expected;
+  }
+  producer.join();
+  BOOST_CHECK(isOrdered);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(Pipeline_execution)
+
+BOOST_AUTO_TEST_CASE(Pipeline_matches_sequential_run)
+{
+  const std::string scene = makeScene(3000);
+  std::istringstream first(scene);
+  klimchuk::Matrix sequential;
+  const klimchuk::pipeline_statistics_t expected = klimchuk::runSequentially(first, transform, sequential);
+  std::istringstream second(scene);
+  klimchuk::Matrix pipelined;
+  const klimchuk::pipeline_statistics_t statistics = klimchuk::runPipeline(second, transform, pipelined, 2);
+  BOOST_CHECK_EQUAL(statistics.numberOfShapes, 3000);
+  BOOST_CHECK_EQUAL(expected.numberOfShapes, 3000);
+  BOOST_REQUIRE_EQUAL(pipelined.getNumberOFLayers(), sequential.getNumberOFLayers());
+  for (size_t i = 0; i < sequential.getNumberOFLayers(); ++i)
+  {
+    BOOST_REQUIRE_EQUAL(pipelined.getSizeOfLayer(i), sequential.getSizeOfLayer(i));
+    for (size_t j = 0; j < sequential.getSizeOfLayer(i); ++j)
+    {
+      BOOST_CHECK_CLOSE(pipelined[i][j]->getArea(), sequential[i][j]->getArea(), EPSILON);
+      BOOST_CHECK_CLOSE(pipelined[i][j]->getFrameRect().pos.x, sequential[i][j]->getFrameRect().pos.x, EPSILON);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Pipeline_propagates_errors)
+{
+  const std::string scene = makeScene(5000);
+  std::istringstream first(scene);
+  klimchuk::Matrix matrix;
+  size_t numberOfTransformed = 0;
+  BOOST_CHECK_THROW(klimchuk::runPipeline(first, [&](const klimchuk::Shape::ShapePtr& shape)
+  {
+    if (++numberOfTransformed == 1000)
+    {
+      shape->scale(-1.0);
+    }
+  }, matrix, 4), std::invalid_argument);
+  std::istringstream second(makeScene(10) + "hexagon 1 2\n" + scene);
+  BOOST_CHECK_THROW(klimchuk::runPipeline(second, transform, matrix), std::runtime_error);
+  std::istringstream third(scene);
+  BOOST_CHECK_THROW(klimchuk::runPipeline(third, klimchuk::Transform(), matrix), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,10 +1,83 @@
 #include <stdexcept>
+#include <cmath>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <thread>
 #include "boost/test/unit_test.hpp"
 #include "polygon.hpp"
 #include "shape.hpp"
 
 const double EPSILON = 0.000001;
 
+namespace
+{
+  std::vector<klimchuk::point_t> makeSurveyRing(size_t size, unsigned int seed)
+  {
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<double> noise(-0.01, 0.01);
+    std::vector<klimchuk::point_t> points(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+      const double angle = 2 * M_PI * i / size;
+      const double radius = 10.0 + std::sin(5 * angle) + noise(generator);
+      points[i] = { 20.0 + radius * std::cos(angle), -5.0 + radius * std::sin(angle) };
+    }
+    return points;
+  }
+
+  std::vector<klimchuk::point_t> makeComb(size_t numberOfTeeth)
+  {
+    std::vector<klimchuk::point_t> points{ { 0.0, 0.0 }, { 2.0 * numberOfTeeth, 0.0 } };
+    for (size_t i = numberOfTeeth; i > 0; --i)
+    {
+      const double x = 2.0 * i;
+      points.insert(points.end(), { { x, 5.0 + (i % 3) }, { x - 1.0, 5.0 + (i % 3) }, { x - 1.0, 1.0 },
+        { x - 1.5, 1.0 + 0.1 * (i % 5) } });
+    }
+    points.back().y = 4.0;
+    return points;
+  }
+
+  bool isInsideByRayCasting(const std::vector<klimchuk::point_t>& points, const klimchuk::point_t& point)
+  {
+    bool isInside = false;
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      const klimchuk::point_t& begin = points[i];
+      const klimchuk::point_t& end = points[(i + 1) % points.size()];
+      if ((begin.x <= point.x) != (end.x <= point.x))
+      {
+        const double y = begin.y + (point.x - begin.x) * (end.y - begin.y) / (end.x - begin.x);
+        isInside = (y < point.y) ? !isInside : isInside;
+      }
+    }
+    return isInside;
+  }
+
+  double getMaxDeviation(const std::vector<klimchuk::point_t>& points, const klimchuk::Polygon& polygon)
+  {
+    double maxDeviation = 0.0;
+    for (const klimchuk::point_t& point : points)
+    {
+      double deviation = -1.0;
+      for (size_t i = 0; i < polygon.getSize(); ++i)
+      {
+        const klimchuk::point_t begin = polygon[i];
+        const klimchuk::point_t end = polygon[(i + 1) % polygon.getSize()];
+        const double length = std::hypot(end.x - begin.x, end.y - begin.y);
+        const double ratio = std::min(1.0, std::max(0.0,
+          ((point.x - begin.x) * (end.x - begin.x) + (point.y - begin.y) * (end.y - begin.y)) / (length * length)));
+        const double distance = std::hypot(point.x - begin.x - ratio * (end.x - begin.x),
+          point.y - begin.y - ratio * (end.y - begin.y));
+        deviation = (deviation < 0.0) ? distance : std::min(deviation, distance);
+      }
+      maxDeviation = std::max(maxDeviation, deviation);
+    }
+    return maxDeviation;
+  }
+}
+
 BOOST_AUTO_TEST_SUITE(Polygon_constructor)
 
 BOOST_AUTO_TEST_CASE(Polygon_valid_constructor)
@@ -27,6 +100,9 @@ BOOST_AUTO_TEST_CASE(Polygon_invalid_constructor)
   BOOST_CHECK_THROW(klimchuk::Polygon({ { 1.0, 2.0 }, { 2.0, 3.0 } }), std::length_error);
   BOOST_CHECK_THROW(klimchuk::Polygon({ { 1.0, 0.0 }, { 5.0, 0.0 },
     { 10.0, 0.0 } }), std::invalid_argument);
+  BOOST_CHECK_THROW(klimchuk::Polygon({ { 0.1, 0.1 }, { 0.1, 0.1 }, { 0.3, 0.3 }, { 0.7, 0.7 } }), std::invalid_argument);
+  BOOST_CHECK_THROW(klimchuk::Polygon({ { 0.0, 0.0 }, { 2.0, 2.0 }, { 2.0, 0.0 }, { 0.0, 2.0 } }), std::invalid_argument);
+  BOOST_CHECK_NO_THROW(klimchuk::Polygon({ { 0.0, 0.0 }, { 1.0, 1e-20 }, { 2.0, 0.0 } }));
 }
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -133,6 +209,14 @@ BOOST_AUTO_TEST_CASE(polygon_scaling_valid)
   BOOST_CHECK_CLOSE(polygon.getFrameRect().width, 6.0 * coefficient, EPSILON);
   BOOST_CHECK_CLOSE(polygon.getFrameRect().height, 6.0 * coefficient, EPSILON);
 }
+BOOST_AUTO_TEST_CASE(polygon_scaling_keeps_centre)
+{
+  klimchuk::Polygon polygon({ { 2.0, 2.0 }, { 2.0, 8.0 }, { 8.0, 8.0 }, { 8.0, 2.0 } });
+  polygon.scale(0.5);
+  BOOST_CHECK_CLOSE(polygon.getCentre().x, 5.0, EPSILON);
+  BOOST_CHECK_CLOSE(polygon.getCentre().y, 5.0, EPSILON);
+  BOOST_CHECK_CLOSE(polygon.getArea(), 9.0, EPSILON);
+}
 BOOST_AUTO_TEST_CASE(cirlce_scaling_invalid)
 {
   klimchuk::Polygon polygon({ { -3.0, -3.0 }, { -3.0, 3.0 },
@@ -160,3 +244,244 @@ BOOST_AUTO_TEST_CASE(polygon_rotating_correctness)
 }
 
 BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(polygon_oriented_frame_rect)
+
+BOOST_AUTO_TEST_CASE(polygon_oriented_frame_rect_after_rotating)
+{
+  klimchuk::Polygon polygon({ { -3.0, -1.0 }, { -3.0, 1.0 }, { 0.0, 2.0 },
+    { 3.0, 1.0 }, { 3.0, -1.0 } });
+  polygon.rotate(45.0);
+  klimchuk::oriented_rectangle_t frame = polygon.getOrientedFrameRect();
+  BOOST_CHECK_CLOSE(frame.width * frame.height, 18.0, EPSILON);
+  BOOST_CHECK_CLOSE(std::abs(frame.axis.x), std::abs(frame.axis.y), EPSILON);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(polygon_simplification)
+
+BOOST_AUTO_TEST_CASE(polygon_simplification_removes_collinear_vertices)
+{
+  klimchuk::Polygon polygon({ { 0.0, 0.0 }, { 1.0, 0.0 }, { 2.0, 0.0 }, { 2.0, 1.0 }, { 2.0, 2.0 },
+    { 1.0, 2.0 }, { 0.0, 2.0 }, { 0.0, 1.0 } });
+  for (klimchuk::Polygon::Simplification method : { klimchuk::Polygon::Simplification::DOUGLAS_PEUCKER,
+    klimchuk::Polygon::Simplification::VISVALINGAM })
+  {
+    klimchuk::Polygon simplified = polygon.simplify(0.0, method);
+    BOOST_CHECK_EQUAL(simplified.getSize(), 4);
+    BOOST_CHECK_CLOSE(simplified.getArea(), 4.0, EPSILON);
+  }
+  BOOST_CHECK_THROW(polygon.simplify(-1.0), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(polygon_simplification_respects_tolerance)
+{
+  std::vector<klimchuk::point_t> points = makeSurveyRing(2000, 1);
+  klimchuk::Polygon polygon(points.data(), points.size());
+  klimchuk::Polygon douglasPeucker = polygon.simplify(0.05);
+  BOOST_CHECK_LT(douglasPeucker.getSize(), 200);
+  BOOST_CHECK_LE(getMaxDeviation(points, douglasPeucker), 0.05 + EPSILON);
+  klimchuk::Polygon visvalingam = polygon.simplify(0.05, klimchuk::Polygon::Simplification::VISVALINGAM);
+  BOOST_CHECK_LT(visvalingam.getSize(), 400);
+  BOOST_CHECK_CLOSE(visvalingam.getArea(), polygon.getArea(), 0.5);
+}
+
+BOOST_AUTO_TEST_CASE(polygon_levels_of_detail_follow_transformations)
+{
+  std::vector<klimchuk::point_t> points = makeSurveyRing(5000, 2);
+  klimchuk::Polygon polygon(points.data(), points.size());
+  const size_t numberOfLevels = polygon.getNumberOfLevels();
+  BOOST_REQUIRE_GT(numberOfLevels, 3);
+  BOOST_CHECK_EQUAL(polygon.getLevelOfDetail(0.0), 0);
+  BOOST_CHECK_EQUAL(polygon.getLevelOfDetail(100.0), numberOfLevels - 1);
+  for (size_t i = 1; i < numberOfLevels; ++i)
+  {
+    BOOST_CHECK_GT(polygon.getErrorOfLevel(i), polygon.getErrorOfLevel(i - 1));
+    BOOST_CHECK_LT(polygon.getPointsOfLevel(i).size(), polygon.getPointsOfLevel(i - 1).size());
+  }
+  const size_t level = polygon.getLevelOfDetail(0.1);
+  const double error = polygon.getErrorOfLevel(level);
+  BOOST_CHECK_LE(error, 0.1);
+
+  polygon.move(3.0, 4.0);
+  polygon.rotate(30.0);
+  polygon.scale(2.0);
+  std::vector<klimchuk::point_t> transformedPoints = polygon.getPointsOfLevel(0);
+  std::vector<klimchuk::point_t> levelPoints = polygon.getPointsOfLevel(level);
+  klimchuk::Polygon simplified(levelPoints.data(), levelPoints.size());
+  BOOST_CHECK_CLOSE(polygon.getErrorOfLevel(level), 2 * error, EPSILON);
+  BOOST_CHECK_LE(getMaxDeviation(transformedPoints, simplified), 2 * error + EPSILON);
+  BOOST_CHECK_EQUAL(polygon.getLevelOfDetail(2 * error), level);
+  BOOST_CHECK_THROW(polygon.getPointsOfLevel(numberOfLevels), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(polygon_triangulation_and_containment)
+
+BOOST_AUTO_TEST_CASE(polygon_triangulation_covers_polygon)
+{
+  std::vector<std::vector<klimchuk::point_t>> rings{ makeComb(20), makeSurveyRing(500, 3) };
+  rings.push_back(rings.front());
+  std::reverse(rings.back().begin(), rings.back().end());
+  for (const std::vector<klimchuk::point_t>& ring : rings)
+  {
+    klimchuk::Polygon polygon(ring.data(), ring.size());
+    std::vector<size_t> triangles = polygon.getTriangulation();
+    BOOST_REQUIRE_EQUAL(triangles.size(), 3 * (ring.size() - 2));
+    double area = 0.0;
+    for (size_t i = 0; i < triangles.size(); i += 3)
+    {
+      const klimchuk::point_t a = polygon[triangles[i]];
+      const klimchuk::point_t b = polygon[triangles[i + 1]];
+      const klimchuk::point_t c = polygon[triangles[i + 2]];
+      const double doubleArea = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+      BOOST_CHECK_GE(doubleArea, 0.0);
+      area += doubleArea / 2;
+    }
+    BOOST_CHECK_CLOSE(area, polygon.getArea(), EPSILON);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(polygon_triangulation_skips_repeated_vertices)
+{
+  klimchuk::Polygon square({ { 0.0, 0.0 }, { 4.0, 0.0 }, { 4.0, 4.0 }, { 0.0, 4.0 }, { 0.0, 0.0 } });
+  BOOST_CHECK_EQUAL(square.getTriangulation().size(), 6);
+  BOOST_CHECK(square.contains({ 1.0, 3.0 }));
+  BOOST_CHECK(!square.contains({ 5.0, 3.0 }));
+
+  klimchuk::Polygon corner({ { 0.0, 0.0 }, { 4.0, 0.0 }, { 4.0, 0.0 }, { 4.0, 2.0 }, { 2.0, 2.0 }, { 2.0, 2.0 },
+    { 2.0, 2.0 }, { 2.0, 4.0 }, { 0.0, 4.0 }, { 0.0, 0.0 } });
+  const std::vector<size_t> triangles = corner.getTriangulation();
+  BOOST_REQUIRE_EQUAL(triangles.size(), 12);
+  double area = 0.0;
+  for (size_t i = 0; i < triangles.size(); i += 3)
+  {
+    const klimchuk::point_t a = corner[triangles[i]];
+    const klimchuk::point_t b = corner[triangles[i + 1]];
+    const klimchuk::point_t c = corner[triangles[i + 2]];
+    area += ((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x)) / 2;
+  }
+  BOOST_CHECK_CLOSE(area, 12.0, EPSILON);
+  BOOST_CHECK(corner.contains({ 1.0, 3.0 }));
+  BOOST_CHECK(!corner.contains({ 3.0, 3.0 }));
+}
+
+BOOST_AUTO_TEST_CASE(polygon_contains_matches_ray_casting)
+{
+  std::vector<klimchuk::point_t> star(4000);
+  for (size_t i = 0; i < star.size(); ++i)
+  {
+    const double angle = 2 * M_PI * i / star.size();
+    const double radius = (i % 2 == 0) ? 50.0 : 5.0;
+    star[i] = { 50.0 + radius * std::cos(angle), 3.5 + radius * std::sin(angle) };
+  }
+  std::mt19937 generator(4);
+  std::uniform_real_distribution<double> abscissa(-1.0, 101.0);
+  std::uniform_real_distribution<double> ordinate(-50.0, 55.0);
+  std::vector<klimchuk::point_t> points(5000);
+  for (klimchuk::point_t& point : points)
+  {
+    point = { abscissa(generator), ordinate(generator) };
+  }
+  for (const std::vector<klimchuk::point_t>& ring : { makeComb(50), star })
+  {
+    klimchuk::Polygon polygon(ring.data(), ring.size());
+    std::vector<bool> results = polygon.contains(points.data(), points.size());
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      BOOST_REQUIRE_EQUAL(polygon.contains(points[i]), isInsideByRayCasting(ring, points[i]));
+      BOOST_REQUIRE_EQUAL(results[i], isInsideByRayCasting(ring, points[i]));
+    }
+  }
+  const std::vector<klimchuk::point_t> teeth = makeComb(50);
+  klimchuk::Polygon comb(teeth.data(), teeth.size());
+  BOOST_CHECK(comb.contains({ 1.5, 4.5 }));
+  BOOST_CHECK(!comb.contains({ 2.75, 4.5 }));
+}
+
+BOOST_AUTO_TEST_CASE(polygon_contains_after_transformations)
+{
+  klimchuk::Polygon polygon({ { 0.0, 0.0 }, { 4.0, 0.0 }, { 4.0, 4.0 }, { 2.0, 1.0 }, { 0.0, 4.0 } });
+  BOOST_CHECK(polygon.contains({ 1.0, 1.0 }));
+  BOOST_CHECK(!polygon.contains({ 2.0, 3.0 }));
+  polygon.move(10.0, 0.0);
+  BOOST_CHECK(!polygon.contains({ 1.0, 1.0 }));
+  BOOST_CHECK(polygon.contains({ 11.0, 1.0 }));
+  polygon.rotate(180.0);
+  BOOST_CHECK(polygon.contains({ polygon.getCentre().x, polygon.getCentre().y + 1.0 }));
+  BOOST_CHECK_EQUAL(polygon.getTriangulation().size(), 9);
+  BOOST_CHECK_THROW(polygon.contains(nullptr, 2), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(polygon_contains_follows_transformations_without_rebuilding)
+{
+  const std::vector<klimchuk::point_t> ring = makeSurveyRing(300, 7);
+  klimchuk::Polygon polygon(ring.data(), ring.size());
+  BOOST_CHECK(polygon.contains({ 20.0, -5.0 }));
+  polygon.rotate(37.0);
+  polygon.scale(1.5);
+  polygon.move(-4.0, 9.0);
+  polygon.rotate(-101.0);
+  std::vector<klimchuk::point_t> transformed(ring.size());
+  for (size_t i = 0; i < ring.size(); ++i)
+  {
+    transformed[i] = polygon[i];
+  }
+  std::mt19937 generator(8);
+  std::uniform_real_distribution<double> abscissa(-10.0, 40.0);
+  std::uniform_real_distribution<double> ordinate(-15.0, 35.0);
+  for (size_t i = 0; i < 5000; ++i)
+  {
+    const klimchuk::point_t point{ abscissa(generator), ordinate(generator) };
+    BOOST_REQUIRE_EQUAL(polygon.contains(point), isInsideByRayCasting(transformed, point));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(polygon_contains_from_several_threads)
+{
+  const std::vector<klimchuk::point_t> ring = makeComb(200);
+  const klimchuk::Polygon polygon(ring.data(), ring.size());
+  std::vector<klimchuk::point_t> points(4000);
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    points[i] = { 0.1 * i, 0.5 + 0.001 * i };
+  }
+  std::vector<char> results(points.size(), 0);
+  std::vector<std::thread> threads;
+  for (size_t part = 0; part < 4; ++part)
+  {
+    threads.emplace_back([&polygon, &points, &results, part]()
+    {
+      for (size_t i = part; i < points.size(); i += 4)
+      {
+        results[i] = polygon.contains(points[i]) ? 1 : 0;
+      }
+    });
+  }
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    BOOST_REQUIRE_EQUAL(results[i] == 1, isInsideByRayCasting(ring, points[i]));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(polygon_caches_are_allocated_behind_one_pointer)
+{
+  BOOST_CHECK_EQUAL(sizeof(klimchuk::Polygon) - sizeof(klimchuk::Shape), sizeof(size_t) + 2 * sizeof(void*));
+  klimchuk::Polygon polygon({ { -3.0, -3.0 }, { -3.0, 3.0 }, { 3.0, 3.0 }, { 3.0, -3.0 } });
+  BOOST_CHECK(polygon.contains({ 0.0, 0.0 }));
+  klimchuk::Polygon moved(std::move(polygon));
+  moved.move(10.0, 0.0);
+  BOOST_CHECK(moved.contains({ 10.0, 0.0 }));
+  BOOST_CHECK(!moved.contains({ 0.0, 0.0 }));
+  moved = klimchuk::Polygon({ { 0.0, 0.0 }, { 1.0, 0.0 }, { 1.0, 1.0 }, { 0.0, 1.0 } });
+  BOOST_CHECK(moved.contains({ 0.5, 0.5 }));
+  BOOST_CHECK_EQUAL(moved.getNumberOfLevels(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
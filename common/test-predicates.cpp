@@ -0,0 +1,66 @@
+#include <cmath>
+#include "boost/test/unit_test.hpp"
+#include "predicates.hpp"
+
+namespace
+{
+  int getSign(double value)
+  {
+    return (value > 0.0) - (value < 0.0);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(predicates_orientation)
+
+BOOST_AUTO_TEST_CASE(orientation_of_simple_points)
+{
+  BOOST_CHECK_GT(klimchuk::getOrientation({ 0.0, 0.0 }, { 1.0, 0.0 }, { 0.0, 1.0 }), 0.0);
+  BOOST_CHECK_LT(klimchuk::getOrientation({ 0.0, 0.0 }, { 0.0, 1.0 }, { 1.0, 0.0 }), 0.0);
+  BOOST_CHECK_EQUAL(klimchuk::getOrientation({ 0.0, 0.0 }, { 1.0, 1.0 }, { 3.0, 3.0 }), 0.0);
+  BOOST_CHECK_EQUAL(klimchuk::getOrientation({ 0.0, 0.0 }, { 2.0, 1.0 }, { 4.0, 2.0 }), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(orientation_of_nearly_collinear_points)
+{
+  const double step = std::ldexp(1.0, -53);
+  for (int i = 0; i < 64; ++i)
+  {
+    for (int j = 0; j < 64; ++j)
+    {
+      const klimchuk::point_t point{ 0.5 + (i * step), 0.5 + (j * step) };
+      BOOST_REQUIRE_EQUAL(getSign(klimchuk::getOrientation(point, { 12.0, 12.0 }, { 24.0, 24.0 })), getSign(j - i));
+      BOOST_REQUIRE_EQUAL(getSign(klimchuk::getOrientation({ 12.0, 12.0 }, point, { 24.0, 24.0 })), getSign(i - j));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(predicates_in_circle)
+
+BOOST_AUTO_TEST_CASE(in_circle_of_simple_points)
+{
+  const klimchuk::point_t a{ 0.0, 0.0 };
+  const klimchuk::point_t b{ 1.0, 0.0 };
+  const klimchuk::point_t c{ 0.0, 1.0 };
+  BOOST_CHECK_GT(klimchuk::getInCircle(a, b, c, { 0.5, 0.5 }), 0.0);
+  BOOST_CHECK_LT(klimchuk::getInCircle(a, b, c, { 2.0, 2.0 }), 0.0);
+  BOOST_CHECK_EQUAL(klimchuk::getInCircle(a, b, c, { 1.0, 1.0 }), 0.0);
+  BOOST_CHECK_LT(klimchuk::getInCircle(a, c, b, { 0.5, 0.5 }), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(in_circle_of_nearly_cocircular_points)
+{
+  const double offset = std::ldexp(1.0, 20);
+  const double step = std::ldexp(1.0, -30);
+  const klimchuk::point_t a{ offset, offset };
+  const klimchuk::point_t b{ offset + 1.0, offset };
+  const klimchuk::point_t c{ offset, offset + 1.0 };
+  BOOST_CHECK_EQUAL(klimchuk::getInCircle(a, b, c, { offset + 1.0, offset + 1.0 }), 0.0);
+  BOOST_CHECK_GT(klimchuk::getInCircle(a, b, c, { offset + 1.0, offset + 1.0 - step }), 0.0);
+  BOOST_CHECK_LT(klimchuk::getInCircle(a, b, c, { offset + 1.0, offset + 1.0 + step }), 0.0);
+  BOOST_CHECK_GT(klimchuk::getInCircle(a, b, c, { offset + 1.0 - step, offset + 1.0 }), 0.0);
+  BOOST_CHECK_LT(klimchuk::getInCircle(b, a, c, { offset + 1.0 - step, offset + 1.0 }), 0.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
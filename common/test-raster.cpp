@@ -0,0 +1,196 @@
+#include <stdexcept>
+#include <sstream>
+#include <string>
+#include <cmath>
+#include "boost/test/unit_test.hpp"
+#include "raster.hpp"
+#include "circle.hpp"
+#include "rectangle.hpp"
+#include "triangle.hpp"
+
+const double EPSILON = 0.000001;
+
+namespace
+{
+  size_t countPixels(const klimchuk::Raster& raster, unsigned int value)
+  {
+    size_t count = 0;
+    for (size_t row = 0; row < raster.getHeight(); ++row)
+    {
+      for (size_t column = 0; column < raster.getWidth(); ++column)
+      {
+        count += (raster(column, row) == value) ? 1 : 0;
+      }
+    }
+    return count;
+  }
+
+  class UnsupportedShape: public klimchuk::Shape
+  {
+  public:
+    double getArea() const override
+    {
+      return 0.0;
+    }
+    klimchuk::rectangle_t getFrameRect() const override
+    {
+      return { 0.0, 0.0, { 0.0, 0.0 } };
+    }
+    klimchuk::oriented_rectangle_t getOrientedFrameRect() const override
+    {
+      return { 0.0, 0.0, { 0.0, 0.0 }, { 1.0, 0.0 } };
+    }
+    void move(const klimchuk::point_t&) override
+    {}
+    void move(double, double) override
+    {}
+    void scale(double) override
+    {}
+    klimchuk::point_t getCentre() const override
+    {
+      return { 0.0, 0.0 };
+    }
+    void rotate(double) override
+    {}
+    uint64_t getHash() const override
+    {
+      return 0;
+    }
+  };
+}
+
+BOOST_AUTO_TEST_SUITE(Raster_construction)
+
+BOOST_AUTO_TEST_CASE(Raster_invalid_arguments)
+{
+  const klimchuk::rectangle_t viewport{ 10.0, 10.0, { 0.0, 0.0 } };
+  BOOST_CHECK_THROW(klimchuk::Raster(0, 10, viewport), std::invalid_argument);
+  BOOST_CHECK_THROW(klimchuk::Raster(10, 10, klimchuk::rectangle_t{ 0.0, 10.0, { 0.0, 0.0 } }), std::invalid_argument);
+  klimchuk::Raster raster(10, 10, viewport);
+  BOOST_CHECK_THROW(raster(10, 0), std::out_of_range);
+  klimchuk::CompositeShape compositeShape(std::make_shared<klimchuk::Circle>(0.0, 0.0, 1.0));
+  BOOST_CHECK_THROW(raster.render(compositeShape, klimchuk::Raster::Mode::COVERAGE, 0), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(Raster_rendering)
+
+BOOST_AUTO_TEST_CASE(Raster_coverage_of_overlapping_rectangles)
+{
+  klimchuk::CompositeShape compositeShape(std::make_shared<klimchuk::Rectangle>(4.0, 4.0, -1.0, 0.0));
+  compositeShape.add(std::make_shared<klimchuk::Rectangle>(4.0, 2.0, 1.0, 0.0));
+  klimchuk::Raster raster(100, 100, { 10.0, 10.0, { 0.0, 0.0 } });
+  raster.render(compositeShape, klimchuk::Raster::Mode::COVERAGE);
+  BOOST_CHECK_EQUAL(countPixels(raster, 2), 20 * 20);
+  BOOST_CHECK_EQUAL(countPixels(raster, 1), 40 * 40 + 40 * 20 - 2 * 20 * 20);
+  BOOST_CHECK_EQUAL(raster(30, 50), 1);
+  BOOST_CHECK_EQUAL(raster(50, 50), 2);
+  BOOST_CHECK_EQUAL(raster(50, 35), 1);
+  BOOST_CHECK_EQUAL(raster(0, 0), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Raster_render_replaces_previous_image)
+{
+  klimchuk::CompositeShape compositeShape(std::make_shared<klimchuk::Rectangle>(4.0, 4.0, -1.0, 0.0));
+  compositeShape.add(std::make_shared<klimchuk::Rectangle>(4.0, 2.0, 1.0, 0.0));
+  klimchuk::Raster raster(100, 100, { 10.0, 10.0, { 0.0, 0.0 } });
+  raster.render(compositeShape, klimchuk::Raster::Mode::COVERAGE);
+  raster.render(compositeShape, klimchuk::Raster::Mode::COVERAGE);
+  BOOST_CHECK_EQUAL(countPixels(raster, 2), 20 * 20);
+  BOOST_CHECK_EQUAL(countPixels(raster, 4), 0);
+  raster.render(klimchuk::CompositeShape(std::make_shared<klimchuk::Rectangle>(2.0, 2.0, 3.0, 3.0)),
+    klimchuk::Raster::Mode::LAYER_INDEX);
+  BOOST_CHECK_EQUAL(countPixels(raster, 1), 20 * 20);
+  BOOST_CHECK_EQUAL(raster(50, 50), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Raster_circle_and_triangle_area)
+{
+  klimchuk::CompositeShape compositeShape(std::make_shared<klimchuk::Circle>(-5.0, 0.0, 4.0));
+  compositeShape.add(std::make_shared<klimchuk::Triangle>(klimchuk::point_t{ 1.0, -4.0 },
+    klimchuk::point_t{ 9.0, -4.0 }, klimchuk::point_t{ 1.0, 4.0 }));
+  compositeShape[1]->rotate(30.0);
+  klimchuk::Raster raster(1000, 500, { 20.0, 10.0, { 0.0, 0.0 } });
+  raster.render(compositeShape, klimchuk::Raster::Mode::LAYER_INDEX);
+  const double areaOfPixel = 0.02 * 0.02;
+  BOOST_CHECK_CLOSE(countPixels(raster, 1) * areaOfPixel, M_PI * 16.0, 0.5);
+  BOOST_CHECK_CLOSE(countPixels(raster, 2) * areaOfPixel, 32.0, 0.5);
+}
+
+BOOST_AUTO_TEST_CASE(Raster_layer_index_of_matrix)
+{
+  std::shared_ptr<klimchuk::Rectangle> bottom = std::make_shared<klimchuk::Rectangle>(6.0, 6.0, 0.0, 0.0);
+  std::shared_ptr<klimchuk::Circle> top = std::make_shared<klimchuk::Circle>(0.0, 0.0, 1.0);
+  std::shared_ptr<klimchuk::Rectangle> aside = std::make_shared<klimchuk::Rectangle>(1.8, 1.8, 4.0, 4.0);
+  klimchuk::Matrix matrix;
+  matrix.add(bottom);
+  matrix.add(top);
+  matrix.add(aside);
+  klimchuk::Raster raster(10, 10, { 10.0, 10.0, { 0.0, 0.0 } });
+  raster.render(matrix, klimchuk::Raster::Mode::LAYER_INDEX);
+  BOOST_CHECK_EQUAL(raster(5, 5), 2);
+  BOOST_CHECK_EQUAL(raster(3, 3), 1);
+  BOOST_CHECK_EQUAL(raster(9, 0), 1);
+  BOOST_CHECK_EQUAL(raster(9, 9), 0);
+  raster.clear();
+  BOOST_CHECK_EQUAL(raster(5, 5), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Raster_parallel_mode_matches_serial_mode)
+{
+  klimchuk::CompositeShape compositeShape(std::make_shared<klimchuk::Circle>(0.0, 0.0, 3.0));
+  for (size_t i = 0; i < 200; ++i)
+  {
+    compositeShape.add(std::make_shared<klimchuk::Rectangle>(1.0 + (i % 5), 0.5 + (i % 3),
+      std::sin(i * 1.3) * 40.0, std::cos(i * 0.7) * 25.0));
+    compositeShape[i + 1]->rotate(i * 11.0);
+  }
+  klimchuk::Raster serial(300, 200, { 90.0, 60.0, { 0.0, 0.0 } });
+  klimchuk::Raster parallel(300, 200, serial.getViewport());
+  serial.render(compositeShape, klimchuk::Raster::Mode::COVERAGE);
+  parallel.render(compositeShape, klimchuk::Raster::Mode::COVERAGE, 4);
+  for (size_t row = 0; row < serial.getHeight(); ++row)
+  {
+    for (size_t column = 0; column < serial.getWidth(); ++column)
+    {
+      BOOST_REQUIRE_EQUAL(serial(column, row), parallel(column, row));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Raster_parallel_failure_keeps_previous_image)
+{
+  klimchuk::CompositeShape compositeShape(std::make_shared<klimchuk::Rectangle>(4.0, 4.0, 0.0, 0.0));
+  klimchuk::Raster raster(10, 10, { 10.0, 10.0, { 0.0, 0.0 } });
+  raster.render(compositeShape, klimchuk::Raster::Mode::COVERAGE, 4);
+  for (size_t i = 0; i < 20; ++i)
+  {
+    compositeShape.add(std::make_shared<klimchuk::Circle>(0.0, 0.0, 1.0));
+  }
+  compositeShape.add(std::make_shared<UnsupportedShape>());
+  BOOST_CHECK_THROW(raster.render(compositeShape, klimchuk::Raster::Mode::COVERAGE, 4), std::invalid_argument);
+  BOOST_CHECK_EQUAL(countPixels(raster, 1), 16);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(Raster_output)
+
+BOOST_AUTO_TEST_CASE(Raster_pgm_and_ppm_output)
+{
+  klimchuk::CompositeShape compositeShape(std::make_shared<klimchuk::Rectangle>(2.0, 2.0, 0.0, 0.0));
+  klimchuk::Raster raster(4, 2, { 4.0, 2.0, { 0.0, 0.0 } });
+  raster.render(compositeShape, klimchuk::Raster::Mode::COVERAGE);
+  std::ostringstream pgm;
+  raster.writePgm(pgm);
+  BOOST_CHECK_EQUAL(pgm.str().size(), std::string("P5\n4 2\n255\n").size() + 8);
+  BOOST_CHECK_EQUAL(static_cast<unsigned char>(pgm.str().back()), 0);
+  BOOST_CHECK_EQUAL(static_cast<unsigned char>(pgm.str()[pgm.str().size() - 3]), 255);
+  std::ostringstream ppm;
+  raster.writePpm(ppm);
+  BOOST_CHECK_EQUAL(ppm.str().substr(0, 11), "P6\n4 2\n255\n");
+  BOOST_CHECK_EQUAL(ppm.str().size(), 11 + 24);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,4 +1,5 @@
 #include <stdexcept>
+#include <cmath>
 #include "boost/test/unit_test.hpp"
 #include "rectangle.hpp"
 
@@ -106,6 +107,18 @@ BOOST_AUTO_TEST_CASE(rectangle_scaling_valid)
   BOOST_CHECK_CLOSE(rectangle.getFrameRect().width, 3.0 * coefficient, EPSILON);
   BOOST_CHECK_CLOSE(rectangle.getFrameRect().height, 13.0 * coefficient, EPSILON);
 }
+BOOST_AUTO_TEST_CASE(rectangle_scaling_keeps_rotation)
+{
+  klimchuk::Rectangle rectangle(3.0, 13.0, 8.0, 12.0);
+  rectangle.rotate(30.0);
+  rectangle.scale(2.0);
+  klimchuk::oriented_rectangle_t frame = rectangle.getOrientedFrameRect();
+  BOOST_CHECK_CLOSE(frame.width, 6.0, EPSILON);
+  BOOST_CHECK_CLOSE(frame.height, 26.0, EPSILON);
+  BOOST_CHECK_CLOSE(frame.pos.x, 8.0, EPSILON);
+  BOOST_CHECK_CLOSE(frame.axis.x, std::cos(M_PI / 6), EPSILON);
+  BOOST_CHECK_CLOSE(frame.axis.y, std::sin(M_PI / 6), EPSILON);
+}
 BOOST_AUTO_TEST_CASE(rectangle_scaling_invalid)
 {
   klimchuk::Rectangle rectangle(3.0, 13.0, 8.0, 12.0);
@@ -127,4 +140,47 @@ BOOST_AUTO_TEST_CASE(rectangle_rotating_correctness)
   BOOST_CHECK_CLOSE(rectangle.getFrameRect().height, 13.0, EPSILON);
 }
 
+BOOST_AUTO_TEST_CASE(rectangle_rotating_keeps_sizes)
+{
+  klimchuk::Rectangle rectangle(4.0, 2.0, 1.0, -1.0);
+  rectangle.rotate(30.0);
+  BOOST_CHECK_CLOSE(rectangle.getWidth(), 4.0, EPSILON);
+  BOOST_CHECK_CLOSE(rectangle.getHeight(), 2.0, EPSILON);
+  BOOST_CHECK_CLOSE(rectangle.getFrameRect().width, (4.0 * std::cos(M_PI / 6)) + (2.0 * std::sin(M_PI / 6)), EPSILON);
+  BOOST_CHECK_CLOSE(rectangle.getFrameRect().height, (4.0 * std::sin(M_PI / 6)) + (2.0 * std::cos(M_PI / 6)), EPSILON);
+  BOOST_CHECK_CLOSE(rectangle.getCentre().x, 1.0, EPSILON);
+  BOOST_CHECK_CLOSE(rectangle.getCentre().y, -1.0, EPSILON);
+  for (size_t i = 0; i < 100000; ++i)
+  {
+    rectangle.rotate(3.6);
+  }
+  const klimchuk::point_t axis = rectangle.getOrientedFrameRect().axis;
+  BOOST_CHECK_CLOSE((axis.x * axis.x) + (axis.y * axis.y), 1.0, EPSILON);
+  BOOST_CHECK_CLOSE(axis.x, std::cos(M_PI / 6), 0.0001);
+  BOOST_CHECK_CLOSE(rectangle.getArea(), 8.0, EPSILON);
+}
+
+BOOST_AUTO_TEST_CASE(rectangle_payload_size)
+{
+  BOOST_CHECK_EQUAL(sizeof(klimchuk::Rectangle) - sizeof(klimchuk::Shape), 6 * sizeof(double));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(rectangle_oriented_frame_rect)
+
+BOOST_AUTO_TEST_CASE(rectangle_oriented_frame_rect_after_rotating)
+{
+  klimchuk::Rectangle rectangle(3.0, 13.0, 8.0, 12.0);
+  rectangle.rotate(30.0);
+  klimchuk::oriented_rectangle_t frame = rectangle.getOrientedFrameRect();
+  BOOST_CHECK_CLOSE(frame.width, 3.0, EPSILON);
+  BOOST_CHECK_CLOSE(frame.height, 13.0, EPSILON);
+  BOOST_CHECK_CLOSE(frame.pos.x, 8.0, EPSILON);
+  BOOST_CHECK_CLOSE(frame.pos.y, 12.0, EPSILON);
+  BOOST_CHECK_CLOSE(frame.axis.x, std::cos(M_PI / 6), EPSILON);
+  BOOST_CHECK_CLOSE(frame.axis.y, std::sin(M_PI / 6), EPSILON);
+  BOOST_CHECK_LT(frame.width * frame.height, rectangle.getFrameRect().width * rectangle.getFrameRect().height);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
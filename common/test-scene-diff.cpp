@@ -0,0 +1,251 @@
+#include <memory>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include "boost/test/unit_test.hpp"
+#include "scene-diff.hpp"
+#include "circle.hpp"
+#include "rectangle.hpp"
+#include "triangle.hpp"
+#include "polygon.hpp"
+
+const double EPSILON = 0.000001;
+
+namespace
+{
+  klimchuk::Shape::ShapePtr makeShape(size_t index)
+  {
+    std::mt19937 generator(static_cast<unsigned int>(index));
+    std::uniform_real_distribution<double> position(-100.0, 100.0);
+    std::uniform_real_distribution<double> size(0.5, 9.0);
+    if (index % 3 == 0)
+    {
+      return std::make_shared<klimchuk::Circle>(position(generator), position(generator), size(generator));
+    }
+    return std::make_shared<klimchuk::Rectangle>(size(generator), size(generator), position(generator),
+      position(generator));
+  }
+
+  klimchuk::CompositeShape makeScene(const std::vector<size_t>& indexes)
+  {
+    klimchuk::CompositeShape scene(makeShape(indexes.front()));
+    for (size_t i = 1; i < indexes.size(); ++i)
+    {
+      scene.add(makeShape(indexes[i]));
+    }
+    return scene;
+  }
+
+  std::vector<size_t> getIndexes(size_t beginning, size_t end)
+  {
+    std::vector<size_t> indexes;
+    for (size_t i = beginning; i < end; ++i)
+    {
+      indexes.push_back(i);
+    }
+    return indexes;
+  }
+
+  size_t count(const std::vector<klimchuk::scene_change_t>& changes, klimchuk::scene_change_t::Type type)
+  {
+    return std::count_if(changes.begin(), changes.end(), [type](const klimchuk::scene_change_t& change)
+    {
+      return change.type == type;
+    });
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(Scene_hash)
+
+BOOST_AUTO_TEST_CASE(Shape_hash_depends_on_geometry)
+{
+  const klimchuk::point_t points[4] = { { 0.0, 0.0 }, { 2.0, 0.0 }, { 2.0, 1.0 }, { 0.0, 1.0 } };
+  BOOST_CHECK_EQUAL(klimchuk::Circle(1.0, 2.0, 3.0).getHash(), klimchuk::Circle(1.0, 2.0, 3.0).getHash());
+  BOOST_CHECK_EQUAL(klimchuk::Circle(0.0, 2.0, 3.0).getHash(), klimchuk::Circle(-0.0, 2.0, 3.0).getHash());
+  BOOST_CHECK_NE(klimchuk::Circle(1.0, 2.0, 3.0).getHash(), klimchuk::Circle(2.0, 1.0, 3.0).getHash());
+  BOOST_CHECK_EQUAL(klimchuk::Rectangle(2.0, 1.0, 1.0, 0.5).getHash(),
+    klimchuk::Rectangle(2.0, 1.0, 1.0, 0.5).getHash());
+  BOOST_CHECK_EQUAL(klimchuk::Triangle({ 0.0, 0.0 }, { 2.0, 0.0 }, { 0.0, 1.0 }).getHash(),
+    klimchuk::Triangle({ 0.0, 0.0 }, { 2.0, 0.0 }, { 0.0, 1.0 }).getHash());
+  BOOST_CHECK_EQUAL(klimchuk::Polygon(points, 4).getHash(), klimchuk::Polygon(points, 4).getHash());
+  BOOST_CHECK_NE(klimchuk::Polygon(points, 4).getHash(), klimchuk::Rectangle(2.0, 1.0, 1.0, 0.5).getHash());
+
+  klimchuk::Rectangle rectangle(2.0, 1.0, 1.0, 0.5);
+  const uint64_t hash = rectangle.getHash();
+  rectangle.move(1.0, 0.0);
+  BOOST_CHECK_NE(rectangle.getHash(), hash);
+  rectangle.move(-1.0, 0.0);
+  BOOST_CHECK_EQUAL(rectangle.getHash(), hash);
+}
+
+BOOST_AUTO_TEST_CASE(CompositeShape_hash_follows_children)
+{
+  klimchuk::CompositeShape scene = makeScene(getIndexes(0, 10));
+  const uint64_t hash = scene.getHash();
+  BOOST_CHECK_EQUAL(makeScene(getIndexes(0, 10)).getHash(), hash);
+  scene[3]->move(1.0, 0.0);
+  BOOST_CHECK_NE(scene.getHash(), hash);
+  scene[3]->move(-1.0, 0.0);
+  BOOST_CHECK_EQUAL(scene.getHash(), hash);
+  scene.move(5.0, 5.0);
+  BOOST_CHECK_NE(scene.getHash(), hash);
+  scene.move(-5.0, -5.0);
+  scene.remove(9);
+  BOOST_CHECK_EQUAL(scene.getHash(), makeScene(getIndexes(0, 9)).getHash());
+  scene.add(makeShape(9));
+  BOOST_CHECK_EQUAL(scene.getHash(), hash);
+
+  std::vector<size_t> reversed = getIndexes(0, 10);
+  std::reverse(reversed.begin(), reversed.end());
+  BOOST_CHECK_NE(makeScene(reversed).getHash(), hash);
+}
+
+BOOST_AUTO_TEST_CASE(CompositeShape_hash_follows_children_of_copied_and_moved_composites)
+{
+  klimchuk::Shape::ShapePtr shape = makeShape(3);
+  std::shared_ptr<klimchuk::CompositeShape> group = std::make_shared<klimchuk::CompositeShape>(shape);
+  klimchuk::CompositeShape scene(group);
+  scene.add(makeShape(4));
+  std::unique_ptr<klimchuk::CompositeShape> copiedScene = std::make_unique<klimchuk::CompositeShape>(scene);
+  klimchuk::CompositeShape movedScene(std::move(scene));
+  const uint64_t hash = movedScene.getHash();
+  BOOST_CHECK_EQUAL(copiedScene->getHash(), hash);
+
+  shape->move(1.0, 0.0);
+  BOOST_CHECK_NE(movedScene.getHash(), hash);
+  BOOST_CHECK_EQUAL(copiedScene->getHash(), movedScene.getHash());
+  copiedScene.reset();
+  shape->move(-1.0, 0.0);
+  BOOST_CHECK_EQUAL(movedScene.getHash(), hash);
+
+  group->add(makeShape(5));
+  const uint64_t groupHash = movedScene.getHash();
+  group->remove(0);
+  BOOST_CHECK_NE(movedScene.getHash(), groupHash);
+  const uint64_t removedHash = movedScene.getHash();
+  shape->move(1.0, 0.0);
+  BOOST_CHECK_EQUAL(movedScene.getHash(), removedHash);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(Scene_diff)
+
+BOOST_AUTO_TEST_CASE(Scene_diff_of_equal_scenes_is_empty)
+{
+  const klimchuk::CompositeShape scene = makeScene(getIndexes(0, 100));
+  BOOST_CHECK(klimchuk::diffScenes(scene, scene).empty());
+  BOOST_CHECK(klimchuk::diffScenes(scene, makeScene(getIndexes(0, 100))).empty());
+}
+
+BOOST_AUTO_TEST_CASE(Scene_diff_finds_added_removed_and_moved_children)
+{
+  std::vector<size_t> newIndexes = getIndexes(0, 10);
+  for (size_t i = 11; i < 50; ++i)
+  {
+    newIndexes.push_back(i);
+  }
+  newIndexes.push_back(70);
+  for (size_t i = 50; i < 100; ++i)
+  {
+    if (i != 70)
+    {
+      newIndexes.push_back(i);
+    }
+  }
+  newIndexes.push_back(1000);
+  const klimchuk::CompositeShape oldScene = makeScene(getIndexes(0, 100));
+  const klimchuk::CompositeShape newScene = makeScene(newIndexes);
+  const std::vector<klimchuk::scene_change_t> changes = klimchuk::diffScenes(oldScene, newScene);
+  BOOST_REQUIRE_EQUAL(changes.size(), 3);
+  for (const klimchuk::scene_change_t& change : changes)
+  {
+    BOOST_CHECK_EQUAL(change.oldParent, &oldScene);
+    BOOST_CHECK_EQUAL(change.newParent, &newScene);
+    switch (change.type)
+    {
+    case klimchuk::scene_change_t::Type::REMOVED:
+      BOOST_CHECK_EQUAL(change.oldIndex, 10);
+      BOOST_CHECK_EQUAL(change.newIndex, klimchuk::scene_change_t::NO_INDEX);
+      BOOST_CHECK_EQUAL(change.shape, oldScene[10]);
+      break;
+    case klimchuk::scene_change_t::Type::ADDED:
+      BOOST_CHECK_EQUAL(change.oldIndex, klimchuk::scene_change_t::NO_INDEX);
+      BOOST_CHECK_EQUAL(change.newIndex, 99);
+      BOOST_CHECK_EQUAL(change.shape, newScene[99]);
+      break;
+    case klimchuk::scene_change_t::Type::MOVED:
+      BOOST_CHECK_EQUAL(change.oldIndex, 70);
+      BOOST_CHECK_EQUAL(change.newIndex, 49);
+      BOOST_CHECK_EQUAL(change.shape, newScene[49]);
+      break;
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Scene_diff_descends_into_changed_composites)
+{
+  klimchuk::CompositeShape oldScene = makeScene(getIndexes(0, 20));
+  klimchuk::CompositeShape newScene = makeScene(getIndexes(0, 20));
+  std::shared_ptr<klimchuk::CompositeShape> oldGroup = std::make_shared<klimchuk::CompositeShape>(
+    makeScene(getIndexes(100, 150)));
+  std::shared_ptr<klimchuk::CompositeShape> newGroup = std::make_shared<klimchuk::CompositeShape>(
+    makeScene(getIndexes(100, 150)));
+  oldScene.add(oldGroup);
+  newScene.add(newGroup);
+  oldScene.add(makeShape(20));
+  newScene.add(makeShape(20));
+  BOOST_CHECK(klimchuk::diffScenes(oldScene, newScene).empty());
+
+  (*std::dynamic_pointer_cast<klimchuk::CompositeShape>(newScene[20]))[7]->move(0.5, 0.5);
+  const std::vector<klimchuk::scene_change_t> changes = klimchuk::diffScenes(oldScene, newScene);
+  BOOST_REQUIRE_EQUAL(changes.size(), 2);
+  BOOST_CHECK_EQUAL(count(changes, klimchuk::scene_change_t::Type::REMOVED), 1);
+  BOOST_CHECK_EQUAL(count(changes, klimchuk::scene_change_t::Type::ADDED), 1);
+  for (const klimchuk::scene_change_t& change : changes)
+  {
+    BOOST_CHECK_EQUAL(change.oldParent, oldGroup.get());
+    BOOST_CHECK_EQUAL(change.newParent, newGroup.get());
+    BOOST_CHECK_EQUAL((change.type == klimchuk::scene_change_t::Type::REMOVED) ? change.oldIndex : change.newIndex, 7);
+  }
+
+  newScene.remove(0);
+  BOOST_CHECK_EQUAL(klimchuk::diffScenes(oldScene, newScene).size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(Scene_diff_sees_edits_through_held_nested_composites)
+{
+  const klimchuk::CompositeShape oldScene = makeScene(getIndexes(0, 10));
+  klimchuk::CompositeShape newScene = makeScene(getIndexes(0, 10));
+  std::shared_ptr<klimchuk::CompositeShape> inner = std::make_shared<klimchuk::CompositeShape>(
+    makeScene(getIndexes(100, 110)));
+  std::shared_ptr<klimchuk::CompositeShape> group = std::make_shared<klimchuk::CompositeShape>(inner);
+  newScene.add(group);
+  const klimchuk::CompositeShape copiedScene = newScene;
+  const uint64_t hash = newScene.getHash();
+  const klimchuk::rectangle_t frame = newScene.getHullFrameRect();
+
+  inner->add(makeShape(110));
+  inner->move(3.0, 0.0);
+  BOOST_CHECK_NE(newScene.getHash(), hash);
+  BOOST_CHECK_EQUAL(copiedScene.getHash(), newScene.getHash());
+  klimchuk::CompositeShape expectedGroup = makeScene(getIndexes(100, 111));
+  expectedGroup.move(3.0, 0.0);
+  klimchuk::CompositeShape expectedScene = makeScene(getIndexes(0, 10));
+  expectedScene.add(std::make_shared<klimchuk::CompositeShape>(std::make_shared<klimchuk::CompositeShape>(
+    expectedGroup)));
+  BOOST_CHECK_EQUAL(newScene.getHash(), expectedScene.getHash());
+  BOOST_CHECK(newScene.getHullFrameRect().width != frame.width);
+  BOOST_CHECK_CLOSE(newScene.getHullFrameRect().width, expectedScene.getHullFrameRect().width, EPSILON);
+
+  const std::vector<klimchuk::scene_change_t> changes = klimchuk::diffScenes(oldScene, newScene);
+  BOOST_REQUIRE_EQUAL(changes.size(), 1);
+  BOOST_CHECK(changes[0].type == klimchuk::scene_change_t::Type::ADDED);
+  BOOST_CHECK_EQUAL(changes[0].shape, group);
+  const std::vector<klimchuk::scene_change_t> nestedChanges = klimchuk::diffScenes(expectedScene, newScene);
+  BOOST_CHECK(nestedChanges.empty());
+  (*inner)[4]->move(0.0, 1.0);
+  BOOST_CHECK_EQUAL(klimchuk::diffScenes(expectedScene, newScene).size(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
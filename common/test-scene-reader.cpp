@@ -0,0 +1,115 @@
+#include <stdexcept>
+#include <sstream>
+#include <string>
+#include <cmath>
+#include "boost/test/unit_test.hpp"
+#include "scene-reader.hpp"
+#include "circle.hpp"
+#include "rectangle.hpp"
+#include "polygon.hpp"
+
+const double EPSILON = 0.000001;
+
+namespace
+{
+  std::string getError(const std::string& text)
+  {
+    std::istringstream stream(text);
+    klimchuk::SceneReader reader(stream);
+    try
+    {
+      while (reader.next())
+      {}
+    }
+    catch (const std::runtime_error& error)
+    {
+      return error.what();
+    }
+    return "";
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(SceneReader_parsing)
+
+BOOST_AUTO_TEST_CASE(SceneReader_reads_all_kinds)
+{
+  std::istringstream stream("# scene\n"
+    "circle 1 2 3\n"
+    "\n"
+    "  rectangle 4 2 0 0 90\r\n"
+    "triangle 0 0 2 0 0 2\n"
+    "polygon 0 0 4 0 4 4 2 1 0 4");
+  klimchuk::CompositeShape compositeShape = klimchuk::readScene(stream);
+  BOOST_REQUIRE_EQUAL(compositeShape.getSize(), 4);
+  BOOST_CHECK_CLOSE(compositeShape[0]->getArea(), M_PI * 9.0, EPSILON);
+  BOOST_CHECK_CLOSE(compositeShape[1]->getFrameRect().width, 2.0, EPSILON);
+  BOOST_CHECK_CLOSE(compositeShape[1]->getFrameRect().height, 4.0, EPSILON);
+  BOOST_CHECK_CLOSE(compositeShape[2]->getArea(), 2.0, EPSILON);
+  BOOST_CHECK_CLOSE(compositeShape[3]->getArea(), 10.0, EPSILON);
+}
+
+BOOST_AUTO_TEST_CASE(SceneReader_reads_long_lines_with_small_buffer)
+{
+  std::ostringstream text;
+  const size_t numberOfVertices = 1000;
+  for (size_t line = 0; line < 3; ++line)
+  {
+    text << "polygon";
+    for (size_t i = 0; i < numberOfVertices; ++i)
+    {
+      const double angle = 2 * M_PI * i / numberOfVertices;
+      text << ' ' << 10.0 * std::cos(angle) << ' ' << 10.0 * std::sin(angle);
+    }
+    text << "\ncircle 0.5 -0.25 1e-1\n";
+  }
+  std::istringstream stream(text.str());
+  klimchuk::SceneReader reader(stream, 16, 1 << 20);
+  size_t numberOfShapes = 0;
+  while (klimchuk::Shape::ShapePtr shape = reader.next())
+  {
+    if (numberOfShapes % 2 == 0)
+    {
+      BOOST_REQUIRE_EQUAL(std::dynamic_pointer_cast<klimchuk::Polygon>(shape)->getSize(), numberOfVertices);
+    }
+    else
+    {
+      BOOST_CHECK_CLOSE(std::dynamic_pointer_cast<klimchuk::Circle>(shape)->getRadius(), 0.1, EPSILON);
+    }
+    ++numberOfShapes;
+  }
+  BOOST_CHECK_EQUAL(numberOfShapes, 6);
+  BOOST_CHECK_EQUAL(reader.getLineNumber(), 6);
+
+  std::istringstream longLine(text.str());
+  klimchuk::SceneReader limited(longLine, 16, 1024);
+  BOOST_CHECK_THROW(limited.next(), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(SceneReader_reports_lines_of_errors)
+{
+  BOOST_CHECK_EQUAL(getError("circle 1 2 3\ncircle 1 2 -3\n"),
+    "SceneReader: Line 2: Circle: Radius can't be less than a zero.");
+  BOOST_CHECK_EQUAL(getError("circle 1 2 3\n\nrectangle 1 2 x 4\n"), "SceneReader: Line 3: Invalid number.");
+  BOOST_CHECK_EQUAL(getError("circle 1 2 nan\n"), "SceneReader: Line 1: Invalid number.");
+  BOOST_CHECK_EQUAL(getError("triangle 0 0 1 1 2 2\n"), "SceneReader: Line 1: Triangle: Wrong value of coordinates.");
+  BOOST_CHECK_EQUAL(getError("polygon 0 0 1 1\n"),
+    "SceneReader: Line 1: Polygon: Invalid initializer list to construct object.");
+  BOOST_CHECK_EQUAL(getError("hexagon 1 2\n"), "SceneReader: Line 1: Unknown kind of shape.");
+  BOOST_CHECK_EQUAL(getError("circle 1 2\n"), "SceneReader: Line 1: Circle needs centre and radius.");
+  BOOST_CHECK_EQUAL(getError("circle 1 2 3\n# comment\n"), "");
+
+  std::istringstream empty("# nothing\n");
+  BOOST_CHECK_THROW(klimchuk::readScene(empty), std::runtime_error);
+  BOOST_CHECK_THROW(klimchuk::SceneReader(empty, 0), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(SceneReader_feeds_matrix)
+{
+  std::istringstream stream("rectangle 2 2 0 0\nrectangle 2 2 1 0\nrectangle 2 2 10 0\n");
+  klimchuk::Matrix matrix;
+  klimchuk::readScene(stream, matrix);
+  BOOST_CHECK_EQUAL(matrix.getSizeOfMatrix(), 3);
+  BOOST_CHECK_EQUAL(matrix.getNumberOFLayers(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,69 @@
+#ifndef KLIMCHUK_TEST_SCENES
+#define KLIMCHUK_TEST_SCENES
+
+#include <map>
+#include <random>
+#include <string>
+#include <stdexcept>
+#include "composite-shape.hpp"
+#include "matrix.hpp"
+#include "circle.hpp"
+#include "rectangle.hpp"
+#include "triangle.hpp"
+
+namespace klimchuk
+{
+  namespace test
+  {
+    typedef std::map<Shape::ShapePtr, size_t> layers_t;
+
+    inline layers_t getLayers(Matrix& matrix)
+    {
+      layers_t layers;
+      for (size_t i = 0; i < matrix.getNumberOFLayers(); ++i)
+      {
+        for (size_t j = 0; j < matrix.getSizeOfLayer(i); ++j)
+        {
+          layers[matrix[i][j]] = i;
+        }
+      }
+      return layers;
+    }
+
+    inline CompositeShape makeScene(const Shape::ShapePtr& firstShape, size_t numberOfShapes, unsigned int seed,
+      double extent, double maxSize, const std::string& kinds = "R", double rotationStep = 0.0)
+    {
+      std::mt19937 generator(seed);
+      std::uniform_real_distribution<double> position(-extent, extent);
+      std::uniform_real_distribution<double> size(0.5, maxSize);
+      CompositeShape scene(firstShape);
+      for (size_t i = 1; i < numberOfShapes; ++i)
+      {
+        const double x = position(generator);
+        const double y = position(generator);
+        switch (kinds[i % kinds.size()])
+        {
+        case 'C':
+          scene.add(std::make_shared<Circle>(x, y, size(generator) / 2));
+          break;
+        case 'R':
+          scene.add(std::make_shared<Rectangle>(size(generator), size(generator), x, y));
+          if (rotationStep != 0.0)
+          {
+            scene[i]->rotate(rotationStep * i);
+          }
+          break;
+        case 'T':
+          scene.add(std::make_shared<Triangle>(point_t{ x, y }, point_t{ x + size(generator), y },
+            point_t{ x, y + size(generator) }));
+          break;
+        default:
+          throw std::invalid_argument("makeScene: Unknown kind of shape.");
+        }
+      }
+      return scene;
+    }
+  }
+}
+
+#endif
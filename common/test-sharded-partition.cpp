@@ -0,0 +1,51 @@
+#include <stdexcept>
+#include "boost/test/unit_test.hpp"
+#include "test-scenes.hpp"
+#include "sharded-partition.hpp"
+#include "partition.hpp"
+#include "rectangle.hpp"
+
+namespace
+{
+  using klimchuk::test::getLayers;
+
+  klimchuk::CompositeShape makeScene(size_t numberOfShapes, unsigned int seed)
+  {
+    return klimchuk::test::makeScene(std::make_shared<klimchuk::Rectangle>(90.0, 2.0, 0.0, 0.0),
+      numberOfShapes, seed, 50.0, 8.0, "CRR", 7.0);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(Sharded_partition)
+
+BOOST_AUTO_TEST_CASE(Sharded_partition_matches_partition)
+{
+  klimchuk::CompositeShape scene = makeScene(600, 21);
+  for (klimchuk::Matrix::Mode mode : { klimchuk::Matrix::Mode::FIRST_FIT, klimchuk::Matrix::Mode::MINIMUM_LAYERS })
+  {
+    for (klimchuk::Matrix::Filter filter : { klimchuk::Matrix::Filter::FRAME, klimchuk::Matrix::Filter::ORIENTED_FRAME })
+    {
+      klimchuk::Matrix expected = klimchuk::partition(scene, mode, filter);
+      for (size_t numberOfProcesses : { 1, 3, 8 })
+      {
+        klimchuk::Matrix matrix = klimchuk::partitionInProcesses(scene, numberOfProcesses, mode, filter);
+        BOOST_CHECK(matrix.getMode() == mode);
+        BOOST_CHECK(matrix.getFilter() == filter);
+        BOOST_CHECK_EQUAL(matrix.getNumberOFLayers(), expected.getNumberOFLayers());
+        BOOST_CHECK(getLayers(matrix) == getLayers(expected));
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Sharded_partition_handles_more_processes_than_shapes)
+{
+  klimchuk::CompositeShape scene(std::make_shared<klimchuk::Rectangle>(2.0, 2.0, 0.0, 0.0));
+  scene.add(std::make_shared<klimchuk::Rectangle>(2.0, 2.0, 1.0, 0.0));
+  scene.add(std::make_shared<klimchuk::Rectangle>(2.0, 2.0, 1.0, 0.0));
+  klimchuk::Matrix matrix = klimchuk::partitionInProcesses(scene, 5, klimchuk::Matrix::Mode::MINIMUM_LAYERS);
+  BOOST_CHECK_EQUAL(matrix.getNumberOFLayers(), 3);
+  BOOST_CHECK_THROW(klimchuk::partitionInProcesses(scene, 0), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
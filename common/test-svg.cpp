@@ -0,0 +1,271 @@
+#include <stdexcept>
+#include <sstream>
+#include <string>
+#include <cmath>
+#include "boost/test/unit_test.hpp"
+#include "svg.hpp"
+#include "circle.hpp"
+#include "rectangle.hpp"
+#include "triangle.hpp"
+#include "polygon.hpp"
+
+const double EPSILON = 0.000001;
+
+namespace
+{
+  klimchuk::CompositeShape readSvg(const std::string& text, size_t sizeOfBuffer = 65536)
+  {
+    std::istringstream stream(text);
+    return klimchuk::readSvg(stream, sizeOfBuffer);
+  }
+
+  std::string getError(const std::string& text)
+  {
+    try
+    {
+      readSvg(text);
+    }
+    catch (const std::runtime_error& error)
+    {
+      return error.what();
+    }
+    return "";
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(Svg_reading)
+
+BOOST_AUTO_TEST_CASE(Svg_reads_all_kinds)
+{
+  klimchuk::CompositeShape compositeShape = readSvg("<?xml version=\"1.0\"?>\n"
+    "<!DOCTYPE svg>\n"
+    "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"100\" height=\"100\">\n"
+    "  <rect x=\"1\" y=\"2\" width=\"4px\" height=\"2\" fill=\"red\"/>\n"
+    "  <circle cx='1' cy='2' r='+3'></circle>\n"
+    "  <polygon points=\"0,0 2,0 0,2\"/>\n"
+    "  <polygon points=\"0 0, 4 0, 4 4, 2 1, 0 4\"/>\n"
+    "</svg>\n");
+  BOOST_REQUIRE_EQUAL(compositeShape.getSize(), 4);
+  const klimchuk::Rectangle* rectangle = dynamic_cast<const klimchuk::Rectangle*>(compositeShape[0].get());
+  BOOST_REQUIRE(rectangle);
+  BOOST_CHECK_CLOSE(rectangle->getCentre().x, 3.0, EPSILON);
+  BOOST_CHECK_CLOSE(rectangle->getCentre().y, 3.0, EPSILON);
+  BOOST_CHECK_CLOSE(rectangle->getArea(), 8.0, EPSILON);
+  BOOST_CHECK_CLOSE(compositeShape[1]->getArea(), M_PI * 9.0, EPSILON);
+  BOOST_CHECK(dynamic_cast<const klimchuk::Triangle*>(compositeShape[2].get()));
+  BOOST_CHECK_CLOSE(compositeShape[2]->getArea(), 2.0, EPSILON);
+  BOOST_CHECK(dynamic_cast<const klimchuk::Polygon*>(compositeShape[3].get()));
+  BOOST_CHECK_CLOSE(compositeShape[3]->getArea(), 10.0, EPSILON);
+}
+
+BOOST_AUTO_TEST_CASE(Svg_applies_nested_transforms)
+{
+  klimchuk::CompositeShape compositeShape = readSvg("<svg>"
+    "<g transform=\"translate(10, 20)\">"
+    "<g transform=\"rotate(90) scale(2)\">"
+    "<rect x=\"0\" y=\"0\" width=\"2\" height=\"1\"/>"
+    "<circle cx=\"1\" cy=\"0\" r=\"1\"/>"
+    "</g>"
+    "<polygon transform=\"matrix(1 0 0 2 0 0)\" points=\"0,0 1,0 1,1 0,1\"/>"
+    "</g>"
+    "<circle cx=\"0\" cy=\"0\" r=\"1\" transform=\"rotate(90 5 0)\"/>"
+    "</svg>");
+  BOOST_REQUIRE_EQUAL(compositeShape.getSize(), 2);
+  const klimchuk::CompositeShape* outer = dynamic_cast<const klimchuk::CompositeShape*>(compositeShape[0].get());
+  BOOST_REQUIRE(outer);
+  BOOST_REQUIRE_EQUAL(outer->getSize(), 2);
+  const klimchuk::CompositeShape* inner = dynamic_cast<const klimchuk::CompositeShape*>((*outer)[0].get());
+  BOOST_REQUIRE(inner);
+  BOOST_REQUIRE_EQUAL(inner->getSize(), 2);
+  const klimchuk::rectangle_t frame = (*inner)[0]->getFrameRect();
+  BOOST_CHECK_CLOSE(frame.width, 2.0, EPSILON);
+  BOOST_CHECK_CLOSE(frame.height, 4.0, EPSILON);
+  BOOST_CHECK_CLOSE(frame.pos.x, 9.0, EPSILON);
+  BOOST_CHECK_CLOSE(frame.pos.y, 22.0, EPSILON);
+  BOOST_CHECK_CLOSE((*inner)[1]->getCentre().x, 10.0, EPSILON);
+  BOOST_CHECK_CLOSE((*inner)[1]->getCentre().y, 22.0, EPSILON);
+  BOOST_CHECK_CLOSE((*inner)[1]->getArea(), M_PI * 4.0, EPSILON);
+  BOOST_CHECK_CLOSE((*outer)[1]->getArea(), 2.0, EPSILON);
+  BOOST_CHECK_CLOSE((*outer)[1]->getFrameRect().pos.y, 21.0, EPSILON);
+  BOOST_CHECK_CLOSE(compositeShape[1]->getCentre().x, 5.0, EPSILON);
+  BOOST_CHECK_CLOSE(compositeShape[1]->getCentre().y, -5.0, EPSILON);
+}
+
+BOOST_AUTO_TEST_CASE(Svg_applies_reflections_to_circles_and_rectangles)
+{
+  klimchuk::CompositeShape compositeShape = readSvg("<svg>"
+    "<rect x=\"0\" y=\"0\" width=\"4\" height=\"2\" transform=\"scale(1,-1)\"/>"
+    "<circle cx=\"1\" cy=\"2\" r=\"1\" transform=\"scale(-2,2)\"/>"
+    "<rect x=\"-2\" y=\"-1\" width=\"4\" height=\"2\" transform=\"matrix(0 1 1 0 0 0) rotate(30)\"/>"
+    "</svg>");
+  BOOST_REQUIRE_EQUAL(compositeShape.getSize(), 3);
+  const klimchuk::rectangle_t frame = compositeShape[0]->getFrameRect();
+  BOOST_CHECK_CLOSE(frame.width, 4.0, EPSILON);
+  BOOST_CHECK_CLOSE(frame.height, 2.0, EPSILON);
+  BOOST_CHECK_CLOSE(frame.pos.x, 2.0, EPSILON);
+  BOOST_CHECK_CLOSE(frame.pos.y, -1.0, EPSILON);
+  BOOST_CHECK_CLOSE(compositeShape[1]->getCentre().x, -2.0, EPSILON);
+  BOOST_CHECK_CLOSE(compositeShape[1]->getCentre().y, 4.0, EPSILON);
+  BOOST_CHECK_CLOSE(compositeShape[1]->getArea(), M_PI * 4.0, EPSILON);
+  const klimchuk::oriented_rectangle_t rectangle = compositeShape[2]->getOrientedFrameRect();
+  BOOST_CHECK_CLOSE(rectangle.width, 4.0, EPSILON);
+  BOOST_CHECK_CLOSE(rectangle.height, 2.0, EPSILON);
+  BOOST_CHECK_CLOSE(std::abs(rectangle.axis.x), 0.5, EPSILON);
+  BOOST_CHECK_CLOSE(std::abs(rectangle.axis.y), std::sqrt(3.0) / 2, EPSILON);
+  BOOST_CHECK_GT(rectangle.axis.x * rectangle.axis.y, 0.0);
+  BOOST_CHECK(!getError("<svg><circle cx=\"0\" cy=\"0\" r=\"1\" transform=\"scale(1,2)\"/></svg>").empty());
+}
+
+BOOST_AUTO_TEST_CASE(Svg_reads_straight_paths)
+{
+  klimchuk::CompositeShape compositeShape = readSvg("<svg>"
+    "<path d=\"M0 0 H4 V4 L0 4 Z\"/>"
+    "<path d=\"m 10,10 2,0 0,2 z m 5 0 l 3 0 l 0 3 l -3 0 z\"/>"
+    "</svg>");
+  BOOST_REQUIRE_EQUAL(compositeShape.getSize(), 2);
+  BOOST_CHECK_CLOSE(compositeShape[0]->getArea(), 16.0, EPSILON);
+  const klimchuk::CompositeShape* subpaths = dynamic_cast<const klimchuk::CompositeShape*>(compositeShape[1].get());
+  BOOST_REQUIRE(subpaths);
+  BOOST_REQUIRE_EQUAL(subpaths->getSize(), 2);
+  BOOST_CHECK(dynamic_cast<const klimchuk::Triangle*>((*subpaths)[0].get()));
+  BOOST_CHECK_CLOSE((*subpaths)[0]->getArea(), 2.0, EPSILON);
+  BOOST_CHECK_CLOSE((*subpaths)[1]->getArea(), 9.0, EPSILON);
+  BOOST_CHECK_CLOSE((*subpaths)[1]->getFrameRect().pos.x, 16.5, EPSILON);
+}
+
+BOOST_AUTO_TEST_CASE(Svg_starts_subpath_after_closing_at_previous_start)
+{
+  klimchuk::CompositeShape compositeShape = readSvg("<svg>"
+    "<path d=\"M0 0 L4 0 L4 4 Z L0 4 L-4 4 Z\"/>"
+    "<path d=\"M10 0 h4 v4 z v-4 h-4 z\"/>"
+    "</svg>");
+  BOOST_REQUIRE_EQUAL(compositeShape.getSize(), 2);
+  for (size_t i = 0; i < 2; ++i)
+  {
+    const klimchuk::CompositeShape* subpaths = dynamic_cast<const klimchuk::CompositeShape*>(compositeShape[i].get());
+    BOOST_REQUIRE(subpaths);
+    BOOST_REQUIRE_EQUAL(subpaths->getSize(), 2);
+    BOOST_CHECK_CLOSE((*subpaths)[0]->getArea(), 8.0, EPSILON);
+    BOOST_CHECK_CLOSE((*subpaths)[1]->getArea(), 8.0, EPSILON);
+  }
+  const klimchuk::CompositeShape* subpaths = dynamic_cast<const klimchuk::CompositeShape*>(compositeShape[0].get());
+  const klimchuk::Triangle* triangle = dynamic_cast<const klimchuk::Triangle*>((*subpaths)[1].get());
+  BOOST_REQUIRE(triangle);
+  BOOST_CHECK_EQUAL((*triangle)[0].x, 0.0);
+  BOOST_CHECK_EQUAL((*triangle)[0].y, 0.0);
+  BOOST_CHECK_CLOSE((*triangle)[2].x, -4.0, EPSILON);
+}
+
+BOOST_AUTO_TEST_CASE(Svg_skips_subpaths_without_area)
+{
+  klimchuk::CompositeShape compositeShape = readSvg("<svg>"
+    "<path d=\"M 0 0 L 10 10\"/>"
+    "<circle cx=\"0\" cy=\"0\" r=\"1\"/>"
+    "<path d=\"M0 0 L1 1 L2 2 Z M5 5 Z M0 0 L4 0 L4 0 L4 4 L0 4 L0 0\"/>"
+    "<polygon points=\"0,0 3,3\"/>"
+    "</svg>");
+  BOOST_REQUIRE_EQUAL(compositeShape.getSize(), 2);
+  BOOST_CHECK_CLOSE(compositeShape[0]->getArea(), M_PI, EPSILON);
+  BOOST_CHECK(dynamic_cast<const klimchuk::Polygon*>(compositeShape[1].get()));
+  BOOST_CHECK_CLOSE(compositeShape[1]->getArea(), 16.0, EPSILON);
+  BOOST_CHECK_EQUAL(getError("<svg><path d=\"M 0 0 L 10 10\"/></svg>"), "readSvg: Image has no shapes.");
+}
+
+BOOST_AUTO_TEST_CASE(Svg_skips_comments_and_definitions)
+{
+  klimchuk::CompositeShape compositeShape = readSvg("<svg>"
+    "<!-- <circle cx=\"0\" cy=\"0\" r=\"1\"/> -->"
+    "<style><![CDATA[ svg > circle { fill: red; } ]]></style>"
+    "<defs><g><rect x=\"0\" y=\"0\" width=\"1\" height=\"1\"/></g></defs>"
+    "<text x=\"0\" y=\"0\">label &lt; 1</text>"
+    "<circle cx=\"0\" cy=\"0\" r=\"2\" title='a > b'/>"
+    "</svg>", 16);
+  BOOST_REQUIRE_EQUAL(compositeShape.getSize(), 1);
+  BOOST_CHECK_CLOSE(compositeShape[0]->getArea(), M_PI * 4.0, EPSILON);
+}
+
+BOOST_AUTO_TEST_CASE(Svg_reads_long_tags_with_small_buffer)
+{
+  std::ostringstream text;
+  const size_t numberOfVertices = 1000;
+  text << "<svg>\n<polygon points=\"";
+  for (size_t i = 0; i < numberOfVertices; ++i)
+  {
+    const double angle = 2 * M_PI * i / numberOfVertices;
+    text << ' ' << 10.0 * std::cos(angle) << ',' << 10.0 * std::sin(angle);
+  }
+  text << "\"/>\n</svg>\n";
+  klimchuk::CompositeShape compositeShape = readSvg(text.str(), 16);
+  BOOST_REQUIRE_EQUAL(compositeShape.getSize(), 1);
+  BOOST_CHECK_EQUAL(dynamic_cast<const klimchuk::Polygon*>(compositeShape[0].get())->getSize(), numberOfVertices);
+}
+
+BOOST_AUTO_TEST_CASE(Svg_reports_line_of_error)
+{
+  BOOST_CHECK_EQUAL(getError("<svg>\n\n<circle cx=\"0\" cy=\"0\" r=\"-1\"/>\n</svg>").find("readSvg: Line 3: "), 0);
+  BOOST_CHECK_EQUAL(getError("<svg>\n<path d=\"M0 0 C 1 1 2 2 3 3\"/>"),
+    "readSvg: Line 2: Only straight segments are supported in path.");
+  BOOST_CHECK_EQUAL(getError("<svg>\n<circle cx=\"a\" cy=\"0\" r=\"1\"/>"), "readSvg: Line 2: Invalid number.");
+  BOOST_CHECK_EQUAL(getError("<svg>\n<circle cx=\"1cm\" cy=\"0\" r=\"1\"/>"),
+    "readSvg: Line 2: Unsupported unit of length.");
+  BOOST_CHECK_EQUAL(getError("<svg>\n\n<rect width=\"1\" height=\"1\" transform=\"skewX(30)\"/>").find("readSvg: Line 3: "), 0);
+  BOOST_CHECK_EQUAL(getError("<svg>\n<circle cx=\"0\" cy=\"0\" r=\"1\""), "readSvg: Line 2: Tag is not closed.");
+  BOOST_CHECK_EQUAL(getError("<svg></svg>"), "readSvg: Image has no shapes.");
+}
+
+BOOST_AUTO_TEST_CASE(Svg_accepts_skew_for_polygons)
+{
+  klimchuk::CompositeShape compositeShape = readSvg("<svg>"
+    "<polygon transform=\"skewX(45)\" points=\"0,0 2,0 2,2 0,2\"/>"
+    "</svg>");
+  BOOST_CHECK_CLOSE(compositeShape[0]->getArea(), 4.0, EPSILON);
+  BOOST_CHECK_CLOSE(compositeShape[0]->getFrameRect().width, 4.0, EPSILON);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(Svg_writing)
+
+BOOST_AUTO_TEST_CASE(Svg_round_trips_composite_shape)
+{
+  klimchuk::CompositeShape compositeShape(std::make_shared<klimchuk::Circle>(1.0, 2.0, 3.0));
+  klimchuk::Shape::ShapePtr rectangle = std::make_shared<klimchuk::Rectangle>(4.0, 2.0, 5.0, -1.0);
+  rectangle->rotate(30.0);
+  compositeShape.add(rectangle);
+  klimchuk::CompositeShape nested(std::make_shared<klimchuk::Triangle>(klimchuk::point_t{ 0.0, 0.0 },
+    klimchuk::point_t{ 2.0, 0.0 }, klimchuk::point_t{ 0.0, 2.0 }));
+  nested.add(std::make_shared<klimchuk::Polygon>(std::initializer_list<klimchuk::point_t>{ { 0.0, 0.0 }, { 4.0, 0.0 },
+    { 4.0, 4.0 }, { 2.0, 1.0 }, { 0.0, 4.0 } }));
+  compositeShape.add(std::make_shared<klimchuk::CompositeShape>(nested));
+  std::ostringstream stream;
+  klimchuk::writeSvg(stream, compositeShape);
+  klimchuk::CompositeShape copy = readSvg(stream.str());
+  BOOST_REQUIRE_EQUAL(copy.getSize(), 3);
+  BOOST_CHECK_CLOSE(copy.getArea(), compositeShape.getArea(), EPSILON);
+  const klimchuk::oriented_rectangle_t frame = dynamic_cast<const klimchuk::Rectangle*>(copy[1].get())
+      ->getOrientedFrameRect();
+  BOOST_CHECK_CLOSE(frame.pos.x, 5.0, EPSILON);
+  BOOST_CHECK_CLOSE(frame.pos.y, -1.0, EPSILON);
+  BOOST_CHECK_CLOSE(std::atan2(frame.axis.y, frame.axis.x) * 180 / M_PI, 30.0, EPSILON);
+  const klimchuk::CompositeShape* copyOfNested = dynamic_cast<const klimchuk::CompositeShape*>(copy[2].get());
+  BOOST_REQUIRE(copyOfNested);
+  BOOST_CHECK_EQUAL(copyOfNested->getSize(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(Svg_writes_layers_of_matrix)
+{
+  klimchuk::Matrix matrix;
+  matrix.add(std::make_shared<klimchuk::Circle>(0.0, 0.0, 1.0));
+  matrix.add(std::make_shared<klimchuk::Circle>(0.5, 0.0, 1.0));
+  matrix.add(std::make_shared<klimchuk::Circle>(5.0, 0.0, 1.0));
+  std::ostringstream stream;
+  klimchuk::writeSvg(stream, matrix);
+  const std::string text = stream.str();
+  BOOST_CHECK(text.find("<g id=\"layer-0\">") != std::string::npos);
+  BOOST_CHECK(text.find("<g id=\"layer-1\">") != std::string::npos);
+  klimchuk::CompositeShape copy = readSvg(text);
+  BOOST_REQUIRE_EQUAL(copy.getSize(), matrix.getNumberOFLayers());
+  BOOST_CHECK_CLOSE(copy.getArea(), 3 * M_PI, EPSILON);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
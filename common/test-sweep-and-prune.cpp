@@ -0,0 +1,141 @@
+#include <stdexcept>
+#include <random>
+#include "boost/test/unit_test.hpp"
+#include "sweep-and-prune.hpp"
+#include "circle.hpp"
+#include "rectangle.hpp"
+#include "triangle.hpp"
+
+BOOST_AUTO_TEST_SUITE(SweepAndPrune_adding)
+
+BOOST_AUTO_TEST_CASE(SweepAndPrune_adding_invalid_shape)
+{
+  klimchuk::SweepAndPrune sweepAndPrune;
+  BOOST_CHECK_THROW(sweepAndPrune.add(nullptr), std::invalid_argument);
+  BOOST_CHECK_THROW(sweepAndPrune[0], std::out_of_range);
+  BOOST_CHECK_THROW(sweepAndPrune.update(0), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(SweepAndPrune_adding_reports_started_overlaps)
+{
+  klimchuk::SweepAndPrune sweepAndPrune;
+  sweepAndPrune.add(std::make_shared<klimchuk::Circle>(2.0, 2.0, 2.0));
+  sweepAndPrune.add(std::make_shared<klimchuk::Rectangle>(10.0, 6.0, 1.0, 3.0));
+  sweepAndPrune.add(std::make_shared<klimchuk::Triangle>(klimchuk::point_t{ -5.0, 1.0 },
+    klimchuk::point_t{ -2.0, 3.0 }, klimchuk::point_t{ -2.0, -2.0 }));
+  BOOST_CHECK_EQUAL(sweepAndPrune.getSize(), 3);
+  BOOST_CHECK_EQUAL(sweepAndPrune.getNumberOfOverlaps(), 2);
+  BOOST_CHECK(sweepAndPrune.areOverlapping(0, 1));
+  BOOST_CHECK(sweepAndPrune.areOverlapping(2, 1));
+  BOOST_CHECK(!sweepAndPrune.areOverlapping(0, 2));
+  BOOST_CHECK_EQUAL(sweepAndPrune.getStartedOverlaps().size(), 2);
+  BOOST_CHECK(sweepAndPrune.getStoppedOverlaps().empty());
+}
+
+BOOST_AUTO_TEST_CASE(SweepAndPrune_touching_frames_overlap)
+{
+  klimchuk::SweepAndPrune sweepAndPrune;
+  sweepAndPrune.add(std::make_shared<klimchuk::Rectangle>(2.0, 2.0, 0.0, 0.0));
+  sweepAndPrune.add(std::make_shared<klimchuk::Rectangle>(2.0, 2.0, 2.0, 0.0));
+  BOOST_CHECK(sweepAndPrune.areOverlapping(0, 1));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(SweepAndPrune_updating)
+
+BOOST_AUTO_TEST_CASE(SweepAndPrune_reports_only_changed_pairs)
+{
+  std::shared_ptr<klimchuk::Circle> first = std::make_shared<klimchuk::Circle>(0.0, 0.0, 1.0);
+  std::shared_ptr<klimchuk::Circle> second = std::make_shared<klimchuk::Circle>(5.0, 0.0, 1.0);
+  std::shared_ptr<klimchuk::Circle> third = std::make_shared<klimchuk::Circle>(0.0, 1.5, 1.0);
+  klimchuk::SweepAndPrune sweepAndPrune;
+  sweepAndPrune.add(first);
+  sweepAndPrune.add(second);
+  sweepAndPrune.add(third);
+  sweepAndPrune.clearChanges();
+
+  second->move(-4.0, 0.0);
+  sweepAndPrune.update(1);
+  BOOST_REQUIRE_EQUAL(sweepAndPrune.getStartedOverlaps().size(), 2);
+  BOOST_CHECK(sweepAndPrune.getStartedOverlaps()[0] == klimchuk::SweepAndPrune::IndexPair(0, 1));
+  BOOST_CHECK(sweepAndPrune.getStartedOverlaps()[1] == klimchuk::SweepAndPrune::IndexPair(1, 2));
+  BOOST_CHECK(sweepAndPrune.getStoppedOverlaps().empty());
+  sweepAndPrune.clearChanges();
+
+  third->move(0.0, 10.0);
+  third->scale(0.5);
+  sweepAndPrune.update(2);
+  BOOST_CHECK(sweepAndPrune.getStartedOverlaps().empty());
+  BOOST_REQUIRE_EQUAL(sweepAndPrune.getStoppedOverlaps().size(), 2);
+  BOOST_CHECK(sweepAndPrune.getStoppedOverlaps()[0] == klimchuk::SweepAndPrune::IndexPair(0, 2));
+  BOOST_CHECK(sweepAndPrune.getStoppedOverlaps()[1] == klimchuk::SweepAndPrune::IndexPair(1, 2));
+}
+
+BOOST_AUTO_TEST_CASE(SweepAndPrune_pair_moving_away_and_back_is_not_reported)
+{
+  std::shared_ptr<klimchuk::Rectangle> rectangle = std::make_shared<klimchuk::Rectangle>(2.0, 2.0, 0.0, 0.0);
+  klimchuk::SweepAndPrune sweepAndPrune;
+  sweepAndPrune.add(rectangle);
+  sweepAndPrune.add(std::make_shared<klimchuk::Rectangle>(2.0, 2.0, 1.0, 1.0));
+  sweepAndPrune.clearChanges();
+  rectangle->move(20.0, 0.0);
+  sweepAndPrune.update(0);
+  rectangle->move(-20.0, 0.0);
+  rectangle->rotate(30.0);
+  sweepAndPrune.update(0);
+  BOOST_CHECK(sweepAndPrune.areOverlapping(0, 1));
+  BOOST_CHECK(sweepAndPrune.getStartedOverlaps().empty());
+  BOOST_CHECK(sweepAndPrune.getStoppedOverlaps().empty());
+}
+
+BOOST_AUTO_TEST_CASE(SweepAndPrune_matches_brute_force_under_random_motion)
+{
+  std::mt19937 generator(7);
+  std::uniform_real_distribution<double> position(-50.0, 50.0);
+  std::uniform_real_distribution<double> step(-1.5, 1.5);
+  std::uniform_real_distribution<double> size(0.5, 4.0);
+  klimchuk::SweepAndPrune sweepAndPrune;
+  std::vector<klimchuk::Shape::ShapePtr> shapes;
+  for (size_t i = 0; i < 200; ++i)
+  {
+    shapes.push_back(std::make_shared<klimchuk::Rectangle>(size(generator), size(generator),
+      position(generator), position(generator)));
+    sweepAndPrune.add(shapes.back());
+  }
+  for (size_t frame = 0; frame < 20; ++frame)
+  {
+    for (size_t i = 0; i < shapes.size(); i += 3)
+    {
+      shapes[i]->move(step(generator), step(generator));
+      shapes[i]->rotate(step(generator) * 10.0);
+      sweepAndPrune.update(i);
+    }
+    if (frame % 2 == 1)
+    {
+      for (const klimchuk::Shape::ShapePtr& shape : shapes)
+      {
+        shape->move(step(generator), step(generator));
+      }
+      sweepAndPrune.update();
+    }
+    size_t numberOfOverlaps = 0;
+    for (size_t i = 0; i < shapes.size(); ++i)
+    {
+      for (size_t j = i + 1; j < shapes.size(); ++j)
+      {
+        klimchuk::rectangle_t first = shapes[i]->getFrameRect();
+        klimchuk::rectangle_t second = shapes[j]->getFrameRect();
+        bool isOverlapping = (first.pos.x + first.width / 2 >= second.pos.x - second.width / 2)
+          && (second.pos.x + second.width / 2 >= first.pos.x - first.width / 2)
+          && (first.pos.y + first.height / 2 >= second.pos.y - second.height / 2)
+          && (second.pos.y + second.height / 2 >= first.pos.y - first.height / 2);
+        BOOST_CHECK_EQUAL(sweepAndPrune.areOverlapping(i, j), isOverlapping);
+        numberOfOverlaps += isOverlapping ? 1 : 0;
+      }
+    }
+    BOOST_CHECK_EQUAL(sweepAndPrune.getNumberOfOverlaps(), numberOfOverlaps);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
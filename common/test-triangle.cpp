@@ -1,5 +1,6 @@
 #include <stdexcept>
 #include <algorithm>
+#include <cmath>
 #include "boost/test/unit_test.hpp"
 #include "triangle.hpp"
 
@@ -43,6 +44,13 @@ BOOST_AUTO_TEST_CASE(triangle_invalid_construct)
   BOOST_CHECK_THROW(klimchuk::Triangle triangle(b, c, c), std::invalid_argument);
 }
 
+BOOST_AUTO_TEST_CASE(triangle_nearly_degenerate_construct)
+{
+  BOOST_CHECK_THROW(klimchuk::Triangle({ 0.1, 0.1 }, { 0.3, 0.3 }, { 0.7, 0.7 }), std::invalid_argument);
+  BOOST_CHECK_NO_THROW(klimchuk::Triangle({ 0.0, 0.0 }, { 1.0, 1e-20 }, { 2.0, 0.0 }));
+  BOOST_CHECK_NO_THROW(klimchuk::Triangle({ 0.5, 0.5 + std::ldexp(1.0, -53) }, { 12.0, 12.0 }, { 24.0, 24.0 }));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE(triangle_area)
@@ -152,3 +160,16 @@ BOOST_AUTO_TEST_CASE(triangle_rotating_correctness)
 }
 
 BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(triangle_oriented_frame_rect)
+
+BOOST_AUTO_TEST_CASE(triangle_oriented_frame_rect_contains_tops)
+{
+  klimchuk::Triangle triangle({ 0.0, 0.0 }, { 4.0, 0.0 }, { 0.0, 3.0 });
+  triangle.rotate(37.0);
+  klimchuk::oriented_rectangle_t frame = triangle.getOrientedFrameRect();
+  BOOST_CHECK_CLOSE(frame.width * frame.height, 12.0, EPSILON);
+  BOOST_CHECK_LT(frame.width * frame.height, triangle.getFrameRect().width * triangle.getFrameRect().height);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,344 @@
+#include <stdexcept>
+#include <random>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <limits>
+#include "boost/test/unit_test.hpp"
+#include "union-area.hpp"
+#include "composite-shape.hpp"
+#include "circle.hpp"
+#include "rectangle.hpp"
+#include "triangle.hpp"
+#include "polygon.hpp"
+
+const double EPSILON = 0.000001;
+
+namespace
+{
+  double estimateUnionArea(klimchuk::CompositeShape& compositeShape, size_t resolution)
+  {
+    double minX = compositeShape[0]->getFrameRect().pos.x;
+    double maxX = minX;
+    double minY = compositeShape[0]->getFrameRect().pos.y;
+    double maxY = minY;
+    for (size_t k = 0; k < compositeShape.getSize(); ++k)
+    {
+      klimchuk::rectangle_t frame = compositeShape[k]->getFrameRect();
+      minX = std::min(minX, frame.pos.x - (frame.width / 2));
+      maxX = std::max(maxX, frame.pos.x + (frame.width / 2));
+      minY = std::min(minY, frame.pos.y - (frame.height / 2));
+      maxY = std::max(maxY, frame.pos.y + (frame.height / 2));
+    }
+    const klimchuk::rectangle_t frame{ maxX - minX, maxY - minY, { (minX + maxX) / 2, (minY + maxY) / 2 } };
+    const double stepX = frame.width / resolution;
+    const double stepY = frame.height / resolution;
+    size_t numberOfCovered = 0;
+    for (size_t i = 0; i < resolution; ++i)
+    {
+      for (size_t j = 0; j < resolution; ++j)
+      {
+        const klimchuk::point_t point{ frame.pos.x - (frame.width / 2) + ((i + 0.5) * stepX),
+          frame.pos.y - (frame.height / 2) + ((j + 0.5) * stepY) };
+        for (size_t k = 0; k < compositeShape.getSize(); ++k)
+        {
+          std::shared_ptr<klimchuk::Circle> circle = std::dynamic_pointer_cast<klimchuk::Circle>(compositeShape[k]);
+          bool isInside = false;
+          if (circle)
+          {
+            isInside = std::hypot(point.x - circle->getCentre().x, point.y - circle->getCentre().y) < circle->getRadius();
+          }
+          else
+          {
+            klimchuk::oriented_rectangle_t box = compositeShape[k]->getOrientedFrameRect();
+            const double u = ((point.x - box.pos.x) * box.axis.x) + ((point.y - box.pos.y) * box.axis.y);
+            const double v = ((point.y - box.pos.y) * box.axis.x) - ((point.x - box.pos.x) * box.axis.y);
+            isInside = (std::abs(u) < box.width / 2) && (std::abs(v) < box.height / 2);
+          }
+          if (isInside)
+          {
+            ++numberOfCovered;
+            break;
+          }
+        }
+      }
+    }
+    return numberOfCovered * stepX * stepY;
+  }
+
+  double getUnionAreaOfPolygons(const std::vector<std::vector<klimchuk::point_t>>& polygons)
+  {
+    std::vector<std::pair<klimchuk::point_t, klimchuk::point_t>> edges;
+    std::vector<double> lines;
+    for (const std::vector<klimchuk::point_t>& polygon : polygons)
+    {
+      for (size_t i = 0; i < polygon.size(); ++i)
+      {
+        edges.emplace_back(polygon[i], polygon[(i + 1) % polygon.size()]);
+        lines.push_back(polygon[i].x);
+      }
+    }
+    for (size_t i = 0; i < edges.size(); ++i)
+    {
+      for (size_t j = i + 1; j < edges.size(); ++j)
+      {
+        const klimchuk::point_t& a = edges[i].first;
+        const klimchuk::point_t& b = edges[i].second;
+        const klimchuk::point_t& c = edges[j].first;
+        const klimchuk::point_t& d = edges[j].second;
+        const double denominator = ((b.x - a.x) * (d.y - c.y)) - ((b.y - a.y) * (d.x - c.x));
+        if (denominator != 0.0)
+        {
+          const double t = (((c.x - a.x) * (d.y - c.y)) - ((c.y - a.y) * (d.x - c.x))) / denominator;
+          const double u = (((c.x - a.x) * (b.y - a.y)) - ((c.y - a.y) * (b.x - a.x))) / denominator;
+          if ((t > 0.0) && (t < 1.0) && (u > 0.0) && (u < 1.0))
+          {
+            lines.push_back(a.x + (t * (b.x - a.x)));
+          }
+        }
+      }
+    }
+    std::sort(lines.begin(), lines.end());
+    double area = 0.0;
+    for (size_t k = 0; k + 1 < lines.size(); ++k)
+    {
+      const double x = (lines[k] + lines[k + 1]) / 2;
+      std::vector<std::pair<double, double>> intervals;
+      for (const std::vector<klimchuk::point_t>& polygon : polygons)
+      {
+        std::vector<double> ordinates;
+        for (size_t i = 0; i < polygon.size(); ++i)
+        {
+          const klimchuk::point_t& a = polygon[i];
+          const klimchuk::point_t& b = polygon[(i + 1) % polygon.size()];
+          if ((a.x < x) != (b.x < x))
+          {
+            ordinates.push_back(a.y + ((x - a.x) * (b.y - a.y) / (b.x - a.x)));
+          }
+        }
+        std::sort(ordinates.begin(), ordinates.end());
+        for (size_t i = 0; i + 1 < ordinates.size(); i += 2)
+        {
+          intervals.emplace_back(ordinates[i], ordinates[i + 1]);
+        }
+      }
+      std::sort(intervals.begin(), intervals.end());
+      double length = 0.0;
+      double top = -std::numeric_limits<double>::infinity();
+      for (const std::pair<double, double>& interval : intervals)
+      {
+        length += std::max(0.0, interval.second - std::max(top, interval.first));
+        top = std::max(top, interval.second);
+      }
+      area += length * (lines[k + 1] - lines[k]);
+    }
+    return area;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(UnionArea_exact_cases)
+
+BOOST_AUTO_TEST_CASE(UnionArea_disjoint_shapes)
+{
+  klimchuk::CompositeShape compositeShape(std::make_shared<klimchuk::Rectangle>(2.0, 3.0, 0.0, 0.0));
+  compositeShape.add(std::make_shared<klimchuk::Circle>(10.0, 0.0, 2.0));
+  compositeShape.add(std::make_shared<klimchuk::Triangle>(klimchuk::point_t{ -10.0, 0.0 },
+    klimchuk::point_t{ -6.0, 0.0 }, klimchuk::point_t{ -10.0, 3.0 }));
+  BOOST_CHECK_CLOSE(compositeShape.getUnionArea(), compositeShape.getArea(), EPSILON);
+}
+
+BOOST_AUTO_TEST_CASE(UnionArea_overlapping_polygons)
+{
+  klimchuk::CompositeShape compositeShape(std::make_shared<klimchuk::Rectangle>(4.0, 4.0, 0.0, 0.0));
+  compositeShape.add(std::make_shared<klimchuk::Rectangle>(4.0, 4.0, 2.0, 2.0));
+  compositeShape.add(std::make_shared<klimchuk::Rectangle>(1.0, 1.0, 0.0, 0.0));
+  BOOST_CHECK_CLOSE(compositeShape.getUnionArea(), 28.0, EPSILON);
+  compositeShape.add(std::make_shared<klimchuk::Polygon>(std::initializer_list<klimchuk::point_t>{ { 4.0, 4.0 },
+    { 8.0, 4.0 }, { 8.0, 8.0 }, { 6.0, 5.0 }, { 4.0, 8.0 } }));
+  BOOST_CHECK_CLOSE(compositeShape.getUnionArea(), 28.0 + 10.0, EPSILON);
+}
+
+BOOST_AUTO_TEST_CASE(UnionArea_coincident_edges)
+{
+  klimchuk::CompositeShape compositeShape(std::make_shared<klimchuk::Rectangle>(2.0, 2.0, 0.0, 0.0));
+  compositeShape.add(std::make_shared<klimchuk::Rectangle>(2.0, 2.0, 0.0, 0.0));
+  compositeShape.add(std::make_shared<klimchuk::Rectangle>(2.0, 2.0, 2.0, 0.0));
+  compositeShape.add(std::make_shared<klimchuk::Rectangle>(2.0, 1.0, 0.0, 0.5));
+  compositeShape.add(std::make_shared<klimchuk::Triangle>(klimchuk::point_t{ -1.0, -1.0 },
+    klimchuk::point_t{ 3.0, -1.0 }, klimchuk::point_t{ 3.0, -3.0 }));
+  BOOST_CHECK_CLOSE(compositeShape.getUnionArea(), 8.0 + 4.0, EPSILON);
+}
+
+BOOST_AUTO_TEST_CASE(UnionArea_circles)
+{
+  klimchuk::CompositeShape compositeShape(std::make_shared<klimchuk::Circle>(0.0, 0.0, 1.0));
+  compositeShape.add(std::make_shared<klimchuk::Circle>(1.0, 0.0, 1.0));
+  const double lens = (2 * std::acos(0.5)) - (0.5 * std::sqrt(3.0));
+  BOOST_CHECK_CLOSE(compositeShape.getUnionArea(), (2 * M_PI) - lens, EPSILON);
+  compositeShape.add(std::make_shared<klimchuk::Circle>(0.0, 0.0, 1.0));
+  compositeShape.add(std::make_shared<klimchuk::Circle>(0.0, 0.0, 0.5));
+  BOOST_CHECK_CLOSE(compositeShape.getUnionArea(), (2 * M_PI) - lens, EPSILON);
+
+  klimchuk::CompositeShape mixed(std::make_shared<klimchuk::Circle>(0.0, 0.0, 1.0));
+  mixed.add(std::make_shared<klimchuk::Rectangle>(2.0, 2.0, 1.0, 1.0));
+  BOOST_CHECK_CLOSE(mixed.getUnionArea(), M_PI + 4.0 - (M_PI / 4), EPSILON);
+  mixed.add(std::make_shared<klimchuk::Circle>(1.0, 1.0, 0.5));
+  BOOST_CHECK_CLOSE(mixed.getUnionArea(), M_PI + 4.0 - (M_PI / 4), EPSILON);
+}
+
+BOOST_AUTO_TEST_CASE(UnionArea_nested_composite_shapes)
+{
+  std::shared_ptr<klimchuk::CompositeShape> group = std::make_shared<klimchuk::CompositeShape>(
+    std::make_shared<klimchuk::Rectangle>(4.0, 4.0, 2.0, 2.0));
+  group->add(std::make_shared<klimchuk::Rectangle>(1.0, 1.0, 0.0, 0.0));
+  klimchuk::CompositeShape compositeShape(std::make_shared<klimchuk::Rectangle>(4.0, 4.0, 0.0, 0.0));
+  compositeShape.add(group);
+  BOOST_CHECK_CLOSE(compositeShape.getUnionArea(), 28.0, EPSILON);
+}
+
+BOOST_AUTO_TEST_CASE(UnionArea_touching_shapes_in_parallel_mode)
+{
+  klimchuk::CompositeShape compositeShape(std::make_shared<klimchuk::Circle>(0.0, 0.0, 2.5));
+  compositeShape.add(std::make_shared<klimchuk::Circle>(4.0, 3.0, 2.5));
+  compositeShape.add(std::make_shared<klimchuk::Rectangle>(2.0, 2.0, 5.0, -1.0));
+  compositeShape.add(std::make_shared<klimchuk::Triangle>(klimchuk::point_t{ -2.5, -6.0 },
+    klimchuk::point_t{ 2.5, -6.0 }, klimchuk::point_t{ -2.5, -2.5 }));
+  const double area = (12.5 * M_PI) + 4.0 + 8.75;
+  for (size_t numberOfThreads = 1; numberOfThreads <= 8; ++numberOfThreads)
+  {
+    BOOST_CHECK_CLOSE(compositeShape.getUnionArea(numberOfThreads), area, EPSILON);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(UnionArea_shapes_rotated_by_right_angles)
+{
+  klimchuk::CompositeShape compositeShape(std::make_shared<klimchuk::Triangle>(klimchuk::point_t{ 1.0, 1.0 },
+    klimchuk::point_t{ -1.0, 2.0 }, klimchuk::point_t{ -3.0, -2.0 }));
+  compositeShape.add(std::make_shared<klimchuk::Rectangle>(2.0, 2.0, -3.0, -1.0));
+  compositeShape[1]->rotate(90.0);
+  klimchuk::CompositeShape halfTurn(std::make_shared<klimchuk::Rectangle>(2.0, 2.0, 0.0, -1.0));
+  halfTurn[0]->rotate(180.0);
+  halfTurn.add(std::make_shared<klimchuk::Circle>(0.0, 0.0, 1.0));
+  for (size_t numberOfThreads = 1; numberOfThreads <= 8; ++numberOfThreads)
+  {
+    BOOST_CHECK_CLOSE(compositeShape.getUnionArea(numberOfThreads), 8.375, EPSILON);
+    BOOST_CHECK_CLOSE(halfTurn.getUnionArea(numberOfThreads), 4.0 + (M_PI / 2), EPSILON);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(UnionArea_circles_tangent_to_rotated_edges)
+{
+  klimchuk::CompositeShape compositeShape(std::make_shared<klimchuk::Circle>(-1.0, 1.0, 0.5));
+  compositeShape.add(std::make_shared<klimchuk::Rectangle>(1.0, 4.0, 0.0, 1.0));
+  compositeShape[1]->rotate(90.0);
+  klimchuk::CompositeShape touching(std::make_shared<klimchuk::Circle>(0.0, -4.0, 2.0));
+  touching.add(std::make_shared<klimchuk::Rectangle>(4.0, 4.0, -4.0, -3.0));
+  touching[1]->rotate(270.0);
+  touching.add(std::make_shared<klimchuk::Rectangle>(4.0, 3.0, 1.0, -4.0));
+  touching[2]->rotate(270.0);
+  const double segment = (4 * std::acos(0.25)) - (0.5 * std::sqrt(3.75));
+  for (size_t numberOfThreads = 1; numberOfThreads <= 8; ++numberOfThreads)
+  {
+    BOOST_CHECK_CLOSE(compositeShape.getUnionArea(numberOfThreads), 4.0, EPSILON);
+    BOOST_CHECK_CLOSE(touching.getUnionArea(numberOfThreads), 16.0 + 12.0 + segment, EPSILON);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(UnionArea_invalid_arguments)
+{
+  klimchuk::CompositeShape compositeShape(std::make_shared<klimchuk::Circle>(0.0, 0.0, 1.0));
+  BOOST_CHECK_THROW(compositeShape.getUnionArea(0), std::invalid_argument);
+  BOOST_CHECK_THROW(klimchuk::getUnionArea(nullptr, 1), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(UnionArea_random_scenes)
+
+BOOST_AUTO_TEST_CASE(UnionArea_matches_sampling_and_parallel_mode)
+{
+  std::mt19937 generator(7);
+  std::uniform_real_distribution<double> position(-10.0, 10.0);
+  std::uniform_real_distribution<double> size(0.5, 4.0);
+  std::uniform_real_distribution<double> angle(0.0, 90.0);
+  klimchuk::CompositeShape compositeShape(std::make_shared<klimchuk::Circle>(0.0, 0.0, 2.0));
+  for (size_t i = 0; i < 60; ++i)
+  {
+    if (i % 2 == 0)
+    {
+      compositeShape.add(std::make_shared<klimchuk::Circle>(position(generator), position(generator), size(generator) / 2));
+    }
+    else
+    {
+      compositeShape.add(std::make_shared<klimchuk::Rectangle>(size(generator), size(generator), position(generator),
+        position(generator)));
+      compositeShape[compositeShape.getSize() - 1]->rotate(angle(generator));
+    }
+  }
+  const double area = compositeShape.getUnionArea();
+  BOOST_CHECK_LT(area, compositeShape.getArea());
+  BOOST_CHECK_CLOSE(area, estimateUnionArea(compositeShape, 1000), 0.5);
+  BOOST_CHECK_CLOSE(compositeShape.getUnionArea(4), area, EPSILON);
+}
+
+BOOST_AUTO_TEST_CASE(UnionArea_matches_slabs_on_integer_scenes)
+{
+  std::mt19937 generator(3);
+  std::uniform_int_distribution<int> position(-4, 4);
+  std::uniform_int_distribution<int> size(1, 4);
+  std::uniform_int_distribution<int> quarter(0, 3);
+  for (size_t scene = 0; scene < 400; ++scene)
+  {
+    std::vector<std::vector<klimchuk::point_t>> polygons;
+    klimchuk::CompositeShape compositeShape(std::make_shared<klimchuk::Rectangle>(1.0, 1.0, 0.0, 0.0));
+    polygons.push_back({ { -0.5, -0.5 }, { 0.5, -0.5 }, { 0.5, 0.5 }, { -0.5, 0.5 } });
+    for (size_t i = 0; i < 2 + (scene % 6); ++i)
+    {
+      if (i % 2 == 0)
+      {
+        const double width = size(generator);
+        const double height = size(generator);
+        const klimchuk::point_t centre{ static_cast<double>(position(generator)), static_cast<double>(position(generator)) };
+        const int turns = quarter(generator);
+        compositeShape.add(std::make_shared<klimchuk::Rectangle>(width, height, centre.x, centre.y));
+        compositeShape[compositeShape.getSize() - 1]->rotate(90.0 * turns);
+        const double halfWidth = ((turns % 2 == 0) ? width : height) / 2;
+        const double halfHeight = ((turns % 2 == 0) ? height : width) / 2;
+        polygons.push_back({ { centre.x - halfWidth, centre.y - halfHeight }, { centre.x + halfWidth, centre.y - halfHeight },
+          { centre.x + halfWidth, centre.y + halfHeight }, { centre.x - halfWidth, centre.y + halfHeight } });
+      }
+      else
+      {
+        std::vector<klimchuk::point_t> points(3);
+        for (klimchuk::point_t& point : points)
+        {
+          point = { static_cast<double>(position(generator)), static_cast<double>(position(generator)) };
+        }
+        if (((points[1].x - points[0].x) * (points[2].y - points[0].y))
+          == ((points[1].y - points[0].y) * (points[2].x - points[0].x)))
+        {
+          continue;
+        }
+        compositeShape.add(std::make_shared<klimchuk::Triangle>(points[0], points[1], points[2]));
+        polygons.push_back(points);
+      }
+    }
+    const double area = getUnionAreaOfPolygons(polygons);
+    for (size_t numberOfThreads = 1; numberOfThreads <= 4; ++numberOfThreads)
+    {
+      BOOST_CHECK_CLOSE(compositeShape.getUnionArea(numberOfThreads), area, EPSILON);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(UnionArea_circle_starting_on_edge)
+{
+  klimchuk::CompositeShape compositeShape(std::make_shared<klimchuk::Rectangle>(3.0, 1.0, 2.0, 1.0));
+  compositeShape[0]->rotate(30.0);
+  compositeShape.add(std::make_shared<klimchuk::Circle>(4.0, 1.0, 1.0));
+  const double area = compositeShape.getUnionArea();
+  BOOST_CHECK_LT(area, compositeShape.getArea());
+  BOOST_CHECK_CLOSE(area, estimateUnionArea(compositeShape, 1000), 0.5);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,92 @@
+#include <stdexcept>
+#include <random>
+#include <vector>
+#include <cmath>
+#include "boost/test/unit_test.hpp"
+#include "vertex-encoding.hpp"
+#include "polygon.hpp"
+
+const double EPSILON = 0.000001;
+
+BOOST_AUTO_TEST_SUITE(Vertex_encoding)
+
+BOOST_AUTO_TEST_CASE(Vertex_encoding_round_trips_on_grid)
+{
+  std::mt19937 generator(7);
+  std::uniform_int_distribution<int> step(-3000, 3000);
+  std::vector<klimchuk::point_t> points;
+  int x = -100000;
+  int y = 250000;
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    points.push_back({ x * 0.001, y * 0.001 });
+    x += (i % 200 == 0) ? 1000000 : step(generator);
+    y += step(generator);
+  }
+  const std::vector<uint8_t> data = klimchuk::encodeVertices(points.data(), points.size(), 0.001);
+  BOOST_CHECK_EQUAL(klimchuk::getNumberOfEncodedVertices(data.data(), data.size()), points.size());
+  BOOST_CHECK_EQUAL(klimchuk::getSizeOfEncodedVertices(data.data(), data.size()), data.size());
+  BOOST_CHECK_CLOSE(klimchuk::getQuantumOfEncodedVertices(data.data(), data.size()), 0.001, EPSILON);
+  BOOST_CHECK_LT(data.size() * 4, points.size() * sizeof(klimchuk::point_t));
+  const std::vector<klimchuk::point_t> decoded = klimchuk::decodeVertices(data.data(), data.size());
+  BOOST_REQUIRE_EQUAL(decoded.size(), points.size());
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    BOOST_CHECK_SMALL(decoded[i].x - points[i].x, 1e-9);
+    BOOST_CHECK_SMALL(decoded[i].y - points[i].y, 1e-9);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Vertex_encoding_rounds_to_grid)
+{
+  const klimchuk::point_t points[] = { { 0.26, -0.24 }, { 0.26, -0.24 }, { 1e15, -1e15 }, { -1e15, 3.0 } };
+  const std::vector<uint8_t> data = klimchuk::encodeVertices(points, 4, 0.5);
+  klimchuk::point_t decoded[4];
+  klimchuk::decodeVertices(data.data(), data.size(), decoded);
+  BOOST_CHECK_CLOSE(decoded[0].x, 0.5, EPSILON);
+  BOOST_CHECK_SMALL(decoded[0].y, EPSILON);
+  BOOST_CHECK_CLOSE(decoded[1].x, 0.5, EPSILON);
+  BOOST_CHECK_CLOSE(decoded[2].x, 1e15, EPSILON);
+  BOOST_CHECK_CLOSE(decoded[2].y, -1e15, EPSILON);
+  BOOST_CHECK_CLOSE(decoded[3].x, -1e15, EPSILON);
+  BOOST_CHECK_CLOSE(decoded[3].y, 3.0, EPSILON);
+}
+
+BOOST_AUTO_TEST_CASE(Vertex_encoding_handles_extreme_deltas)
+{
+  const double limit = 4e18;
+  const klimchuk::point_t points[] = { { -limit, limit }, { limit, -limit }, { -limit, 0.0 } };
+  const std::vector<uint8_t> data = klimchuk::encodeVertices(points, 3, 1.0);
+  const std::vector<klimchuk::point_t> decoded = klimchuk::decodeVertices(data.data(), data.size());
+  for (size_t i = 0; i < 3; ++i)
+  {
+    BOOST_CHECK_CLOSE(decoded[i].x, points[i].x, EPSILON);
+    BOOST_CHECK_CLOSE(decoded[i].y, points[i].y, EPSILON);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Vertex_encoding_rejects_invalid_input)
+{
+  const klimchuk::point_t points[] = { { 0.0, 0.0 }, { 1e300, 0.0 } };
+  BOOST_CHECK_THROW(klimchuk::encodeVertices(points, 2, 0.0), std::invalid_argument);
+  BOOST_CHECK_THROW(klimchuk::encodeVertices(points, 2, 1.0), std::out_of_range);
+  const std::vector<uint8_t> data = klimchuk::encodeVertices(points, 1, 1.0);
+  BOOST_CHECK_THROW(klimchuk::decodeVertices(data.data(), data.size() - 1), std::invalid_argument);
+  BOOST_CHECK_THROW(klimchuk::decodeVertices(data.data(), 3), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(Polygon_is_constructed_from_encoded_block)
+{
+  klimchuk::Polygon polygon{ { 0.0, 0.0 }, { 4.0, 0.0 }, { 4.0, 4.0 }, { 2.0, 1.0 }, { 0.0, 4.0 } };
+  const std::vector<uint8_t> data = polygon.encode(0.25);
+  klimchuk::Polygon copy(data.data(), data.size());
+  BOOST_CHECK_EQUAL(copy.getSize(), polygon.getSize());
+  BOOST_CHECK_CLOSE(copy.getArea(), polygon.getArea(), EPSILON);
+  const klimchuk::point_t line[] = { { 0.0, 0.0 }, { 1.0, 1.0 }, { 2.0, 2.0 } };
+  const std::vector<uint8_t> degenerate = klimchuk::encodeVertices(line, 3, 1.0);
+  BOOST_CHECK_THROW(klimchuk::Polygon(degenerate.data(), degenerate.size()), std::invalid_argument);
+  const std::vector<uint8_t> small = klimchuk::encodeVertices(line, 2, 1.0);
+  BOOST_CHECK_THROW(klimchuk::Polygon(small.data(), small.size()), std::length_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
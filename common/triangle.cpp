@@ -2,21 +2,39 @@
 #include <algorithm>
 #include <stdexcept>
 #include <cmath>
+#include "predicates.hpp"
+
+namespace
+{
+  const uint64_t HASH_SEED = 3;
+}
 
 klimchuk::Triangle::Triangle(const point_t& firstTop, const point_t& secondTop, const point_t& thirdTop):
   a_{ firstTop },
   b_{ secondTop },
   c_{ thirdTop }
 {
-  double firstSide = sqrt(pow(secondTop.x - firstTop.x, 2) + pow(secondTop.y - firstTop.y, 2));
-  double secondSide = sqrt(pow(thirdTop.x - secondTop.x, 2) + pow(thirdTop.y - secondTop.y, 2));
-  double thirdSide = sqrt(pow(thirdTop.x - firstTop.x, 2) + pow(thirdTop.y - firstTop.y, 2));
-  if ((firstSide + secondSide <= thirdSide) || (firstSide + thirdSide <= secondSide) || (secondSide + thirdSide <= firstSide))
+  if (getOrientation(firstTop, secondTop, thirdTop) == 0.0)
   {
     throw std::invalid_argument("Triangle: Wrong value of coordinates.");
   }
 }
 
+klimchuk::point_t klimchuk::Triangle::operator[](size_t index) const
+{
+  switch (index)
+  {
+  case 0:
+    return a_;
+  case 1:
+    return b_;
+  case 2:
+    return c_;
+  default:
+    throw std::out_of_range("Triangle: Invalid index to access.");
+  }
+}
+
 double klimchuk::Triangle::getArea() const
 {
   return std::abs((((a_.x - c_.x) * (b_.y - c_.y)) - ((b_.x - c_.x) * (a_.y - c_.y))) * 0.5);
@@ -36,23 +54,33 @@ klimchuk::rectangle_t klimchuk::Triangle::getFrameRect() const
   return rectangle_t { maxX - minX, maxY - minY, getCentre() };
 }
 
+klimchuk::oriented_rectangle_t klimchuk::Triangle::getOrientedFrameRect() const
+{
+  const point_t tops[3] = { a_, b_, c_ };
+  return getMinimumAreaRect(tops, 3);
+}
+
 void klimchuk::Triangle::move(double moveAbscissa, double moveOrdinate)
 {
+  const Journal::Scope scope(Journal::Operation::MOVE_BY, *this, moveAbscissa, moveOrdinate);
   a_.x += moveAbscissa;
   a_.y += moveOrdinate;
   b_.x += moveAbscissa;
   b_.y += moveOrdinate;
   c_.x += moveAbscissa;
   c_.y += moveOrdinate;
+  invalidateOwners();
 }
 
 void klimchuk::Triangle::move(const point_t& point)
 {
+  const Journal::Scope scope(Journal::Operation::MOVE_TO, *this, point.x, point.y);
   move(point.x - getCentre().x, point.y - getCentre().y);
 }
 
 void klimchuk::Triangle::scale(double coefficient)
 {
+  const Journal::Scope scope(Journal::Operation::SCALE, *this, coefficient);
   if (coefficient <= 0)
   {
     throw std::invalid_argument("Triangle: Coefficient must be vore than a zero");
@@ -64,10 +92,12 @@ void klimchuk::Triangle::scale(double coefficient)
   b_.y = centre.y + (b_.y - centre.y) * coefficient;
   c_.x = centre.x + (c_.x - centre.x) * coefficient;
   c_.y = centre.y + (c_.y - centre.y) * coefficient;
+  invalidateOwners();
 }
 
 void klimchuk::Triangle::rotate(double angle)
 {
+  const Journal::Scope scope(Journal::Operation::ROTATE, *this, angle);
   angle *= M_PI / 180;
   double cosinusOfAngle = cos(angle);
   double sinusOfAngle = sin(angle);
@@ -78,4 +108,10 @@ void klimchuk::Triangle::rotate(double angle)
       centre.y + (sinusOfAngle * (b_.x - centre.x)) + (cosinusOfAngle * (b_.y - centre.y)) };
   c_ = { centre.x + (cosinusOfAngle * (c_.x - centre.x)) - (sinusOfAngle * (c_.y - centre.y)),
       centre.y + (sinusOfAngle * (c_.x - centre.x)) + (cosinusOfAngle * (c_.y - centre.y)) };
+  invalidateOwners();
+}
+
+uint64_t klimchuk::Triangle::getHash() const
+{
+  return hashCombine(hashCombine(hashCombine(HASH_SEED, a_), b_), c_);
 }
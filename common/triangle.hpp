@@ -9,13 +9,16 @@ namespace klimchuk
   {
   public:
     Triangle(const point_t& firstTop, const point_t& secondTop, const point_t& thirdTop);
+    point_t operator[](size_t index) const;
     double getArea() const override;
     rectangle_t getFrameRect() const override;
+    oriented_rectangle_t getOrientedFrameRect() const override;
     void move(const point_t& point) override;
     void move(double moveAbscissa, double moveOrdinate) override;
     point_t getCentre() const override;
     void scale(double coefficient) override;
     void rotate(double angle) override;
+    uint64_t getHash() const override;
   private:
     point_t a_;
     point_t b_;
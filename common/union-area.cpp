@@ -0,0 +1,958 @@
+#include "union-area.hpp"
+#include <stdexcept>
+#include <algorithm>
+#include <vector>
+#include <utility>
+#include <memory>
+#include <thread>
+#include <random>
+#include <cmath>
+#include <cstdint>
+#include "outline.hpp"
+#include "partition.hpp"
+#include "predicates.hpp"
+
+namespace
+{
+  const uint32_t NO_CURVE = static_cast<uint32_t>(-1);
+  const uint32_t CROSSING_LINE = static_cast<uint32_t>(1) << 31;
+  const double LINE_TOLERANCE = 1e-12;
+
+  struct curve_t
+  {
+    klimchuk::point_t left;
+    klimchuk::point_t right;
+    klimchuk::point_t centre;
+    double radius;
+    int side;
+    uint32_t first;
+    uint32_t last;
+  };
+
+  struct crossing_t
+  {
+    double x;
+    uint32_t line;
+    uint32_t lower;
+    uint32_t upper;
+  };
+
+  struct scene_t
+  {
+    double tolerance;
+    std::vector<double> lines;
+    std::vector<curve_t> curves;
+    std::vector<uint32_t> starts;
+    std::vector<uint32_t> endOffsets;
+    std::vector<uint32_t> ends;
+    std::vector<uint32_t> crossingOffsets;
+    std::vector<uint32_t> crossings;
+  };
+
+  double getOrdinate(const curve_t& curve, double x)
+  {
+    if (curve.radius > 0.0)
+    {
+      const double offset = x - curve.centre.x;
+      return curve.centre.y - (curve.side * std::sqrt(std::max(0.0, (curve.radius * curve.radius) - (offset * offset))));
+    }
+    if (x <= curve.left.x)
+    {
+      return curve.left.y;
+    }
+    if (x >= curve.right.x)
+    {
+      return curve.right.y;
+    }
+    return curve.left.y + ((x - curve.left.x) * (curve.right.y - curve.left.y) / (curve.right.x - curve.left.x));
+  }
+
+  double getIntegral(const curve_t& curve, double first, double last)
+  {
+    if (curve.radius > 0.0)
+    {
+      auto getPrimitive = [&curve](double x)
+      {
+        const double offset = std::min(curve.radius, std::max(-curve.radius, x - curve.centre.x));
+        const double squaredRadius = curve.radius * curve.radius;
+        return ((offset * std::sqrt(std::max(0.0, squaredRadius - (offset * offset))))
+          + (squaredRadius * std::asin(offset / curve.radius))) / 2;
+      };
+      return (curve.centre.y * (last - first)) - (curve.side * (getPrimitive(last) - getPrimitive(first)));
+    }
+    return (getOrdinate(curve, first) + getOrdinate(curve, last)) * (last - first) / 2;
+  }
+
+  double getDifference(const curve_t& lhs, const curve_t& rhs, double first, double last)
+  {
+    double difference = 0.0;
+    for (double x : { (3 * first + last) / 4, (first + last) / 2, (first + 3 * last) / 4 })
+    {
+      difference += getOrdinate(lhs, x) - getOrdinate(rhs, x);
+    }
+    return difference;
+  }
+
+  bool isLower(const scene_t& scene, uint32_t lhs, uint32_t rhs, uint32_t line)
+  {
+    const curve_t& lower = scene.curves[lhs];
+    const curve_t& upper = scene.curves[rhs];
+    const double first = scene.lines[line];
+    const double last = scene.lines[line + 1];
+    double difference = getOrdinate(lower, (first + last) / 2) - getOrdinate(upper, (first + last) / 2);
+    if (std::abs(difference) <= scene.tolerance)
+    {
+      difference = getDifference(lower, upper, first, last);
+    }
+    if (std::abs(difference) <= scene.tolerance)
+    {
+      difference = getDifference(lower, upper, first, std::min(lower.right.x, upper.right.x));
+    }
+    if (std::abs(difference) > scene.tolerance)
+    {
+      return difference < 0.0;
+    }
+    if (lower.side != upper.side)
+    {
+      return lower.side > upper.side;
+    }
+    return lhs < rhs;
+  }
+
+  bool isOnArc(const curve_t& arc, const klimchuk::point_t& point)
+  {
+    return (arc.side > 0) ? (point.y <= arc.centre.y) : (point.y >= arc.centre.y);
+  }
+
+  void getCrossings(const curve_t& lhs, const curve_t& rhs, std::vector<double>& crossings)
+  {
+    crossings.clear();
+    if ((lhs.radius == 0.0) && (rhs.radius == 0.0))
+    {
+      const double lhsLeft = klimchuk::getOrientation(rhs.left, rhs.right, lhs.left);
+      const double lhsRight = klimchuk::getOrientation(rhs.left, rhs.right, lhs.right);
+      const double rhsLeft = klimchuk::getOrientation(lhs.left, lhs.right, rhs.left);
+      const double rhsRight = klimchuk::getOrientation(lhs.left, lhs.right, rhs.right);
+      if (((lhsLeft > 0.0) == (lhsRight > 0.0)) || ((rhsLeft > 0.0) == (rhsRight > 0.0))
+        || (lhsLeft == 0.0) || (lhsRight == 0.0) || (rhsLeft == 0.0) || (rhsRight == 0.0))
+      {
+        return;
+      }
+      crossings.push_back(lhs.left.x + ((lhs.right.x - lhs.left.x) * lhsLeft / (lhsLeft - lhsRight)));
+      return;
+    }
+    if ((lhs.radius > 0.0) && (rhs.radius > 0.0))
+    {
+      const double dx = rhs.centre.x - lhs.centre.x;
+      const double dy = rhs.centre.y - lhs.centre.y;
+      const double distance = std::sqrt((dx * dx) + (dy * dy));
+      if ((distance == 0.0) || (distance >= lhs.radius + rhs.radius) || (distance <= std::abs(lhs.radius - rhs.radius)))
+      {
+        return;
+      }
+      const double along = ((lhs.radius * lhs.radius) - (rhs.radius * rhs.radius) + (distance * distance)) / (2 * distance);
+      const double across = std::sqrt(std::max(0.0, (lhs.radius * lhs.radius) - (along * along)));
+      const klimchuk::point_t middle{ lhs.centre.x + (dx * along / distance), lhs.centre.y + (dy * along / distance) };
+      for (int direction : { -1, 1 })
+      {
+        const klimchuk::point_t point{ middle.x - (direction * dy * across / distance),
+          middle.y + (direction * dx * across / distance) };
+        if (isOnArc(lhs, point) && isOnArc(rhs, point))
+        {
+          crossings.push_back(point.x);
+        }
+      }
+      return;
+    }
+    const curve_t& segment = (lhs.radius == 0.0) ? lhs : rhs;
+    const curve_t& arc = (lhs.radius == 0.0) ? rhs : lhs;
+    const klimchuk::point_t direction{ segment.right.x - segment.left.x, segment.right.y - segment.left.y };
+    const klimchuk::point_t offset{ segment.left.x - arc.centre.x, segment.left.y - arc.centre.y };
+    const double a = (direction.x * direction.x) + (direction.y * direction.y);
+    const double b = 2 * ((offset.x * direction.x) + (offset.y * direction.y));
+    const double c = (offset.x * offset.x) + (offset.y * offset.y) - (arc.radius * arc.radius);
+    const double discriminant = (b * b) - (4 * a * c);
+    if (discriminant <= 0.0)
+    {
+      return;
+    }
+    const double root = std::sqrt(discriminant);
+    for (double t : { (-b - root) / (2 * a), (-b + root) / (2 * a) })
+    {
+      const klimchuk::point_t point{ segment.left.x + (t * direction.x), segment.left.y + (t * direction.y) };
+      if ((t > 0.0) && (t < 1.0) && isOnArc(arc, point))
+      {
+        crossings.push_back(point.x);
+      }
+    }
+  }
+
+  void setLines(scene_t& scene, std::vector<curve_t>& curves)
+  {
+    std::vector<std::pair<double, uint32_t>> ends;
+    ends.reserve(2 * curves.size());
+    for (uint32_t curve = 0; curve < curves.size(); ++curve)
+    {
+      ends.emplace_back(curves[curve].left.x, 2 * curve);
+      ends.emplace_back(curves[curve].right.x, (2 * curve) + 1);
+    }
+    std::sort(ends.begin(), ends.end());
+    for (const std::pair<double, uint32_t>& end : ends)
+    {
+      if (scene.lines.empty() || (end.first - scene.lines.back() > scene.tolerance))
+      {
+        scene.lines.push_back(end.first);
+      }
+      curve_t& curve = curves[end.second / 2];
+      ((end.second % 2 == 0) ? curve.first : curve.last) = scene.lines.size() - 1;
+    }
+    ends.clear();
+    ends.shrink_to_fit();
+
+    std::vector<uint32_t> firstCurves(scene.lines.size() + 1, 0);
+    for (curve_t& curve : curves)
+    {
+      curve.left.x = scene.lines[curve.first];
+      curve.right.x = scene.lines[curve.last];
+      firstCurves[curve.first + 1] += (curve.first != curve.last) ? 1 : 0;
+    }
+    for (size_t line = 0; line < scene.lines.size(); ++line)
+    {
+      firstCurves[line + 1] += firstCurves[line];
+    }
+    scene.curves.resize(firstCurves.back());
+    for (const curve_t& curve : curves)
+    {
+      if (curve.first != curve.last)
+      {
+        scene.curves[firstCurves[curve.first]++] = curve;
+      }
+    }
+  }
+
+  std::vector<crossing_t> findCrossings(const scene_t& scene)
+  {
+    std::vector<klimchuk::rectangle_t> frames;
+    frames.reserve(scene.curves.size());
+    for (const curve_t& curve : scene.curves)
+    {
+      const double bottom = (curve.radius > 0.0) ? (curve.centre.y - ((curve.side > 0) ? curve.radius : 0.0))
+        : std::min(curve.left.y, curve.right.y);
+      const double top = (curve.radius > 0.0) ? (curve.centre.y + ((curve.side > 0) ? 0.0 : curve.radius))
+        : std::max(curve.left.y, curve.right.y);
+      frames.push_back(klimchuk::rectangle_t{ curve.right.x - curve.left.x, top - bottom,
+        { (curve.left.x + curve.right.x) / 2, (bottom + top) / 2 } });
+    }
+    std::vector<crossing_t> crossings;
+    std::vector<double> candidates;
+    for (const klimchuk::intersection_t& intersection : klimchuk::findIntersections(frames.data(), frames.size()))
+    {
+      getCrossings(scene.curves[intersection.first], scene.curves[intersection.second], candidates);
+      for (double x : candidates)
+      {
+        crossings.push_back(crossing_t{ x, 0, static_cast<uint32_t>(intersection.first),
+          static_cast<uint32_t>(intersection.second) });
+      }
+    }
+    std::sort(crossings.begin(), crossings.end(), [](const crossing_t& lhs, const crossing_t& rhs)
+    {
+      return (lhs.x < rhs.x) || ((lhs.x == rhs.x) && ((lhs.lower < rhs.lower)
+        || ((lhs.lower == rhs.lower) && (lhs.upper < rhs.upper))));
+    });
+    return crossings;
+  }
+
+  void setCrossings(scene_t& scene, std::vector<crossing_t>& crossings)
+  {
+    std::vector<double> crossingLines;
+    uint32_t line = 0;
+    for (crossing_t& crossing : crossings)
+    {
+      while ((line + 1 < scene.lines.size()) && (scene.lines[line + 1] <= crossing.x))
+      {
+        ++line;
+      }
+      if (std::abs(crossing.x - scene.lines[line]) <= scene.tolerance)
+      {
+        crossing.line = line;
+      }
+      else if ((line + 1 < scene.lines.size()) && (scene.lines[line + 1] - crossing.x <= scene.tolerance))
+      {
+        crossing.line = line + 1;
+      }
+      else
+      {
+        if (crossingLines.empty() || (crossing.x - crossingLines.back() > scene.tolerance))
+        {
+          crossingLines.push_back(crossing.x);
+        }
+        crossing.line = CROSSING_LINE | (crossingLines.size() - 1);
+      }
+    }
+
+    std::vector<double> lines;
+    lines.reserve(scene.lines.size() + crossingLines.size());
+    std::vector<uint32_t> endLines(scene.lines.size());
+    std::vector<uint32_t> newLines(crossingLines.size());
+    for (size_t end = 0, crossing = 0; (end < scene.lines.size()) || (crossing < crossingLines.size());)
+    {
+      if ((crossing == crossingLines.size()) || ((end < scene.lines.size()) && (scene.lines[end] < crossingLines[crossing])))
+      {
+        endLines[end] = lines.size();
+        lines.push_back(scene.lines[end]);
+        ++end;
+      }
+      else
+      {
+        newLines[crossing] = lines.size();
+        lines.push_back(crossingLines[crossing]);
+        ++crossing;
+      }
+    }
+    scene.lines.swap(lines);
+
+    const uint32_t numberOfLines = scene.lines.size();
+    scene.starts.assign(numberOfLines + 1, 0);
+    scene.endOffsets.assign(numberOfLines + 1, 0);
+    for (curve_t& curve : scene.curves)
+    {
+      curve.first = endLines[curve.first];
+      curve.last = endLines[curve.last];
+      ++scene.starts[curve.first + 1];
+      ++scene.endOffsets[curve.last + 1];
+    }
+    scene.crossingOffsets.assign(numberOfLines + 1, 0);
+    size_t numberOfCrossings = 0;
+    for (const crossing_t& crossing : crossings)
+    {
+      const uint32_t line = (crossing.line & CROSSING_LINE) ? newLines[crossing.line & ~CROSSING_LINE]
+        : endLines[crossing.line];
+      const curve_t& lower = scene.curves[crossing.lower];
+      const curve_t& upper = scene.curves[crossing.upper];
+      if ((line > std::max(lower.first, upper.first)) && (line < std::min(lower.last, upper.last)))
+      {
+        scene.crossingOffsets[line + 1] += 2;
+        crossings[numberOfCrossings++] = crossing_t{ crossing.x, line, crossing.lower, crossing.upper };
+      }
+    }
+    crossings.resize(numberOfCrossings);
+    for (uint32_t line = 0; line < numberOfLines; ++line)
+    {
+      scene.starts[line + 1] += scene.starts[line];
+      scene.endOffsets[line + 1] += scene.endOffsets[line];
+      scene.crossingOffsets[line + 1] += scene.crossingOffsets[line];
+    }
+    scene.ends.resize(scene.curves.size());
+    std::vector<uint32_t> nextEnds(scene.endOffsets.begin(), scene.endOffsets.end() - 1);
+    for (uint32_t curve = 0; curve < scene.curves.size(); ++curve)
+    {
+      scene.ends[nextEnds[scene.curves[curve].last]++] = curve;
+    }
+    scene.crossings.resize(2 * crossings.size());
+    std::vector<uint32_t> nextCrossings(scene.crossingOffsets.begin(), scene.crossingOffsets.end() - 1);
+    for (const crossing_t& crossing : crossings)
+    {
+      scene.crossings[nextCrossings[crossing.line]++] = crossing.lower;
+      scene.crossings[nextCrossings[crossing.line]++] = crossing.upper;
+    }
+  }
+
+  class ActiveCurves
+  {
+  public:
+    explicit ActiveCurves(size_t numberOfCurves):
+      nodes_(numberOfCurves),
+      curvesOfNodes_(numberOfCurves),
+      nodesOfCurves_(numberOfCurves),
+      isActive_(numberOfCurves, false),
+      root_{ NO_CURVE }
+    {
+      std::minstd_rand generator(1);
+      for (uint32_t i = 0; i < numberOfCurves; ++i)
+      {
+        nodes_[i] = node_t{ NO_CURVE, NO_CURVE, NO_CURVE, static_cast<uint32_t>(generator()) };
+        curvesOfNodes_[i] = i;
+        nodesOfCurves_[i] = i;
+      }
+    }
+
+    bool isActive(uint32_t curve) const
+    {
+      return isActive_[curve];
+    }
+
+    uint32_t getNext(uint32_t curve) const
+    {
+      uint32_t node = nodesOfCurves_[curve];
+      if (nodes_[node].right != NO_CURVE)
+      {
+        node = nodes_[node].right;
+        while (nodes_[node].left != NO_CURVE)
+        {
+          node = nodes_[node].left;
+        }
+        return curvesOfNodes_[node];
+      }
+      while ((nodes_[node].parent != NO_CURVE) && (nodes_[nodes_[node].parent].right == node))
+      {
+        node = nodes_[node].parent;
+      }
+      node = nodes_[node].parent;
+      return (node == NO_CURVE) ? NO_CURVE : curvesOfNodes_[node];
+    }
+
+    uint32_t getPrevious(uint32_t curve) const
+    {
+      uint32_t node = nodesOfCurves_[curve];
+      if (nodes_[node].left != NO_CURVE)
+      {
+        node = nodes_[node].left;
+        while (nodes_[node].right != NO_CURVE)
+        {
+          node = nodes_[node].right;
+        }
+        return curvesOfNodes_[node];
+      }
+      while ((nodes_[node].parent != NO_CURVE) && (nodes_[nodes_[node].parent].left == node))
+      {
+        node = nodes_[node].parent;
+      }
+      node = nodes_[node].parent;
+      return (node == NO_CURVE) ? NO_CURVE : curvesOfNodes_[node];
+    }
+
+    uint32_t getFirst() const
+    {
+      uint32_t node = root_;
+      if (node == NO_CURVE)
+      {
+        return NO_CURVE;
+      }
+      while (nodes_[node].left != NO_CURVE)
+      {
+        node = nodes_[node].left;
+      }
+      return curvesOfNodes_[node];
+    }
+
+    uint32_t getLast() const
+    {
+      uint32_t node = root_;
+      if (node == NO_CURVE)
+      {
+        return NO_CURVE;
+      }
+      while (nodes_[node].right != NO_CURVE)
+      {
+        node = nodes_[node].right;
+      }
+      return curvesOfNodes_[node];
+    }
+
+    template < typename Predicate >
+    uint32_t findLast(Predicate isBelow) const
+    {
+      uint32_t last = NO_CURVE;
+      uint32_t node = root_;
+      while (node != NO_CURVE)
+      {
+        if (isBelow(curvesOfNodes_[node]))
+        {
+          last = curvesOfNodes_[node];
+          node = nodes_[node].right;
+        }
+        else
+        {
+          node = nodes_[node].left;
+        }
+      }
+      return last;
+    }
+
+    void insertAfter(uint32_t curve, uint32_t previous)
+    {
+      const uint32_t node = nodesOfCurves_[curve];
+      nodes_[node].left = NO_CURVE;
+      nodes_[node].right = NO_CURVE;
+      isActive_[curve] = true;
+      if (root_ == NO_CURVE)
+      {
+        nodes_[node].parent = NO_CURVE;
+        root_ = node;
+        return;
+      }
+      uint32_t parent = (previous == NO_CURVE) ? root_ : nodesOfCurves_[previous];
+      bool isLeft = previous == NO_CURVE;
+      if (!isLeft && (nodes_[parent].right != NO_CURVE))
+      {
+        parent = nodes_[parent].right;
+        isLeft = true;
+      }
+      if (isLeft)
+      {
+        while (nodes_[parent].left != NO_CURVE)
+        {
+          parent = nodes_[parent].left;
+        }
+        nodes_[parent].left = node;
+      }
+      else
+      {
+        nodes_[parent].right = node;
+      }
+      nodes_[node].parent = parent;
+      while ((nodes_[node].parent != NO_CURVE) && (nodes_[nodes_[node].parent].priority < nodes_[node].priority))
+      {
+        rotateUp(node);
+      }
+    }
+
+    bool isBefore(uint32_t lhs, uint32_t rhs) const
+    {
+      if (lhs == rhs)
+      {
+        return false;
+      }
+      uint32_t left = nodesOfCurves_[lhs];
+      uint32_t right = nodesOfCurves_[rhs];
+      size_t leftDepth = getDepth(left);
+      size_t rightDepth = getDepth(right);
+      uint32_t leftChild = NO_CURVE;
+      uint32_t rightChild = NO_CURVE;
+      for (; leftDepth > rightDepth; --leftDepth)
+      {
+        leftChild = left;
+        left = nodes_[left].parent;
+      }
+      for (; rightDepth > leftDepth; --rightDepth)
+      {
+        rightChild = right;
+        right = nodes_[right].parent;
+      }
+      while (left != right)
+      {
+        leftChild = left;
+        left = nodes_[left].parent;
+        rightChild = right;
+        right = nodes_[right].parent;
+      }
+      return (leftChild == NO_CURVE) ? (nodes_[left].right == rightChild) : (nodes_[left].left == leftChild);
+    }
+
+    void erase(uint32_t curve)
+    {
+      const uint32_t node = nodesOfCurves_[curve];
+      isActive_[curve] = false;
+      while ((nodes_[node].left != NO_CURVE) || (nodes_[node].right != NO_CURVE))
+      {
+        const uint32_t left = nodes_[node].left;
+        const uint32_t right = nodes_[node].right;
+        rotateUp(((right == NO_CURVE) || ((left != NO_CURVE) && (nodes_[left].priority > nodes_[right].priority)))
+          ? left : right);
+      }
+      replaceChild(nodes_[node].parent, node, NO_CURVE);
+    }
+
+  private:
+    struct node_t
+    {
+      uint32_t left;
+      uint32_t right;
+      uint32_t parent;
+      uint32_t priority;
+    };
+
+    std::vector<node_t> nodes_;
+    std::vector<uint32_t> curvesOfNodes_;
+    std::vector<uint32_t> nodesOfCurves_;
+    std::vector<bool> isActive_;
+    uint32_t root_;
+
+    size_t getDepth(uint32_t node) const
+    {
+      size_t depth = 0;
+      for (; nodes_[node].parent != NO_CURVE; node = nodes_[node].parent)
+      {
+        ++depth;
+      }
+      return depth;
+    }
+
+    void replaceChild(uint32_t parent, uint32_t child, uint32_t node)
+    {
+      if (parent == NO_CURVE)
+      {
+        root_ = node;
+      }
+      else if (nodes_[parent].left == child)
+      {
+        nodes_[parent].left = node;
+      }
+      else
+      {
+        nodes_[parent].right = node;
+      }
+      if (node != NO_CURVE)
+      {
+        nodes_[node].parent = parent;
+      }
+    }
+
+    void rotateUp(uint32_t node)
+    {
+      const uint32_t parent = nodes_[node].parent;
+      replaceChild(nodes_[parent].parent, parent, node);
+      if (nodes_[parent].left == node)
+      {
+        nodes_[parent].left = nodes_[node].right;
+        if (nodes_[node].right != NO_CURVE)
+        {
+          nodes_[nodes_[node].right].parent = parent;
+        }
+        nodes_[node].right = parent;
+      }
+      else
+      {
+        nodes_[parent].right = nodes_[node].left;
+        if (nodes_[node].left != NO_CURVE)
+        {
+          nodes_[nodes_[node].left].parent = parent;
+        }
+        nodes_[node].left = parent;
+      }
+      nodes_[parent].parent = node;
+    }
+  };
+
+  class StripSweep
+  {
+  public:
+    StripSweep(const scene_t& scene, uint32_t firstLine, uint32_t lastLine):
+      scene_(scene),
+      firstLine_(firstLine),
+      lastLine_(lastLine),
+      first_(scene.starts[firstLine]),
+      last_(scene.starts[lastLine]),
+      currentLine_(scene.lines[firstLine]),
+      area_(0.0)
+    {
+      for (size_t i = 0; i < first_; ++i)
+      {
+        if (scene.curves[i].last > firstLine)
+        {
+          initialCurves_.push_back(i);
+        }
+      }
+      const size_t numberOfCurves = (last_ - first_) + initialCurves_.size();
+      curves_ = std::make_unique<ActiveCurves>(numberOfCurves);
+      coverages_.assign(numberOfCurves, 0);
+      signs_.assign(numberOfCurves, 0);
+      isMoved_.assign(numberOfCurves, false);
+      beginnings_.assign(numberOfCurves, currentLine_);
+    }
+
+    double integrate()
+    {
+      std::vector<uint32_t> order(initialCurves_.size());
+      for (size_t i = 0; i < order.size(); ++i)
+      {
+        order[i] = (last_ - first_) + i;
+      }
+      for (uint32_t curve = first_; curve < scene_.starts[firstLine_ + 1]; ++curve)
+      {
+        order.push_back(curve - first_);
+      }
+      std::sort(order.begin(), order.end(), [this](uint32_t lhs, uint32_t rhs)
+      {
+        return isLower(scene_, getGlobal(lhs), getGlobal(rhs), firstLine_);
+      });
+      uint32_t previous = NO_CURVE;
+      for (uint32_t curve : order)
+      {
+        curves_->insertAfter(curve, previous);
+        updateCoverage(curve, previous);
+        previous = curve;
+      }
+      for (uint32_t line = firstLine_ + 1; line < lastLine_; ++line)
+      {
+        moveCurves(line);
+      }
+      currentLine_ = scene_.lines[lastLine_];
+      for (uint32_t curve = curves_->getFirst(); curve != NO_CURVE; curve = curves_->getNext(curve))
+      {
+        close(curve);
+      }
+      return area_;
+    }
+
+  private:
+    const scene_t& scene_;
+    uint32_t firstLine_;
+    uint32_t lastLine_;
+    size_t first_;
+    size_t last_;
+    double currentLine_;
+    double area_;
+    std::vector<uint32_t> initialCurves_;
+    std::unique_ptr<ActiveCurves> curves_;
+    std::vector<int> coverages_;
+    std::vector<int> signs_;
+    std::vector<bool> isMoved_;
+    std::vector<double> beginnings_;
+    std::vector<uint32_t> removed_;
+    std::vector<uint32_t> inserted_;
+
+    uint32_t getGlobal(uint32_t curve) const
+    {
+      return (curve < last_ - first_) ? (first_ + curve) : initialCurves_[curve - (last_ - first_)];
+    }
+
+    uint32_t getLocal(uint32_t curve) const
+    {
+      if (curve >= first_)
+      {
+        return curve - first_;
+      }
+      return (last_ - first_) + (std::lower_bound(initialCurves_.begin(), initialCurves_.end(), curve)
+        - initialCurves_.begin());
+    }
+
+    uint32_t getLowest(const std::vector<uint32_t>& curves) const
+    {
+      uint32_t lowest = curves.front();
+      for (uint32_t curve : curves)
+      {
+        lowest = curves_->isBefore(curve, lowest) ? curve : lowest;
+      }
+      return lowest;
+    }
+
+    uint32_t getHighest(const std::vector<uint32_t>& curves) const
+    {
+      uint32_t highest = curves.front();
+      for (uint32_t curve : curves)
+      {
+        highest = curves_->isBefore(highest, curve) ? curve : highest;
+      }
+      return highest;
+    }
+
+    void moveCurves(uint32_t line)
+    {
+      currentLine_ = scene_.lines[line];
+      removed_.clear();
+      inserted_.clear();
+      for (uint32_t i = scene_.endOffsets[line]; i < scene_.endOffsets[line + 1]; ++i)
+      {
+        const uint32_t curve = getLocal(scene_.ends[i]);
+        isMoved_[curve] = true;
+        removed_.push_back(curve);
+      }
+      for (uint32_t i = scene_.crossingOffsets[line]; i < scene_.crossingOffsets[line + 1]; ++i)
+      {
+        const uint32_t curve = getLocal(scene_.crossings[i]);
+        if (!isMoved_[curve])
+        {
+          isMoved_[curve] = true;
+          removed_.push_back(curve);
+          inserted_.push_back(curve);
+        }
+      }
+      for (uint32_t curve = scene_.starts[line]; curve < scene_.starts[line + 1]; ++curve)
+      {
+        isMoved_[curve - first_] = true;
+        inserted_.push_back(curve - first_);
+        beginnings_[curve - first_] = currentLine_;
+      }
+
+      uint32_t below = NO_CURVE;
+      uint32_t above = NO_CURVE;
+      bool isBounded = false;
+      if (!removed_.empty())
+      {
+        const uint32_t lowest = getLowest(removed_);
+        const uint32_t highest = getHighest(removed_);
+        below = curves_->getPrevious(lowest);
+        above = curves_->getNext(highest);
+        isBounded = true;
+        for (uint32_t curve = lowest; curve != above; curve = curves_->getNext(curve))
+        {
+          close(curve);
+        }
+        for (uint32_t curve : removed_)
+        {
+          curves_->erase(curve);
+        }
+      }
+      for (uint32_t curve : inserted_)
+      {
+        const uint32_t previous = curves_->findLast([this, curve, line](uint32_t other)
+        {
+          return isLower(scene_, getGlobal(other), getGlobal(curve), line);
+        });
+        curves_->insertAfter(curve, previous);
+      }
+      if (!inserted_.empty())
+      {
+        uint32_t lowest = curves_->getPrevious(getLowest(inserted_));
+        while ((lowest != NO_CURVE) && isMoved_[lowest])
+        {
+          lowest = curves_->getPrevious(lowest);
+        }
+        uint32_t highest = curves_->getNext(getHighest(inserted_));
+        while ((highest != NO_CURVE) && isMoved_[highest])
+        {
+          highest = curves_->getNext(highest);
+        }
+        if (!isBounded || ((below != NO_CURVE) && ((lowest == NO_CURVE) || curves_->isBefore(lowest, below))))
+        {
+          below = lowest;
+        }
+        if (!isBounded || ((above != NO_CURVE) && ((highest == NO_CURVE) || curves_->isBefore(above, highest))))
+        {
+          above = highest;
+        }
+        isBounded = true;
+      }
+      if (isBounded)
+      {
+        for (uint32_t curve = (below == NO_CURVE) ? curves_->getFirst() : curves_->getNext(below); curve != above;
+          curve = curves_->getNext(curve))
+        {
+          close(curve);
+          updateCoverage(curve, curves_->getPrevious(curve));
+        }
+      }
+      for (uint32_t curve : removed_)
+      {
+        isMoved_[curve] = false;
+      }
+      for (uint32_t curve : inserted_)
+      {
+        isMoved_[curve] = false;
+      }
+    }
+
+    void close(uint32_t curve)
+    {
+      if (signs_[curve] != 0)
+      {
+        area_ += signs_[curve] * getIntegral(scene_.curves[getGlobal(curve)], beginnings_[curve], currentLine_);
+      }
+      beginnings_[curve] = currentLine_;
+    }
+
+    void updateCoverage(uint32_t curve, uint32_t previous)
+    {
+      const int side = scene_.curves[getGlobal(curve)].side;
+      coverages_[curve] = (previous == NO_CURVE) ? 0 : (coverages_[previous] + scene_.curves[getGlobal(previous)].side);
+      signs_[curve] = (side > 0) ? ((coverages_[curve] == 0) ? -1 : 0) : ((coverages_[curve] == 1) ? 1 : 0);
+    }
+  };
+}
+
+double klimchuk::getUnionArea(const Shape::ShapePtr* shapes, size_t numberOfShapes, size_t numberOfThreads)
+{
+  if (!shapes || (numberOfShapes == 0))
+  {
+    throw std::invalid_argument("getUnionArea: Array of shapes is empty.");
+  }
+  if (numberOfThreads == 0)
+  {
+    throw std::invalid_argument("getUnionArea: Number of threads must be more than zero.");
+  }
+  outlines_t outlines;
+  for (size_t i = 0; i < numberOfShapes; ++i)
+  {
+    if (!shapes[i])
+    {
+      throw std::invalid_argument("getUnionArea: Parametr is not shape.");
+    }
+    addOutlines(outlines, shapes[i]);
+  }
+  if (outlines.outlines.empty())
+  {
+    return 0.0;
+  }
+
+  double minX = outlines.frames[0].pos.x;
+  double maxX = minX;
+  double minY = outlines.frames[0].pos.y;
+  double maxY = minY;
+  for (const rectangle_t& frame : outlines.frames)
+  {
+    minX = std::min(minX, frame.pos.x - (frame.width / 2));
+    maxX = std::max(maxX, frame.pos.x + (frame.width / 2));
+    minY = std::min(minY, frame.pos.y - (frame.height / 2));
+    maxY = std::max(maxY, frame.pos.y + (frame.height / 2));
+  }
+  const point_t origin{ (minX + maxX) / 2, (minY + maxY) / 2 };
+  scene_t scene;
+  scene.tolerance = LINE_TOLERANCE * std::max({ std::abs(minX), std::abs(maxX), std::abs(minY), std::abs(maxY) });
+  std::vector<curve_t> curves;
+  curves.reserve(outlines.vertices.size() + (2 * outlines.outlines.size()));
+  for (const outline_t& outline : outlines.outlines)
+  {
+    if (outline.radius > 0.0)
+    {
+      const point_t centre{ outline.centre.x - origin.x, outline.centre.y - origin.y };
+      const point_t left{ centre.x - outline.radius, centre.y };
+      const point_t right{ centre.x + outline.radius, centre.y };
+      curves.push_back(curve_t{ left, right, centre, outline.radius, 1, 0, 0 });
+      curves.push_back(curve_t{ left, right, centre, outline.radius, -1, 0, 0 });
+      continue;
+    }
+    for (size_t k = outline.begin; k < outline.end; ++k)
+    {
+      const point_t& begin = outlines.vertices[k];
+      const point_t& end = outlines.vertices[(k + 1 == outline.end) ? outline.begin : (k + 1)];
+      const point_t first{ begin.x - origin.x, begin.y - origin.y };
+      const point_t second{ end.x - origin.x, end.y - origin.y };
+      if (first.x < second.x)
+      {
+        curves.push_back(curve_t{ first, second, { 0.0, 0.0 }, 0.0, 1, 0, 0 });
+      }
+      else if (first.x > second.x)
+      {
+        curves.push_back(curve_t{ second, first, { 0.0, 0.0 }, 0.0, -1, 0, 0 });
+      }
+    }
+  }
+
+  setLines(scene, curves);
+  curves.clear();
+  curves.shrink_to_fit();
+  if (scene.curves.empty())
+  {
+    return 0.0;
+  }
+  std::vector<crossing_t> crossings = findCrossings(scene);
+  setCrossings(scene, crossings);
+  crossings.clear();
+  crossings.shrink_to_fit();
+
+  const size_t numberOfSlabs = scene.lines.size() - 1;
+  numberOfThreads = std::min(numberOfThreads, numberOfSlabs);
+  std::vector<double> integrals(numberOfThreads, 0.0);
+  auto integrateStrip = [&scene, &integrals, numberOfSlabs, numberOfThreads](size_t strip)
+  {
+    StripSweep sweep(scene, strip * numberOfSlabs / numberOfThreads, (strip + 1) * numberOfSlabs / numberOfThreads);
+    integrals[strip] = sweep.integrate();
+  };
+  std::vector<std::thread> threads;
+  for (size_t strip = 1; strip < numberOfThreads; ++strip)
+  {
+    threads.emplace_back(integrateStrip, strip);
+  }
+  integrateStrip(0);
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+  double integral = 0.0;
+  for (double stripIntegral : integrals)
+  {
+    integral += stripIntegral;
+  }
+  return integral;
+}
@@ -0,0 +1,11 @@
+#ifndef KLIMCHUK_UNION_AREA
+#define KLIMCHUK_UNION_AREA
+
+#include "shape.hpp"
+
+namespace klimchuk
+{
+  double getUnionArea(const Shape::ShapePtr* shapes, size_t numberOfShapes, size_t numberOfThreads = 1);
+}
+
+#endif
@@ -0,0 +1,259 @@
+#include "vertex-encoding.hpp"
+#include <stdexcept>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+
+namespace
+{
+  const size_t SIZE_OF_BLOCK = 64;
+  const size_t SIZE_OF_PADDING = 8;
+  const double MAX_QUANTIZED_COORDINATE = 4611686018427387904.0;
+
+  struct header_t
+  {
+    size_t numberOfPoints;
+    double quantum;
+    int64_t first[2];
+    size_t beginningOfColumns;
+  };
+
+  uint64_t encodeZigzag(int64_t value)
+  {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+  }
+
+  int64_t decodeZigzag(uint64_t value)
+  {
+    return static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1));
+  }
+
+  unsigned int getWidth(uint64_t value)
+  {
+    unsigned int width = 0;
+    while (value != 0)
+    {
+      value >>= 1;
+      ++width;
+    }
+    return width;
+  }
+
+  size_t getSizeOfPacked(size_t numberOfValues, unsigned int width)
+  {
+    return ((numberOfValues * width) + 7) / 8;
+  }
+
+  void writeVarint(std::vector<uint8_t>& data, uint64_t value)
+  {
+    while (value >= 0x80)
+    {
+      data.push_back(static_cast<uint8_t>(value | 0x80));
+      value >>= 7;
+    }
+    data.push_back(static_cast<uint8_t>(value));
+  }
+
+  uint64_t readVarint(const uint8_t* data, size_t size, size_t& position)
+  {
+    uint64_t value = 0;
+    for (unsigned int shift = 0; shift < 64; shift += 7)
+    {
+      if (position >= size)
+      {
+        break;
+      }
+      const uint8_t byte = data[position++];
+      value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0)
+      {
+        return value;
+      }
+    }
+    throw std::invalid_argument("decodeVertices: Invalid varint.");
+  }
+
+  void writeColumn(std::vector<uint8_t>& data, const int64_t* quantized, size_t numberOfPoints)
+  {
+    uint64_t values[SIZE_OF_BLOCK];
+    for (size_t beginning = 1; beginning < numberOfPoints; beginning += SIZE_OF_BLOCK)
+    {
+      const size_t numberOfValues = std::min(SIZE_OF_BLOCK, numberOfPoints - beginning);
+      uint64_t mask = 0;
+      for (size_t i = 0; i < numberOfValues; ++i)
+      {
+        const size_t index = 2 * (beginning + i);
+        values[i] = encodeZigzag(quantized[index] - quantized[index - 2]);
+        mask |= values[i];
+      }
+      const unsigned int width = getWidth(mask);
+      data.push_back(static_cast<uint8_t>(width));
+      const size_t offset = data.size();
+      data.resize(offset + getSizeOfPacked(numberOfValues, width), 0);
+      uint8_t* bytes = data.data() + offset;
+      for (size_t i = 0; i < numberOfValues; ++i)
+      {
+        size_t bit = i * width;
+        uint64_t value = values[i];
+        int remaining = width;
+        while (remaining > 0)
+        {
+          const unsigned int shift = bit & 7;
+          bytes[bit >> 3] |= static_cast<uint8_t>(value << shift);
+          value >>= 8 - shift;
+          bit += 8 - shift;
+          remaining -= 8 - shift;
+        }
+      }
+    }
+  }
+
+  size_t skipColumn(const uint8_t* data, size_t size, size_t position, size_t numberOfPoints)
+  {
+    for (size_t beginning = 1; beginning < numberOfPoints; beginning += SIZE_OF_BLOCK)
+    {
+      if (position >= size || data[position] > 64)
+      {
+        throw std::invalid_argument("decodeVertices: Invalid block.");
+      }
+      position += 1 + getSizeOfPacked(std::min(SIZE_OF_BLOCK, numberOfPoints - beginning), data[position]);
+    }
+    return position;
+  }
+
+  size_t readColumn(const uint8_t* data, size_t position, size_t numberOfPoints, int64_t first, double quantum,
+      klimchuk::point_t* points, double klimchuk::point_t::* coordinate)
+  {
+    int64_t deltas[SIZE_OF_BLOCK];
+    int64_t current = first;
+    points[0].*coordinate = static_cast<double>(current) * quantum;
+    for (size_t beginning = 1; beginning < numberOfPoints; beginning += SIZE_OF_BLOCK)
+    {
+      const size_t numberOfValues = std::min(SIZE_OF_BLOCK, numberOfPoints - beginning);
+      const unsigned int width = data[position];
+      const uint8_t* bytes = data + position + 1;
+      const uint64_t mask = (width == 64) ? ~uint64_t(0) : ((uint64_t(1) << width) - 1);
+      for (size_t i = 0; (width == 0) && (i < numberOfValues); ++i)
+      {
+        deltas[i] = 0;
+      }
+      for (size_t i = 0; (width != 0) && (i < numberOfValues); ++i)
+      {
+        const size_t bit = i * width;
+        const unsigned int shift = bit & 7;
+        uint64_t word = 0;
+        std::memcpy(&word, bytes + (bit >> 3), sizeof(word));
+        const uint64_t next = bytes[(bit >> 3) + 8];
+        deltas[i] = decodeZigzag(((word >> shift) | ((next << 1) << (63 - shift))) & mask);
+      }
+      for (size_t i = 0; i < numberOfValues; ++i)
+      {
+        current += deltas[i];
+        points[beginning + i].*coordinate = static_cast<double>(current) * quantum;
+      }
+      position += 1 + getSizeOfPacked(numberOfValues, width);
+    }
+    return position;
+  }
+
+  header_t readHeader(const uint8_t* data, size_t size)
+  {
+    header_t header{ 0, 0.0, { 0, 0 }, 0 };
+    size_t position = 0;
+    const uint64_t numberOfPoints = readVarint(data, size, position);
+    if ((size - position < sizeof(double)) || (numberOfPoints / SIZE_OF_BLOCK > size))
+    {
+      throw std::invalid_argument("decodeVertices: Invalid header.");
+    }
+    header.numberOfPoints = numberOfPoints;
+    std::memcpy(&header.quantum, data + position, sizeof(double));
+    position += sizeof(double);
+    if (!(header.quantum > 0.0) || !std::isfinite(header.quantum))
+    {
+      throw std::invalid_argument("decodeVertices: Invalid quantum.");
+    }
+    if (header.numberOfPoints > 0)
+    {
+      header.first[0] = decodeZigzag(readVarint(data, size, position));
+      header.first[1] = decodeZigzag(readVarint(data, size, position));
+    }
+    header.beginningOfColumns = position;
+    return header;
+  }
+}
+
+std::vector<uint8_t> klimchuk::encodeVertices(const point_t* points, size_t numberOfPoints, double quantum)
+{
+  if (!(quantum > 0.0) || !std::isfinite(quantum))
+  {
+    throw std::invalid_argument("encodeVertices: Quantum should be positive.");
+  }
+  std::vector<int64_t> quantized(2 * numberOfPoints);
+  for (size_t i = 0; i < numberOfPoints; ++i)
+  {
+    const double x = std::nearbyint(points[i].x / quantum);
+    const double y = std::nearbyint(points[i].y / quantum);
+    if (!(std::abs(x) < MAX_QUANTIZED_COORDINATE) || !(std::abs(y) < MAX_QUANTIZED_COORDINATE))
+    {
+      throw std::out_of_range("encodeVertices: Coordinate doesn't fit the grid.");
+    }
+    quantized[2 * i] = static_cast<int64_t>(x);
+    quantized[(2 * i) + 1] = static_cast<int64_t>(y);
+  }
+  std::vector<uint8_t> data;
+  data.reserve(32 + numberOfPoints);
+  writeVarint(data, numberOfPoints);
+  data.resize(data.size() + sizeof(double));
+  std::memcpy(data.data() + data.size() - sizeof(double), &quantum, sizeof(double));
+  if (numberOfPoints > 0)
+  {
+    writeVarint(data, encodeZigzag(quantized[0]));
+    writeVarint(data, encodeZigzag(quantized[1]));
+  }
+  writeColumn(data, quantized.data(), numberOfPoints);
+  writeColumn(data, quantized.data() + 1, numberOfPoints);
+  data.resize(data.size() + SIZE_OF_PADDING, 0);
+  return data;
+}
+
+size_t klimchuk::getNumberOfEncodedVertices(const uint8_t* data, size_t size)
+{
+  return readHeader(data, size).numberOfPoints;
+}
+
+double klimchuk::getQuantumOfEncodedVertices(const uint8_t* data, size_t size)
+{
+  return readHeader(data, size).quantum;
+}
+
+size_t klimchuk::getSizeOfEncodedVertices(const uint8_t* data, size_t size)
+{
+  const header_t header = readHeader(data, size);
+  size_t position = skipColumn(data, size, header.beginningOfColumns, header.numberOfPoints);
+  position = skipColumn(data, size, position, header.numberOfPoints) + SIZE_OF_PADDING;
+  if (position > size)
+  {
+    throw std::invalid_argument("decodeVertices: Block is truncated.");
+  }
+  return position;
+}
+
+void klimchuk::decodeVertices(const uint8_t* data, size_t size, point_t* points)
+{
+  getSizeOfEncodedVertices(data, size);
+  const header_t header = readHeader(data, size);
+  if (header.numberOfPoints == 0)
+  {
+    return;
+  }
+  const size_t position = readColumn(data, header.beginningOfColumns, header.numberOfPoints, header.first[0],
+      header.quantum, points, &point_t::x);
+  readColumn(data, position, header.numberOfPoints, header.first[1], header.quantum, points, &point_t::y);
+}
+
+std::vector<klimchuk::point_t> klimchuk::decodeVertices(const uint8_t* data, size_t size)
+{
+  std::vector<point_t> points(getNumberOfEncodedVertices(data, size));
+  decodeVertices(data, size, points.data());
+  return points;
+}
@@ -0,0 +1,18 @@
+#ifndef KLIMCHUK_VERTEX_ENCODING
+#define KLIMCHUK_VERTEX_ENCODING
+
+#include <cstdint>
+#include <vector>
+#include "base-types.hpp"
+
+namespace klimchuk
+{
+  std::vector<uint8_t> encodeVertices(const point_t* points, size_t numberOfPoints, double quantum);
+  size_t getNumberOfEncodedVertices(const uint8_t* data, size_t size);
+  size_t getSizeOfEncodedVertices(const uint8_t* data, size_t size);
+  double getQuantumOfEncodedVertices(const uint8_t* data, size_t size);
+  void decodeVertices(const uint8_t* data, size_t size, point_t* points);
+  std::vector<point_t> decodeVertices(const uint8_t* data, size_t size);
+}
+
+#endif